@@ -0,0 +1,89 @@
+using FON.Types;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// Shape of the generated records: how many top-level fields, how deep o:{...} values nest, how long
+/// the arrays are and how large the RawData blobs are. Values are deterministic per id, so every run
+/// (and every engine) sees the same bytes.
+/// </summary>
+/// <remarks>
+/// Fields cycle through int, long, double, string and bool, and arrays are int and float lists. That is
+/// what the native backend carries, so Engine=Native really runs native for every shape except the
+/// RawData one, which the Auto methods hand back to the managed path.
+/// </remarks>
+public sealed record DataShape(string Name, int Fields, int Depth, int ArrayLength, int RawBytes) {
+    public static IEnumerable<DataShape> All => [
+        new("flat-8", Fields: 8, Depth: 0, ArrayLength: 0, RawBytes: 0),
+        new("wide-64", Fields: 64, Depth: 0, ArrayLength: 0, RawBytes: 0),
+        new("nested-4", Fields: 8, Depth: 4, ArrayLength: 0, RawBytes: 0),
+        new("arrays-256", Fields: 4, Depth: 0, ArrayLength: 256, RawBytes: 0),
+        new("raw-16k", Fields: 4, Depth: 0, ArrayLength: 0, RawBytes: 16 * 1024)
+    ];
+
+    /// <summary>
+    /// Shapes without RawData, for comparisons that need the native backend to take every record.
+    /// </summary>
+    public static IEnumerable<DataShape> Native => All.Where(shape => shape.RawBytes == 0);
+
+
+    public override string ToString() => Name;
+
+
+    public FonDump CreateDump(int count) {
+        var dump = new FonDump(count);
+        for (int i = 0; i < count; i++) {
+            dump.Add((ulong)i, CreateRecord(i));
+        }
+        return dump;
+    }
+
+
+    public FonCollection CreateRecord(int id) => CreateRecord(id, Fields, Depth);
+
+
+
+
+    private FonCollection CreateRecord(int id, int fields, int depth) {
+        var record = new FonCollection();
+        for (int f = 0; f < fields; f++) {
+            var key = $"f{f}";
+            switch (f % 5) {
+                case 0: record.Add(key, id + f); break;
+                case 1: record.Add(key, (long)id * 1_000_003 + f); break;
+                case 2: record.Add(key, id * 0.25 + f); break;
+                case 3: record.Add(key, $"value {id % 1000} of field {f}"); break;
+                default: record.Add(key, (id + f) % 2 == 0); break;
+            }
+        }
+
+        if (ArrayLength > 0) {
+            record.Add("ints", Enumerable.Range(id, ArrayLength).ToList());
+            record.Add("floats", Enumerable.Range(0, ArrayLength).Select(i => (id + i) * 0.5f).ToList());
+        }
+
+        if (RawBytes > 0) {
+            var bytes = new byte[RawBytes];
+            new Random(id).NextBytes(bytes);
+            record.Add("blob", new RawData(bytes));
+        }
+
+        if (depth > 0) {
+            record.Add("child", CreateRecord(id, Math.Max(1, fields / 2), depth - 1));
+        }
+
+        return record;
+    }
+}
+
+
+
+
+/// <summary>
+/// Which implementation the Auto methods dispatch to.
+/// </summary>
+public enum Engine {
+    Managed,
+    Native
+}
@@ -0,0 +1,223 @@
+using BenchmarkDotNet.Attributes;
+using FON.Core;
+using FON.Types;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// Every managed file and stream serializer over the same dump.
+/// </summary>
+[BenchmarkCategory("serialize")]
+public class SerializeFileBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo file = null!;
+    private FonDump dump = null!;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+    [Params(20_000)]
+    public int Records { get; set; }
+
+    [ParamsSource(typeof(Scratch), nameof(Scratch.ThreadCounts))]
+    public int Threads { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.Use(Engine.Managed);
+        scratch = new Scratch();
+        file = scratch.File("out.fon");
+        dump = Shape.CreateDump(Records);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() {
+        dump.Dispose();
+        scratch.Dispose();
+    }
+
+
+    [Benchmark(Baseline = true)]
+    public Task Basic() => Fon.SerializeToFileAsync(dump, file, Threads);
+
+    [Benchmark]
+    public Task Pipeline() => Fon.SerializeToFilePipelineAsync(dump, file, Threads);
+
+    [Benchmark]
+    public Task Chunked() => Fon.SerializeToFileChunkedAsync(dump, file, chunkSize: 1000, Threads);
+
+    [Benchmark]
+    public Task ToStream() => Fon.SerializeToStreamAsync(dump, Stream.Null, Threads);
+
+    [Benchmark]
+    public Task CompressedBrotli() => Fon.SerializeToFileCompressedAsync(dump, file, FonCompression.Brotli, maxDegreeOfParallelism: Threads);
+
+    [Benchmark]
+    public Task CompressedDeflate() => Fon.SerializeToFileCompressedAsync(dump, file, FonCompression.Deflate, maxDegreeOfParallelism: Threads);
+
+    [Benchmark]
+    public async Task Writer() {
+        await using var writer = FonWriter.Create(file, maxDegreeOfParallelism: Threads);
+        foreach (var (_, record) in dump) {
+            await writer.WriteAsync(record);
+        }
+    }
+}
+
+
+
+
+/// <summary>
+/// Every managed file reader over the same file, written once per parameter set.
+/// </summary>
+[BenchmarkCategory("deserialize")]
+public class DeserializeFileBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo file = null!;
+    private FileInfo compressed = null!;
+    private FonLineIndex index = null!;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+    [Params(20_000)]
+    public int Records { get; set; }
+
+    [ParamsSource(typeof(Scratch), nameof(Scratch.ThreadCounts))]
+    public int Threads { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.Use(Engine.Managed);
+        scratch = new Scratch();
+        file = scratch.File("in.fon");
+        compressed = scratch.File("in.fonz");
+
+        using var dump = Shape.CreateDump(Records);
+        Fon.SerializeToFileChunkedAsync(dump, file).GetAwaiter().GetResult();
+        Fon.SerializeToFileCompressedAsync(dump, compressed).GetAwaiter().GetResult();
+        index = Fon.BuildLineIndexAsync(file).GetAwaiter().GetResult();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() => scratch.Dispose();
+
+
+    [Benchmark(Baseline = true)]
+    public async Task<int> ReadAll() => Count(await Fon.DeserializeFromFileAsync(file, Threads));
+
+    [Benchmark]
+    public async Task<int> Chunked() => Count(await Fon.DeserializeFromFileChunkedAsync(file, chunkSize: 10000, Threads));
+
+    [Benchmark]
+    public async Task<int> Mapped() => Count(await Fon.DeserializeFromFileMappedAsync(file, Threads));
+
+    [Benchmark]
+    public async Task<int> Compressed() => Count(await Fon.DeserializeFromCompressedFileAsync(compressed, Threads));
+
+    [Benchmark]
+    public async Task<int> Streamed() {
+        var count = 0;
+        await foreach (var (_, record) in Fon.ReadRecordsAsync(file, Threads)) {
+            count += record.Count;
+        }
+        return count;
+    }
+
+    [Benchmark]
+    public async Task<int> Documents() {
+        var count = 0;
+        await foreach (var document in Fon.ReadDocumentsAsync(file)) {
+            using (document) {
+                foreach (var (_, record) in document) {
+                    count += record.Count;
+                }
+            }
+        }
+        return count;
+    }
+
+    [Benchmark]
+    public async Task<int> SelectedKeys() => Count(await Fon.DeserializeFromFileAsync(file, Threads, new FonReadOptions("f0", "f2")));
+
+    /// <summary>
+    /// 100 lines from the middle through the line index.
+    /// </summary>
+    [Benchmark]
+    public async Task<int> Range() {
+        var count = 0;
+        await foreach (var (_, record) in Fon.ReadRangeAsync(file, (ulong)Records / 2, 100, index)) {
+            count += record.Count;
+        }
+        return count;
+    }
+
+
+    private static int Count(FonDump dump) {
+        using (dump) {
+            return dump.Count;
+        }
+    }
+}
+
+
+
+
+/// <summary>
+/// The Auto entry points, managed against the native backend.
+/// </summary>
+[BenchmarkCategory("auto")]
+public class AutoBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo output = null!;
+    private FileInfo input = null!;
+    private FonDump dump = null!;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+    [Params(20_000)]
+    public int Records { get; set; }
+
+    [ParamsSource(typeof(Scratch), nameof(Scratch.ThreadCounts))]
+    public int Threads { get; set; }
+
+    [ParamsAllValues]
+    public Engine Engine { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        scratch = new Scratch();
+        output = scratch.File("out.fon");
+        input = scratch.File("in.fon");
+        dump = Shape.CreateDump(Records);
+
+        Scratch.Use(Engine.Managed);
+        Fon.SerializeToFileChunkedAsync(dump, input).GetAwaiter().GetResult();
+        Scratch.Use(Engine);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() {
+        Scratch.Use(Engine.Managed);
+        dump.Dispose();
+        scratch.Dispose();
+    }
+
+
+    [Benchmark]
+    public Task SerializeAuto() => Fon.SerializeToFileAutoAsync(dump, output, Threads);
+
+    [Benchmark]
+    public async Task<int> DeserializeAuto() {
+        using var loaded = await Fon.DeserializeFromFileAutoAsync(input, Threads);
+        return loaded.Count;
+    }
+}
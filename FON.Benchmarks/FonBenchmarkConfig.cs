@@ -0,0 +1,25 @@
+using BenchmarkDotNet.Columns;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Exporters;
+using BenchmarkDotNet.Exporters.Json;
+using BenchmarkDotNet.Order;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// Default job plus allocation and GC counts, lock contention and thread pool work items, exported as
+/// full JSON (for diffing runs in CI) and GitHub markdown (for pasting into a PR).
+/// </summary>
+public sealed class FonBenchmarkConfig : ManualConfig {
+    public FonBenchmarkConfig() {
+        Add(DefaultConfig.Instance);
+        AddDiagnoser(MemoryDiagnoser.Default);
+        AddDiagnoser(ThreadingDiagnoser.Default);
+        AddExporter(JsonExporter.Full);
+        AddExporter(MarkdownExporter.GitHub);
+        AddColumn(CategoriesColumn.Default);
+        WithOrderer(new DefaultOrderer(SummaryOrderPolicy.Declared));
+    }
+}
@@ -0,0 +1,7 @@
+using BenchmarkDotNet.Running;
+using FON.Benchmarks;
+
+// dotnet run -c Release -- --filter '*'                 every benchmark
+// dotnet run -c Release -- --anyCategories tuning       only the threshold sweeps
+// dotnet run -c Release -- --filter '*Auto*' --join     managed vs native in one table
+BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args, new FonBenchmarkConfig());
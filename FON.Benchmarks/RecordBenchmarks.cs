@@ -0,0 +1,238 @@
+using BenchmarkDotNet.Attributes;
+using FON.Core;
+using FON.Native;
+using FON.Types;
+using System.Buffers;
+using System.Text;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// One record at a time: the per-line cost under the file methods, without I/O or threading.
+/// </summary>
+[BenchmarkCategory("record")]
+public class RecordBenchmarks {
+    private FonCollection record = null!;
+    private byte[] line = null!;
+    private readonly ArrayBufferWriter<byte> buffer = new(1 << 20);
+    private readonly FonCollection target = new();
+    private readonly FonCollectionPool pool = new();
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+
+    [GlobalSetup]
+    public void Setup() {
+        record = Shape.CreateRecord(12345);
+        line = Encoding.UTF8.GetBytes(Fon.SerializeToString(record));
+    }
+
+
+    [Benchmark]
+    public string SerializeToString() => Fon.SerializeToString(record);
+
+    [Benchmark]
+    public int SerializeUtf8() {
+        buffer.ResetWrittenCount();
+        Fon.Serialize(record, buffer);
+        return buffer.WrittenCount;
+    }
+
+    [Benchmark(Baseline = true)]
+    public int DeserializeInto() {
+        Fon.DeserializeInto(line, target, pool);
+        return target.Count;
+    }
+
+    [Benchmark]
+    public int Document() {
+        using var document = FonDocument.Parse(line);
+        return document[0].Count;
+    }
+}
+
+
+
+
+/// <summary>
+/// The native library on the lines of <see cref="RecordBenchmarks"/>; <c>--join</c> puts both in one table.
+/// </summary>
+[BenchmarkCategory("record", "native")]
+public class NativeRecordBenchmarks {
+    private byte[] line = null!;
+    private IntPtr nativeRecord;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.RequireNative();
+        line = Encoding.UTF8.GetBytes(Fon.SerializeToString(Shape.CreateRecord(12345)));
+        nativeRecord = NativeApi.DeserializeCollection(line);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() {
+        if (nativeRecord != IntPtr.Zero) {
+            NativeBindings.fon_collection_free(nativeRecord);
+        }
+    }
+
+
+    [Benchmark]
+    public int NativeDeserialize() {
+        var handle = NativeApi.DeserializeCollection(line);
+        NativeBindings.fon_collection_free(handle);
+        return line.Length;
+    }
+
+    [Benchmark]
+    public int NativeSerialize() => NativeApi.SerializeCollection(nativeRecord).Length;
+}
+
+
+
+
+/// <summary>
+/// Generated serializer of a [FonSerializable] type against the collection API on the same keys.
+/// </summary>
+[BenchmarkCategory("record")]
+public class TypedRecordBenchmarks {
+    private BenchmarkOrder order = null!;
+    private FonCollection collection = null!;
+    private byte[] line = null!;
+    private readonly ArrayBufferWriter<byte> buffer = new(1 << 16);
+    private readonly FonCollection target = new();
+
+
+    [Params(0, 16, 256)]
+    public int Items { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        order = new BenchmarkOrder {
+            Id = 42,
+            Customer = "Customer 42",
+            Total = 1234.5,
+            Paid = true,
+            Prices = Enumerable.Range(0, Items).Select(i => i * 1.25).ToList(),
+            ShipTo = new BenchmarkAddress { City = "Berlin", Zip = 10115 }
+        };
+        collection = FonCollection.Serialize(order);
+        line = Encoding.UTF8.GetBytes(Fon.SerializeToString(collection));
+    }
+
+
+    [Benchmark(Baseline = true)]
+    public int SerializeTyped() {
+        buffer.ResetWrittenCount();
+        Fon.SerializeRecord(order, buffer);
+        return buffer.WrittenCount;
+    }
+
+    [Benchmark]
+    public int SerializeCollection() {
+        buffer.ResetWrittenCount();
+        Fon.Serialize(collection, buffer);
+        return buffer.WrittenCount;
+    }
+
+    [Benchmark]
+    public BenchmarkOrder DeserializeTyped() => Fon.DeserializeRecord<BenchmarkOrder>(line);
+
+    [Benchmark]
+    public BenchmarkOrder DeserializeCollection() {
+        Fon.DeserializeInto(line, target);
+        return target.Deserialize<BenchmarkOrder>();
+    }
+}
+
+
+
+
+[FonSerializable]
+public class BenchmarkOrder {
+    public int Id { get; set; }
+    public string? Customer { get; set; }
+    public double Total { get; set; }
+    public bool Paid { get; set; }
+    public List<double>? Prices { get; set; }
+    public BenchmarkAddress? ShipTo { get; set; }
+}
+
+
+[FonSerializable]
+public class BenchmarkAddress {
+    public string? City { get; set; }
+    public int Zip { get; set; }
+}
+
+
+
+
+/// <summary>
+/// Z85 encoding of RawData.
+/// </summary>
+[BenchmarkCategory("raw")]
+public class RawDataBenchmarks {
+    private byte[] data = null!;
+    private byte[] encoded = null!;
+
+
+    [Params(64, 16 * 1024, 1024 * 1024)]
+    public int Bytes { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        data = new byte[Bytes];
+        new Random(Bytes).NextBytes(data);
+        encoded = Encoding.ASCII.GetBytes(new RawData(data).Pack().encoded);
+    }
+
+
+    [Benchmark(Baseline = true)]
+    public string Pack() => new RawData(data).Pack().encoded;
+
+    [Benchmark]
+    public int Unpack() => RawData.FromEncoded(encoded).Unpack().Memory.Length;
+}
+
+
+
+
+/// <summary>
+/// Z85 in the native library, on the inputs of <see cref="RawDataBenchmarks"/>.
+/// </summary>
+[BenchmarkCategory("raw", "native")]
+public class NativeRawDataBenchmarks {
+    private byte[] data = null!;
+    private byte[] encoded = null!;
+
+
+    [Params(64, 16 * 1024, 1024 * 1024)]
+    public int Bytes { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.RequireNative();
+        data = new byte[Bytes];
+        new Random(Bytes).NextBytes(data);
+        encoded = Encoding.ASCII.GetBytes(new RawData(data).Pack().encoded);
+    }
+
+
+    [Benchmark]
+    public int NativeEncode() => NativeApi.Z85Encode(data).Length;
+
+    [Benchmark]
+    public int NativeDecode() => NativeApi.Z85Decode(encoded).Length;
+}
@@ -0,0 +1,47 @@
+using FON.Acceleration;
+using FON.Native;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// Per-benchmark-class temp directory plus the engine switch shared by all benchmarks.
+/// </summary>
+internal sealed class Scratch : IDisposable {
+    private readonly DirectoryInfo directory = Directory.CreateTempSubdirectory("fon-bench-");
+
+
+    public FileInfo File(string name) => new(Path.Combine(directory.FullName, name));
+
+    public void Dispose() => directory.Delete(recursive: true);
+
+
+    /// <summary>
+    /// Routes the Auto methods to <paramref name="engine"/>. Native fails the benchmark (not the run)
+    /// when the library was not built: <c>cargo build --release</c> in FON.Native.
+    /// </summary>
+    public static void Use(Engine engine) {
+        if (engine == Engine.Native) {
+            NativeBackend.Register();
+            RequireNative();
+        }
+        FonAccelerator.ForceManaged = engine == Engine.Managed;
+    }
+
+
+    /// <summary>
+    /// For the benchmarks that call the native library directly; call it from [GlobalSetup] so a missing
+    /// library fails those benchmarks once, like <see cref="Use"/> does, instead of every invocation.
+    /// </summary>
+    public static void RequireNative() {
+        if (!NativeLoader.IsAvailable) {
+            throw new InvalidOperationException("Native library not found, build FON.Native first");
+        }
+    }
+
+
+    /// <summary>
+    /// 1, 4 and every core; duplicates dropped on small machines.
+    /// </summary>
+    public static IEnumerable<int> ThreadCounts => new[] { 1, 4, Environment.ProcessorCount }.Distinct().Order();
+}
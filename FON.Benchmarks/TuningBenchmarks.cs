@@ -0,0 +1,139 @@
+using BenchmarkDotNet.Attributes;
+using FON.Core;
+using FON.Types;
+
+namespace FON.Benchmarks;
+
+
+/// <summary>
+/// Re-derives <see cref="Fon.ParallelMethodThreshold"/>: the record count where Chunked (with the chunk size
+/// the Auto method would pick) overtakes Pipeline. The default of 2000 sits where the two lines cross.
+/// </summary>
+[BenchmarkCategory("tuning")]
+public class ParallelMethodThresholdBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo file = null!;
+    private FonDump dump = null!;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+    [Params(250, 500, 1000, 2000, 4000, 8000, 16000)]
+    public int Records { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.Use(Engine.Managed);
+        scratch = new Scratch();
+        file = scratch.File("out.fon");
+        dump = Shape.CreateDump(Records);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() {
+        dump.Dispose();
+        scratch.Dispose();
+    }
+
+
+    [Benchmark(Baseline = true)]
+    public Task Pipeline() => Fon.SerializeToFilePipelineAsync(dump, file);
+
+    [Benchmark]
+    public Task Chunked() {
+        // Same formula as SerializeToFileAutoAsync
+        var targetChunks = Math.Max(Environment.ProcessorCount * 4, 50);
+        var chunkSize = Math.Max(500, Math.Min(2000, Records / targetChunks));
+        return Fon.SerializeToFileChunkedAsync(dump, file, chunkSize);
+    }
+}
+
+
+
+
+/// <summary>
+/// Re-derives the 500..2000 record clamp the Auto serializer puts on the chunk size.
+/// </summary>
+[BenchmarkCategory("tuning")]
+public class ChunkSizeBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo file = null!;
+    private FonDump dump = null!;
+
+
+    [ParamsSource(typeof(DataShape), nameof(DataShape.All))]
+    public DataShape Shape { get; set; } = null!;
+
+    [Params(100_000)]
+    public int Records { get; set; }
+
+    [Params(125, 250, 500, 1000, 2000, 4000, 8000)]
+    public int ChunkSize { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.Use(Engine.Managed);
+        scratch = new Scratch();
+        file = scratch.File("out.fon");
+        dump = Shape.CreateDump(Records);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() {
+        dump.Dispose();
+        scratch.Dispose();
+    }
+
+
+    [Benchmark]
+    public Task Chunked() => Fon.SerializeToFileChunkedAsync(dump, file, ChunkSize);
+}
+
+
+
+
+/// <summary>
+/// Re-derives <see cref="Fon.MappedFileThreshold"/>: the file size where parsing memory-mapped ranges beats
+/// reading the whole file into one array first. Files are grown from the flat shape to the given size.
+/// </summary>
+[BenchmarkCategory("tuning")]
+public class MappedFileThresholdBenchmarks {
+    private Scratch scratch = null!;
+    private FileInfo file = null!;
+
+
+    [Params(16, 64, 256, 512, 1024)]
+    public int Megabytes { get; set; }
+
+
+    [GlobalSetup]
+    public void Setup() {
+        Scratch.Use(Engine.Managed);
+        scratch = new Scratch();
+        file = scratch.File("in.fon");
+
+        var shape = DataShape.All.First();
+        var lineBytes = Fon.SerializeToString(shape.CreateRecord(0)).Length + 1;
+        using var dump = shape.CreateDump((int)((long)Megabytes * 1024 * 1024 / lineBytes));
+        Fon.SerializeToFileChunkedAsync(dump, file).GetAwaiter().GetResult();
+    }
+
+    [GlobalCleanup]
+    public void Cleanup() => scratch.Dispose();
+
+
+    [Benchmark(Baseline = true)]
+    public async Task<int> ReadAll() {
+        using var dump = await Fon.DeserializeFromFileAsync(file);
+        return dump.Count;
+    }
+
+    [Benchmark]
+    public async Task<int> Mapped() {
+        using var dump = await Fon.DeserializeFromFileMappedAsync(file);
+        return dump.Count;
+    }
+}
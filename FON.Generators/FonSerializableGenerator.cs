@@ -0,0 +1,269 @@
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Linq;
+using System.Threading;
+
+namespace FON.Generators;
+
+
+/// <summary>
+/// Emits an <c>IFonTypeSerializer&lt;T&gt;</c> for every <c>[FonSerializable]</c> type, registered
+/// through a module initializer. Property types are checked against what FON can store, so a
+/// property that could not round-trip is a compile error instead of a runtime surprise.
+/// </summary>
+[Generator(LanguageNames.CSharp)]
+public sealed class FonSerializableGenerator : IIncrementalGenerator {
+    internal const string AttributeName = "FON.Core.FonSerializableAttribute";
+    private const string RawDataName = "FON.Types.RawData";
+
+
+    public void Initialize(IncrementalGeneratorInitializationContext context) {
+        var types = context.SyntaxProvider.ForAttributeWithMetadataName(
+            AttributeName,
+            predicate: static (node, _) => node is ClassDeclarationSyntax or StructDeclarationSyntax or RecordDeclarationSyntax,
+            transform: static (context, cancellationToken) => Parse((INamedTypeSymbol)context.TargetSymbol, context.SemanticModel.Compilation, cancellationToken));
+
+        context.RegisterSourceOutput(types, static (context, model) => {
+            foreach (var diagnostic in model.Diagnostics) {
+                context.ReportDiagnostic(diagnostic.ToDiagnostic());
+            }
+            if (model.SerializerName.Length > 0) {
+                context.AddSource($"{model.Namespace}.{model.SerializerName}.g.cs".TrimStart('.'), SerializerEmitter.Emit(model));
+            }
+        });
+    }
+
+
+
+
+    private static TypeModel Parse(INamedTypeSymbol type, Compilation compilation, CancellationToken cancellationToken) {
+        var diagnostics = new List<DiagnosticInfo>();
+        var location = type.Locations.FirstOrDefault();
+        var typeName = type.ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+        var ns = type.ContainingNamespace.IsGlobalNamespace ? null : type.ContainingNamespace.ToDisplayString();
+
+        var problem = type.IsGenericType ? "generic types are not supported"
+            : type.IsAbstract ? "abstract types cannot be created"
+            : !IsAccessible(type) ? "the type and its containing types must be public or internal"
+            : null;
+        if (problem != null) {
+            diagnostics.Add(DiagnosticInfo.Create(Diagnostics.UnsupportedType, location, type.Name, problem));
+        } else if (!type.IsValueType && !type.InstanceConstructors.Any(c => c.Parameters.Length == 0 && IsAccessible(c.DeclaredAccessibility))) {
+            diagnostics.Add(DiagnosticInfo.Create(Diagnostics.MissingConstructor, location, type.Name));
+        }
+
+        if (diagnostics.Count > 0) {
+            return new TypeModel(ns, typeName, "", type.IsValueType, default, new EquatableArray<DiagnosticInfo>(diagnostics.ToImmutableArray()));
+        }
+
+        var properties = new List<PropertyModel>();
+        foreach (var property in GetProperties(type)) {
+            cancellationToken.ThrowIfCancellationRequested();
+
+            var model = ParseProperty(property, compilation);
+            if (model != null) {
+                properties.Add(model);
+            } else {
+                var propertyLocation = property.Locations.FirstOrDefault(l => l.IsInSource) ?? location;
+                diagnostics.Add(DiagnosticInfo.Create(Diagnostics.UnsupportedProperty, propertyLocation,
+                    property.Name, property.Type.ToDisplayString(SymbolDisplayFormat.MinimallyQualifiedFormat)));
+            }
+        }
+
+        return new TypeModel(
+            ns,
+            typeName,
+            GetSerializerName(type),
+            type.IsValueType,
+            new EquatableArray<PropertyModel>(properties.ToImmutableArray()),
+            new EquatableArray<DiagnosticInfo>(diagnostics.ToImmutableArray()));
+    }
+
+
+
+
+    /// <summary>
+    /// Public instance properties with a public getter and setter, base types included, in
+    /// declaration order (base first) like the reflection path's keys. Init-only and read-only
+    /// properties are left out, they cannot be set after construction.
+    /// </summary>
+    private static IEnumerable<IPropertySymbol> GetProperties(INamedTypeSymbol type) {
+        var chain = new Stack<INamedTypeSymbol>();
+        for (var current = type; current != null && current.SpecialType != SpecialType.System_Object && current.SpecialType != SpecialType.System_ValueType; current = current.BaseType) {
+            chain.Push(current);
+        }
+
+        var seen = new HashSet<string>();
+        var result = new List<IPropertySymbol>();
+        foreach (var current in chain) {
+            foreach (var property in current.GetMembers().OfType<IPropertySymbol>()) {
+                if (property.IsStatic || property.IsIndexer || property.DeclaredAccessibility != Accessibility.Public ||
+                    property.GetMethod is not { DeclaredAccessibility: Accessibility.Public } ||
+                    property.SetMethod is not { DeclaredAccessibility: Accessibility.Public, IsInitOnly: false }) {
+                    continue;
+                }
+                // An override or 'new' property replaces the base one under the same key
+                if (seen.Add(property.Name)) {
+                    result.Add(property);
+                } else {
+                    result[result.FindIndex(p => p.Name == property.Name)] = property;
+                }
+            }
+        }
+        return result;
+    }
+
+
+
+
+    private static PropertyModel? ParseProperty(IPropertySymbol property, Compilation compilation) {
+        var type = property.Type;
+        var typeName = type.WithNullableAnnotation(NullableAnnotation.NotAnnotated).ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+
+        if (GetValueMethod(type) is { } method) {
+            var name = Display(type);
+            return new PropertyModel(property.Name, PropertyKind.Scalar, CollectionShape.None, typeName, name, method, type.IsReferenceType, false, null);
+        }
+
+        if (type is INamedTypeSymbol { OriginalDefinition.SpecialType: SpecialType.System_Nullable_T } nullable &&
+            GetValueMethod(nullable.TypeArguments[0]) is { } underlying) {
+            return new PropertyModel(property.Name, PropertyKind.Scalar, CollectionShape.None, typeName, Display(nullable.TypeArguments[0]), underlying, false, true, null);
+        }
+
+        if (IsSerializable(type)) {
+            return new PropertyModel(property.Name, PropertyKind.Object, CollectionShape.None, typeName, Display(type), "", type.IsReferenceType, false, GetSerializer(type, compilation));
+        }
+
+        var (shape, element) = GetCollection(type);
+        if (shape == CollectionShape.None || element == null) {
+            return null;
+        }
+
+        if (GetValueMethod(element) is { } elementMethod) {
+            return new PropertyModel(property.Name, PropertyKind.List, shape, typeName, Display(element), elementMethod, element.IsReferenceType, false, null);
+        }
+        if (IsSerializable(element)) {
+            return new PropertyModel(property.Name, PropertyKind.ObjectList, shape, typeName, Display(element), "", element.IsReferenceType, false, GetSerializer(element, compilation));
+        }
+        return null;
+    }
+
+
+
+
+    /// <summary>
+    /// Writer / reader method suffix for the types in <c>Fon.SupportTypes</c> (objects aside).
+    /// </summary>
+    private static string? GetValueMethod(ITypeSymbol type) {
+        switch (type.SpecialType) {
+            case SpecialType.System_Byte: return "Byte";
+            case SpecialType.System_Int16: return "Int16";
+            case SpecialType.System_Int32: return "Int32";
+            case SpecialType.System_UInt32: return "UInt32";
+            case SpecialType.System_Int64: return "Int64";
+            case SpecialType.System_UInt64: return "UInt64";
+            case SpecialType.System_Single: return "Single";
+            case SpecialType.System_Double: return "Double";
+            case SpecialType.System_Boolean: return "Boolean";
+            case SpecialType.System_String: return "String";
+        }
+        return type.ToDisplayString() is RawDataName or RawDataName + "?" ? "RawData" : null;
+    }
+
+
+    private static (CollectionShape shape, ITypeSymbol? element) GetCollection(ITypeSymbol type) {
+        if (type is IArrayTypeSymbol { Rank: 1 } array) {
+            return (CollectionShape.Array, array.ElementType);
+        }
+        if (type is INamedTypeSymbol { IsGenericType: true, TypeArguments.Length: 1 } named) {
+            switch (named.OriginalDefinition.ToDisplayString()) {
+                case "System.Collections.Generic.List<T>": return (CollectionShape.List, named.TypeArguments[0]);
+                case "System.Collections.Generic.IList<T>": return (CollectionShape.IList, named.TypeArguments[0]);
+            }
+        }
+        return (CollectionShape.None, null);
+    }
+
+
+    private static bool IsSerializable(ITypeSymbol type) {
+        return type is INamedTypeSymbol { IsGenericType: false } named &&
+            named.GetAttributes().Any(a => a.AttributeClass?.ToDisplayString() == AttributeName);
+    }
+
+
+    /// <summary>
+    /// Nested types of this compilation are called directly; ones from other assemblies go through
+    /// the registry, their generated serializer is internal to that assembly.
+    /// </summary>
+    private static string GetSerializer(ITypeSymbol type, Compilation compilation) {
+        if (SymbolEqualityComparer.Default.Equals(type.ContainingAssembly, compilation.Assembly)) {
+            var ns = type.ContainingNamespace.IsGlobalNamespace ? "global::" : $"global::{type.ContainingNamespace.ToDisplayString()}.";
+            return $"{ns}{GetSerializerName((INamedTypeSymbol)type)}.Instance";
+        }
+        return $"global::FON.Core.FonTypeSerializers.GetRequired<{Display(type)}>()";
+    }
+
+
+    private static string GetSerializerName(INamedTypeSymbol type) {
+        var name = type.Name;
+        for (var containing = type.ContainingType; containing != null; containing = containing.ContainingType) {
+            name = containing.Name + "_" + name;
+        }
+        return name + "FonSerializer";
+    }
+
+
+    private static string Display(ITypeSymbol type) {
+        return type.WithNullableAnnotation(NullableAnnotation.NotAnnotated).ToDisplayString(SymbolDisplayFormat.FullyQualifiedFormat);
+    }
+
+
+    private static bool IsAccessible(INamedTypeSymbol type) {
+        for (ISymbol? current = type; current is INamedTypeSymbol named; current = named.ContainingType) {
+            if (!IsAccessible(named.DeclaredAccessibility)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    private static bool IsAccessible(Accessibility accessibility) {
+        return accessibility is Accessibility.Public or Accessibility.Internal or Accessibility.ProtectedOrInternal;
+    }
+}
+
+
+
+
+internal static class Diagnostics {
+    private const string Category = "FON";
+
+
+    public static readonly DiagnosticDescriptor UnsupportedProperty = new(
+        "FON001",
+        "Property type is not supported by FON",
+        "Property '{0}' of type '{1}' cannot be serialized: FON stores primitives from Fon.SupportTypes, string, RawData, [FonSerializable] types, and arrays, List<T> or IList<T> of those",
+        Category,
+        DiagnosticSeverity.Error,
+        isEnabledByDefault: true);
+
+    public static readonly DiagnosticDescriptor MissingConstructor = new(
+        "FON002",
+        "[FonSerializable] type needs a parameterless constructor",
+        "'{0}' needs a public or internal parameterless constructor to be [FonSerializable]",
+        Category,
+        DiagnosticSeverity.Error,
+        isEnabledByDefault: true);
+
+    public static readonly DiagnosticDescriptor UnsupportedType = new(
+        "FON003",
+        "Type cannot be [FonSerializable]",
+        "'{0}' cannot be [FonSerializable]: {1}",
+        Category,
+        DiagnosticSeverity.Error,
+        isEnabledByDefault: true);
+}
@@ -0,0 +1,344 @@
+using Microsoft.CodeAnalysis.CSharp;
+using System.Linq;
+using System.Text;
+
+namespace FON.Generators;
+
+
+/// <summary>
+/// Writes the source of one generated serializer. Keys are the property names as UTF-8 literals;
+/// <c>Read</c> matches them by length first, then by bytes, so a record costs one span compare per key.
+/// </summary>
+internal static class SerializerEmitter {
+    private const string Writer = "global::FON.Core.FonUtf8Writer";
+    private const string Reader = "global::FON.Core.FonUtf8Reader";
+    private const string Collection = "global::FON.Types.FonCollection";
+    private const string List = "global::System.Collections.Generic.List";
+    private const string IList = "global::System.Collections.Generic.IList";
+
+    private static readonly string Version = typeof(SerializerEmitter).Assembly.GetName().Version?.ToString() ?? "1.0.0.0";
+
+
+    public static string Emit(TypeModel model) {
+        var source = new CodeBuilder();
+        source.Line("// <auto-generated/>");
+        source.Line("#nullable enable");
+        source.Line();
+        if (model.Namespace != null) {
+            source.Line($"namespace {model.Namespace};");
+            source.Line();
+        }
+
+        source.Line($"/// <summary>FON serializer for <see cref=\"{model.TypeName}\"/>, generated from [FonSerializable].</summary>");
+        source.Line($"[global::System.CodeDom.Compiler.GeneratedCode(\"FON.Generators\", \"{Version}\")]");
+        source.Open($"internal sealed class {model.SerializerName} : global::FON.Core.IFonTypeSerializer<{model.TypeName}>");
+        source.Line($"public static readonly {model.SerializerName} Instance = new();");
+        source.Line();
+        source.Line("#pragma warning disable CA2255 // Registering before first use is exactly what a module initializer is for");
+        source.Line("[global::System.Runtime.CompilerServices.ModuleInitializer]");
+        source.Line("internal static void Register() => global::FON.Core.FonTypeSerializers.Register(Instance);");
+        source.Line("#pragma warning restore CA2255");
+
+        EmitWrite(source, model);
+        EmitRead(source, model);
+        EmitToCollection(source, model);
+        EmitFromCollection(source, model);
+
+        source.Close();
+        return source.ToString();
+    }
+
+
+
+
+    private static void EmitWrite(CodeBuilder source, TypeModel model) {
+        source.Line();
+        source.Open($"public void Write(ref {Writer} writer, {model.TypeName} value)");
+        EmitNullCheck(source, model);
+
+        for (int i = 0; i < model.Properties.Count; i++) {
+            var property = model.Properties[i];
+            var access = $"value.{Identifier(property.Name)}";
+            var key = Utf8(property.Name);
+            var local = $"p{i}";
+
+            switch (property.Kind) {
+                case PropertyKind.Scalar when property.IsNullableValue:
+                    source.Line($"if ({access} is {{ }} {local}) writer.Write{property.ValueMethod}({key}, {local});");
+                    break;
+                case PropertyKind.Scalar:
+                    source.Line($"writer.Write{property.ValueMethod}({key}, {access});");
+                    break;
+                case PropertyKind.List:
+                    source.Line($"writer.WriteArray<{property.ElementTypeName}>({key}, {access});");
+                    break;
+                case PropertyKind.Object:
+                    if (property.IsReference) {
+                        source.Open($"if ({access} is {{ }} {local})");
+                    } else {
+                        source.Open();
+                        source.Line($"var {local} = {access};");
+                    }
+                    source.Line($"writer.BeginObject({key});");
+                    source.Line($"{property.Serializer}.Write(ref writer, {local});");
+                    source.Line("writer.EndObject();");
+                    source.Close();
+                    break;
+                case PropertyKind.ObjectList:
+                    source.Open($"if ({access} is {{ }} {local})");
+                    source.Line($"writer.BeginObjectArray({key});");
+                    source.Open($"for (int i = 0; i < {local}.{Count(property)}; i++)");
+                    source.Line("writer.BeginArrayObject();");
+                    if (property.IsReference) {
+                        source.Line($"if ({local}[i] is {{ }} item) {property.Serializer}.Write(ref writer, item);");
+                    } else {
+                        source.Line($"{property.Serializer}.Write(ref writer, {local}[i]);");
+                    }
+                    source.Line("writer.EndObject();");
+                    source.Close();
+                    source.Line("writer.EndObjectArray();");
+                    source.Close();
+                    break;
+            }
+        }
+        source.Close();
+    }
+
+
+
+
+    private static void EmitRead(CodeBuilder source, TypeModel model) {
+        source.Line();
+        source.Open($"public {model.TypeName} Read(ref {Reader} reader)");
+        source.Line($"var result = new {model.TypeName}();");
+        source.Open("while (reader.TryReadProperty(out var key))");
+
+        if (model.Properties.Count > 0) {
+            source.Open("switch (key.Length)");
+            foreach (var group in model.Properties.GroupBy(p => Encoding.UTF8.GetByteCount(p.Name)).OrderBy(g => g.Key)) {
+                source.Line($"case {group.Key}:");
+                source.Indent();
+                foreach (var property in group) {
+                    source.Open($"if (global::System.MemoryExtensions.SequenceEqual(key, {Utf8(property.Name)}))");
+                    EmitReadValue(source, property);
+                    source.Line("continue;");
+                    source.Close();
+                }
+                source.Line("break;");
+                source.Unindent();
+            }
+            source.Close();
+        }
+
+        source.Line("reader.Skip();");
+        source.Close();
+        source.Line("return result;");
+        source.Close();
+    }
+
+
+    private static void EmitReadValue(CodeBuilder source, PropertyModel property) {
+        var target = $"result.{Identifier(property.Name)}";
+
+        switch (property.Kind) {
+            case PropertyKind.Scalar:
+                source.Line($"{target} = reader.Read{property.ValueMethod}();");
+                break;
+            case PropertyKind.List:
+                source.Line($"{target} = reader.ReadList<{property.ElementTypeName}>(){ToShape(property)};");
+                break;
+            case PropertyKind.Object:
+                source.Line("reader.BeginObject();");
+                source.Line($"{target} = {property.Serializer}.Read(ref reader);");
+                break;
+            case PropertyKind.ObjectList:
+                source.Line("reader.BeginObjectArray();");
+                source.Line($"var list = new {List}<{property.ElementTypeName}>();");
+                source.Open("while (reader.TryBeginArrayObject())");
+                source.Line($"list.Add({property.Serializer}.Read(ref reader));");
+                source.Close();
+                source.Line($"{target} = list{ToShape(property)};");
+                break;
+        }
+    }
+
+
+
+
+    private static void EmitToCollection(CodeBuilder source, TypeModel model) {
+        source.Line();
+        source.Open($"public {Collection} ToCollection({model.TypeName} value)");
+        EmitNullCheck(source, model);
+        source.Line($"var collection = new {Collection}({model.Properties.Count});");
+
+        for (int i = 0; i < model.Properties.Count; i++) {
+            var property = model.Properties[i];
+            var access = $"value.{Identifier(property.Name)}";
+            var key = Quote(property.Name);
+            var local = $"p{i}";
+
+            switch (property.Kind) {
+                case PropertyKind.Scalar when property.IsReference || property.IsNullableValue:
+                    source.Line($"if ({access} is {{ }} {local}) collection.Add({key}, {local});");
+                    break;
+                case PropertyKind.List:
+                    source.Line($"if ({access} is {{ }} {local}) collection.Add({key}, {ToCollectionList(property, local)});");
+                    break;
+                case PropertyKind.Scalar:
+                    source.Line($"collection.Add({key}, {access});");
+                    break;
+                case PropertyKind.Object when property.IsReference:
+                    source.Line($"if ({access} is {{ }} {local}) collection.Add({key}, {property.Serializer}.ToCollection({local}));");
+                    break;
+                case PropertyKind.Object:
+                    source.Line($"collection.Add({key}, {property.Serializer}.ToCollection({access}));");
+                    break;
+                case PropertyKind.ObjectList:
+                    source.Open($"if ({access} is {{ }} {local})");
+                    source.Line($"var list = new {List}<{Collection}>({local}.{Count(property)});");
+                    source.Open($"foreach (var item in {local})");
+                    source.Line(property.IsReference
+                        ? $"list.Add(item is null ? new {Collection}() : {property.Serializer}.ToCollection(item));"
+                        : $"list.Add({property.Serializer}.ToCollection(item));");
+                    source.Close();
+                    source.Line($"collection.Add({key}, list);");
+                    source.Close();
+                    break;
+            }
+        }
+
+        source.Line("return collection;");
+        source.Close();
+    }
+
+
+
+
+    private static void EmitFromCollection(CodeBuilder source, TypeModel model) {
+        source.Line();
+        source.Open($"public {model.TypeName} FromCollection({Collection} collection)");
+        source.Line("global::System.ArgumentNullException.ThrowIfNull(collection);");
+        source.Line($"var result = new {model.TypeName}();");
+
+        for (int i = 0; i < model.Properties.Count; i++) {
+            var property = model.Properties[i];
+            var target = $"result.{Identifier(property.Name)}";
+            var key = Quote(property.Name);
+            var local = $"p{i}";
+
+            switch (property.Kind) {
+                case PropertyKind.Scalar when property.IsReference:
+                    source.Line($"if (collection.TryGet<{property.ElementTypeName}>({key}) is {{ }} {local}) {target} = {local};");
+                    break;
+                case PropertyKind.Scalar:
+                    source.Line($"if (collection.TryGetNullable<{property.ElementTypeName}>({key}) is {{ }} {local}) {target} = {local};");
+                    break;
+                case PropertyKind.List:
+                    source.Line($"if (collection.TryGet<{IList}<{property.ElementTypeName}>>({key}) is {{ }} {local}) {target} = {FromList(property, local)};");
+                    break;
+                case PropertyKind.Object:
+                    source.Line($"if (collection.TryGet<{Collection}>({key}) is {{ }} {local}) {target} = {property.Serializer}.FromCollection({local});");
+                    break;
+                case PropertyKind.ObjectList:
+                    source.Open($"if (collection.TryGet<{IList}<{Collection}>>({key}) is {{ }} {local})");
+                    source.Line($"var list = new {List}<{property.ElementTypeName}>({local}.Count);");
+                    source.Open($"foreach (var item in {local})");
+                    source.Line($"list.Add({property.Serializer}.FromCollection(item));");
+                    source.Close();
+                    source.Line($"{target} = list{ToShape(property)};");
+                    source.Close();
+                    break;
+            }
+        }
+
+        source.Line("return result;");
+        source.Close();
+    }
+
+
+
+
+    private static void EmitNullCheck(CodeBuilder source, TypeModel model) {
+        if (!model.IsValueType) {
+            source.Line("global::System.ArgumentNullException.ThrowIfNull(value);");
+        }
+    }
+
+
+    // The readers build a List<T>; arrays get a copy, IList<T> takes the list as is
+    private static string ToShape(PropertyModel property) => property.Shape == CollectionShape.Array ? ".ToArray()" : "";
+
+
+    // FonCollection takes the element type from List<T>'s type argument, which arrays don't have
+    private static string ToCollectionList(PropertyModel property, string local) {
+        var list = $"{List}<{property.ElementTypeName}>";
+        return property.Shape switch {
+            CollectionShape.Array => $"new {list}({local})",
+            CollectionShape.IList => $"{local} as {list} ?? new {list}({local})",
+            _ => local
+        };
+    }
+
+
+    private static string FromList(PropertyModel property, string local) {
+        var element = property.ElementTypeName;
+        return property.Shape switch {
+            CollectionShape.Array => $"{local} as {element}[] ?? global::System.Linq.Enumerable.ToArray({local})",
+            CollectionShape.List => $"{local} as {List}<{element}> ?? new {List}<{element}>({local})",
+            _ => local
+        };
+    }
+
+
+    private static string Count(PropertyModel property) => property.Shape == CollectionShape.Array ? "Length" : "Count";
+
+
+    private static string Identifier(string name) {
+        return SyntaxFacts.GetKeywordKind(name) != SyntaxKind.None ? "@" + name : name;
+    }
+
+
+    private static string Quote(string name) => SymbolDisplay.FormatLiteral(name, quote: true);
+
+
+    private static string Utf8(string name) => Quote(name) + "u8";
+
+
+
+
+    /// <summary>
+    /// Indented line writer for the generated source.
+    /// </summary>
+    private sealed class CodeBuilder {
+        private readonly StringBuilder builder = new();
+        private int indent;
+
+
+        public void Line(string text = "") {
+            if (text.Length > 0) {
+                builder.Append(' ', indent * 4);
+            }
+            builder.Append(text).Append('\n');
+        }
+
+        public void Open(string? header = null) {
+            if (header != null) {
+                builder.Append(' ', indent * 4).Append(header).Append(" {\n");
+            } else {
+                builder.Append(' ', indent * 4).Append("{\n");
+            }
+            indent++;
+        }
+
+        public void Close() {
+            indent--;
+            Line("}");
+        }
+
+        public void Indent() => indent++;
+
+        public void Unindent() => indent--;
+
+        public override string ToString() => builder.ToString();
+    }
+}
@@ -0,0 +1,124 @@
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.Text;
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Linq;
+
+namespace FON.Generators;
+
+
+/// <summary>
+/// How a property is written and read.
+/// </summary>
+internal enum PropertyKind {
+    Scalar,      // primitive, string or RawData
+    List,        // array / list of primitives, strings or RawData
+    Object,      // nested [FonSerializable] type, o:{...}
+    ObjectList   // array / list of nested types, o:[{...},...]
+}
+
+
+internal enum CollectionShape {
+    None,
+    Array,       // T[]
+    List,        // List<T>
+    IList        // IList<T>, filled with a List<T>
+}
+
+
+
+
+/// <summary>
+/// Everything the emitter needs about one property. Plain strings only, so the incremental
+/// pipeline can compare models between compilations and skip unchanged types.
+/// </summary>
+internal sealed record PropertyModel(
+    string Name,
+    PropertyKind Kind,
+    CollectionShape Shape,
+    string TypeName,          // full property type
+    string ElementTypeName,   // element (or the type itself for scalars / objects)
+    string ValueMethod,       // FonUtf8Writer / FonUtf8Reader suffix: Int32, String, RawData, ...
+    bool IsReference,         // element can be null (string, RawData, classes)
+    bool IsNullableValue,     // int?, double?, ... (the element type is the underlying one)
+    string? Serializer        // expression yielding the nested serializer
+);
+
+
+internal sealed record TypeModel(
+    string? Namespace,
+    string TypeName,          // fully qualified, global:: prefixed
+    string SerializerName,
+    bool IsValueType,
+    EquatableArray<PropertyModel> Properties,
+    EquatableArray<DiagnosticInfo> Diagnostics
+);
+
+
+
+
+/// <summary>
+/// Diagnostic with its location flattened to plain values (a <see cref="Location"/> would keep the
+/// whole syntax tree alive across generator runs).
+/// </summary>
+internal sealed record DiagnosticInfo(DiagnosticDescriptor Descriptor, string? FilePath, TextSpan Span, LinePositionSpan LineSpan, EquatableArray<string> Arguments) {
+    public static DiagnosticInfo Create(DiagnosticDescriptor descriptor, Location? location, params string[] arguments) {
+        var lineSpan = location?.GetLineSpan();
+        return new DiagnosticInfo(
+            descriptor,
+            location?.SourceTree?.FilePath,
+            location?.SourceSpan ?? default,
+            lineSpan?.Span ?? default,
+            new EquatableArray<string>(arguments.ToImmutableArray()));
+    }
+
+    public Diagnostic ToDiagnostic() {
+        var location = FilePath == null ? Location.None : Location.Create(FilePath, Span, LineSpan);
+        return Diagnostic.Create(Descriptor, location, Arguments.ToArray<object>());
+    }
+}
+
+
+
+
+/// <summary>
+/// ImmutableArray with element-wise equality, for incremental generator models.
+/// </summary>
+internal readonly struct EquatableArray<T> : IEquatable<EquatableArray<T>>, IEnumerable<T> where T : IEquatable<T> {
+    private readonly ImmutableArray<T> items;
+
+
+    public EquatableArray(ImmutableArray<T> items) {
+        this.items = items;
+    }
+
+
+    public int Count => items.IsDefault ? 0 : items.Length;
+
+    public T this[int index] => items[index];
+
+
+    public bool Equals(EquatableArray<T> other) => AsArray().SequenceEqual(other.AsArray());
+
+    public override bool Equals(object? obj) => obj is EquatableArray<T> other && Equals(other);
+
+    public override int GetHashCode() {
+        int hash = 17;
+        foreach (var item in AsArray()) {
+            hash = hash * 31 + (item?.GetHashCode() ?? 0);
+        }
+        return hash;
+    }
+
+
+    public TResult[] ToArray<TResult>() => AsArray().Select(item => (TResult)(object)item!).ToArray();
+
+    public IEnumerator<T> GetEnumerator() => ((IEnumerable<T>)AsArray()).GetEnumerator();
+
+    IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+
+
+    private ImmutableArray<T> AsArray() => items.IsDefault ? ImmutableArray<T>.Empty : items;
+}
@@ -1,4 +1,7 @@
+using FON.Core;
+using FON.Types;
 using System.Buffers;
+using System.Runtime.CompilerServices;
 using System.Text;
 
 
@@ -19,60 +22,47 @@ public static class NativeApi {
 
 
     public static string SerializeDump(IntPtr dump, int maxThreads = 0) {
+        using var buffer = SerializeDumpToMemory(dump, maxThreads);
+        return utf8NoBom.GetString(buffer.Memory.Span);
+    }
+
+
+    public static string SerializeCollection(IntPtr collection) {
+        using var buffer = SerializeCollectionToMemory(collection);
+        return utf8NoBom.GetString(buffer.Memory.Span);
+    }
+
+
+    /// <summary>
+    /// Serializes the dump once and hands back the native allocation as UTF-8 memory, with no
+    /// size query pass and no managed copy. Dispose the owner to release it.
+    /// </summary>
+    public static IMemoryOwner<byte> SerializeDumpToMemory(IntPtr dump, int maxThreads = 0) {
         if (dump == IntPtr.Zero) {
             throw new ArgumentException("Dump handle is null", nameof(dump));
         }
 
         FonError error = default;
-        unsafe {
-            int rc = NativeBindings.fon_serialize_dump_to_buffer(dump, null, 0, out long required, maxThreads, ref error);
-            ThrowIfError(rc, error);
-
-            if (required == 0) {
-                return string.Empty;
-            }
-
-            int size = checked((int)required);
-            byte[] rented = ArrayPool<byte>.Shared.Rent(size);
-            try {
-                fixed (byte* p = rented) {
-                    rc = NativeBindings.fon_serialize_dump_to_buffer(dump, p, size, out required, maxThreads, ref error);
-                }
-                ThrowIfError(rc, error);
-                return utf8NoBom.GetString(rented, 0, size);
-            } finally {
-                ArrayPool<byte>.Shared.Return(rented);
-            }
-        }
+        NativeMetrics.Call("fon_serialize_dump_to_owned");
+        int rc = NativeBindings.fon_serialize_dump_to_owned(dump, maxThreads, out FonBuffer buffer, ref error);
+        ThrowIfError(rc, error);
+        return new NativeBuffer(buffer);
     }
 
 
-    public static string SerializeCollection(IntPtr collection) {
+    /// <summary>
+    /// Single-collection counterpart of <see cref="SerializeDumpToMemory"/>.
+    /// </summary>
+    public static IMemoryOwner<byte> SerializeCollectionToMemory(IntPtr collection) {
         if (collection == IntPtr.Zero) {
             throw new ArgumentException("Collection handle is null", nameof(collection));
         }
 
         FonError error = default;
-        unsafe {
-            int rc = NativeBindings.fon_serialize_collection_to_buffer(collection, null, 0, out long required, ref error);
-            ThrowIfError(rc, error);
-
-            if (required == 0) {
-                return string.Empty;
-            }
-
-            int size = checked((int)required);
-            byte[] rented = ArrayPool<byte>.Shared.Rent(size);
-            try {
-                fixed (byte* p = rented) {
-                    rc = NativeBindings.fon_serialize_collection_to_buffer(collection, p, size, out required, ref error);
-                }
-                ThrowIfError(rc, error);
-                return utf8NoBom.GetString(rented, 0, size);
-            } finally {
-                ArrayPool<byte>.Shared.Return(rented);
-            }
-        }
+        NativeMetrics.Call("fon_serialize_collection_to_owned");
+        int rc = NativeBindings.fon_serialize_collection_to_owned(collection, out FonBuffer buffer, ref error);
+        ThrowIfError(rc, error);
+        return new NativeBuffer(buffer);
     }
 
 
@@ -89,6 +79,7 @@ public static class NativeApi {
         FonError error = default;
         unsafe {
             fixed (byte* p = destination) {
+                NativeMetrics.Call("fon_serialize_dump_to_buffer");
                 int rc = NativeBindings.fon_serialize_dump_to_buffer(
                     dump, p, destination.Length, out long required, maxThreads, ref error
                 );
@@ -111,6 +102,7 @@ public static class NativeApi {
         FonError error = default;
         unsafe {
             fixed (byte* p = destination) {
+                NativeMetrics.Call("fon_serialize_collection_to_buffer");
                 int rc = NativeBindings.fon_serialize_collection_to_buffer(
                     collection, p, destination.Length, out long required, ref error
                 );
@@ -126,6 +118,7 @@ public static class NativeApi {
         FonError error = default;
         unsafe {
             fixed (byte* p = utf8) {
+                NativeMetrics.Call("fon_deserialize_dump_from_buffer");
                 IntPtr handle = NativeBindings.fon_deserialize_dump_from_buffer(p, utf8.Length, maxThreads, ref error);
                 if (handle == IntPtr.Zero) {
                     throw new FonNativeException(error);
@@ -153,6 +146,7 @@ public static class NativeApi {
         FonError error = default;
         unsafe {
             fixed (byte* p = utf8) {
+                NativeMetrics.Call("fon_deserialize_collection_from_buffer");
                 IntPtr handle = NativeBindings.fon_deserialize_collection_from_buffer(p, utf8.Length, ref error);
                 if (handle == IntPtr.Zero) {
                     throw new FonNativeException(error);
@@ -177,6 +171,357 @@ public static class NativeApi {
 
 
 
+    /// <summary>
+    /// Parses a multi-line buffer keeping only the keys of <paramref name="options"/>; every other value
+    /// is skipped natively without being parsed. Same key semantics as the managed deserializers.
+    /// </summary>
+    public static IntPtr DeserializeDump(ReadOnlySpan<byte> utf8, FonReadOptions options, int maxThreads = 0) {
+        IntPtr nativeOptions = CreateReadOptions(options);
+        try {
+            FonError error = default;
+            unsafe {
+                fixed (byte* p = utf8) {
+                    NativeMetrics.Call("fon_deserialize_dump_from_buffer_projected");
+                    IntPtr handle = NativeBindings.fon_deserialize_dump_from_buffer_projected(p, utf8.Length, maxThreads, nativeOptions, ref error);
+                    if (handle == IntPtr.Zero) {
+                        throw new FonNativeException(error);
+                    }
+                    return handle;
+                }
+            }
+        } finally {
+            NativeBindings.fon_read_options_free(nativeOptions);
+        }
+    }
+
+
+    /// <summary>
+    /// Single-line counterpart of <see cref="DeserializeDump(ReadOnlySpan{byte}, FonReadOptions, int)"/>.
+    /// </summary>
+    public static IntPtr DeserializeCollection(ReadOnlySpan<byte> utf8, FonReadOptions options) {
+        IntPtr nativeOptions = CreateReadOptions(options);
+        try {
+            FonError error = default;
+            unsafe {
+                fixed (byte* p = utf8) {
+                    NativeMetrics.Call("fon_deserialize_collection_from_buffer_projected");
+                    IntPtr handle = NativeBindings.fon_deserialize_collection_from_buffer_projected(p, utf8.Length, nativeOptions, ref error);
+                    if (handle == IntPtr.Zero) {
+                        throw new FonNativeException(error);
+                    }
+                    return handle;
+                }
+            }
+        } finally {
+            NativeBindings.fon_read_options_free(nativeOptions);
+        }
+    }
+
+
+
+    /// <summary>
+    /// Copies a managed dump into a new native dump with a single packed call (see
+    /// <see cref="NativeDumpBuilder"/>). Returns false, creating nothing, if a record holds a
+    /// value the native types cannot carry.
+    /// </summary>
+    public static bool TryCreateDump(FonDump dump, out IntPtr handle) {
+        ArgumentNullException.ThrowIfNull(dump);
+
+        var builder = new NativeDumpBuilder(dump.Count);
+        foreach (var (id, record) in dump) {
+            if (!builder.TryAdd(id, record)) {
+                handle = IntPtr.Zero;
+                return false;
+            }
+        }
+        handle = builder.CreateDump();
+        return true;
+    }
+
+
+    /// <summary>
+    /// Copies every record of a native dump into a new managed dump with a single packed call.
+    /// </summary>
+    public static FonDump ToManagedDump(IntPtr dump) {
+        if (dump == IntPtr.Zero) {
+            throw new ArgumentException("Dump handle is null", nameof(dump));
+        }
+
+        FonError error = default;
+        NativeMetrics.Call("fon_dump_unpack");
+        int rc = NativeBindings.fon_dump_unpack(dump, out FonPackedBatch batch, ref error);
+        ThrowIfError(rc, error);
+        try {
+            return NativeBatchReader.ReadDump(batch);
+        } finally {
+            NativeBindings.fon_packed_batch_free(ref batch);
+        }
+    }
+
+
+    /// <summary>
+    /// Copies a native collection (e.g. from <see cref="NativeBindings.fon_dump_get"/>) into a
+    /// managed one, every field in one call instead of one <c>fon_collection_get_*</c> per key.
+    /// </summary>
+    public static FonCollection ToManagedCollection(IntPtr collection) {
+        if (collection == IntPtr.Zero) {
+            throw new ArgumentException("Collection handle is null", nameof(collection));
+        }
+
+        FonError error = default;
+        NativeMetrics.Call("fon_collection_unpack");
+        int rc = NativeBindings.fon_collection_unpack(collection, out FonPackedBatch batch, ref error);
+        ThrowIfError(rc, error);
+        try {
+            return NativeBatchReader.ReadCollection(batch);
+        } finally {
+            NativeBindings.fon_packed_batch_free(ref batch);
+        }
+    }
+
+
+    /// <summary>
+    /// Copies <paramref name="key"/> of every record into <paramref name="values"/>, in id order, with
+    /// one parallel native call. <paramref name="values"/> needs room for <see cref="NativeBindings.fon_dump_size"/>
+    /// rows; pass <paramref name="present"/> (same length) to tell missing or mistyped rows from zeros.
+    /// Overloads for long and double widen smaller numeric types.
+    /// </summary>
+    public static void ExtractColumn(IntPtr dump, string key, Span<int> values, Span<bool> present = default, int maxThreads = 0) {
+        CheckColumn(dump, key, values.Length, present.Length);
+        FonError error = default;
+        unsafe {
+            fixed (int* v = values)
+            fixed (bool* p = present) {
+                NativeMetrics.Call("fon_dump_extract_int");
+                int rc = NativeBindings.fon_dump_extract_int(dump, key, v, (byte*)p, values.Length, maxThreads, ref error);
+                ThrowIfError(rc, error);
+            }
+        }
+    }
+
+
+    public static void ExtractColumn(IntPtr dump, string key, Span<long> values, Span<bool> present = default, int maxThreads = 0) {
+        CheckColumn(dump, key, values.Length, present.Length);
+        FonError error = default;
+        unsafe {
+            fixed (long* v = values)
+            fixed (bool* p = present) {
+                NativeMetrics.Call("fon_dump_extract_long");
+                int rc = NativeBindings.fon_dump_extract_long(dump, key, v, (byte*)p, values.Length, maxThreads, ref error);
+                ThrowIfError(rc, error);
+            }
+        }
+    }
+
+
+    public static void ExtractColumn(IntPtr dump, string key, Span<double> values, Span<bool> present = default, int maxThreads = 0) {
+        CheckColumn(dump, key, values.Length, present.Length);
+        FonError error = default;
+        unsafe {
+            fixed (double* v = values)
+            fixed (bool* p = present) {
+                NativeMetrics.Call("fon_dump_extract_double");
+                int rc = NativeBindings.fon_dump_extract_double(dump, key, v, (byte*)p, values.Length, maxThreads, ref error);
+                ThrowIfError(rc, error);
+            }
+        }
+    }
+
+
+    public static void ExtractColumn(IntPtr dump, string key, Span<bool> values, Span<bool> present = default, int maxThreads = 0) {
+        CheckColumn(dump, key, values.Length, present.Length);
+        FonError error = default;
+        unsafe {
+            fixed (bool* v = values)
+            fixed (bool* p = present) {
+                NativeMetrics.Call("fon_dump_extract_bool");
+                int rc = NativeBindings.fon_dump_extract_bool(dump, key, (byte*)v, (byte*)p, values.Length, maxThreads, ref error);
+                ThrowIfError(rc, error);
+            }
+        }
+    }
+
+
+    /// <summary>
+    /// Record ids matching the rows of <see cref="ExtractColumn(IntPtr, string, Span{int}, Span{bool}, int)"/>.
+    /// </summary>
+    public static void ExtractIds(IntPtr dump, Span<ulong> ids) {
+        if (dump == IntPtr.Zero) {
+            throw new ArgumentException("Dump handle is null", nameof(dump));
+        }
+        FonError error = default;
+        unsafe {
+            fixed (ulong* p = ids) {
+                ThrowIfError(NativeBindings.fon_dump_extract_ids(dump, p, ids.Length, ref error), error);
+            }
+        }
+    }
+
+
+    /// <summary>
+    /// String column in id order; null for rows without a string under <paramref name="key"/>.
+    /// </summary>
+    public static string?[] ExtractStringColumn(IntPtr dump, string key, int maxThreads = 0) {
+        int rows = checked((int)NativeBindings.fon_dump_size(dump));
+        CheckColumn(dump, key, rows, 0);
+
+        var offsets = new long[rows + 1];
+        var present = new bool[rows];
+        FonError error = default;
+        unsafe {
+            fixed (long* o = offsets)
+            fixed (bool* p = present) {
+                int rc = NativeBindings.fon_dump_extract_string(dump, key, o, (byte*)p, rows, null, 0, out long required, maxThreads, ref error);
+                ThrowIfError(rc, error);
+
+                int size = checked((int)required);
+                byte[] rented = ArrayPool<byte>.Shared.Rent(size);
+                try {
+                    fixed (byte* b = rented) {
+                        rc = NativeBindings.fon_dump_extract_string(dump, key, o, (byte*)p, rows, b, size, out required, maxThreads, ref error);
+                    }
+                    ThrowIfError(rc, error);
+
+                    var result = new string?[rows];
+                    for (int i = 0; i < rows; i++) {
+                        if (present[i]) {
+                            result[i] = utf8NoBom.GetString(rented, (int)offsets[i], (int)(offsets[i + 1] - offsets[i]));
+                        }
+                    }
+                    return result;
+                } finally {
+                    ArrayPool<byte>.Shared.Return(rented);
+                }
+            }
+        }
+    }
+
+
+    private static void CheckColumn(IntPtr dump, string key, int length, int presentLength) {
+        if (dump == IntPtr.Zero) {
+            throw new ArgumentException("Dump handle is null", nameof(dump));
+        }
+        ArgumentNullException.ThrowIfNull(key);
+        // The native side writes one present flag per row it fills
+        if (presentLength != 0 && presentLength < length) {
+            throw new ArgumentException("present must be empty or at least as long as values", "present");
+        }
+    }
+
+
+
+    /// <summary>
+    /// Streams the records of a FON file in line order through a <see cref="NativeFileReader"/>. Each
+    /// batch of <paramref name="batchSize"/> lines is read and parsed natively on the thread pool while
+    /// the caller consumes the previous one, so memory stays at about two batches whatever the file size.
+    /// Ids are line numbers, as with <see cref="Fon.ReadRecordsAsync(FileInfo, int?, FonReadOptions?, CancellationToken)"/>.
+    /// </summary>
+    public static async IAsyncEnumerable<(ulong id, FonCollection record)> ReadRecordsAsync(FileInfo file, int batchSize = NativeFileReader.DefaultBatchSize, int maxThreads = 0, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        ArgumentOutOfRangeException.ThrowIfLessThan(batchSize, 1);
+
+        using var reader = new NativeFileReader(file);
+        // At most one read in flight: the handle is never used by two threads at once
+        var pending = Task.Run(() => reader.ReadRecords(batchSize, maxThreads), cancellationToken);
+        try {
+            while (true) {
+                // Only the end of the file stops the stream, a batch of blank lines is just empty
+                if (await pending is not { } records) {
+                    yield break;
+                }
+                pending = Task.Run(() => reader.ReadRecords(batchSize, maxThreads), cancellationToken);
+
+                foreach (var record in records) {
+                    cancellationToken.ThrowIfCancellationRequested();
+                    yield return record;
+                }
+            }
+        } finally {
+            // Stopped early: let the read ahead finish before the reader is closed under it
+            try {
+                await pending;
+            } catch (Exception) {
+                // Either already surfaced or no longer of interest to the caller
+            }
+        }
+    }
+
+
+
+    internal static IntPtr DeserializeFile(FileInfo file, FonReadOptions? options, int maxThreads, ref FonError error) {
+        NativeMetrics.Call("fon_deserialize_from_file");
+        if (options == null) {
+            return NativeBindings.fon_deserialize_from_file(file.FullName, maxThreads, ref error);
+        }
+        IntPtr nativeOptions = CreateReadOptions(options);
+        try {
+            return NativeBindings.fon_deserialize_from_file_projected(file.FullName, maxThreads, nativeOptions, ref error);
+        } finally {
+            NativeBindings.fon_read_options_free(nativeOptions);
+        }
+    }
+
+
+
+    /// <summary>
+    /// Z85-encodes <paramref name="data"/> with the native kernel; the ASCII result is what
+    /// RawData.Pack produces for the same bytes.
+    /// </summary>
+    public static byte[] Z85Encode(ReadOnlySpan<byte> data) {
+        FonError error = default;
+        unsafe {
+            fixed (byte* p = data) {
+                NativeMetrics.Call("fon_z85_encode");
+                int rc = NativeBindings.fon_z85_encode(p, data.Length, null, 0, out long required, ref error);
+                ThrowIfError(rc, error);
+
+                var result = new byte[checked((int)required)];
+                fixed (byte* r = result) {
+                    rc = NativeBindings.fon_z85_encode(p, data.Length, r, result.Length, out required, ref error);
+                }
+                ThrowIfError(rc, error);
+                return result;
+            }
+        }
+    }
+
+
+    /// <summary>
+    /// Decodes Z85 text (RawData.Pack output). Throws <see cref="FonNativeException"/> on an invalid character.
+    /// </summary>
+    public static byte[] Z85Decode(ReadOnlySpan<byte> text) {
+        FonError error = default;
+        unsafe {
+            fixed (byte* p = text) {
+                NativeMetrics.Call("fon_z85_decode");
+                int rc = NativeBindings.fon_z85_decode(p, text.Length, null, 0, out long required, ref error);
+                ThrowIfError(rc, error);
+
+                var result = new byte[checked((int)required)];
+                fixed (byte* r = result) {
+                    rc = NativeBindings.fon_z85_decode(p, text.Length, r, result.Length, out required, ref error);
+                }
+                ThrowIfError(rc, error);
+                return result;
+            }
+        }
+    }
+
+
+
+    private static IntPtr CreateReadOptions(FonReadOptions options) {
+        ArgumentNullException.ThrowIfNull(options);
+
+        var keys = options.Keys.ToArray();
+        FonError error = default;
+        IntPtr handle = NativeBindings.fon_read_options_create(keys, keys.Length, ref error);
+        if (handle == IntPtr.Zero) {
+            throw new FonNativeException(error);
+        }
+        return handle;
+    }
+
+
+
     private static void ThrowIfError(int code, FonError error) {
         if (code != FonResultCode.OK) {
             throw new FonNativeException(error);
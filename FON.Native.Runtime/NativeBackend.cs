@@ -0,0 +1,104 @@
+using FON.Acceleration;
+using FON.Core;
+using FON.Types;
+using System.Runtime.CompilerServices;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// <see cref="IFonBackend"/> over the native library. Registers itself with
+/// <see cref="FonAccelerator"/> as soon as this assembly is loaded (any use of a FON.Native type);
+/// call <see cref="Register"/> at startup to have it in place before the first Auto call.
+/// Registration does not load the native binary, that happens on the first
+/// <see cref="IsAvailable"/> check.
+/// </summary>
+public sealed class NativeBackend : IFonBackend {
+    public static NativeBackend Instance { get; } = new();
+
+
+    private NativeBackend() { }
+
+
+    public static void Register() => FonAccelerator.Register(Instance);
+
+
+#pragma warning disable CA2255 // Registering on load is the point: FON.Core must not probe for this assembly
+    [ModuleInitializer]
+    internal static void RegisterOnLoad() {
+        if (FonAccelerator.Backend == null) {
+            Register();
+        }
+    }
+#pragma warning restore CA2255
+
+
+
+    public string Name => "native";
+
+    public bool IsAvailable => NativeLoader.IsAvailable;
+
+    public string? Version => NativeLoader.GetVersion();
+
+
+
+    /// <summary>
+    /// Copies the dump over in one packed call and lets the native library write it. Declines
+    /// when a record holds a value the native types cannot carry, and when the native write
+    /// fails, so the managed serializer reports the error the same way it always does.
+    /// </summary>
+    public bool TrySerializeToFile(FonDump dump, FileInfo file, int maxDegreeOfParallelism) {
+        if (!NativeApi.TryCreateDump(dump, out IntPtr handle)) {
+            NativeMetrics.Declined("serialize");
+            return false;
+        }
+        try {
+            FonError error = default;
+            NativeMetrics.Call("fon_serialize_to_file");
+            if (NativeBindings.fon_serialize_to_file(handle, file.FullName, maxDegreeOfParallelism, ref error) != FonResultCode.OK) {
+                NativeMetrics.Declined("serialize");
+                return false;
+            }
+            return true;
+        } finally {
+            NativeBindings.fon_dump_free(handle);
+        }
+    }
+
+
+    /// <summary>
+    /// Parses natively and copies the result back in one packed call. Declines when the native
+    /// parser fails or produced a value type the packed format has no tag for; the managed
+    /// parser then reads the file (and reports any real format error).
+    /// </summary>
+    public FonDump? TryDeserializeFromFile(FileInfo file, FonReadOptions? options, int maxDegreeOfParallelism) {
+        NativeBindings.fon_set_max_depth(Fon.MaxDepth);
+
+        FonError error = default;
+        IntPtr handle = NativeApi.DeserializeFile(file, options, maxDegreeOfParallelism, ref error);
+        if (handle == IntPtr.Zero) {
+            NativeMetrics.Declined("deserialize");
+            return null;
+        }
+        try {
+            NativeMetrics.Call("fon_dump_unpack");
+            if (NativeBindings.fon_dump_unpack(handle, out FonPackedBatch batch, ref error) != FonResultCode.OK) {
+                NativeMetrics.Declined("deserialize");
+                return null;
+            }
+            return ReadAndFree(ref batch);
+        } finally {
+            NativeBindings.fon_dump_free(handle);
+        }
+    }
+
+
+    private static FonDump ReadAndFree(ref FonPackedBatch batch) {
+        try {
+            return NativeBatchReader.ReadDump(batch);
+        } finally {
+            NativeBindings.fon_packed_batch_free(ref batch);
+        }
+    }
+}
@@ -1,17 +1,120 @@
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using System.Text;
+
+[assembly: DisableRuntimeMarshalling]
 
 namespace FON.Native;
 
 
 /// <summary>
-/// Error structure returned by native library
+/// Error structure returned by native library. Blittable, so calls pass it by pointer without
+/// marshalling; <see cref="Message"/> decodes the native text only when it is read.
 /// </summary>
-[StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
-public struct FonError {
+[StructLayout(LayoutKind.Sequential)]
+public unsafe struct FonError {
     public int Code;
 
-    [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 256)]
-    public string Message;
+    private fixed byte message[256];
+
+
+    /// <summary>
+    /// The NUL-terminated UTF-8 message the native side wrote, or null if there is none.
+    /// </summary>
+    public string? Message {
+        get {
+            fixed (byte* p = message) {
+                var text = new ReadOnlySpan<byte>(p, 256);
+                int end = text.IndexOf((byte)0);
+                text = end < 0 ? text : text[..end];
+                return text.IsEmpty ? null : Encoding.UTF8.GetString(text);
+            }
+        }
+    }
+}
+
+
+
+/// <summary>
+/// UTF-8 text allocated by the native library (the *_to_owned calls). Release it with
+/// <see cref="NativeBindings.fon_buffer_free"/>; <see cref="NativeApi"/> wraps it as <see cref="System.Buffers.IMemoryOwner{T}"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FonBuffer {
+    public IntPtr Data;
+    public long Length;
+    public long Capacity;
+}
+
+
+
+/// <summary>
+/// One record of a <see cref="FonPackedBatch"/>: a contiguous run of fields. Records flagged
+/// <see cref="FonPackedTag.Nested"/> are nested collections, referenced by index from a later record.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FonPackedRecord {
+    public ulong Id;
+    public long FirstField;
+    public int FieldCount;
+    public int Flags;
+}
+
+
+
+/// <summary>
+/// One field of a <see cref="FonPackedBatch"/>. <see cref="Value"/> holds scalars directly (floats
+/// as their bits), the arena offset for strings and arrays, or the record index for an object;
+/// <see cref="Length"/> is the byte count of a string or the element count of an array.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FonPackedField {
+    public int Key;
+    public int Tag;
+    public long Value;
+    public long Length;
+}
+
+
+
+/// <summary>
+/// Many records in one native call: interned UTF-8 keys (<see cref="KeyOffsets"/> has
+/// <see cref="KeyCount"/> + 1 entries), records, fields and a value arena. Filled by
+/// <see cref="NativeDumpBuilder"/>, or by <see cref="NativeBindings.fon_dump_unpack"/> in the other direction.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct FonPackedBatch {
+    public IntPtr KeyBytes;
+    public long KeyBytesLength;
+    public IntPtr KeyOffsets;
+    public int KeyCount;
+    public int Reserved;
+    public IntPtr Records;
+    public long RecordCount;
+    public IntPtr Fields;
+    public long FieldCount;
+    public IntPtr Arena;
+    public long ArenaLength;
+}
+
+
+
+/// <summary>
+/// Type tags of <see cref="FonPackedField.Tag"/>, and the record flag for nested collections.
+/// </summary>
+public static class FonPackedTag {
+    public const int Int = 1;
+    public const int Long = 2;
+    public const int Float = 3;
+    public const int Double = 4;
+    public const int Bool = 5;
+    public const int String = 6;
+    public const int IntArray = 7;
+    public const int FloatArray = 8;
+    public const int Object = 9;
+    public const int ObjectArray = 10;
+
+    public const int Nested = 1;
 }
 
 
@@ -32,65 +135,79 @@ public static class FonResultCode {
 /// <summary>
 /// Low-level native interop for the FON acceleration library.
 /// </summary>
-public static class NativeBindings {
+/// <remarks>
+/// Every entry point is a <see cref="LibraryImportAttribute"/> stub generated at compile time:
+/// strings are encoded to UTF-8 on the stack, arrays and <c>ref</c>/<c>out</c> arguments are
+/// pinned, nothing is marshalled at run time, so the bindings work under NativeAOT. Sizes and
+/// scalar / nested-collection getters return without blocking or allocating, so they skip the
+/// GC transition. Lookups in a hot loop should use the
+/// <see cref="ReadOnlySpan{T}"/> key overloads with a <c>u8</c> literal, which also skip the
+/// string encoding. The shipped binaries are x64 / ARM64 only, where <c>extern "C"</c> is the
+/// platform calling convention, so none is spelled out.
+/// </remarks>
+public static unsafe partial class NativeBindings {
     private const string LibraryName = "fon_native";
 
 
 
     // ==================== VERSION ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern IntPtr fon_version();
+    // No SuppressGCTransition: this is the availability probe, it has to fail cleanly when the binary is missing
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_version();
 
 
 
     // ==================== CONFIGURATION ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern void fon_set_raw_unpack(int enable);
+    [LibraryImport(LibraryName)]
+    public static partial void fon_set_raw_unpack(int enable);
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern void fon_set_max_depth(int depth);
+    [LibraryImport(LibraryName)]
+    public static partial void fon_set_max_depth(int depth);
 
 
 
     // ==================== MEMORY MANAGEMENT ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern IntPtr fon_dump_create();
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_dump_create();
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern void fon_dump_free(IntPtr dump);
+    [LibraryImport(LibraryName)]
+    public static partial void fon_dump_free(IntPtr dump);
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern long fon_dump_size(IntPtr dump);
+    [LibraryImport(LibraryName)]
+    [SuppressGCTransition]
+    public static partial long fon_dump_size(IntPtr dump);
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern IntPtr fon_dump_get(IntPtr dump, ulong index);
+    [LibraryImport(LibraryName)]
+    [SuppressGCTransition]
+    public static partial IntPtr fon_dump_get(IntPtr dump, ulong index);
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern IntPtr fon_collection_create();
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_collection_create();
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern void fon_collection_free(IntPtr collection);
+    [LibraryImport(LibraryName)]
+    public static partial void fon_collection_free(IntPtr collection);
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern long fon_collection_size(IntPtr collection);
+    [LibraryImport(LibraryName)]
+    [SuppressGCTransition]
+    public static partial long fon_collection_size(IntPtr collection);
 
 
 
     // ==================== SERIALIZATION ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_serialize_to_file(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_serialize_to_file(
         IntPtr dump,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+        string path,
         int maxThreads,
         ref FonError error
     );
@@ -99,9 +216,9 @@ public static class NativeBindings {
 
     // ==================== DESERIALIZATION ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern IntPtr fon_deserialize_from_file(
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string path,
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr fon_deserialize_from_file(
+        string path,
         int maxThreads,
         ref FonError error
     );
@@ -116,8 +233,8 @@ public static class NativeBindings {
     /// <paramref name="requiredSize"/> with the exact byte count; second call with a buffer of that
     /// size receives the bytes. Output is NOT null-terminated.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern unsafe int fon_serialize_dump_to_buffer(
+    [LibraryImport(LibraryName)]
+    public static partial int fon_serialize_dump_to_buffer(
         IntPtr dump,
         byte* buffer,
         long bufferSize,
@@ -131,8 +248,8 @@ public static class NativeBindings {
     /// Serializes a single Collection into the caller-supplied UTF-8 buffer (two-call pattern).
     /// See <see cref="fon_serialize_dump_to_buffer"/> for protocol details.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern unsafe int fon_serialize_collection_to_buffer(
+    [LibraryImport(LibraryName)]
+    public static partial int fon_serialize_collection_to_buffer(
         IntPtr collection,
         byte* buffer,
         long bufferSize,
@@ -142,14 +259,48 @@ public static class NativeBindings {
 
 
 
+    // ==================== OWNED BUFFER SERIALIZATION ====================
+
+    /// <summary>
+    /// Serializes a Dump once into a buffer the native library allocates, instead of the two-call
+    /// size/copy pattern. The caller releases <paramref name="buffer"/> with <see cref="fon_buffer_free"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_serialize_dump_to_owned(
+        IntPtr dump,
+        int maxThreads,
+        out FonBuffer buffer,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Single-collection counterpart of <see cref="fon_serialize_dump_to_owned"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_serialize_collection_to_owned(
+        IntPtr collection,
+        out FonBuffer buffer,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Releases a buffer from the *_to_owned calls and clears it (freeing it twice is harmless).
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial void fon_buffer_free(ref FonBuffer buffer);
+
+
+
     // ==================== STRING / BUFFER DESERIALIZATION ====================
 
     /// <summary>
     /// Parses a multi-line UTF-8 buffer into a new Dump. Caller owns the returned handle and must
     /// free it via <see cref="fon_dump_free"/>. The input does not need to be null-terminated.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern unsafe IntPtr fon_deserialize_dump_from_buffer(
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_deserialize_dump_from_buffer(
         byte* data,
         long size,
         int maxThreads,
@@ -162,19 +313,242 @@ public static class NativeBindings {
     /// must free it via <see cref="fon_collection_free"/> (unless ownership is transferred via
     /// <see cref="fon_dump_add"/> or <see cref="fon_collection_add_collection"/>).
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl)]
-    public static extern unsafe IntPtr fon_deserialize_collection_from_buffer(
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_deserialize_collection_from_buffer(
+        byte* data,
+        long size,
+        ref FonError error
+    );
+
+
+
+    // ==================== PROJECTION ====================
+
+    /// <summary>
+    /// Creates a key allow-list from UTF-8 key paths (dotted paths descend into objects).
+    /// Free via <see cref="fon_read_options_free"/>. Returns <see cref="IntPtr.Zero"/> on error.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr fon_read_options_create(
+        string[] keys,
+        int count,
+        ref FonError error
+    );
+
+
+    [LibraryImport(LibraryName)]
+    public static partial void fon_read_options_free(IntPtr options);
+
+
+    /// <summary>
+    /// <see cref="fon_deserialize_dump_from_buffer"/> keeping only the keys of <paramref name="options"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_deserialize_dump_from_buffer_projected(
         byte* data,
         long size,
+        int maxThreads,
+        IntPtr options,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// <see cref="fon_deserialize_collection_from_buffer"/> keeping only the keys of <paramref name="options"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_deserialize_collection_from_buffer_projected(
+        byte* data,
+        long size,
+        IntPtr options,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// <see cref="fon_deserialize_from_file"/> keeping only the keys of <paramref name="options"/>.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr fon_deserialize_from_file_projected(
+        string path,
+        int maxThreads,
+        IntPtr options,
+        ref FonError error
+    );
+
+
+
+    // ==================== RECORD CURSOR ====================
+
+    /// <summary>
+    /// Creates a forward-only cursor over a UTF-8 buffer. The buffer is NOT copied: it must stay
+    /// valid and pinned until <see cref="fon_cursor_free"/>. Returns <see cref="IntPtr.Zero"/> on error.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial IntPtr fon_cursor_create(
+        byte* data,
+        long size,
+        ref FonError error
+    );
+
+
+    [LibraryImport(LibraryName)]
+    public static partial void fon_cursor_free(IntPtr cursor);
+
+
+    /// <summary>
+    /// Parses the next non-empty line. <paramref name="collection"/> is a new Collection owned by
+    /// the caller (free via <see cref="fon_collection_free"/>), or <see cref="IntPtr.Zero"/> at the end.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_cursor_next(
+        IntPtr cursor,
+        out ulong id,
+        out IntPtr collection,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Parses up to <paramref name="maxLines"/> following lines in parallel into a new Dump owned by
+    /// the caller (free via <see cref="fon_dump_free"/>), or <see cref="IntPtr.Zero"/> at the end.
+    /// Ids inside the dump are relative: record k is line <paramref name="firstId"/> + k.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_cursor_next_batch(
+        IntPtr cursor,
+        long maxLines,
+        int maxThreads,
+        out ulong firstId,
+        out IntPtr dump,
         ref FonError error
     );
 
 
 
+    // ==================== STREAMING FILE HANDLES ====================
+
+    // A reader or writer handle must be used by one thread at a time; it may move between
+    // threads between calls. Separate handles are independent.
+
+    /// <summary>
+    /// Opens a file for batched reading. Returns <see cref="IntPtr.Zero"/> on error.
+    /// Close via <see cref="fon_reader_close"/>.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr fon_reader_open(
+        string path,
+        ref FonError error
+    );
+
+
+    [LibraryImport(LibraryName)]
+    public static partial void fon_reader_close(IntPtr reader);
+
+
+    /// <summary>
+    /// Reads and parses up to <paramref name="maxRecords"/> following lines into a new Dump owned by
+    /// the caller (free via <see cref="fon_dump_free"/>), or <see cref="IntPtr.Zero"/> at the end.
+    /// Ids inside the dump are relative: record k is line <paramref name="firstId"/> + k.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_reader_next_batch(
+        IntPtr reader,
+        long maxRecords,
+        int maxThreads,
+        out ulong firstId,
+        out IntPtr dump,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Opens a file for appending records. Returns <see cref="IntPtr.Zero"/> on error.
+    /// Close via <see cref="fon_writer_close"/>.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr fon_writer_open(
+        string path,
+        int append,
+        ref FonError error
+    );
+
+
+    [LibraryImport(LibraryName)]
+    public static partial int fon_writer_append(
+        IntPtr writer,
+        IntPtr collection,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Appends every record of <paramref name="dump"/> in id order, serialized in parallel.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_writer_append_dump(
+        IntPtr writer,
+        IntPtr dump,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+    [LibraryImport(LibraryName)]
+    public static partial int fon_writer_flush(
+        IntPtr writer,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Flushes and frees the writer; the handle is invalid afterwards even on error.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_writer_close(
+        IntPtr writer,
+        ref FonError error
+    );
+
+
+
+    // ==================== Z85 ====================
+
+    /// <summary>
+    /// Encodes bytes to RawData's Z85 text (ASCII, padding marker included). Same two-call pattern
+    /// as <see cref="fon_serialize_dump_to_buffer"/>; nothing is written unless
+    /// <paramref name="bufferSize"/> covers <paramref name="requiredSize"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_z85_encode(
+        byte* data,
+        long size,
+        byte* buffer,
+        long bufferSize,
+        out long requiredSize,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Decodes Z85 text produced by <see cref="fon_z85_encode"/> or RawData. Two-call pattern;
+    /// an invalid character fails with <see cref="FonResultCode.ParseFailed"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_z85_decode(
+        byte* text,
+        long size,
+        byte* buffer,
+        long bufferSize,
+        out long requiredSize,
+        ref FonError error
+    );
+
+
     // ==================== COLLECTION ADD OPERATIONS ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_dump_add(
+    [LibraryImport(LibraryName)]
+    public static partial int fon_dump_add(
         IntPtr dump,
         ulong id,
         IntPtr collection,
@@ -182,64 +556,64 @@ public static class NativeBindings {
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_int(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_int(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         int value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_long(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_long(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         long value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_float(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_float(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         float value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_double(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_double(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         double value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_bool(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_bool(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         int value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_string(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_string(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string value,
+        string key,
+        string value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_int_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_int_array(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         int[] values,
         long count,
         ref FonError error
@@ -252,10 +626,10 @@ public static class NativeBindings {
     /// <paramref name="parent"/>. The caller MUST NOT use the child handle again and MUST NOT
     /// call <c>fon_collection_free</c> on it; doing so causes a double-free.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_collection(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_collection(
         IntPtr parent,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         IntPtr child,
         ref FonError error
     );
@@ -267,20 +641,20 @@ public static class NativeBindings {
     /// owned by <paramref name="parent"/>. The caller MUST NOT use any child handle again and MUST NOT
     /// call <c>fon_collection_free</c> on any of them; doing so causes a double-free.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_collection_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_collection_array(
         IntPtr parent,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         IntPtr[] children,
         long count,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_add_float_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_add_float_array(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         float[] values,
         long count,
         ref FonError error
@@ -290,65 +664,70 @@ public static class NativeBindings {
 
     // ==================== COLLECTION GET OPERATIONS ====================
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_int(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial int fon_collection_get_int(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         out int value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_long(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial int fon_collection_get_long(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         out long value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_float(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial int fon_collection_get_float(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         out float value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_double(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial int fon_collection_get_double(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         out double value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_bool(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial int fon_collection_get_bool(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         out int value,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_string(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_get_string(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         [Out] byte[] buffer,
         long bufferSize,
         ref FonError error
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_int_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_get_int_array(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         [Out] int[]? buffer,
         long bufferSize,
         out long actualSize,
@@ -356,10 +735,10 @@ public static class NativeBindings {
     );
 
 
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_float_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_get_float_array(
         IntPtr collection,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         [Out] float[]? buffer,
         long bufferSize,
         out long actualSize,
@@ -373,10 +752,11 @@ public static class NativeBindings {
     /// MUST NOT call <c>fon_collection_free</c> on it. Returns <see cref="IntPtr.Zero"/>
     /// if the key is missing or the value is not a nested collection.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern IntPtr fon_collection_get_collection(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    [SuppressGCTransition]
+    public static partial IntPtr fon_collection_get_collection(
         IntPtr parent,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         ref FonError error
     );
 
@@ -387,13 +767,257 @@ public static class NativeBindings {
     /// Ownership: every returned handle is owned by <paramref name="parent"/>. The caller
     /// MUST NOT call <c>fon_collection_free</c> on any of them.
     /// </summary>
-    [DllImport(LibraryName, CallingConvention = CallingConvention.Cdecl, CharSet = CharSet.Ansi)]
-    public static extern int fon_collection_get_collection_array(
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_collection_get_collection_array(
         IntPtr parent,
-        [MarshalAs(UnmanagedType.LPUTF8Str)] string key,
+        string key,
         [Out] IntPtr[]? buffer,
         long bufferSize,
         out long actualSize,
         ref FonError error
     );
+
+
+
+    // ==================== PACKED BATCHES ====================
+
+    /// <summary>
+    /// Adds every top-level record of <paramref name="batch"/> to the dump in one call, in
+    /// place of one fon_collection_add_* call per field. The batch stays owned by the caller and
+    /// is only read during the call; on error the dump is left untouched.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_dump_append_packed(
+        IntPtr dump,
+        in FonPackedBatch batch,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Packs every record of the dump, in id order, into a batch allocated by the library.
+    /// Release it with <see cref="fon_packed_batch_free"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_dump_unpack(
+        IntPtr dump,
+        out FonPackedBatch batch,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Packs one collection (e.g. from <see cref="fon_dump_get"/>); its own record is the last
+    /// one of the batch. Release it with <see cref="fon_packed_batch_free"/>.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_collection_unpack(
+        IntPtr collection,
+        out FonPackedBatch batch,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Releases a batch from <see cref="fon_dump_unpack"/> or <see cref="fon_collection_unpack"/>
+    /// and clears it. Never pass a batch the caller filled in.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial void fon_packed_batch_free(ref FonPackedBatch batch);
+
+
+    // ==================== COLUMN EXTRACTION ====================
+
+    /// <summary>
+    /// Fills <paramref name="values"/> with <paramref name="key"/> of every record, in id order
+    /// (the order of <see cref="fon_dump_extract_ids"/>), in one call spread over up to
+    /// <paramref name="maxThreads"/> threads. <paramref name="length"/> must be at least
+    /// <see cref="fon_dump_size"/>. <paramref name="present"/> may be null; otherwise it gets 1 per row
+    /// holding the key with a matching type and 0 per row that does not (its value is then 0).
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_dump_extract_int(
+        IntPtr dump,
+        string key,
+        int* values,
+        byte* present,
+        long length,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// <see cref="fon_dump_extract_int"/> for long; int values are widened.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_dump_extract_long(
+        IntPtr dump,
+        string key,
+        long* values,
+        byte* present,
+        long length,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// <see cref="fon_dump_extract_int"/> for double; int and float values are widened, missing rows are NaN.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_dump_extract_double(
+        IntPtr dump,
+        string key,
+        double* values,
+        byte* present,
+        long length,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// <see cref="fon_dump_extract_int"/> for bool, written as 0 / 1 bytes.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_dump_extract_bool(
+        IntPtr dump,
+        string key,
+        byte* values,
+        byte* present,
+        long length,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+    /// <summary>
+    /// Record ids in the row order of the extract calls.
+    /// </summary>
+    [LibraryImport(LibraryName)]
+    public static partial int fon_dump_extract_ids(IntPtr dump, ulong* ids, long length, ref FonError error);
+
+
+    /// <summary>
+    /// String column as one UTF-8 blob: row i is <c>bytes[offsets[i]..offsets[i + 1]]</c>, so
+    /// <paramref name="offsets"/> needs <paramref name="length"/> + 1 entries. Two-call pattern for
+    /// the blob: with <paramref name="bytes"/>=null only <paramref name="requiredSize"/>,
+    /// <paramref name="offsets"/> and <paramref name="present"/> are filled.
+    /// </summary>
+    [LibraryImport(LibraryName, StringMarshalling = StringMarshalling.Utf8)]
+    public static partial int fon_dump_extract_string(
+        IntPtr dump,
+        string key,
+        long* offsets,
+        byte* present,
+        long length,
+        byte* bytes,
+        long bytesSize,
+        out long requiredSize,
+        int maxThreads,
+        ref FonError error
+    );
+
+
+
+    // ==================== PRE-ENCODED KEYS ====================
+
+    // The native side reads keys up to a NUL. u8 literals have one, but a span cannot prove it,
+    // so the key is copied next to a terminator; keys up to 255 bytes stay on the stack.
+    private const int KeyStackLimit = 256;
+
+
+    private static ReadOnlySpan<byte> Terminated(ReadOnlySpan<byte> key, Span<byte> scratch) {
+        var buffer = key.Length < scratch.Length ? scratch : new byte[key.Length + 1];
+        key.CopyTo(buffer);
+        buffer[key.Length] = 0;
+        return buffer[..(key.Length + 1)];
+    }
+
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_int(IntPtr, string, out int, ref FonError)"/> with a UTF-8 key, e.g. <c>"id"u8</c>.
+    /// </summary>
+    public static int fon_collection_get_int(IntPtr collection, ReadOnlySpan<byte> key, out int value, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetInt(collection, k, out value, ref error);
+        }
+    }
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_long(IntPtr, string, out long, ref FonError)"/> with a UTF-8 key, e.g. <c>"id"u8</c>.
+    /// </summary>
+    public static int fon_collection_get_long(IntPtr collection, ReadOnlySpan<byte> key, out long value, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetLong(collection, k, out value, ref error);
+        }
+    }
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_float(IntPtr, string, out float, ref FonError)"/> with a UTF-8 key, e.g. <c>"id"u8</c>.
+    /// </summary>
+    public static int fon_collection_get_float(IntPtr collection, ReadOnlySpan<byte> key, out float value, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetFloat(collection, k, out value, ref error);
+        }
+    }
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_double(IntPtr, string, out double, ref FonError)"/> with a UTF-8 key, e.g. <c>"id"u8</c>.
+    /// </summary>
+    public static int fon_collection_get_double(IntPtr collection, ReadOnlySpan<byte> key, out double value, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetDouble(collection, k, out value, ref error);
+        }
+    }
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_bool(IntPtr, string, out int, ref FonError)"/> with a UTF-8 key, e.g. <c>"id"u8</c>.
+    /// </summary>
+    public static int fon_collection_get_bool(IntPtr collection, ReadOnlySpan<byte> key, out int value, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetBool(collection, k, out value, ref error);
+        }
+    }
+
+
+    /// <summary>
+    /// <see cref="fon_collection_get_collection(IntPtr, string, ref FonError)"/> with a UTF-8 key. Same borrowed-handle rules.
+    /// </summary>
+    public static IntPtr fon_collection_get_collection(IntPtr parent, ReadOnlySpan<byte> key, ref FonError error) {
+        fixed (byte* k = Terminated(key, stackalloc byte[KeyStackLimit])) {
+            return GetCollection(parent, k, ref error);
+        }
+    }
+
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_int")]
+    [SuppressGCTransition]
+    private static partial int GetInt(IntPtr collection, byte* key, out int value, ref FonError error);
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_long")]
+    [SuppressGCTransition]
+    private static partial int GetLong(IntPtr collection, byte* key, out long value, ref FonError error);
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_float")]
+    [SuppressGCTransition]
+    private static partial int GetFloat(IntPtr collection, byte* key, out float value, ref FonError error);
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_double")]
+    [SuppressGCTransition]
+    private static partial int GetDouble(IntPtr collection, byte* key, out double value, ref FonError error);
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_bool")]
+    [SuppressGCTransition]
+    private static partial int GetBool(IntPtr collection, byte* key, out int value, ref FonError error);
+
+    [LibraryImport(LibraryName, EntryPoint = "fon_collection_get_collection")]
+    [SuppressGCTransition]
+    private static partial IntPtr GetCollection(IntPtr parent, byte* key, ref FonError error);
 }
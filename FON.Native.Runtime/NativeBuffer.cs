@@ -0,0 +1,60 @@
+using System.Buffers;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Exposes a <see cref="FonBuffer"/> allocated by the native library as <see cref="Memory{T}"/>
+/// without copying it; disposing returns the allocation via <see cref="NativeBindings.fon_buffer_free"/>.
+/// The memory is invalid after <see cref="IDisposable.Dispose"/>. There is deliberately no
+/// finalizer: it could free the buffer under a live span, so an undisposed buffer leaks instead.
+/// </summary>
+internal sealed unsafe class NativeBuffer : MemoryManager<byte> {
+    private FonBuffer buffer;
+    private readonly int length;
+    private int disposed;
+
+
+    /// <summary>
+    /// Takes ownership of <paramref name="buffer"/>; it is freed here even if the constructor throws.
+    /// </summary>
+    public NativeBuffer(FonBuffer buffer) {
+        this.buffer = buffer;
+        if (buffer.Length > int.MaxValue) {
+            Free();
+            throw new InvalidOperationException($"Serialized output of {buffer.Length} bytes does not fit in a single Memory<byte>");
+        }
+        length = (int)buffer.Length;
+    }
+
+
+
+    public override Span<byte> GetSpan() {
+        ObjectDisposedException.ThrowIf(disposed != 0, this);
+        return new Span<byte>((byte*)buffer.Data, length);
+    }
+
+
+    // Native memory never moves, pinning is just an offset
+    public override MemoryHandle Pin(int elementIndex = 0) {
+        ObjectDisposedException.ThrowIf(disposed != 0, this);
+        if ((uint)elementIndex > (uint)length) {
+            throw new ArgumentOutOfRangeException(nameof(elementIndex));
+        }
+        return new MemoryHandle((byte*)buffer.Data + elementIndex);
+    }
+
+
+    public override void Unpin() { }
+
+
+    protected override void Dispose(bool disposing) => Free();
+
+
+    private void Free() {
+        if (Interlocked.Exchange(ref disposed, 1) == 0) {
+            NativeBindings.fon_buffer_free(ref buffer);
+        }
+    }
+}
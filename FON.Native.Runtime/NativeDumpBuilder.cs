@@ -0,0 +1,502 @@
+using FON.Core;
+using FON.Types;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Fills a <see cref="FonPackedBatch"/> on the managed side and hands it to the native library
+/// in one call, instead of one <c>fon_collection_add_*</c> P/Invoke (and one UTF-8 key
+/// marshalling) per field. Keys are interned: each distinct key is encoded once per builder.
+/// </summary>
+/// <remarks>
+/// Records are written like <see cref="FonUtf8Writer"/> writes objects:
+/// <code>
+/// builder.BeginRecord(id);
+/// builder.Add("id", 1);
+/// builder.BeginObject("owner");
+/// builder.Add("name", "Bob");
+/// builder.EndObject();
+/// builder.EndRecord();
+/// builder.AppendTo(dump);
+/// </code>
+/// A builder is not thread-safe. <see cref="Clear"/> keeps the buffers (and interned keys) for
+/// the next batch.
+/// </remarks>
+public sealed class NativeDumpBuilder {
+    private readonly Dictionary<string, int> keyIds = new(StringComparer.Ordinal);
+    private readonly List<int> keyOffsets = [0];
+    private byte[] keyBytes = new byte[256];
+    private int keyLength;
+
+    private readonly List<FonPackedRecord> records;
+    private readonly List<FonPackedField> fields;
+    private byte[] arena = new byte[4096];
+    private int arenaLength;
+
+    private readonly List<Frame> open = [];
+    private readonly Stack<Frame> framePool = new();
+    private int topLevelCount;
+
+
+    public NativeDumpBuilder(int recordCapacity = 0) {
+        records = new List<FonPackedRecord>(recordCapacity);
+        fields = new List<FonPackedField>(recordCapacity * 8);
+    }
+
+
+    /// <summary>
+    /// Completed top-level records, i.e. what <see cref="AppendTo"/> will add.
+    /// </summary>
+    public int RecordCount => topLevelCount;
+
+
+
+    public void BeginRecord(ulong id) {
+        if (open.Count != 0) {
+            throw new InvalidOperationException("A record is already open");
+        }
+        Push(FrameKind.Record, -1).Id = id;
+    }
+
+
+    public void EndRecord() {
+        var frame = Pop(FrameKind.Record);
+        Flush(frame, 0);
+        topLevelCount++;
+        Release(frame);
+    }
+
+
+    public void BeginObject(string key) => Push(FrameKind.Object, Key(key));
+
+
+    /// <summary>
+    /// Starts the next element of the array opened by <see cref="BeginObjectArray"/>; close it with <see cref="EndObject"/>.
+    /// </summary>
+    public void BeginArrayObject() {
+        if (Top.Kind != FrameKind.Array) {
+            throw new InvalidOperationException("BeginArrayObject needs an open object array");
+        }
+        Push(FrameKind.Object, -1);
+    }
+
+
+    public void EndObject() {
+        var frame = Pop(FrameKind.Object);
+        int index = Flush(frame, FonPackedTag.Nested);
+        if (Top.Kind == FrameKind.Array) {
+            Top.Children.Add(index);
+        } else {
+            Top.Fields.Add(new FonPackedField { Key = frame.Key, Tag = FonPackedTag.Object, Value = index });
+        }
+        Release(frame);
+    }
+
+
+    public void BeginObjectArray(string key) => Push(FrameKind.Array, Key(key));
+
+
+    public void EndObjectArray() {
+        var frame = Pop(FrameKind.Array);
+        var children = CollectionsMarshal.AsSpan(frame.Children);
+        long offset = WriteArena(MemoryMarshal.AsBytes(children), align: true);
+        Top.Fields.Add(new FonPackedField { Key = frame.Key, Tag = FonPackedTag.ObjectArray, Value = offset, Length = children.Length });
+        Release(frame);
+    }
+
+
+
+    public void Add(string key, int value) => AddScalar(key, FonPackedTag.Int, value);
+
+    public void Add(string key, long value) => AddScalar(key, FonPackedTag.Long, value);
+
+    public void Add(string key, float value) => AddScalar(key, FonPackedTag.Float, BitConverter.SingleToInt32Bits(value));
+
+    public void Add(string key, double value) => AddScalar(key, FonPackedTag.Double, BitConverter.DoubleToInt64Bits(value));
+
+    public void Add(string key, bool value) => AddScalar(key, FonPackedTag.Bool, value ? 1 : 0);
+
+
+    public void Add(string key, string value) {
+        ArgumentNullException.ThrowIfNull(value);
+        int byteCount = Encoding.UTF8.GetByteCount(value);
+        EnsureArena(byteCount);
+        long offset = arenaLength;
+        arenaLength += Encoding.UTF8.GetBytes(value, arena.AsSpan(arenaLength));
+        AddField(key, FonPackedTag.String, offset, byteCount);
+    }
+
+
+    public void Add(string key, ReadOnlySpan<int> values) {
+        AddField(key, FonPackedTag.IntArray, WriteArena(MemoryMarshal.AsBytes(values), align: true), values.Length);
+    }
+
+
+    public void Add(string key, ReadOnlySpan<float> values) {
+        AddField(key, FonPackedTag.FloatArray, WriteArena(MemoryMarshal.AsBytes(values), align: true), values.Length);
+    }
+
+
+
+    /// <summary>
+    /// Adds <paramref name="collection"/> as record <paramref name="id"/>. Returns false, and adds
+    /// nothing, if it holds a value the native types cannot carry (byte, short, uint, ulong,
+    /// <see cref="RawData"/>, or arrays other than int, float and objects).
+    /// </summary>
+    public bool TryAdd(ulong id, FonCollection collection) {
+        ArgumentNullException.ThrowIfNull(collection);
+        int recordMark = records.Count, fieldMark = fields.Count, arenaMark = arenaLength;
+
+        BeginRecord(id);
+        if (TryAddFields(collection, 0)) {
+            EndRecord();
+            return true;
+        }
+
+        while (open.Count > 0) {
+            var frame = open[^1];
+            open.RemoveAt(open.Count - 1);
+            Release(frame);
+        }
+        records.RemoveRange(recordMark, records.Count - recordMark);
+        fields.RemoveRange(fieldMark, fields.Count - fieldMark);
+        arenaLength = arenaMark;
+        return false;
+    }
+
+
+    private bool TryAddFields(FonCollection collection, int depth) {
+        if (depth > Fon.MaxDepth) {
+            return false;
+        }
+        foreach (var (key, value) in collection) {
+            switch (value) {
+                case int v: Add(key, v); break;
+                case long v: Add(key, v); break;
+                case float v: Add(key, v); break;
+                case double v: Add(key, v); break;
+                case bool v: Add(key, v); break;
+                case string v: Add(key, v); break;
+                case List<int> v: Add(key, CollectionsMarshal.AsSpan(v)); break;
+                case IList<int> v: Add(key, v.ToArray()); break;
+                case List<float> v: Add(key, CollectionsMarshal.AsSpan(v)); break;
+                case IList<float> v: Add(key, v.ToArray()); break;
+                case FonCollection v:
+                    BeginObject(key);
+                    if (!TryAddFields(v, depth + 1)) {
+                        return false;
+                    }
+                    EndObject();
+                    break;
+                case IList<FonCollection> v:
+                    BeginObjectArray(key);
+                    foreach (var item in v) {
+                        BeginArrayObject();
+                        if (!TryAddFields(item, depth + 1)) {
+                            return false;
+                        }
+                        EndObject();
+                    }
+                    EndObjectArray();
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+
+
+    /// <summary>
+    /// Adds every completed record to the native <paramref name="dump"/> in a single call.
+    /// The builder keeps its content; call <see cref="Clear"/> to start the next batch.
+    /// </summary>
+    public unsafe void AppendTo(IntPtr dump) {
+        if (dump == IntPtr.Zero) {
+            throw new ArgumentException("Dump handle is null", nameof(dump));
+        }
+        if (open.Count != 0) {
+            throw new InvalidOperationException("A record is still open");
+        }
+
+        var offsets = CollectionsMarshal.AsSpan(keyOffsets);
+        var recordSpan = CollectionsMarshal.AsSpan(records);
+        var fieldSpan = CollectionsMarshal.AsSpan(fields);
+        FonError error = default;
+        int rc;
+        fixed (byte* keysPtr = keyBytes)
+        fixed (int* offsetsPtr = offsets)
+        fixed (FonPackedRecord* recordsPtr = recordSpan)
+        fixed (FonPackedField* fieldsPtr = fieldSpan)
+        fixed (byte* arenaPtr = arena) {
+            var batch = new FonPackedBatch {
+                KeyBytes = (IntPtr)keysPtr,
+                KeyBytesLength = keyLength,
+                KeyOffsets = (IntPtr)offsetsPtr,
+                KeyCount = offsets.Length - 1,
+                Records = (IntPtr)recordsPtr,
+                RecordCount = recordSpan.Length,
+                Fields = (IntPtr)fieldsPtr,
+                FieldCount = fieldSpan.Length,
+                Arena = (IntPtr)arenaPtr,
+                ArenaLength = arenaLength
+            };
+            NativeMetrics.Call("fon_dump_append_packed");
+            rc = NativeBindings.fon_dump_append_packed(dump, in batch, ref error);
+        }
+        if (rc != FonResultCode.OK) {
+            throw new FonNativeException(error);
+        }
+    }
+
+
+    /// <summary>
+    /// Creates a native dump holding every completed record. The caller frees it with
+    /// <see cref="NativeBindings.fon_dump_free"/>.
+    /// </summary>
+    public IntPtr CreateDump() {
+        var dump = NativeBindings.fon_dump_create();
+        try {
+            AppendTo(dump);
+            return dump;
+        } catch {
+            NativeBindings.fon_dump_free(dump);
+            throw;
+        }
+    }
+
+
+    public void Clear() {
+        while (open.Count > 0) {
+            Release(open[^1]);
+            open.RemoveAt(open.Count - 1);
+        }
+        records.Clear();
+        fields.Clear();
+        arenaLength = 0;
+        topLevelCount = 0;
+    }
+
+
+
+
+    private Frame Top => open.Count > 0 ? open[^1] : throw new InvalidOperationException("No record is open");
+
+
+    private int Key(string key) {
+        ArgumentNullException.ThrowIfNull(key);
+        ref int id = ref CollectionsMarshal.GetValueRefOrAddDefault(keyIds, key, out bool exists);
+        if (!exists) {
+            id = keyIds.Count - 1;
+            int byteCount = Encoding.UTF8.GetByteCount(key);
+            if (keyLength + byteCount > keyBytes.Length) {
+                Array.Resize(ref keyBytes, Math.Max(keyBytes.Length * 2, keyLength + byteCount));
+            }
+            keyLength += Encoding.UTF8.GetBytes(key, keyBytes.AsSpan(keyLength));
+            keyOffsets.Add(keyLength);
+        }
+        return id;
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private void AddScalar(string key, int tag, long value) => AddField(key, tag, value, 0);
+
+
+    private void AddField(string key, int tag, long value, long length) {
+        var frame = Top;
+        if (frame.Kind == FrameKind.Array) {
+            throw new InvalidOperationException("Values inside an object array must be wrapped in BeginArrayObject / EndObject");
+        }
+        frame.Fields.Add(new FonPackedField { Key = Key(key), Tag = tag, Value = value, Length = length });
+    }
+
+
+    private Frame Push(FrameKind kind, int key) {
+        if (kind != FrameKind.Record) {
+            _ = Top;
+        }
+        var frame = framePool.Count > 0 ? framePool.Pop() : new Frame();
+        frame.Kind = kind;
+        frame.Key = key;
+        open.Add(frame);
+        return frame;
+    }
+
+
+    private Frame Pop(FrameKind kind) {
+        if (open.Count == 0 || open[^1].Kind != kind) {
+            throw new InvalidOperationException($"No open {kind.ToString().ToLowerInvariant()} to end");
+        }
+        var frame = open[^1];
+        open.RemoveAt(open.Count - 1);
+        return frame;
+    }
+
+
+    // Fields of a record are contiguous, so an open record keeps its own list until it ends;
+    // nested records end first and get the lower index the native side expects
+    private int Flush(Frame frame, int flags) {
+        records.Add(new FonPackedRecord {
+            Id = frame.Id,
+            FirstField = fields.Count,
+            FieldCount = frame.Fields.Count,
+            Flags = flags
+        });
+        fields.AddRange(frame.Fields);
+        return records.Count - 1;
+    }
+
+
+    private void Release(Frame frame) {
+        frame.Fields.Clear();
+        frame.Children.Clear();
+        frame.Id = 0;
+        framePool.Push(frame);
+    }
+
+
+    private long WriteArena(ReadOnlySpan<byte> bytes, bool align) {
+        int padding = align ? (-arenaLength) & 3 : 0;
+        EnsureArena(padding + bytes.Length);
+        arena.AsSpan(arenaLength, padding).Clear();
+        arenaLength += padding;
+        long offset = arenaLength;
+        bytes.CopyTo(arena.AsSpan(arenaLength));
+        arenaLength += bytes.Length;
+        return offset;
+    }
+
+
+    private void EnsureArena(int extra) {
+        if (arenaLength + extra > arena.Length) {
+            Array.Resize(ref arena, Math.Max(arena.Length * 2, checked(arenaLength + extra)));
+        }
+    }
+
+
+
+
+    private enum FrameKind {
+        Record,
+        Object,
+        Array
+    }
+
+
+    private sealed class Frame {
+        public FrameKind Kind;
+        public int Key;
+        public ulong Id;
+        public readonly List<FonPackedField> Fields = [];
+        public readonly List<int> Children = [];
+    }
+}
+
+
+
+
+/// <summary>
+/// Turns a batch from <see cref="NativeBindings.fon_dump_unpack"/> / <see cref="NativeBindings.fon_collection_unpack"/>
+/// into managed collections. Each distinct key becomes one string, shared by every record.
+/// </summary>
+internal static unsafe class NativeBatchReader {
+    public static FonDump ReadDump(in FonPackedBatch batch) {
+        var dump = new FonDump(checked((int)batch.RecordCount));
+        Read(batch, (id, collection) => dump.Add(id, collection));
+        return dump;
+    }
+
+
+    /// <summary>
+    /// Appends the records of a batch in id order, shifting every id by <paramref name="firstId"/>.
+    /// </summary>
+    public static void ReadRecords(in FonPackedBatch batch, ulong firstId, List<(ulong id, FonCollection record)> records) {
+        Read(batch, (id, collection) => records.Add((firstId + id, collection)));
+    }
+
+
+    public static FonCollection ReadCollection(in FonPackedBatch batch) {
+        FonCollection? last = null;
+        Read(batch, (_, collection) => last = collection);
+        return last ?? new FonCollection();
+    }
+
+
+    private static void Read(in FonPackedBatch batch, Action<ulong, FonCollection> onRecord) {
+        var keyBytes = new ReadOnlySpan<byte>((void*)batch.KeyBytes, checked((int)batch.KeyBytesLength));
+        var keyOffsets = new ReadOnlySpan<int>((void*)batch.KeyOffsets, batch.KeyCount + 1);
+        var records = new ReadOnlySpan<FonPackedRecord>((void*)batch.Records, checked((int)batch.RecordCount));
+        var fields = new ReadOnlySpan<FonPackedField>((void*)batch.Fields, checked((int)batch.FieldCount));
+        var arena = new ReadOnlySpan<byte>((void*)batch.Arena, checked((int)batch.ArenaLength));
+
+        var keys = new string[batch.KeyCount];
+        for (int i = 0; i < keys.Length; i++) {
+            keys[i] = Encoding.UTF8.GetString(keyBytes[keyOffsets[i]..keyOffsets[i + 1]]);
+        }
+
+        var nested = new FonCollection?[records.Length];
+        for (int r = 0; r < records.Length; r++) {
+            var record = records[r];
+            var collection = new FonCollection(record.FieldCount);
+
+            foreach (var field in fields.Slice(checked((int)record.FirstField), record.FieldCount)) {
+                var key = keys[field.Key];
+                switch (field.Tag) {
+                    case FonPackedTag.Int: collection.Add(key, (int)field.Value); break;
+                    case FonPackedTag.Long: collection.Add(key, field.Value); break;
+                    case FonPackedTag.Float: collection.Add(key, BitConverter.Int32BitsToSingle((int)field.Value)); break;
+                    case FonPackedTag.Double: collection.Add(key, BitConverter.Int64BitsToDouble(field.Value)); break;
+                    case FonPackedTag.Bool: collection.Add(key, field.Value != 0); break;
+                    case FonPackedTag.String:
+                        collection.Add(key, Encoding.UTF8.GetString(arena.Slice(checked((int)field.Value), checked((int)field.Length))));
+                        break;
+                    case FonPackedTag.IntArray: collection.Add(key, ReadList<int>(arena, field)); break;
+                    case FonPackedTag.FloatArray: collection.Add(key, ReadList<float>(arena, field)); break;
+                    case FonPackedTag.Object: collection.Add(key, TakeNested(nested, field.Value, r)); break;
+                    case FonPackedTag.ObjectArray:
+                        var indices = ReadList<int>(arena, field);
+                        var children = new List<FonCollection>(indices.Count);
+                        foreach (var index in indices) {
+                            children.Add(TakeNested(nested, index, r));
+                        }
+                        collection.Add(key, children);
+                        break;
+                    default:
+                        throw new InvalidDataException($"Unknown packed type tag {field.Tag} for '{key}'");
+                }
+            }
+
+            if ((record.Flags & FonPackedTag.Nested) != 0) {
+                nested[r] = collection;
+            } else {
+                onRecord(record.Id, collection);
+            }
+        }
+    }
+
+
+    private static List<T> ReadList<T>(ReadOnlySpan<byte> arena, FonPackedField field) where T : unmanaged {
+        int count = checked((int)field.Length);
+        var source = MemoryMarshal.Cast<byte, T>(arena.Slice(checked((int)field.Value), checked(count * sizeof(T))));
+        var list = new List<T>(count);
+        CollectionsMarshal.SetCount(list, count);
+        source.CopyTo(CollectionsMarshal.AsSpan(list));
+        return list;
+    }
+
+
+    private static FonCollection TakeNested(FonCollection?[] nested, long index, int owner) {
+        if (index < 0 || index >= owner || nested[index] is not { } child) {
+            throw new InvalidDataException($"Record {owner} references nested record {index} that is missing or already used");
+        }
+        nested[index] = null;
+        return child;
+    }
+}
@@ -0,0 +1,93 @@
+using FON.Types;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Forward-only native reader over a FON file: the bounded-memory counterpart of
+/// <see cref="NativeBindings.fon_deserialize_from_file"/>. The file is read through a buffered
+/// native handle one batch of lines at a time, so only the current batch is ever held.
+///
+/// Dumps returned by <see cref="ReadBatch"/> are owned by the caller and outlive the reader.
+/// Not thread-safe, but calls may come from different threads one after another.
+/// </summary>
+public sealed class NativeFileReader : IDisposable {
+    /// <summary>
+    /// Lines per batch when none is given.
+    /// </summary>
+    public const int DefaultBatchSize = 16 * 1024;
+
+    private IntPtr handle;
+
+
+    public NativeFileReader(FileInfo file) {
+        ArgumentNullException.ThrowIfNull(file);
+
+        FonError error = default;
+        handle = NativeBindings.fon_reader_open(file.FullName, ref error);
+        if (handle == IntPtr.Zero) {
+            throw new FonNativeException(error);
+        }
+    }
+
+
+    /// <summary>
+    /// Reads and parses up to <paramref name="maxRecords"/> following lines in parallel into a new
+    /// dump, or returns <see cref="IntPtr.Zero"/> at the end of the file. Record k of the dump is line
+    /// <paramref name="firstId"/> + k. The caller frees the dump via <see cref="NativeBindings.fon_dump_free"/>.
+    /// </summary>
+    public IntPtr ReadBatch(int maxRecords, out ulong firstId, int maxThreads = 0) {
+        ObjectDisposedException.ThrowIf(handle == IntPtr.Zero, this);
+        ArgumentOutOfRangeException.ThrowIfLessThan(maxRecords, 1);
+
+        FonError error = default;
+        NativeMetrics.Call("fon_reader_next_batch");
+        int rc = NativeBindings.fon_reader_next_batch(handle, maxRecords, maxThreads, out firstId, out IntPtr dump, ref error);
+        if (rc != FonResultCode.OK) {
+            throw new FonNativeException(error);
+        }
+        return dump;
+    }
+
+
+    /// <summary>
+    /// Reads the next batch straight into managed records with absolute ids (line numbers), in
+    /// line order. Returns null at the end of the file; a batch of blank lines only is an empty list.
+    /// </summary>
+    public List<(ulong id, FonCollection record)>? ReadRecords(int maxRecords, int maxThreads = 0) {
+        IntPtr dump = ReadBatch(maxRecords, out ulong firstId, maxThreads);
+        if (dump == IntPtr.Zero) {
+            return null;
+        }
+
+        var records = new List<(ulong id, FonCollection record)>();
+
+        try {
+            FonError error = default;
+            NativeMetrics.Call("fon_dump_unpack");
+            int rc = NativeBindings.fon_dump_unpack(dump, out FonPackedBatch batch, ref error);
+            if (rc != FonResultCode.OK) {
+                throw new FonNativeException(error);
+            }
+            try {
+                records.Capacity = checked((int)batch.RecordCount);
+                NativeBatchReader.ReadRecords(batch, firstId, records);
+            } finally {
+                NativeBindings.fon_packed_batch_free(ref batch);
+            }
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+        return records;
+    }
+
+
+    public void Dispose() {
+        if (handle == IntPtr.Zero) {
+            return;
+        }
+        NativeBindings.fon_reader_close(handle);
+        handle = IntPtr.Zero;
+    }
+}
@@ -0,0 +1,203 @@
+using FON.Types;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Incremental native writer for FON files, the counterpart of <see cref="FON.Core.FonWriter"/>
+/// that serializes through the native library instead of the managed serializer.
+///
+/// Records are copied into a <see cref="NativeDumpBuilder"/> as they are written, so a record may be
+/// changed or reused as soon as <see cref="WriteAsync(FonCollection, CancellationToken)"/> returns.
+/// Each full batch is serialized in parallel and appended to the file on the thread pool while the
+/// caller fills the next one; with one batch in flight memory follows the batch size, not the file size.
+/// Not thread-safe.
+/// </summary>
+public sealed class NativeFileWriter : IAsyncDisposable {
+    /// <summary>
+    /// Records per batch when none is given.
+    /// </summary>
+    public const int DefaultBatchSize = 4096;
+
+    private readonly int batchSize;
+    private readonly int maxThreads;
+    private readonly NativeDumpBuilder builder;
+    private IntPtr handle;
+    private Task? pending;
+    private bool failed;
+
+
+    private NativeFileWriter(IntPtr handle, int batchSize, int maxThreads) {
+        this.handle = handle;
+        this.batchSize = batchSize;
+        this.maxThreads = maxThreads;
+        builder = new NativeDumpBuilder(batchSize);
+    }
+
+
+    /// <summary>
+    /// Opens <paramref name="file"/> for writing. With <paramref name="append"/> existing records are
+    /// kept and new ones follow them; a missing trailing newline is added first.
+    /// </summary>
+    public static NativeFileWriter Create(FileInfo file, bool append = false, int batchSize = DefaultBatchSize, int maxThreads = 0) {
+        ArgumentNullException.ThrowIfNull(file);
+        ArgumentOutOfRangeException.ThrowIfLessThan(batchSize, 1);
+
+        FonError error = default;
+        IntPtr handle = NativeBindings.fon_writer_open(file.FullName, append ? 1 : 0, ref error);
+        if (handle == IntPtr.Zero) {
+            throw new FonNativeException(error);
+        }
+        return new NativeFileWriter(handle, batchSize, maxThreads);
+    }
+
+
+    /// <summary>
+    /// Records accepted so far. Record k of this writer ends up on line k of the output
+    /// (counted from where the writer started).
+    /// </summary>
+    public long Count { get; private set; }
+
+
+
+
+    /// <summary>
+    /// Copies one record into the current batch. Completes synchronously unless the record fills
+    /// the batch while the previous one is still being written.
+    /// </summary>
+    /// <exception cref="NotSupportedException">The record holds a value the native types cannot carry;
+    /// nothing of it is written. Use <see cref="FON.Core.FonWriter"/> for such data.</exception>
+    public ValueTask WriteAsync(FonCollection record, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(record);
+        ThrowIfUnusable();
+
+        // Ids are local to the batch and only fix the line order inside it
+        if (!builder.TryAdd((ulong)builder.RecordCount, record)) {
+            throw new NotSupportedException("Record holds a value the native writer cannot serialize");
+        }
+        Count++;
+
+        return builder.RecordCount >= batchSize ? SubmitBatchAsync(cancellationToken) : ValueTask.CompletedTask;
+    }
+
+
+    /// <summary>
+    /// Writes records in order. Same as calling <see cref="WriteAsync(FonCollection, CancellationToken)"/> for each one.
+    /// </summary>
+    public async ValueTask WriteAsync(IEnumerable<FonCollection> records, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(records);
+
+        foreach (var record in records) {
+            await WriteAsync(record, cancellationToken);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Writes the partial batch, waits for the batch in flight and flushes the file.
+    /// </summary>
+    public async Task FlushAsync(CancellationToken cancellationToken = default) {
+        ThrowIfUnusable();
+
+        if (builder.RecordCount > 0) {
+            await SubmitBatchAsync(cancellationToken);
+        }
+        await WaitPendingAsync(cancellationToken);
+        await Task.Run(() => {
+            FonError error = default;
+            int rc = NativeBindings.fon_writer_flush(handle, ref error);
+            if (rc != FonResultCode.OK) {
+                failed = true;
+                throw new FonNativeException(error);
+            }
+        }, cancellationToken);
+    }
+
+
+
+
+    /// <summary>
+    /// Flushes pending records and closes the file.
+    /// After a failed batch nothing more is written and the file ends at the last good batch.
+    /// </summary>
+    public async ValueTask DisposeAsync() {
+        if (handle == IntPtr.Zero) {
+            return;
+        }
+
+        try {
+            if (!failed) {
+                await FlushAsync();
+            }
+        } finally {
+            // Only left over after a failure: the handle must not be closed under a running append
+            if (pending != null) {
+                try {
+                    await pending;
+                } catch (Exception) {
+                    // The first failure was already surfaced to the caller
+                }
+            }
+
+            FonError error = default;
+            int rc = NativeBindings.fon_writer_close(handle, ref error);
+            handle = IntPtr.Zero;
+            if (rc != FonResultCode.OK && !failed) {
+                throw new FonNativeException(error);
+            }
+        }
+    }
+
+
+
+
+    private async ValueTask SubmitBatchAsync(CancellationToken cancellationToken) {
+        // Only one append may use the handle at a time
+        await WaitPendingAsync(cancellationToken);
+
+        // The dump is a native copy, so the builder is free for the next batch right away
+        IntPtr dump = builder.CreateDump();
+        builder.Clear();
+
+        pending = Task.Run(() => {
+            try {
+                FonError error = default;
+                NativeMetrics.Call("fon_writer_append_dump");
+                int rc = NativeBindings.fon_writer_append_dump(handle, dump, maxThreads, ref error);
+                if (rc != FonResultCode.OK) {
+                    throw new FonNativeException(error);
+                }
+            } finally {
+                NativeBindings.fon_dump_free(dump);
+            }
+        });
+    }
+
+
+    private async ValueTask WaitPendingAsync(CancellationToken cancellationToken) {
+        if (pending == null) {
+            return;
+        }
+        try {
+            await pending.WaitAsync(cancellationToken);
+        } catch (OperationCanceledException) when (!pending.IsCompleted) {
+            throw;
+        } catch {
+            // Later batches must not be written after a gap, the line numbers would shift
+            failed = true;
+            throw;
+        }
+        pending = null;
+    }
+
+
+    private void ThrowIfUnusable() {
+        ObjectDisposedException.ThrowIf(handle == IntPtr.Zero, this);
+        if (failed) {
+            throw new InvalidOperationException("NativeFileWriter failed on an earlier batch and cannot write further records");
+        }
+    }
+}
@@ -0,0 +1,33 @@
+using System.Diagnostics.Metrics;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Instruments of the <c>FON.Native</c> <see cref="Meter"/>: how often the managed side crosses into
+/// the native library on the bulk paths, and how often the backend hands an Auto call back to the
+/// managed code. Timings and throughput of the Auto calls are on the <c>FON</c> meter, tagged
+/// <c>engine=native</c>.
+/// </summary>
+/// <remarks>
+/// <list type="table">
+/// <item><term>fon.native.calls</term><description>P/Invoke calls into a data-carrying entry point. Tag: function.</description></item>
+/// <item><term>fon.native.declined</term><description>Auto calls the backend declined. Tag: operation.</description></item>
+/// </list>
+/// Small per-handle calls (frees, sizes, versions) are not counted.
+/// </remarks>
+public static class NativeMetrics {
+    public const string MeterName = "FON.Native";
+
+    private static readonly Meter meter = new(MeterName, typeof(NativeMetrics).Assembly.GetName().Version?.ToString());
+
+    private static readonly Counter<long> calls = meter.CreateCounter<long>("fon.native.calls", "{call}", "P/Invoke calls into the native library");
+    private static readonly Counter<long> declined = meter.CreateCounter<long>("fon.native.declined", "{call}", "Auto calls handed back to the managed code");
+
+
+
+    internal static void Call(string function) => calls.Add(1, new KeyValuePair<string, object?>("function", function));
+
+    internal static void Declined(string operation) => declined.Add(1, new KeyValuePair<string, object?>("operation", operation));
+}
@@ -0,0 +1,79 @@
+using System.Buffers;
+
+
+namespace FON.Native;
+
+
+/// <summary>
+/// Forward-only native cursor over a UTF-8 FON buffer: the streaming counterpart of
+/// <see cref="NativeApi.DeserializeDump(ReadOnlySpan{byte}, int)"/>. Lines are parsed only as the
+/// cursor advances, so a caller can walk a large buffer without building the whole dump.
+///
+/// The buffer stays pinned until <see cref="Dispose"/>. Handles returned by <see cref="TryReadNext"/>
+/// and <see cref="ReadBatch"/> are owned by the caller and outlive the cursor.
+/// Not thread-safe.
+/// </summary>
+public sealed class NativeRecordCursor : IDisposable {
+    private MemoryHandle pin;
+    private IntPtr handle;
+
+
+    public NativeRecordCursor(ReadOnlyMemory<byte> utf8) {
+        pin = utf8.Pin();
+
+        FonError error = default;
+        unsafe {
+            handle = NativeBindings.fon_cursor_create((byte*)pin.Pointer, utf8.Length, ref error);
+        }
+        if (handle == IntPtr.Zero) {
+            pin.Dispose();
+            throw new FonNativeException(error);
+        }
+    }
+
+
+    /// <summary>
+    /// Parses the next non-empty line. <paramref name="id"/> is its line number; the caller frees
+    /// <paramref name="collection"/> via <see cref="NativeBindings.fon_collection_free"/>.
+    /// Returns false at the end of the buffer.
+    /// </summary>
+    public bool TryReadNext(out ulong id, out IntPtr collection) {
+        ObjectDisposedException.ThrowIf(handle == IntPtr.Zero, this);
+
+        FonError error = default;
+        int rc = NativeBindings.fon_cursor_next(handle, out id, out collection, ref error);
+        if (rc != FonResultCode.OK) {
+            throw new FonNativeException(error);
+        }
+        return collection != IntPtr.Zero;
+    }
+
+
+    /// <summary>
+    /// Parses up to <paramref name="maxLines"/> following lines in parallel into a new dump, or returns
+    /// <see cref="IntPtr.Zero"/> at the end. Record k of the dump is line <paramref name="firstId"/> + k.
+    /// The caller frees the dump via <see cref="NativeBindings.fon_dump_free"/>.
+    /// </summary>
+    public IntPtr ReadBatch(int maxLines, out ulong firstId, int maxThreads = 0) {
+        ObjectDisposedException.ThrowIf(handle == IntPtr.Zero, this);
+        ArgumentOutOfRangeException.ThrowIfLessThan(maxLines, 1);
+
+        FonError error = default;
+        NativeMetrics.Call("fon_cursor_next_batch");
+        int rc = NativeBindings.fon_cursor_next_batch(handle, maxLines, maxThreads, out firstId, out IntPtr dump, ref error);
+        if (rc != FonResultCode.OK) {
+            throw new FonNativeException(error);
+        }
+        return dump;
+    }
+
+
+    public void Dispose() {
+        if (handle == IntPtr.Zero) {
+            return;
+        }
+        NativeBindings.fon_cursor_free(handle);
+        handle = IntPtr.Zero;
+        pin.Dispose();
+    }
+}
@@ -4,6 +4,8 @@
 //! bindings (`NativeBindings.cs`) work without any change.
 
 use std::ffi::{c_char, c_void, CStr};
+use std::fs::{File, OpenOptions};
+use std::io::{BufRead, BufReader, BufWriter, Read, Seek, SeekFrom, Write};
 use std::path::PathBuf;
 use std::ptr;
 use std::slice;
@@ -13,6 +15,9 @@ use fon::deserialize::{deserialize_dump_from_bytes, deserialize_from_file, deser
 use fon::serialize::{serialize_dump_to_string, serialize_to_file, serialize_to_string};
 use fon::types::{FonCollection, FonDump, FonValue};
 use fon::{DeserializeOptions, FonError as FonLibError};
+use rayon::prelude::*;
+
+mod z85;
 
 
 // Result codes mirror fon_export.h.
@@ -306,6 +311,77 @@ pub extern "C" fn fon_serialize_collection_to_buffer(
 }
 
 
+// ==================== OWNED BUFFER SERIALIZATION ====================
+
+// Single-pass alternative to the two-call pattern: the text is serialized once and the
+// allocation itself is handed to the caller, who returns it via fon_buffer_free.
+
+#[repr(C)]
+pub struct FonBuffer {
+    pub data: *mut u8,
+    pub length: i64,
+    pub capacity: i64,
+}
+
+
+unsafe fn give_buffer(text: String, out: *mut FonBuffer) -> i32 {
+    let mut bytes = std::mem::ManuallyDrop::new(text.into_bytes());
+    (*out).data = bytes.as_mut_ptr();
+    (*out).length = bytes.len() as i64;
+    (*out).capacity = bytes.capacity() as i64;
+    FON_OK
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_serialize_dump_to_owned(
+    dump: *mut c_void,
+    max_threads: i32,
+    out: *mut FonBuffer,
+    error: *mut FonError,
+) -> i32 {
+    if dump.is_null() || out.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let d = unsafe { &*(dump as *const FonDump) };
+    unsafe { give_buffer(serialize_dump_to_string(d, max_threads), out) }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_serialize_collection_to_owned(
+    collection: *mut c_void,
+    out: *mut FonBuffer,
+    error: *mut FonError,
+) -> i32 {
+    if collection.is_null() || out.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let c = unsafe { &*(collection as *const FonCollection) };
+    unsafe { give_buffer(serialize_to_string(c), out) }
+}
+
+
+/// Releases a buffer from one of the *_to_owned calls and clears it, so a second call is a no-op.
+#[no_mangle]
+pub extern "C" fn fon_buffer_free(buffer: *mut FonBuffer) {
+    if buffer.is_null() {
+        return;
+    }
+    unsafe {
+        let b = &mut *buffer;
+        if !b.data.is_null() {
+            drop(Vec::from_raw_parts(b.data, b.length as usize, b.capacity as usize));
+        }
+        b.data = ptr::null_mut();
+        b.length = 0;
+        b.capacity = 0;
+    }
+}
+
+
 // ==================== STRING / BUFFER DESERIALIZATION ====================
 
 #[no_mangle]
@@ -369,6 +445,932 @@ pub extern "C" fn fon_deserialize_collection_from_buffer(
 }
 
 
+// ==================== PROJECTION ====================
+
+// Key allow-list for the deserializers, the native side of FonReadOptions. A dotted path
+// ("meta.owner") descends into o: values and into every element of an o: array.
+// Each line is first cut down to the selected `key=t:value` pairs by bracket/quote scanning
+// only, so unselected strings, raw blobs and nested objects never reach the parser.
+// A non-empty line without any selected key still yields an empty record under its line id,
+// the same as the managed parser; only lines that were empty to begin with are dropped.
+
+struct Projection {
+    // None = the whole value is selected
+    keys: Vec<(Vec<u8>, Option<Projection>)>,
+}
+
+
+impl Projection {
+    fn insert(&mut self, segments: &[&[u8]]) {
+        let Some((head, rest)) = segments.split_first() else {
+            return;
+        };
+        match self.keys.iter().position(|(k, _)| k.as_slice() == *head) {
+            None => {
+                let child = if rest.is_empty() {
+                    None
+                } else {
+                    let mut child = Projection { keys: Vec::new() };
+                    child.insert(rest);
+                    Some(child)
+                };
+                self.keys.push((head.to_vec(), child));
+            }
+            Some(i) => {
+                // A shorter path selects the value whole and wins over longer ones
+                if rest.is_empty() {
+                    self.keys[i].1 = None;
+                } else if let Some(child) = &mut self.keys[i].1 {
+                    child.insert(rest);
+                }
+            }
+        }
+    }
+}
+
+
+fn parse_error(message: &str) -> FonLibError {
+    FonLibError::Parse(message.into())
+}
+
+
+/// Index of the closing quote of a string whose content starts at `start`, honoring escapes.
+fn find_string_end(bytes: &[u8], start: usize) -> Option<usize> {
+    let mut position = start;
+    while position < bytes.len() {
+        position += memchr::memchr2(b'"', b'\\', &bytes[position..])?;
+        if bytes[position] == b'"' {
+            return Some(position);
+        }
+        // Skip the escaped byte
+        position += 2;
+    }
+    None
+}
+
+
+/// Index of the bracket matching bytes[0]; quoted strings are skipped as a whole.
+fn find_closing(bytes: &[u8], open: u8, close: u8) -> Option<usize> {
+    let mut depth = 0i32;
+    let mut position = 0;
+    while position < bytes.len() {
+        position += memchr::memchr3(b'"', open, close, &bytes[position..])?;
+        let c = bytes[position];
+        if c == b'"' {
+            position = find_string_end(bytes, position + 1)? + 1;
+            continue;
+        }
+        if c == open {
+            depth += 1;
+        } else {
+            depth -= 1;
+            if depth == 0 {
+                return Some(position);
+            }
+        }
+        position += 1;
+    }
+    None
+}
+
+
+/// Length of the value at the start of `bytes`, without the trailing ','.
+fn value_len(bytes: &[u8], type_char: u8) -> Result<usize, FonLibError> {
+    if bytes.first() == Some(&b'[') {
+        return find_closing(bytes, b'[', b']')
+            .map(|i| i + 1)
+            .ok_or_else(|| parse_error("Closing bracket not found"));
+    }
+    match type_char {
+        b'o' => {
+            if bytes.first() != Some(&b'{') {
+                return Err(parse_error("Object must start with '{'"));
+            }
+            find_closing(bytes, b'{', b'}')
+                .map(|i| i + 1)
+                .ok_or_else(|| parse_error("Closing brace not found"))
+        }
+        b's' | b'r' => {
+            if bytes.first() != Some(&b'"') {
+                return Err(parse_error("String must start with '\"'"));
+            }
+            Ok(find_string_end(bytes, 1).map_or(bytes.len(), |i| i + 1))
+        }
+        _ => Ok(bytes
+            .iter()
+            .position(|&c| matches!(c, b',' | b']' | b'\r' | b'\n'))
+            .unwrap_or(bytes.len())),
+    }
+}
+
+
+/// Appends the selected pairs of one collection body to `out`.
+fn project_body(body: &[u8], selection: &Projection, out: &mut Vec<u8>, depth: i32) -> Result<(), FonLibError> {
+    if depth > MAX_DEPTH.load(Ordering::Relaxed) {
+        return Err(parse_error("Maximum nesting depth exceeded"));
+    }
+
+    let mut position = 0;
+    let mut found = 0;
+    while position < body.len() {
+        let Some(eq) = memchr::memchr(b'=', &body[position..]).map(|i| position + i) else {
+            break;
+        };
+        let type_at = eq + 1;
+        if body.len() < type_at + 2 || body[type_at + 1] != b':' {
+            return Err(parse_error(&format!("Invalid format at position {}", type_at)));
+        }
+        let type_char = body[type_at];
+        let value_start = type_at + 2;
+        let value = &body[value_start..];
+        let len = value_len(value, type_char)?;
+
+        let key = &body[position..eq];
+        if let Some((_, child)) = selection.keys.iter().find(|(k, _)| k.as_slice() == key) {
+            if found > 0 {
+                out.push(b',');
+            }
+            out.extend_from_slice(&body[position..value_start]);
+            match child {
+                Some(child) if type_char == b'o' => project_objects(&value[..len], child, out, depth + 1)?,
+                _ => out.extend_from_slice(&value[..len]),
+            }
+            found += 1;
+            // Every selected key is in, the rest of the body is not even scanned
+            if found == selection.keys.len() {
+                break;
+            }
+        }
+
+        position = value_start + len;
+        if body.get(position) == Some(&b',') {
+            position += 1;
+        }
+    }
+    Ok(())
+}
+
+
+/// Appends a projected `{...}` object or `[{...},...]` object array to `out`.
+fn project_objects(value: &[u8], selection: &Projection, out: &mut Vec<u8>, depth: i32) -> Result<(), FonLibError> {
+    let inner = &value[1..value.len() - 1];
+    if value[0] == b'{' {
+        out.push(b'{');
+        project_body(inner, selection, out, depth)?;
+        out.push(b'}');
+        return Ok(());
+    }
+
+    out.push(b'[');
+    let mut position = 0;
+    while position < inner.len() {
+        let len = value_len(&inner[position..], b'o')?;
+        if position > 0 {
+            out.push(b',');
+        }
+        project_objects(&inner[position..position + len], selection, out, depth + 1)?;
+        position += len;
+        if inner.get(position) == Some(&b',') {
+            position += 1;
+        }
+    }
+    out.push(b']');
+    Ok(())
+}
+
+
+/// Cuts every line of `bytes` down to the selection. Line structure (and so line ids) is kept.
+fn project_lines(bytes: &[u8], selection: &Projection) -> Result<(Vec<u8>, Vec<u64>), FonLibError> {
+    let mut out = Vec::with_capacity(bytes.len() / 4);
+    // Ids of the lines the projection emptied, which the parser would otherwise drop
+    let mut emptied = Vec::new();
+    let mut rest = bytes.strip_prefix(&[0xEF, 0xBB, 0xBF]).unwrap_or(bytes);
+    let mut id = 0u64;
+    loop {
+        let (line, next) = match memchr::memchr(b'\n', rest) {
+            Some(i) => (&rest[..i], Some(&rest[i + 1..])),
+            None => (rest, None),
+        };
+        let line = line.strip_suffix(b"\r").unwrap_or(line);
+        let start = out.len();
+        project_body(line, selection, &mut out, 0)?;
+        if out.len() == start && !line.is_empty() {
+            emptied.push(id);
+        }
+        match next {
+            Some(next) => {
+                out.push(b'\n');
+                rest = next;
+                id += 1;
+            }
+            None => break,
+        }
+    }
+    Ok((out, emptied))
+}
+
+
+/// Creates a key allow-list from `count` UTF-8 key paths. Free via fon_read_options_free.
+#[no_mangle]
+pub extern "C" fn fon_read_options_create(
+    keys: *const *const c_char,
+    count: i32,
+    error: *mut FonError,
+) -> *mut c_void {
+    if keys.is_null() || count < 1 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument: no keys");
+        return ptr::null_mut();
+    }
+    let mut projection = Projection { keys: Vec::new() };
+    for &key in unsafe { slice::from_raw_parts(keys, count as usize) } {
+        let path = match unsafe { cstr_to_str(key) } {
+            Ok(s) => s,
+            Err(e) => {
+                set_error(error, FON_ERROR_INVALID_ARGUMENT, &e.to_string());
+                return ptr::null_mut();
+            }
+        };
+        let segments: Vec<&[u8]> = path.split('.').map(str::as_bytes).collect();
+        if segments.iter().any(|s| s.is_empty()) {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument: empty key segment");
+            return ptr::null_mut();
+        }
+        projection.insert(&segments);
+    }
+    Box::into_raw(Box::new(projection)) as *mut c_void
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_read_options_free(options: *mut c_void) {
+    if options.is_null() {
+        return;
+    }
+    unsafe {
+        drop(Box::from_raw(options as *mut Projection));
+    }
+}
+
+
+/// fon_deserialize_dump_from_buffer restricted to the keys of `options`.
+#[no_mangle]
+pub extern "C" fn fon_deserialize_dump_from_buffer_projected(
+    data: *const u8,
+    size: i64,
+    max_threads: i32,
+    options: *mut c_void,
+    error: *mut FonError,
+) -> *mut c_void {
+    if (data.is_null() && size > 0) || size < 0 || options.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return ptr::null_mut();
+    }
+    let bytes = if size == 0 {
+        &[][..]
+    } else {
+        unsafe { slice::from_raw_parts(data, size as usize) }
+    };
+    let selection = unsafe { &*(options as *const Projection) };
+    let opts = DeserializeOptions {
+        max_depth: MAX_DEPTH.load(Ordering::Relaxed),
+        unpack_raw: DESERIALIZE_RAW_UNPACK.load(Ordering::Relaxed),
+    };
+    let parsed = project_lines(bytes, selection).and_then(|(projected, emptied)| {
+        let mut dump = deserialize_dump_from_bytes(&projected, max_threads, &opts)?;
+        for id in emptied {
+            dump.add(id, FonCollection::new());
+        }
+        Ok(dump)
+    });
+    match parsed {
+        Ok(dump) => Box::into_raw(Box::new(dump)) as *mut c_void,
+        Err(e) => {
+            let code = err_code(&e);
+            set_error(error, code, &e.to_string());
+            ptr::null_mut()
+        }
+    }
+}
+
+
+/// fon_deserialize_collection_from_buffer restricted to the keys of `options`.
+#[no_mangle]
+pub extern "C" fn fon_deserialize_collection_from_buffer_projected(
+    data: *const u8,
+    size: i64,
+    options: *mut c_void,
+    error: *mut FonError,
+) -> *mut c_void {
+    if (data.is_null() && size > 0) || size < 0 || options.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return ptr::null_mut();
+    }
+    let bytes = if size == 0 {
+        &[][..]
+    } else {
+        unsafe { slice::from_raw_parts(data, size as usize) }
+    };
+    let selection = unsafe { &*(options as *const Projection) };
+    let opts = DeserializeOptions {
+        max_depth: MAX_DEPTH.load(Ordering::Relaxed),
+        unpack_raw: DESERIALIZE_RAW_UNPACK.load(Ordering::Relaxed),
+    };
+    let mut projected = Vec::with_capacity(bytes.len() / 4);
+    match project_body(bytes, selection, &mut projected, 0).and_then(|_| deserialize_line(&projected, &opts)) {
+        Ok(c) => Box::into_raw(Box::new(c)) as *mut c_void,
+        Err(e) => {
+            let code = err_code(&e);
+            set_error(error, code, &e.to_string());
+            ptr::null_mut()
+        }
+    }
+}
+
+
+/// fon_deserialize_from_file restricted to the keys of `options`.
+#[no_mangle]
+pub extern "C" fn fon_deserialize_from_file_projected(
+    path: *const c_char,
+    max_threads: i32,
+    options: *mut c_void,
+    error: *mut FonError,
+) -> *mut c_void {
+    if path.is_null() || options.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return ptr::null_mut();
+    }
+    let path_str = match unsafe { cstr_to_str(path) } {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, &e.to_string());
+            return ptr::null_mut();
+        }
+    };
+    let bytes = match std::fs::read(path_str) {
+        Ok(b) => b,
+        Err(e) => {
+            set_error(error, FON_ERROR_FILE_NOT_FOUND, &e.to_string());
+            return ptr::null_mut();
+        }
+    };
+    fon_deserialize_dump_from_buffer_projected(bytes.as_ptr(), bytes.len() as i64, max_threads, options, error)
+}
+
+
+// ==================== RECORD CURSOR ====================
+
+// Forward-only cursor over a caller-owned UTF-8 buffer, the streaming counterpart of
+// fon_deserialize_dump_from_buffer. Lines are parsed only as the cursor advances; ids are
+// line numbers, as in the dump loaders. The buffer must stay valid (pinned) until fon_cursor_free.
+
+struct FonCursor {
+    data: *const u8,
+    size: usize,
+    position: usize,
+    next_id: u64,
+}
+
+
+impl FonCursor {
+    fn bytes<'a>(&self) -> &'a [u8] {
+        if self.size == 0 {
+            &[]
+        } else {
+            unsafe { slice::from_raw_parts(self.data, self.size) }
+        }
+    }
+
+    /// Advances past the next line. Returns its id and bytes without '\n' / trailing '\r'.
+    fn next_line<'a>(&mut self) -> Option<(u64, &'a [u8])> {
+        let bytes = self.bytes();
+        if self.position >= bytes.len() {
+            return None;
+        }
+        let rest = &bytes[self.position..];
+        let (mut line, advance) = match memchr::memchr(b'\n', rest) {
+            Some(i) => (&rest[..i], i + 1),
+            None => (rest, rest.len()),
+        };
+        if let [head @ .., b'\r'] = line {
+            line = head;
+        }
+        let id = self.next_id;
+        self.position += advance;
+        self.next_id += 1;
+        Some((id, line))
+    }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_cursor_create(data: *const u8, size: i64, error: *mut FonError) -> *mut c_void {
+    if (data.is_null() && size > 0) || size < 0 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return ptr::null_mut();
+    }
+    let mut cursor = FonCursor {
+        data,
+        size: size as usize,
+        position: 0,
+        next_id: 0,
+    };
+    if cursor.bytes().starts_with(&[0xEF, 0xBB, 0xBF]) {
+        cursor.position = 3;
+    }
+    Box::into_raw(Box::new(cursor)) as *mut c_void
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_cursor_free(cursor: *mut c_void) {
+    if cursor.is_null() {
+        return;
+    }
+    unsafe {
+        drop(Box::from_raw(cursor as *mut FonCursor));
+    }
+}
+
+
+/// Parses the next non-empty line into a new Collection owned by the caller.
+/// At the end of the buffer returns FON_OK with *collection set to null.
+#[no_mangle]
+pub extern "C" fn fon_cursor_next(
+    cursor: *mut c_void,
+    id: *mut u64,
+    collection: *mut *mut c_void,
+    error: *mut FonError,
+) -> i32 {
+    if cursor.is_null() || id.is_null() || collection.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let c = unsafe { &mut *(cursor as *mut FonCursor) };
+    unsafe {
+        *collection = ptr::null_mut();
+    }
+
+    let opts = DeserializeOptions {
+        max_depth: MAX_DEPTH.load(Ordering::Relaxed),
+        unpack_raw: DESERIALIZE_RAW_UNPACK.load(Ordering::Relaxed),
+    };
+    while let Some((line_id, line)) = c.next_line() {
+        if line.is_empty() {
+            continue;
+        }
+        return match deserialize_line(line, &opts) {
+            Ok(parsed) => {
+                unsafe {
+                    *id = line_id;
+                    *collection = Box::into_raw(Box::new(parsed)) as *mut c_void;
+                }
+                FON_OK
+            }
+            Err(e) => {
+                let code = err_code(&e);
+                set_error(error, code, &e.to_string());
+                code
+            }
+        };
+    }
+    FON_OK
+}
+
+
+/// Parses up to `max_lines` following lines (in parallel, like fon_deserialize_dump_from_buffer)
+/// into a new Dump owned by the caller. Ids inside the dump are relative: record `k` is line
+/// `*first_id + k`. At the end of the buffer returns FON_OK with *dump set to null.
+#[no_mangle]
+pub extern "C" fn fon_cursor_next_batch(
+    cursor: *mut c_void,
+    max_lines: i64,
+    max_threads: i32,
+    first_id: *mut u64,
+    dump: *mut *mut c_void,
+    error: *mut FonError,
+) -> i32 {
+    if cursor.is_null() || first_id.is_null() || dump.is_null() || max_lines < 1 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let c = unsafe { &mut *(cursor as *mut FonCursor) };
+    unsafe {
+        *dump = ptr::null_mut();
+        *first_id = c.next_id;
+    }
+
+    let start = c.position;
+    let mut lines = 0;
+    while lines < max_lines && c.next_line().is_some() {
+        lines += 1;
+    }
+    if lines == 0 {
+        return FON_OK;
+    }
+
+    let opts = DeserializeOptions {
+        max_depth: MAX_DEPTH.load(Ordering::Relaxed),
+        unpack_raw: DESERIALIZE_RAW_UNPACK.load(Ordering::Relaxed),
+    };
+    match deserialize_dump_from_bytes(&c.bytes()[start..c.position], max_threads, &opts) {
+        Ok(parsed) => {
+            unsafe {
+                *dump = Box::into_raw(Box::new(parsed)) as *mut c_void;
+            }
+            FON_OK
+        }
+        Err(e) => {
+            let code = err_code(&e);
+            set_error(error, code, &e.to_string());
+            code
+        }
+    }
+}
+
+
+// ==================== STREAMING FILE HANDLES ====================
+
+// Bounded-memory counterparts of fon_deserialize_from_file / fon_serialize_to_file: a reader
+// parses a file batch by batch through a buffered handle, a writer appends records as they come.
+// Only the current batch is held, so multi-GB files never need to fit in memory.
+//
+// Threading contract: a handle is not synchronized. Each one must be used by one thread at a
+// time; it may move between threads between calls (the managed async wrappers rely on that).
+// Separate handles are independent, and batch parsing / dump serialization still fan out over
+// `max_threads` internally.
+
+const STREAM_BUFFER_SIZE: usize = 1 << 20;
+
+
+struct FonFileReader {
+    input: BufReader<File>,
+    batch: Vec<u8>,
+    next_id: u64,
+    started: bool,
+}
+
+
+struct FonFileWriter {
+    output: BufWriter<File>,
+    failed: bool,
+}
+
+
+impl FonFileWriter {
+    fn write(&mut self, bytes: &[u8]) -> Result<(), std::io::Error> {
+        let result = self.output.write_all(bytes);
+        if result.is_err() {
+            self.failed = true;
+        }
+        result
+    }
+}
+
+
+unsafe fn path_arg(path: *const c_char, error: *mut FonError) -> Option<PathBuf> {
+    match cstr_to_str(path) {
+        Ok(s) => Some(PathBuf::from(s)),
+        Err(e) => {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, &e.to_string());
+            None
+        }
+    }
+}
+
+
+/// Opens `path` for batched reading. Returns null on error.
+#[no_mangle]
+pub extern "C" fn fon_reader_open(path: *const c_char, error: *mut FonError) -> *mut c_void {
+    let path = match unsafe { path_arg(path, error) } {
+        Some(p) => p,
+        None => return ptr::null_mut(),
+    };
+    match File::open(&path) {
+        Ok(file) => {
+            let reader = FonFileReader {
+                input: BufReader::with_capacity(STREAM_BUFFER_SIZE, file),
+                batch: Vec::new(),
+                next_id: 0,
+                started: false,
+            };
+            Box::into_raw(Box::new(reader)) as *mut c_void
+        }
+        Err(e) => {
+            set_error(error, FON_ERROR_FILE_NOT_FOUND, &format!("Cannot open {}: {}", path.display(), e));
+            ptr::null_mut()
+        }
+    }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_reader_close(reader: *mut c_void) {
+    if reader.is_null() {
+        return;
+    }
+    unsafe {
+        drop(Box::from_raw(reader as *mut FonFileReader));
+    }
+}
+
+
+/// Reads up to `max_records` following lines and parses them in parallel into a new Dump owned
+/// by the caller, with the same relative ids as fon_cursor_next_batch: record `k` is line
+/// `*first_id + k`. At the end of the file returns FON_OK with *dump set to null.
+#[no_mangle]
+pub extern "C" fn fon_reader_next_batch(
+    reader: *mut c_void,
+    max_records: i64,
+    max_threads: i32,
+    first_id: *mut u64,
+    dump: *mut *mut c_void,
+    error: *mut FonError,
+) -> i32 {
+    if reader.is_null() || first_id.is_null() || dump.is_null() || max_records < 1 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let r = unsafe { &mut *(reader as *mut FonFileReader) };
+    unsafe {
+        *dump = ptr::null_mut();
+        *first_id = r.next_id;
+    }
+
+    // The previous batch's allocation is reused, so steady-state reading does not allocate here
+    r.batch.clear();
+    let mut lines = 0;
+    while lines < max_records {
+        match r.input.read_until(b'\n', &mut r.batch) {
+            Ok(0) => break,
+            Ok(_) => lines += 1,
+            Err(e) => {
+                set_error(error, FON_ERROR_PARSE_FAILED, &format!("Read failed: {}", e));
+                return FON_ERROR_PARSE_FAILED;
+            }
+        }
+        if !r.started {
+            r.started = true;
+            if r.batch.starts_with(&[0xEF, 0xBB, 0xBF]) {
+                r.batch.drain(..3);
+            }
+        }
+    }
+    r.next_id += lines as u64;
+    if lines == 0 {
+        return FON_OK;
+    }
+
+    let opts = DeserializeOptions {
+        max_depth: MAX_DEPTH.load(Ordering::Relaxed),
+        unpack_raw: DESERIALIZE_RAW_UNPACK.load(Ordering::Relaxed),
+    };
+    match deserialize_dump_from_bytes(&r.batch, max_threads, &opts) {
+        Ok(parsed) => {
+            unsafe {
+                *dump = Box::into_raw(Box::new(parsed)) as *mut c_void;
+            }
+            FON_OK
+        }
+        Err(e) => {
+            let code = err_code(&e);
+            set_error(error, code, &e.to_string());
+            code
+        }
+    }
+}
+
+
+/// Opens `path` for writing (`append` != 0 keeps existing records; a missing trailing newline
+/// is added so the last old record stays on its own line). Returns null on error.
+#[no_mangle]
+pub extern "C" fn fon_writer_open(path: *const c_char, append: i32, error: *mut FonError) -> *mut c_void {
+    let path = match unsafe { path_arg(path, error) } {
+        Some(p) => p,
+        None => return ptr::null_mut(),
+    };
+
+    let opened = if append != 0 {
+        OpenOptions::new().read(true).append(true).create(true).open(&path)
+    } else {
+        File::create(&path)
+    };
+    let mut file = match opened {
+        Ok(f) => f,
+        Err(e) => {
+            set_error(error, FON_ERROR_WRITE_FAILED, &format!("Cannot open {}: {}", path.display(), e));
+            return ptr::null_mut();
+        }
+    };
+
+    if append != 0 {
+        let mut last = [0u8; 1];
+        let unterminated = match file.metadata() {
+            Ok(m) if m.len() > 0 => file
+                .seek(SeekFrom::End(-1))
+                .and_then(|_| file.read_exact(&mut last))
+                .map(|_| last[0] != b'\n'),
+            Ok(_) => Ok(false),
+            Err(e) => Err(e),
+        };
+        // Appends always land at the end, whatever the read position
+        if let Err(e) = unterminated.and_then(|u| if u { file.write_all(b"\n") } else { Ok(()) }) {
+            set_error(error, FON_ERROR_WRITE_FAILED, &format!("Cannot append to {}: {}", path.display(), e));
+            return ptr::null_mut();
+        }
+    }
+
+    let writer = FonFileWriter {
+        output: BufWriter::with_capacity(STREAM_BUFFER_SIZE, file),
+        failed: false,
+    };
+    Box::into_raw(Box::new(writer)) as *mut c_void
+}
+
+
+fn writer_arg<'a>(writer: *mut c_void, error: *mut FonError) -> Result<&'a mut FonFileWriter, i32> {
+    if writer.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return Err(FON_ERROR_INVALID_ARGUMENT);
+    }
+    let w = unsafe { &mut *(writer as *mut FonFileWriter) };
+    if w.failed {
+        // A partial line may already be out; writing on would corrupt the record after it
+        set_error(error, FON_ERROR_WRITE_FAILED, "Writer failed earlier");
+        return Err(FON_ERROR_WRITE_FAILED);
+    }
+    Ok(w)
+}
+
+
+fn write_result(result: Result<(), std::io::Error>, error: *mut FonError) -> i32 {
+    match result {
+        Ok(()) => FON_OK,
+        Err(e) => {
+            set_error(error, FON_ERROR_WRITE_FAILED, &format!("Write failed: {}", e));
+            FON_ERROR_WRITE_FAILED
+        }
+    }
+}
+
+
+/// Appends one collection as the next line.
+#[no_mangle]
+pub extern "C" fn fon_writer_append(writer: *mut c_void, collection: *mut c_void, error: *mut FonError) -> i32 {
+    let w = match writer_arg(writer, error) {
+        Ok(w) => w,
+        Err(code) => return code,
+    };
+    if collection.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument: collection is null");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let c = unsafe { &*(collection as *const FonCollection) };
+    let mut line = serialize_to_string(c);
+    line.push('\n');
+    write_result(w.write(line.as_bytes()), error)
+}
+
+
+/// Appends every record of `dump` in id order, serialized in parallel like fon_serialize_to_file.
+#[no_mangle]
+pub extern "C" fn fon_writer_append_dump(
+    writer: *mut c_void,
+    dump: *mut c_void,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    let w = match writer_arg(writer, error) {
+        Ok(w) => w,
+        Err(code) => return code,
+    };
+    if dump.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument: dump is null");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let d = unsafe { &*(dump as *const FonDump) };
+    let mut text = serialize_dump_to_string(d, max_threads);
+    if !text.is_empty() && !text.ends_with('\n') {
+        text.push('\n');
+    }
+    write_result(w.write(text.as_bytes()), error)
+}
+
+
+/// Pushes buffered lines to the file.
+#[no_mangle]
+pub extern "C" fn fon_writer_flush(writer: *mut c_void, error: *mut FonError) -> i32 {
+    let w = match writer_arg(writer, error) {
+        Ok(w) => w,
+        Err(code) => return code,
+    };
+    let result = w.output.flush();
+    if result.is_err() {
+        w.failed = true;
+    }
+    write_result(result, error)
+}
+
+
+/// Flushes and frees the writer. The handle is invalid afterwards even when this returns an error.
+#[no_mangle]
+pub extern "C" fn fon_writer_close(writer: *mut c_void, error: *mut FonError) -> i32 {
+    if writer.is_null() {
+        return FON_OK;
+    }
+    let mut w = unsafe { Box::from_raw(writer as *mut FonFileWriter) };
+    if w.failed {
+        // Drop the buffered tail instead of letting BufWriter flush it on drop
+        let _ = w.output.into_parts();
+        return FON_OK;
+    }
+    let result = w.output.flush();
+    write_result(result, error)
+}
+
+
+// ==================== Z85 ====================
+
+// RawData text codec (see z85.rs), same two-call pattern as the buffer serializers:
+// the output is written only when buffer_size covers *required_size.
+
+unsafe fn input_bytes<'a>(data: *const u8, size: i64) -> Option<&'a [u8]> {
+    if (data.is_null() && size > 0) || size < 0 {
+        return None;
+    }
+    Some(if size == 0 { &[][..] } else { slice::from_raw_parts(data, size as usize) })
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_z85_encode(
+    data: *const u8,
+    size: i64,
+    buffer: *mut u8,
+    buffer_size: i64,
+    required_size: *mut i64,
+    error: *mut FonError,
+) -> i32 {
+    let input = match unsafe { input_bytes(data, size) } {
+        Some(bytes) if !required_size.is_null() => bytes,
+        _ => {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+            return FON_ERROR_INVALID_ARGUMENT;
+        }
+    };
+    let required = z85::encoded_len(input.len());
+    unsafe { *required_size = required as i64 };
+    if !buffer.is_null() && buffer_size >= required as i64 {
+        let output = unsafe { slice::from_raw_parts_mut(buffer, required) };
+        z85::encode(input, output);
+    }
+    FON_OK
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_z85_decode(
+    text: *const u8,
+    size: i64,
+    buffer: *mut u8,
+    buffer_size: i64,
+    required_size: *mut i64,
+    error: *mut FonError,
+) -> i32 {
+    let input = match unsafe { input_bytes(text, size) } {
+        Some(bytes) if !required_size.is_null() => bytes,
+        _ => {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+            return FON_ERROR_INVALID_ARGUMENT;
+        }
+    };
+    let required = z85::decoded_len(input);
+    unsafe { *required_size = required as i64 };
+    if buffer.is_null() || buffer_size < required as i64 {
+        return FON_OK;
+    }
+
+    // The last block decodes whole before its padding is dropped; go through a scratch copy
+    // only when the caller's buffer is exact
+    let whole = required.div_ceil(4) * 4;
+    let result = if buffer_size >= whole as i64 {
+        z85::decode(input, unsafe { slice::from_raw_parts_mut(buffer, whole) })
+    } else {
+        let mut scratch = vec![0u8; whole];
+        z85::decode(input, &mut scratch).map(|n| {
+            unsafe { slice::from_raw_parts_mut(buffer, n) }.copy_from_slice(&scratch[..n]);
+            n
+        })
+    };
+    match result {
+        Ok(_) => FON_OK,
+        Err(message) => {
+            set_error(error, FON_ERROR_PARSE_FAILED, &message);
+            FON_ERROR_PARSE_FAILED
+        }
+    }
+}
+
+
 // ==================== COLLECTION ADD OPERATIONS ====================
 
 #[no_mangle]
@@ -999,3 +2001,699 @@ pub extern "C" fn fon_collection_get_collection_array(
         FON_OK
     }
 }
+
+
+// ==================== PACKED BATCHES ====================
+
+// Bulk alternative to one fon_collection_add_* / fon_collection_get_* call per field. A batch
+// is a table of interned keys, a list of records whose fields are contiguous, and one arena
+// holding strings, array elements and object-array child lists. Nested collections are
+// records of their own, flagged FON_PACKED_NESTED and referenced by index; they always come
+// before the record that owns them, so a batch is built in a single forward pass.
+
+pub const FON_PACKED_INT: i32 = 1;
+pub const FON_PACKED_LONG: i32 = 2;
+pub const FON_PACKED_FLOAT: i32 = 3;
+pub const FON_PACKED_DOUBLE: i32 = 4;
+pub const FON_PACKED_BOOL: i32 = 5;
+pub const FON_PACKED_STRING: i32 = 6;
+pub const FON_PACKED_INT_ARRAY: i32 = 7;
+pub const FON_PACKED_FLOAT_ARRAY: i32 = 8;
+pub const FON_PACKED_OBJECT: i32 = 9;
+pub const FON_PACKED_OBJECT_ARRAY: i32 = 10;
+
+pub const FON_PACKED_NESTED: i32 = 1;
+
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct FonPackedRecord {
+    pub id: u64,
+    pub first_field: i64,
+    pub field_count: i32,
+    pub flags: i32,
+}
+
+
+/// `value` holds scalars directly (floats as their bits), the arena offset for strings and
+/// arrays, or the record index for objects; `length` is the byte or element count.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct FonPackedField {
+    pub key: i32,
+    pub tag: i32,
+    pub value: i64,
+    pub length: i64,
+}
+
+
+/// `key_offsets` has `key_count + 1` entries delimiting each key in `key_bytes`.
+#[repr(C)]
+pub struct FonPackedBatch {
+    pub key_bytes: *const u8,
+    pub key_bytes_length: i64,
+    pub key_offsets: *const i32,
+    pub key_count: i32,
+    pub reserved: i32,
+    pub records: *const FonPackedRecord,
+    pub record_count: i64,
+    pub fields: *const FonPackedField,
+    pub field_count: i64,
+    pub arena: *const u8,
+    pub arena_length: i64,
+}
+
+
+unsafe fn packed_slice<'a, T>(data: *const T, length: i64, what: &str) -> Result<&'a [T], FonLibError> {
+    if length < 0 || (length > 0 && data.is_null()) {
+        return Err(FonLibError::InvalidArgument(format!("Invalid packed {}", what)));
+    }
+    if length == 0 {
+        return Ok(&[]);
+    }
+    Ok(slice::from_raw_parts(data, length as usize))
+}
+
+
+fn packed_range<'a>(arena: &'a [u8], offset: i64, length: i64, width: usize) -> Result<&'a [u8], FonLibError> {
+    let bytes = (length as u64).checked_mul(width as u64);
+    match (offset >= 0 && length >= 0, bytes) {
+        (true, Some(bytes)) if (offset as u64).checked_add(bytes).map_or(false, |end| end <= arena.len() as u64) => {
+            Ok(&arena[offset as usize..(offset as u64 + bytes) as usize])
+        }
+        _ => Err(FonLibError::InvalidArgument("Packed value is outside the arena".into())),
+    }
+}
+
+
+fn take_packed_child(built: &mut [Option<FonCollection>], child: i64, owner: usize) -> Result<FonCollection, FonLibError> {
+    if child >= 0 && (child as usize) < owner {
+        if let Some(c) = built[child as usize].take() {
+            return Ok(c);
+        }
+    }
+    Err(FonLibError::InvalidArgument(format!(
+        "Record {} references nested record {} that is missing, not nested or already used",
+        owner, child
+    )))
+}
+
+
+/// Builds every top-level record of a batch. Nothing is returned unless the whole batch is valid.
+unsafe fn build_packed(batch: &FonPackedBatch) -> Result<Vec<(u64, FonCollection)>, FonLibError> {
+    let key_bytes = packed_slice(batch.key_bytes, batch.key_bytes_length, "key bytes")?;
+    let key_offsets = packed_slice(batch.key_offsets, batch.key_count as i64 + 1, "key offsets")?;
+    let records = packed_slice(batch.records, batch.record_count, "records")?;
+    let fields = packed_slice(batch.fields, batch.field_count, "fields")?;
+    let arena = packed_slice(batch.arena, batch.arena_length, "arena")?;
+
+    let mut keys = Vec::with_capacity(batch.key_count.max(0) as usize);
+    for pair in key_offsets.windows(2) {
+        let (start, end) = (pair[0], pair[1]);
+        if start < 0 || end < start || end as usize > key_bytes.len() {
+            return Err(FonLibError::InvalidArgument("Invalid packed key offsets".into()));
+        }
+        let key = std::str::from_utf8(&key_bytes[start as usize..end as usize])
+            .map_err(|_| FonLibError::InvalidArgument("Packed key is not valid UTF-8".into()))?;
+        keys.push(key);
+    }
+
+    let mut built: Vec<Option<FonCollection>> = Vec::with_capacity(records.len());
+    let mut top = Vec::new();
+    for (index, record) in records.iter().enumerate() {
+        let start = record.first_field;
+        let end = start.checked_add(record.field_count as i64);
+        let range = match end {
+            Some(end) if start >= 0 && record.field_count >= 0 && end as usize <= fields.len() => start as usize..end as usize,
+            _ => return Err(FonLibError::InvalidArgument(format!("Record {} has an invalid field range", index))),
+        };
+
+        let mut collection = FonCollection::new();
+        for field in &fields[range] {
+            let key = *keys
+                .get(field.key as usize)
+                .ok_or_else(|| FonLibError::InvalidArgument(format!("Unknown packed key {}", field.key)))?;
+            let value = match field.tag {
+                FON_PACKED_INT => FonValue::Int(field.value as i32),
+                FON_PACKED_LONG => FonValue::Long(field.value),
+                FON_PACKED_FLOAT => FonValue::Float(f32::from_bits(field.value as u32)),
+                FON_PACKED_DOUBLE => FonValue::Double(f64::from_bits(field.value as u64)),
+                FON_PACKED_BOOL => FonValue::Bool(field.value != 0),
+                FON_PACKED_STRING => {
+                    let bytes = packed_range(arena, field.value, field.length, 1)?;
+                    let text = std::str::from_utf8(bytes)
+                        .map_err(|_| FonLibError::InvalidArgument(format!("Value of '{}' is not valid UTF-8", key)))?;
+                    FonValue::String(text.to_owned())
+                }
+                FON_PACKED_INT_ARRAY => {
+                    let bytes = packed_range(arena, field.value, field.length, 4)?;
+                    FonValue::IntArray(bytes.chunks_exact(4).map(|b| i32::from_ne_bytes([b[0], b[1], b[2], b[3]])).collect())
+                }
+                FON_PACKED_FLOAT_ARRAY => {
+                    let bytes = packed_range(arena, field.value, field.length, 4)?;
+                    FonValue::FloatArray(bytes.chunks_exact(4).map(|b| f32::from_ne_bytes([b[0], b[1], b[2], b[3]])).collect())
+                }
+                FON_PACKED_OBJECT => FonValue::Object(Box::new(take_packed_child(&mut built, field.value, index)?)),
+                FON_PACKED_OBJECT_ARRAY => {
+                    let bytes = packed_range(arena, field.value, field.length, 4)?;
+                    let mut children = Vec::with_capacity(field.length as usize);
+                    for b in bytes.chunks_exact(4) {
+                        let child = i32::from_ne_bytes([b[0], b[1], b[2], b[3]]) as i64;
+                        children.push(Box::new(take_packed_child(&mut built, child, index)?));
+                    }
+                    FonValue::ObjectArray(children)
+                }
+                tag => return Err(FonLibError::InvalidArgument(format!("Unknown packed type tag {} for '{}'", tag, key))),
+            };
+            collection.add(key.to_owned(), value);
+        }
+
+        if record.flags & FON_PACKED_NESTED != 0 {
+            built.push(Some(collection));
+        } else {
+            built.push(None);
+            top.push((record.id, collection));
+        }
+    }
+    Ok(top)
+}
+
+
+/// Adds every top-level record of the batch to the dump in one call. On error the dump is
+/// left untouched.
+#[no_mangle]
+pub extern "C" fn fon_dump_append_packed(
+    dump: *mut c_void,
+    batch: *const FonPackedBatch,
+    error: *mut FonError,
+) -> i32 {
+    if dump.is_null() || batch.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    match unsafe { build_packed(&*batch) } {
+        Ok(records) => {
+            let d = unsafe { &mut *(dump as *mut FonDump) };
+            for (id, collection) in records {
+                d.add(id, collection);
+            }
+            FON_OK
+        }
+        Err(e) => {
+            set_error(error, err_code(&e), &e.to_string());
+            err_code(&e)
+        }
+    }
+}
+
+
+#[derive(Default)]
+struct PackWriter<'a> {
+    key_ids: std::collections::HashMap<&'a str, i32>,
+    key_bytes: Vec<u8>,
+    key_offsets: Vec<i32>,
+    records: Vec<FonPackedRecord>,
+    fields: Vec<FonPackedField>,
+    arena: Vec<u8>,
+}
+
+
+impl<'a> PackWriter<'a> {
+    fn new() -> Self {
+        let mut writer = Self::default();
+        writer.key_offsets.push(0);
+        writer
+    }
+
+    fn key(&mut self, key: &'a str) -> i32 {
+        if let Some(&id) = self.key_ids.get(key) {
+            return id;
+        }
+        let id = self.key_ids.len() as i32;
+        self.key_bytes.extend_from_slice(key.as_bytes());
+        self.key_offsets.push(self.key_bytes.len() as i32);
+        self.key_ids.insert(key, id);
+        id
+    }
+
+    // Arrays start 4-aligned so the managed side can read them in place
+    fn align(&mut self) -> i64 {
+        while self.arena.len() % 4 != 0 {
+            self.arena.push(0);
+        }
+        self.arena.len() as i64
+    }
+
+    fn collection(&mut self, collection: &'a FonCollection, id: u64, flags: i32) -> Result<i32, FonLibError> {
+        let mut fields = Vec::with_capacity(collection.len());
+        for (name, value) in collection.iter() {
+            let key = self.key(name.as_str());
+            let (tag, value, length) = match value {
+                FonValue::Int(v) => (FON_PACKED_INT, *v as i64, 0),
+                FonValue::Long(v) => (FON_PACKED_LONG, *v, 0),
+                FonValue::Float(v) => (FON_PACKED_FLOAT, v.to_bits() as i64, 0),
+                FonValue::Double(v) => (FON_PACKED_DOUBLE, v.to_bits() as i64, 0),
+                FonValue::Bool(v) => (FON_PACKED_BOOL, *v as i64, 0),
+                FonValue::String(s) => {
+                    let offset = self.arena.len() as i64;
+                    self.arena.extend_from_slice(s.as_bytes());
+                    (FON_PACKED_STRING, offset, s.len() as i64)
+                }
+                FonValue::IntArray(v) => {
+                    let offset = self.align();
+                    v.iter().for_each(|x| self.arena.extend_from_slice(&x.to_ne_bytes()));
+                    (FON_PACKED_INT_ARRAY, offset, v.len() as i64)
+                }
+                FonValue::FloatArray(v) => {
+                    let offset = self.align();
+                    v.iter().for_each(|x| self.arena.extend_from_slice(&x.to_ne_bytes()));
+                    (FON_PACKED_FLOAT_ARRAY, offset, v.len() as i64)
+                }
+                FonValue::Object(child) => (FON_PACKED_OBJECT, self.collection(child, 0, FON_PACKED_NESTED)? as i64, 0),
+                FonValue::ObjectArray(children) => {
+                    let indices = children
+                        .iter()
+                        .map(|c| self.collection(c, 0, FON_PACKED_NESTED))
+                        .collect::<Result<Vec<i32>, _>>()?;
+                    let offset = self.align();
+                    indices.iter().for_each(|x| self.arena.extend_from_slice(&x.to_ne_bytes()));
+                    (FON_PACKED_OBJECT_ARRAY, offset, indices.len() as i64)
+                }
+                #[allow(unreachable_patterns)]
+                _ => {
+                    return Err(FonLibError::InvalidArgument(format!(
+                        "Value of '{}' has a type packed batches do not carry",
+                        name
+                    )))
+                }
+            };
+            fields.push(FonPackedField { key, tag, value, length });
+        }
+
+        let first_field = self.fields.len() as i64;
+        let field_count = fields.len() as i32;
+        self.fields.extend(fields);
+        self.records.push(FonPackedRecord { id, first_field, field_count, flags });
+        Ok((self.records.len() - 1) as i32)
+    }
+
+    fn finish(self, out: &mut FonPackedBatch) {
+        fn leak<T>(values: Vec<T>) -> (*const T, i64) {
+            let boxed = values.into_boxed_slice();
+            let length = boxed.len() as i64;
+            (Box::into_raw(boxed) as *const T, length)
+        }
+        let key_count = self.key_offsets.len() as i32 - 1;
+        (out.key_bytes, out.key_bytes_length) = leak(self.key_bytes);
+        (out.key_offsets, _) = leak(self.key_offsets);
+        out.key_count = key_count;
+        out.reserved = 0;
+        (out.records, out.record_count) = leak(self.records);
+        (out.fields, out.field_count) = leak(self.fields);
+        (out.arena, out.arena_length) = leak(self.arena);
+    }
+}
+
+
+/// The records of a dump sorted by id; the dump itself does not promise to iterate in id order.
+fn records_by_id(d: &FonDump) -> Vec<(u64, &FonCollection)> {
+    let mut records: Vec<(u64, &FonCollection)> = d.iter().map(|(id, c)| (*id, c)).collect();
+    records.sort_unstable_by_key(|(id, _)| *id);
+    records
+}
+
+
+/// Packs every record of a dump, in id order, into a batch owned by the library. Release it
+/// with fon_packed_batch_free. Fails (and leaves `out` alone) on a value type the batch
+/// format has no tag for.
+#[no_mangle]
+pub extern "C" fn fon_dump_unpack(
+    dump: *mut c_void,
+    out: *mut FonPackedBatch,
+    error: *mut FonError,
+) -> i32 {
+    if dump.is_null() || out.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let d = unsafe { &*(dump as *const FonDump) };
+    let mut writer = PackWriter::new();
+    for (id, collection) in records_by_id(d) {
+        if let Err(e) = writer.collection(collection, id, 0) {
+            set_error(error, err_code(&e), &e.to_string());
+            return err_code(&e);
+        }
+    }
+    writer.finish(unsafe { &mut *out });
+    FON_OK
+}
+
+
+/// Packs a single collection (e.g. one returned by fon_dump_get) as a batch whose last record
+/// is the collection itself, with id 0.
+#[no_mangle]
+pub extern "C" fn fon_collection_unpack(
+    collection: *mut c_void,
+    out: *mut FonPackedBatch,
+    error: *mut FonError,
+) -> i32 {
+    if collection.is_null() || out.is_null() {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let c = unsafe { &*(collection as *const FonCollection) };
+    let mut writer = PackWriter::new();
+    if let Err(e) = writer.collection(c, 0, 0) {
+        set_error(error, err_code(&e), &e.to_string());
+        return err_code(&e);
+    }
+    writer.finish(unsafe { &mut *out });
+    FON_OK
+}
+
+
+/// Releases a batch from fon_dump_unpack / fon_collection_unpack and clears it. Only for
+/// batches the library produced, never for ones the caller filled in.
+#[no_mangle]
+pub extern "C" fn fon_packed_batch_free(batch: *mut FonPackedBatch) {
+    unsafe fn release<T>(data: *const T, length: i64) {
+        if !data.is_null() {
+            drop(Box::from_raw(ptr::slice_from_raw_parts_mut(data as *mut T, length as usize)));
+        }
+    }
+    if batch.is_null() {
+        return;
+    }
+    unsafe {
+        let b = &mut *batch;
+        release(b.key_bytes, b.key_bytes_length);
+        release(b.key_offsets, b.key_count as i64 + 1);
+        release(b.records, b.record_count);
+        release(b.fields, b.field_count);
+        release(b.arena, b.arena_length);
+        *b = FonPackedBatch {
+            key_bytes: ptr::null(),
+            key_bytes_length: 0,
+            key_offsets: ptr::null(),
+            key_count: 0,
+            reserved: 0,
+            records: ptr::null(),
+            record_count: 0,
+            fields: ptr::null(),
+            field_count: 0,
+            arena: ptr::null(),
+            arena_length: 0,
+        };
+    }
+}
+
+
+// ==================== COLUMN EXTRACTION ====================
+
+// One call fills a caller-pinned array with one key of every record, in id order, instead of
+// fon_dump_get + fon_collection_get_* per row. Rows are split into contiguous chunks that run
+// on rayon's global pool, the one the parser already keeps warm, so no call spawns threads. `present` is optional (null): 1 where the row has the key with a
+// matching type, 0 otherwise (the value is then 0 / NaN / empty). Numeric columns widen
+// losslessly: long accepts int, double accepts int and float.
+
+// Below this many rows per chunk handing work to the pool costs more than the lookups
+const EXTRACT_ROWS_PER_THREAD: usize = 16 * 1024;
+
+
+fn extract_threads(max_threads: i32, rows: usize) -> usize {
+    let limit = if max_threads > 0 { max_threads as usize } else { rayon::current_num_threads() };
+    limit.min(rows / EXTRACT_ROWS_PER_THREAD).max(1)
+}
+
+
+// Row i of every column is the record with the i-th smallest id
+fn dump_rows(d: &FonDump) -> Vec<&FonCollection> {
+    records_by_id(d).into_iter().map(|(_, c)| c).collect()
+}
+
+
+/// Splits `rows`, `values` and `present` into matching chunks and runs `f` on each, in parallel.
+fn for_each_row_chunk<T: Send>(
+    rows: &[&FonCollection],
+    values: &mut [T],
+    present: Option<&mut [u8]>,
+    threads: usize,
+    f: impl Fn(&[&FonCollection], &mut [T], Option<&mut [u8]>) + Sync,
+) {
+    if threads <= 1 || rows.is_empty() {
+        f(rows, values, present);
+        return;
+    }
+    let size = (rows.len() + threads - 1) / threads;
+    let present_chunks: Vec<Option<&mut [u8]>> = match present {
+        Some(p) => p.chunks_mut(size).map(Some).collect(),
+        None => (0..threads).map(|_| None).collect(),
+    };
+    rows.par_chunks(size)
+        .zip(values.par_chunks_mut(size))
+        .zip(present_chunks)
+        .for_each(|((r, v), p)| f(r, v, p));
+}
+
+
+/// Shared argument checks; returns the rows and the key, or the error code already set.
+unsafe fn extract_args<'a>(
+    dump: *mut c_void,
+    key: *const c_char,
+    values_null: bool,
+    length: i64,
+    error: *mut FonError,
+) -> Result<(Vec<&'a FonCollection>, &'a str), i32> {
+    if dump.is_null() || key.is_null() || length < 0 || (length > 0 && values_null) {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return Err(FON_ERROR_INVALID_ARGUMENT);
+    }
+    let k = match cstr_to_str(key) {
+        Ok(s) => s,
+        Err(e) => {
+            set_error(error, FON_ERROR_INVALID_ARGUMENT, &e.to_string());
+            return Err(FON_ERROR_INVALID_ARGUMENT);
+        }
+    };
+    let rows = dump_rows(&*(dump as *const FonDump));
+    if (length as u64) < rows.len() as u64 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Output is shorter than the dump");
+        return Err(FON_ERROR_INVALID_ARGUMENT);
+    }
+    Ok((rows, k))
+}
+
+
+unsafe fn extract_column<T: Copy + Send + Sync>(
+    dump: *mut c_void,
+    key: *const c_char,
+    values: *mut T,
+    present: *mut u8,
+    length: i64,
+    max_threads: i32,
+    error: *mut FonError,
+    missing: T,
+    get: impl Fn(&FonValue) -> Option<T> + Sync,
+) -> i32 {
+    let (rows, key) = match extract_args(dump, key, values.is_null(), length, error) {
+        Ok(args) => args,
+        Err(code) => return code,
+    };
+    if rows.is_empty() {
+        return FON_OK;
+    }
+    let values = slice::from_raw_parts_mut(values, rows.len());
+    let present = if present.is_null() { None } else { Some(slice::from_raw_parts_mut(present, rows.len())) };
+
+    for_each_row_chunk(&rows, values, present, extract_threads(max_threads, rows.len()), |rows, values, mut present| {
+        for (i, row) in rows.iter().enumerate() {
+            let value = row.get(key).and_then(&get);
+            values[i] = value.unwrap_or(missing);
+            if let Some(p) = present.as_deref_mut() {
+                p[i] = value.is_some() as u8;
+            }
+        }
+    });
+    FON_OK
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_int(
+    dump: *mut c_void,
+    key: *const c_char,
+    values: *mut i32,
+    present: *mut u8,
+    length: i64,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    unsafe {
+        extract_column(dump, key, values, present, length, max_threads, error, 0, |v| match v {
+            FonValue::Int(x) => Some(*x),
+            _ => None,
+        })
+    }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_long(
+    dump: *mut c_void,
+    key: *const c_char,
+    values: *mut i64,
+    present: *mut u8,
+    length: i64,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    unsafe {
+        extract_column(dump, key, values, present, length, max_threads, error, 0, |v| match v {
+            FonValue::Long(x) => Some(*x),
+            FonValue::Int(x) => Some(*x as i64),
+            _ => None,
+        })
+    }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_double(
+    dump: *mut c_void,
+    key: *const c_char,
+    values: *mut f64,
+    present: *mut u8,
+    length: i64,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    unsafe {
+        extract_column(dump, key, values, present, length, max_threads, error, f64::NAN, |v| match v {
+            FonValue::Double(x) => Some(*x),
+            FonValue::Float(x) => Some(*x as f64),
+            FonValue::Int(x) => Some(*x as f64),
+            _ => None,
+        })
+    }
+}
+
+
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_bool(
+    dump: *mut c_void,
+    key: *const c_char,
+    values: *mut u8,
+    present: *mut u8,
+    length: i64,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    unsafe {
+        extract_column(dump, key, values, present, length, max_threads, error, 0, |v| match v {
+            FonValue::Bool(x) => Some(*x as u8),
+            _ => None,
+        })
+    }
+}
+
+
+/// Record ids in the same order as the extracted columns.
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_ids(dump: *mut c_void, ids: *mut u64, length: i64, error: *mut FonError) -> i32 {
+    if dump.is_null() || length < 0 || (length > 0 && ids.is_null()) {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let d = unsafe { &*(dump as *const FonDump) };
+    if (length as u64) < d.len() as u64 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Output is shorter than the dump");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let out = unsafe { slice::from_raw_parts_mut(ids, d.len()) };
+    for (slot, (id, _)) in out.iter_mut().zip(records_by_id(d)) {
+        *slot = id;
+    }
+    FON_OK
+}
+
+
+/// String column as one UTF-8 blob: row i is bytes[offsets[i]..offsets[i + 1]], so `offsets`
+/// holds length + 1 entries. Two-call pattern for the blob: pass bytes = null to get the size
+/// in required_size; offsets and present are filled on every call.
+#[no_mangle]
+pub extern "C" fn fon_dump_extract_string(
+    dump: *mut c_void,
+    key: *const c_char,
+    offsets: *mut i64,
+    present: *mut u8,
+    length: i64,
+    bytes: *mut u8,
+    bytes_size: i64,
+    required_size: *mut i64,
+    max_threads: i32,
+    error: *mut FonError,
+) -> i32 {
+    // offsets always holds length + 1 entries and offsets[0] is written even for an empty dump
+    if offsets.is_null() || required_size.is_null() || bytes_size < 0 {
+        set_error(error, FON_ERROR_INVALID_ARGUMENT, "Invalid argument");
+        return FON_ERROR_INVALID_ARGUMENT;
+    }
+    let (rows, key) = match unsafe { extract_args(dump, key, false, length, error) } {
+        Ok(args) => args,
+        Err(code) => return code,
+    };
+    let offsets = unsafe { slice::from_raw_parts_mut(offsets, rows.len() + 1) };
+    let mut present = if present.is_null() { None } else { Some(unsafe { slice::from_raw_parts_mut(present, rows.len()) }) };
+    let threads = extract_threads(max_threads, rows.len());
+
+    // Pass 1: lengths into offsets[1..], in parallel; then an in-place prefix sum
+    for_each_row_chunk(&rows, &mut offsets[1..], present.as_deref_mut(), threads, |rows, lengths, mut present| {
+        for (i, row) in rows.iter().enumerate() {
+            let text = match row.get(key) {
+                Some(FonValue::String(s)) => Some(s),
+                _ => None,
+            };
+            lengths[i] = text.map_or(0, |s| s.len() as i64);
+            if let Some(p) = present.as_deref_mut() {
+                p[i] = text.is_some() as u8;
+            }
+        }
+    });
+    offsets[0] = 0;
+    for i in 1..offsets.len() {
+        offsets[i] += offsets[i - 1];
+    }
+    let total = offsets[rows.len()];
+    unsafe { *required_size = total };
+    if bytes.is_null() || bytes_size < total {
+        return FON_OK;
+    }
+
+    // Pass 2: copy. Consecutive rows own consecutive ranges, so the blob splits per chunk
+    let mut blob = unsafe { slice::from_raw_parts_mut(bytes, total as usize) };
+    let size = ((rows.len() + threads - 1) / threads).max(1);
+    let offsets = &*offsets;
+    let mut parts = Vec::with_capacity(threads);
+    for (chunk, rows) in rows.chunks(size).enumerate() {
+        let first = chunk * size;
+        let start = offsets[first];
+        let end = offsets[first + rows.len()];
+        let (part, rest) = std::mem::take(&mut blob).split_at_mut((end - start) as usize);
+        blob = rest;
+        parts.push((first, start, rows, part));
+    }
+    let copy = |(first, start, rows, part): (usize, i64, &[&FonCollection], &mut [u8])| {
+        for (i, row) in rows.iter().enumerate() {
+            if let Some(FonValue::String(s)) = row.get(key) {
+                let at = (offsets[first + i] - start) as usize;
+                part[at..at + s.len()].copy_from_slice(s.as_bytes());
+            }
+        }
+    };
+    if threads <= 1 {
+        parts.into_iter().for_each(copy);
+    } else {
+        parts.into_par_iter().for_each(copy);
+    }
+    FON_OK
+}
@@ -0,0 +1,363 @@
+// Z85 kernels for RawData, the native counterpart of FON/Types/Z85.cs.
+//
+// Text layout is the one the managed RawData uses: 5 chars per big-endian 4-byte block, a partial
+// last block is zero-padded and followed by a marker char '1'..'3' holding the padding.
+// On x86_64 with SSSE3, 16 blocks (64 bytes / 80 chars) are handled per iteration: division by 85
+// is a widening multiply-shift, alphabet mapping and validation are 16-byte table-row lookups.
+// Everything else, and any run holding an invalid char, goes through the scalar code.
+
+const ALPHABET: &[u8; 85] = b"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+const DECODE: [u8; 128] = build_decode();
+
+#[allow(dead_code)]
+const VECTOR_BLOCKS: usize = 16;
+
+
+const fn build_decode() -> [u8; 128] {
+    let mut table = [255u8; 128];
+    let mut i = 0;
+    while i < ALPHABET.len() {
+        table[ALPHABET[i] as usize] = i as u8;
+        i += 1;
+    }
+    table
+}
+
+
+/// Length of the Z85 text for `length` bytes, marker included.
+pub fn encoded_len(length: usize) -> usize {
+    let blocks = length.div_ceil(4);
+    blocks * 5 + usize::from(length % 4 != 0)
+}
+
+
+/// Upper bound of the decoded length of `encoded`; [`decode`] returns the exact count.
+pub fn decoded_len(encoded: &[u8]) -> usize {
+    let (blocks, removed) = split_padding(encoded);
+    (blocks.len() / 5 * 4).saturating_sub(removed)
+}
+
+
+/// Encodes `input` into `output`, which must hold [`encoded_len`] bytes. Returns the bytes written.
+pub fn encode(input: &[u8], output: &mut [u8]) -> usize {
+    assert!(output.len() >= encoded_len(input.len()), "Z85 output buffer too small");
+
+    let full_blocks = input.len() / 4;
+    let done = encode_vector(input, output, full_blocks / VECTOR_BLOCKS);
+
+    let mut write_pos = done * 5;
+    for i in done..full_blocks {
+        let value = u32::from_be_bytes(input[i * 4..i * 4 + 4].try_into().unwrap());
+        encode_block(value, &mut output[write_pos..write_pos + 5]);
+        write_pos += 5;
+    }
+
+    let remaining = input.len() % 4;
+    if remaining > 0 {
+        let mut last = [0u8; 4];
+        last[..remaining].copy_from_slice(&input[full_blocks * 4..]);
+        encode_block(u32::from_be_bytes(last), &mut output[write_pos..write_pos + 5]);
+        write_pos += 5;
+
+        output[write_pos] = b'0' + (4 - remaining) as u8;
+        write_pos += 1;
+    }
+    write_pos
+}
+
+
+/// Decodes `input` (marker included) into `output`, which must hold [`decoded_len`] + 4 bytes.
+/// Returns the bytes written, or a message naming the first invalid char.
+pub fn decode(input: &[u8], output: &mut [u8]) -> Result<usize, String> {
+    let (blocks, removed) = split_padding(input);
+    let block_count = blocks.len() / 5;
+    assert!(output.len() >= block_count * 4, "Z85 output buffer too small");
+
+    let done = decode_vector(blocks, output, block_count / VECTOR_BLOCKS);
+
+    let mut write_pos = done * 4;
+    let mut i = done * 5;
+    while i + 5 <= blocks.len() {
+        let mut value: u32 = 0;
+        for (j, &c) in blocks[i..i + 5].iter().enumerate() {
+            let digit = if c < 128 { DECODE[c as usize] } else { 255 };
+            if digit == 255 {
+                return Err(format!("Invalid Z85 character at position {}", i + j));
+            }
+            value = value.wrapping_mul(85).wrapping_add(digit as u32);
+        }
+        output[write_pos..write_pos + 4].copy_from_slice(&value.to_be_bytes());
+        write_pos += 4;
+        i += 5;
+    }
+    Ok(write_pos.saturating_sub(removed))
+}
+
+
+fn split_padding(encoded: &[u8]) -> (&[u8], usize) {
+    match encoded.last() {
+        Some(&last) if (b'1'..=b'3').contains(&last) => (&encoded[..encoded.len() - 1], (last - b'0') as usize),
+        _ => (encoded, 0),
+    }
+}
+
+
+#[inline(always)]
+fn encode_block(mut value: u32, output: &mut [u8]) {
+    for j in (1..5).rev() {
+        output[j] = ALPHABET[(value % 85) as usize];
+        value /= 85;
+    }
+    output[0] = ALPHABET[value as usize];
+}
+
+
+// ==================== SSSE3 ====================
+
+#[cfg(target_arch = "x86_64")]
+fn encode_vector(input: &[u8], output: &mut [u8], iterations: usize) -> usize {
+    if iterations == 0 || !is_x86_feature_detected!("ssse3") {
+        return 0;
+    }
+    assert!(input.len() >= iterations * VECTOR_BLOCKS * 4 && output.len() >= iterations * VECTOR_BLOCKS * 5);
+    unsafe { ssse3::encode(input, output, iterations) }
+    iterations * VECTOR_BLOCKS
+}
+
+
+#[cfg(target_arch = "x86_64")]
+fn decode_vector(input: &[u8], output: &mut [u8], iterations: usize) -> usize {
+    if iterations == 0 || !is_x86_feature_detected!("ssse3") {
+        return 0;
+    }
+    assert!(input.len() >= iterations * VECTOR_BLOCKS * 5 && output.len() >= iterations * VECTOR_BLOCKS * 4);
+    unsafe { ssse3::decode(input, output, iterations) * VECTOR_BLOCKS }
+}
+
+
+#[cfg(not(target_arch = "x86_64"))]
+fn encode_vector(_input: &[u8], _output: &mut [u8], _iterations: usize) -> usize {
+    0
+}
+
+
+#[cfg(not(target_arch = "x86_64"))]
+fn decode_vector(_input: &[u8], _output: &mut [u8], _iterations: usize) -> usize {
+    0
+}
+
+
+#[cfg(target_arch = "x86_64")]
+mod ssse3 {
+    use std::arch::x86_64::*;
+
+    use super::{ALPHABET, DECODE, VECTOR_BLOCKS};
+
+    /// ceil(2^38 / 85): (v * DIV85_MAGIC) >> 38 == v / 85 for every u32.
+    const DIV85_MAGIC: i64 = 0xC0C0C0C1;
+
+    const BYTE_SWAP: [u8; 16] = [3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12];
+
+    // Byte shuffles between "block b, digit j at 5b + j" (text) and "lane b" (one block per u32),
+    // the same tables Z85.cs builds. 0x80 yields zero.
+    const PACK: [[[u8; 16]; 5]; 2] = build_pack();
+    const UNPACK: [[[u8; 16]; 5]; 2] = build_unpack();
+
+    const fn build_pack() -> [[[u8; 16]; 5]; 2] {
+        let mut rows = [[[0x80u8; 16]; 5]; 2];
+        let mut j = 0;
+        while j < 5 {
+            let mut b = 0;
+            while b < 4 {
+                let text = 5 * b + j;
+                if text < 16 {
+                    rows[0][j][text] = (4 * b) as u8;
+                } else {
+                    rows[1][j][text - 16] = (4 * b) as u8;
+                }
+                b += 1;
+            }
+            j += 1;
+        }
+        rows
+    }
+
+    const fn build_unpack() -> [[[u8; 16]; 5]; 2] {
+        let mut rows = [[[0x80u8; 16]; 5]; 2];
+        let mut j = 0;
+        while j < 5 {
+            let mut b = 0;
+            while b < 4 {
+                let text = 5 * b + j;
+                if text < 16 {
+                    rows[0][j][4 * b] = text as u8;
+                } else {
+                    rows[1][j][4 * b] = (text - 4) as u8;
+                }
+                b += 1;
+            }
+            j += 1;
+        }
+        rows
+    }
+
+
+    #[inline(always)]
+    unsafe fn load(bytes: &[u8]) -> __m128i {
+        _mm_loadu_si128(bytes.as_ptr() as *const __m128i)
+    }
+
+
+    /// 128-entry table as 8 rows of 16; `lookup` maps bytes below 16 * `rows` and zeroes the rest.
+    struct ByteTable([__m128i; 8]);
+
+    impl ByteTable {
+        #[inline(always)]
+        unsafe fn new(table: &[u8; 128]) -> Self {
+            let mut rows = [_mm_setzero_si128(); 8];
+            for (r, row) in rows.iter_mut().enumerate() {
+                *row = load(&table[r * 16..]);
+            }
+            ByteTable(rows)
+        }
+
+        // pshufb looks at the low nibble unless bit 7 is set. Saturating +0x70 keeps 0-15 as
+        // 0x70-0x7F and pushes everything else (including rows below, wrapped around) to 0x80 and up
+        #[inline(always)]
+        unsafe fn lookup(&self, mut index: __m128i, rows: usize) -> __m128i {
+            let bias = _mm_set1_epi8(0x70);
+            let row = _mm_set1_epi8(16);
+            let mut result = _mm_shuffle_epi8(self.0[0], _mm_adds_epu8(index, bias));
+            for r in 1..rows {
+                index = _mm_sub_epi8(index, row);
+                result = _mm_or_si128(result, _mm_shuffle_epi8(self.0[r], _mm_adds_epu8(index, bias)));
+            }
+            result
+        }
+    }
+
+
+    /// Per-lane value / 85.
+    #[inline(always)]
+    unsafe fn div85(value: __m128i) -> __m128i {
+        let magic = _mm_set1_epi64x(DIV85_MAGIC);
+        let even = _mm_srli_epi64(_mm_mul_epu32(value, magic), 38);
+        let odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(value, 32), magic), 38);
+        _mm_or_si128(even, _mm_slli_epi64(odd, 32))
+    }
+
+
+    /// Per-lane value * 85 (SSSE3 has no 32-bit multiply).
+    #[inline(always)]
+    unsafe fn times85(value: __m128i) -> __m128i {
+        let x4 = _mm_slli_epi32(value, 2);
+        let x16 = _mm_slli_epi32(value, 4);
+        let x64 = _mm_slli_epi32(value, 6);
+        _mm_add_epi32(_mm_add_epi32(value, x4), _mm_add_epi32(x16, x64))
+    }
+
+
+    #[target_feature(enable = "ssse3")]
+    pub unsafe fn encode(input: &[u8], output: &mut [u8], iterations: usize) {
+        let byte_swap = load(&BYTE_SWAP);
+        let pack: [[__m128i; 5]; 2] = [0, 1].map(|h| [0, 1, 2, 3, 4].map(|j| load(&PACK[h][j])));
+
+        let mut alphabet = [0u8; 128];
+        alphabet[..ALPHABET.len()].copy_from_slice(ALPHABET);
+        let table = ByteTable::new(&alphabet);
+
+        // Digits of 16 blocks in text order, plus room for the last group's full-width tail store
+        let mut digits = [0u8; VECTOR_BLOCKS * 5 + 12];
+
+        for iteration in 0..iterations {
+            let source = &input[iteration * VECTOR_BLOCKS * 4..];
+
+            for group in 0..4 {
+                let value = _mm_shuffle_epi8(load(&source[group * 16..]), byte_swap);
+
+                let q1 = div85(value);
+                let q2 = div85(q1);
+                let q3 = div85(q2);
+                let q4 = div85(q3);
+                let d = [
+                    q4,
+                    _mm_sub_epi32(q3, times85(q4)),
+                    _mm_sub_epi32(q2, times85(q3)),
+                    _mm_sub_epi32(q1, times85(q2)),
+                    _mm_sub_epi32(value, times85(q1)),
+                ];
+
+                let mut head = _mm_setzero_si128();
+                let mut tail = _mm_setzero_si128();
+                for j in 0..5 {
+                    head = _mm_or_si128(head, _mm_shuffle_epi8(d[j], pack[0][j]));
+                    tail = _mm_or_si128(tail, _mm_shuffle_epi8(d[j], pack[1][j]));
+                }
+
+                // The tail store is 16 bytes wide, the next group's head overwrites the spare part
+                _mm_storeu_si128(digits[group * 20..].as_mut_ptr() as *mut __m128i, head);
+                _mm_storeu_si128(digits[group * 20 + 16..].as_mut_ptr() as *mut __m128i, tail);
+            }
+
+            let destination = &mut output[iteration * VECTOR_BLOCKS * 5..];
+            for k in 0..5 {
+                let chars = table.lookup(load(&digits[k * 16..]), 6);
+                _mm_storeu_si128(destination[k * 16..].as_mut_ptr() as *mut __m128i, chars);
+            }
+        }
+    }
+
+
+    /// Decodes up to `iterations` * 16 blocks, stopping before the first 80-char run holding an
+    /// invalid char so the scalar loop can report it. Returns the iterations done.
+    #[target_feature(enable = "ssse3")]
+    pub unsafe fn decode(input: &[u8], output: &mut [u8], iterations: usize) -> usize {
+        let byte_swap = load(&BYTE_SWAP);
+        let unpack: [[__m128i; 5]; 2] = [0, 1].map(|h| [0, 1, 2, 3, 4].map(|j| load(&UNPACK[h][j])));
+
+        // Control chars are caught by the index wrapping below 0, the table starts at ' '
+        let mut printable = [0u8; 128];
+        printable[..96].copy_from_slice(&DECODE[32..]);
+        let table = ByteTable::new(&printable);
+        let space = _mm_set1_epi8(32);
+
+        let mut digits = [0u8; VECTOR_BLOCKS * 5];
+
+        for iteration in 0..iterations {
+            let source = &input[iteration * VECTOR_BLOCKS * 5..];
+            let mut invalid = _mm_setzero_si128();
+
+            for k in 0..5 {
+                let chars = load(&source[k * 16..]);
+                let index = _mm_sub_epi8(chars, space);
+                let digit = table.lookup(index, 6);
+                invalid = _mm_or_si128(invalid, _mm_or_si128(digit, _mm_or_si128(index, chars)));
+                _mm_storeu_si128(digits[k * 16..].as_mut_ptr() as *mut __m128i, digit);
+            }
+
+            // Valid digits are below 85; 255 from the table, wrapped indices and non-ASCII bytes set bit 7
+            if _mm_movemask_epi8(invalid) != 0 {
+                return iteration;
+            }
+
+            let destination = &mut output[iteration * VECTOR_BLOCKS * 4..];
+            for group in 0..4 {
+                let head = load(&digits[group * 20..]);
+                let tail = load(&digits[group * 20 + 4..]);
+
+                let mut value = _mm_or_si128(_mm_shuffle_epi8(head, unpack[0][0]), _mm_shuffle_epi8(tail, unpack[1][0]));
+                for j in 1..5 {
+                    let digit = _mm_or_si128(_mm_shuffle_epi8(head, unpack[0][j]), _mm_shuffle_epi8(tail, unpack[1][j]));
+                    value = _mm_add_epi32(times85(value), digit);
+                }
+
+                _mm_storeu_si128(
+                    destination[group * 16..].as_mut_ptr() as *mut __m128i,
+                    _mm_shuffle_epi8(value, byte_swap),
+                );
+            }
+        }
+        iterations
+    }
+}
@@ -10,6 +10,11 @@ namespace FON.Native.Test;
 /// These tests require the native library to be compiled and available.
 /// </summary>
 public class NativeAvailabilityTests {
+    public NativeAvailabilityTests() {
+        NativeBackend.Register();
+    }
+
+
     [Fact]
     public void NativeLibrary_IsAvailable() {
         Assert.True(NativeLoader.IsAvailable, "Native library should be available for these tests");
@@ -35,4 +40,11 @@ public class NativeAvailabilityTests {
         var version = FonAccelerator.Version;
         Assert.NotNull(version);
     }
+
+
+    [Fact]
+    public void FonAccelerator_UsesNativeBackend() {
+        Assert.Same(NativeBackend.Instance, FonAccelerator.Backend);
+        Assert.Equal(NativeLoader.GetVersion(), FonAccelerator.Version);
+    }
 }
@@ -1,5 +1,7 @@
 using System.Text;
+using FON.Core;
 using FON.Native;
+using FON.Types;
 using Xunit;
 
 
@@ -8,7 +10,7 @@ namespace FON.Native.Test;
 
 /// <summary>
 /// Tests for native string/buffer-based serialization and deserialization.
-/// Covers both raw NativeBindings (two-call pattern) and high-level NativeApi helpers.
+/// Covers raw NativeBindings (two-call and owned-buffer patterns) and high-level NativeApi helpers.
 /// </summary>
 public class NativeBufferTests {
     [Fact]
@@ -111,6 +113,49 @@ public class NativeBufferTests {
     }
 
 
+    [Fact]
+    public void SerializeDumpToMemory_MatchesStringOutput_AndFreesOnce() {
+        var dump = NativeBindings.fon_dump_create();
+        try {
+            var error = new FonError();
+            var c = NativeBindings.fon_collection_create();
+            NativeBindings.fon_collection_add_int(c, "n", 7, ref error);
+            NativeBindings.fon_collection_add_string(c, "s", "owned", ref error);
+            NativeBindings.fon_dump_add(dump, 0, c, ref error);
+
+            var owner = NativeApi.SerializeDumpToMemory(dump);
+            Assert.Equal(NativeApi.SerializeDump(dump), Encoding.UTF8.GetString(owner.Memory.Span));
+
+            owner.Dispose();
+            owner.Dispose();
+            Assert.Throws<ObjectDisposedException>(() => owner.Memory.Span.Length);
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void FonBuffer_FreeTwice_IsNoOp() {
+        var c = NativeBindings.fon_collection_create();
+        try {
+            var error = new FonError();
+            NativeBindings.fon_collection_add_int(c, "x", 1, ref error);
+
+            int rc = NativeBindings.fon_serialize_collection_to_owned(c, out FonBuffer buffer, ref error);
+            Assert.Equal(FonResultCode.OK, rc);
+            Assert.NotEqual(IntPtr.Zero, buffer.Data);
+            Assert.True(buffer.Length > 0);
+
+            NativeBindings.fon_buffer_free(ref buffer);
+            Assert.Equal(IntPtr.Zero, buffer.Data);
+            NativeBindings.fon_buffer_free(ref buffer);
+        } finally {
+            NativeBindings.fon_collection_free(c);
+        }
+    }
+
+
     [Fact]
     public void TrySerializeCollection_ReturnsFalseWhenBufferTooSmall_AndWritesRequiredSize() {
         var c = NativeBindings.fon_collection_create();
@@ -160,4 +205,85 @@ public class NativeBufferTests {
     public void DeserializeDump_OnInvalidInput_ThrowsFonNativeException() {
         Assert.Throws<FonNativeException>(() => NativeApi.DeserializeDump("key=garbage_without_type_separator"));
     }
+
+
+    [Fact]
+    public void RecordCursor_TryReadNext_YieldsRecordsWithLineIds() {
+        var error = new FonError();
+        using var cursor = new NativeRecordCursor(Encoding.UTF8.GetBytes("a=i:1\r\n\na=i:3\n"));
+
+        Assert.True(cursor.TryReadNext(out ulong id0, out IntPtr c0));
+        Assert.True(cursor.TryReadNext(out ulong id2, out IntPtr c2));
+        try {
+            Assert.Equal(0UL, id0);
+            Assert.Equal(2UL, id2);
+            NativeBindings.fon_collection_get_int(c2, "a", out int a, ref error);
+            Assert.Equal(3, a);
+        } finally {
+            NativeBindings.fon_collection_free(c0);
+            NativeBindings.fon_collection_free(c2);
+        }
+
+        Assert.False(cursor.TryReadNext(out _, out _));
+    }
+
+
+    [Fact]
+    public void RecordCursor_ReadBatch_SplitsBufferIntoConsecutiveDumps() {
+        var text = string.Concat(Enumerable.Range(0, 10).Select(i => $"n=i:{i}\n"));
+        using var cursor = new NativeRecordCursor(Encoding.UTF8.GetBytes(text));
+
+        var seen = new List<int>();
+        IntPtr dump;
+        while ((dump = cursor.ReadBatch(4, out ulong firstId)) != IntPtr.Zero) {
+            try {
+                var size = NativeBindings.fon_dump_size(dump);
+                for (ulong k = 0; k < (ulong)size; k++) {
+                    var error = new FonError();
+                    NativeBindings.fon_collection_get_int(NativeBindings.fon_dump_get(dump, k), "n", out int n, ref error);
+                    Assert.Equal((int)(firstId + k), n);
+                    seen.Add(n);
+                }
+            } finally {
+                NativeBindings.fon_dump_free(dump);
+            }
+        }
+
+        Assert.Equal(Enumerable.Range(0, 10), seen);
+    }
+
+
+    [Fact]
+    public void DeserializeCollection_WithReadOptions_KeepsOnlySelectedKeys() {
+        var utf8 = Encoding.UTF8.GetBytes("id=i:7,skip=s:\"big ]} text\",meta=o:{owner=i:5,other=s:\"x\"},name=s:\"last\"");
+        IntPtr c = NativeApi.DeserializeCollection(utf8, new FonReadOptions("id", "meta.owner"));
+        try {
+            Assert.Equal(2, NativeBindings.fon_collection_size(c));
+
+            var error = new FonError();
+            NativeBindings.fon_collection_get_int(c, "id", out int id, ref error);
+            Assert.Equal(7, id);
+
+            IntPtr meta = NativeBindings.fon_collection_get_collection(c, "meta", ref error);
+            Assert.Equal(1, NativeBindings.fon_collection_size(meta));
+            NativeBindings.fon_collection_get_int(meta, "owner", out int owner, ref error);
+            Assert.Equal(5, owner);
+        } finally {
+            NativeBindings.fon_collection_free(c);
+        }
+    }
+
+
+    [Fact]
+    public void Z85_NativeKernel_MatchesRawData() {
+        var data = new byte[1001];
+        new Random(85).NextBytes(data);
+
+        byte[] encoded = NativeApi.Z85Encode(data);
+        Assert.Equal(new RawData(data.ToArray()).Pack().encoded, Encoding.ASCII.GetString(encoded));
+        Assert.Equal(data, NativeApi.Z85Decode(encoded));
+
+        encoded[200] = (byte)'"';
+        Assert.Throws<FonNativeException>(() => NativeApi.Z85Decode(encoded));
+    }
 }
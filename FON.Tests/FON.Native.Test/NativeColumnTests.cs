@@ -0,0 +1,166 @@
+using FON.Native;
+using Xunit;
+
+namespace FON.Native.Test;
+
+
+/// <summary>
+/// Tests for extracting one key of every record into a managed array in one native call.
+/// </summary>
+public class NativeColumnTests {
+    // Large enough for the native side to split the rows over several threads
+    private const int Rows = 50_000;
+
+
+    private static IntPtr CreateDump() {
+        var builder = new NativeDumpBuilder(Rows);
+        for (int i = 0; i < Rows; i++) {
+            // Ids are not dense: rows come back in id order, which ExtractIds reports
+            builder.BeginRecord((ulong)i * 3);
+            if (i % 10 != 0) {
+                builder.Add("price", i * 0.5);
+            }
+            if (i % 7 == 0) {
+                builder.Add("count", "not a number");
+            } else {
+                builder.Add("count", i);
+            }
+            builder.Add("flag", i % 2 == 0);
+            if (i % 5 != 0) {
+                builder.Add("name", "row " + i);
+            }
+            builder.EndRecord();
+        }
+        return builder.CreateDump();
+    }
+
+
+
+    [Fact]
+    public void ExtractColumn_Double_FillsValuesAndPresence() {
+        var dump = CreateDump();
+        try {
+            var values = new double[Rows];
+            var present = new bool[Rows];
+            NativeApi.ExtractColumn(dump, "price", values, present, maxThreads: 4);
+
+            for (int i = 0; i < Rows; i++) {
+                Assert.Equal(i % 10 != 0, present[i]);
+                if (present[i]) {
+                    Assert.Equal(i * 0.5, values[i]);
+                } else {
+                    Assert.True(double.IsNaN(values[i]));
+                }
+            }
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void ExtractColumn_IntLongBool_HandleMistypedRowsAndWidening() {
+        var dump = CreateDump();
+        try {
+            var ints = new int[Rows];
+            var longs = new long[Rows];
+            var flags = new bool[Rows];
+            var present = new bool[Rows];
+
+            NativeApi.ExtractColumn(dump, "count", ints, present);
+            NativeApi.ExtractColumn(dump, "count", longs);
+            NativeApi.ExtractColumn(dump, "flag", flags, maxThreads: 1);
+
+            for (int i = 0; i < Rows; i++) {
+                int expected = i % 7 == 0 ? 0 : i;
+                Assert.Equal(i % 7 != 0, present[i]);
+                Assert.Equal(expected, ints[i]);
+                Assert.Equal(expected, longs[i]);
+                Assert.Equal(i % 2 == 0, flags[i]);
+            }
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void ExtractIds_AndStringColumn_FollowIdOrder() {
+        var dump = CreateDump();
+        try {
+            var ids = new ulong[Rows];
+            NativeApi.ExtractIds(dump, ids);
+            var names = NativeApi.ExtractStringColumn(dump, "name", maxThreads: 3);
+
+            Assert.Equal(Rows, names.Length);
+            for (int i = 0; i < Rows; i++) {
+                Assert.Equal((ulong)i * 3, ids[i]);
+                Assert.Equal(i % 5 != 0 ? "row " + i : null, names[i]);
+            }
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void Extract_IdsAddedOutOfOrder_ParallelMatchesSequential() {
+        // Ids shuffled as added; every column must still follow the ids ExtractIds reports
+        var added = Enumerable.Range(0, Rows).Select(i => (ulong)i * 3).ToArray();
+        new Random(17).Shuffle(added);
+        var builder = new NativeDumpBuilder(Rows);
+        foreach (var id in added) {
+            builder.BeginRecord(id);
+            builder.Add("count", (long)id);
+            if (id % 4 != 0) {
+                builder.Add("name", "row " + id);
+            }
+            builder.EndRecord();
+        }
+
+        var dump = builder.CreateDump();
+        try {
+            var ids = new ulong[Rows];
+            NativeApi.ExtractIds(dump, ids);
+            Assert.Equal(added.Order(), ids);
+
+            var sequential = new long[Rows];
+            var parallel = new long[Rows];
+            NativeApi.ExtractColumn(dump, "count", sequential, maxThreads: 1);
+            NativeApi.ExtractColumn(dump, "count", parallel, maxThreads: 8);
+            Assert.Equal(sequential, parallel);
+            Assert.Equal(ids.Select(id => (long)id), parallel);
+
+            var names = NativeApi.ExtractStringColumn(dump, "name", maxThreads: 1);
+            Assert.Equal(names, NativeApi.ExtractStringColumn(dump, "name", maxThreads: 8));
+            Assert.Equal(ids.Select(id => id % 4 != 0 ? "row " + id : null), names);
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public unsafe void ExtractString_NullOffsets_RejectedEvenForEmptyDump() {
+        var dump = NativeBindings.fon_dump_create();
+        try {
+            FonError error = default;
+            var rc = NativeBindings.fon_dump_extract_string(dump, "name", null, null, 0, null, 0, out long required, 0, ref error);
+            Assert.Equal(FonResultCode.InvalidArgument, rc);
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void ExtractColumn_ShortOutput_Throws() {
+        var dump = CreateDump();
+        try {
+            Assert.Throws<FonNativeException>(() => NativeApi.ExtractColumn(dump, "price", new double[Rows - 1]));
+            Assert.Throws<ArgumentException>(() => NativeApi.ExtractColumn(dump, "price", new double[Rows], new bool[1]));
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+}
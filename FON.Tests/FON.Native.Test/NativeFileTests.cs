@@ -184,4 +184,24 @@ public class NativeFileTests : IDisposable {
         Assert.Equal(100, loadedItems[0].Get<int>("id"));
         Assert.Equal(200, loadedItems[1].Get<int>("id"));
     }
+
+
+    [Fact]
+    public async Task CrossImpl_ReadOptions_RecordWithoutSelectedKeys_KeptByBoth() {
+        var filePath = Path.Combine(_testDir, "projected.fon");
+        await File.WriteAllTextAsync(filePath, "id=i:1,name=s:\"a\"\nname=s:\"no id\",meta=o:{id=i:9}\n\nid=i:3\n");
+        var file = new FileInfo(filePath);
+        var options = new global::FON.Core.FonReadOptions("id");
+
+        var managed = await global::FON.Core.Fon.DeserializeFromFileAsync(file, options: options);
+        var native = NativeBackend.Instance.TryDeserializeFromFile(file, options, 1);
+
+        Assert.NotNull(native);
+        Assert.Equal(3, managed.Count);
+        Assert.Equal(managed.Count, native.Count);
+        foreach (var (id, record) in managed) {
+            Assert.Equal(global::FON.Core.Fon.SerializeToString(record), global::FON.Core.Fon.SerializeToString(native[id]));
+        }
+        Assert.Equal(0, native[1].Count);
+    }
 }
@@ -0,0 +1,189 @@
+using System.Text;
+using FON.Native;
+using FON.Types;
+using Xunit;
+
+namespace FON.Native.Test;
+
+
+/// <summary>
+/// Tests for the packed batch API: building native dumps and reading them back in one call.
+/// </summary>
+public class NativePackedTests {
+    private static FonCollection CreateRecord(int id) {
+        var owner = new FonCollection { { "name", "owner " + id }, { "score", 0.5 } };
+        return new FonCollection {
+            { "id", id },
+            { "ticks", 9_000_000_000L + id },
+            { "ratio", 1.5f },
+            { "active", id % 2 == 0 },
+            { "label", "ünïcode, \"quoted\"" },
+            { "ints", new List<int> { 1, -2, id } },
+            { "floats", new List<float> { 0.25f } },
+            { "owner", owner },
+            { "items", new List<FonCollection> { new() { { "n", 1 } }, new() { { "n", 2 }, { "child", new FonCollection { { "deep", id } } } } } }
+        };
+    }
+
+
+    private static void AssertEqual(FonCollection expected, FonCollection actual) {
+        Assert.Equal(expected.Count, actual.Count);
+        foreach (var (key, value) in expected) {
+            var other = actual.Get(key);
+            switch (value) {
+                case FonCollection nested:
+                    AssertEqual(nested, Assert.IsType<FonCollection>(other));
+                    break;
+                case List<FonCollection> list:
+                    var otherList = Assert.IsType<List<FonCollection>>(other);
+                    Assert.Equal(list.Count, otherList.Count);
+                    for (int i = 0; i < list.Count; i++) {
+                        AssertEqual(list[i], otherList[i]);
+                    }
+                    break;
+                default:
+                    Assert.Equal(value, other);
+                    break;
+            }
+        }
+    }
+
+
+
+    [Fact]
+    public void TryCreateDump_ToManagedDump_RoundTrips() {
+        var dump = new FonDump();
+        for (int i = 0; i < 100; i++) {
+            dump.Add((ulong)i, CreateRecord(i));
+        }
+
+        Assert.True(NativeApi.TryCreateDump(dump, out IntPtr handle));
+        try {
+            Assert.Equal(100, NativeBindings.fon_dump_size(handle));
+
+            var loaded = NativeApi.ToManagedDump(handle);
+            Assert.Equal(dump.Count, loaded.Count);
+            foreach (var (id, record) in dump) {
+                AssertEqual(record, loaded.Get(id));
+            }
+        } finally {
+            NativeBindings.fon_dump_free(handle);
+        }
+    }
+
+
+    [Fact]
+    public void Builder_RecordsAreReadableThroughFieldGetters() {
+        var builder = new NativeDumpBuilder();
+        builder.BeginRecord(7);
+        builder.Add("id", 42);
+        builder.Add("name", "packed");
+        builder.BeginObject("inner");
+        builder.Add("x", 3);
+        builder.EndObject();
+        builder.EndRecord();
+        Assert.Equal(1, builder.RecordCount);
+
+        var dump = builder.CreateDump();
+        try {
+            var error = new FonError();
+            var record = NativeBindings.fon_dump_get(dump, 7);
+            NativeBindings.fon_collection_get_int(record, "id", out int id, ref error);
+            Assert.Equal(42, id);
+
+            var buf = new byte[16];
+            NativeBindings.fon_collection_get_string(record, "name", buf, buf.Length, ref error);
+            Assert.Equal("packed", Encoding.UTF8.GetString(buf, 0, Array.IndexOf(buf, (byte)0)));
+
+            var inner = NativeBindings.fon_collection_get_collection(record, "inner", ref error);
+            NativeBindings.fon_collection_get_int(inner, "x", out int x, ref error);
+            Assert.Equal(3, x);
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void ToManagedCollection_ReadsDumpEntry() {
+        var dump = new FonDump();
+        dump.Add(3, CreateRecord(3));
+
+        Assert.True(NativeApi.TryCreateDump(dump, out IntPtr handle));
+        try {
+            var collection = NativeApi.ToManagedCollection(NativeBindings.fon_dump_get(handle, 3));
+            AssertEqual(dump.Get(3), collection);
+        } finally {
+            NativeBindings.fon_dump_free(handle);
+        }
+    }
+
+
+    [Fact]
+    public unsafe void Unpack_IdsAddedOutOfOrder_ComeBackInIdOrder() {
+        ulong[] added = [40, 3, 17, 0, 1000, 25, 8];
+        var builder = new NativeDumpBuilder();
+        foreach (var id in added) {
+            builder.BeginRecord(id);
+            builder.Add("id", (long)id);
+            builder.EndRecord();
+        }
+
+        var dump = builder.CreateDump();
+        try {
+            var error = new FonError();
+            Assert.Equal(FonResultCode.OK, NativeBindings.fon_dump_unpack(dump, out FonPackedBatch batch, ref error));
+            try {
+                var records = new ReadOnlySpan<FonPackedRecord>((void*)batch.Records, checked((int)batch.RecordCount));
+                Assert.Equal(added.Order(), records.ToArray().Select(r => r.Id));
+            } finally {
+                NativeBindings.fon_packed_batch_free(ref batch);
+            }
+
+            var loaded = NativeApi.ToManagedDump(dump);
+            foreach (var id in added) {
+                Assert.Equal((long)id, loaded.Get(id).Get<long>("id"));
+            }
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void TryAdd_UnsupportedValue_AddsNothing() {
+        var builder = new NativeDumpBuilder();
+        Assert.True(builder.TryAdd(0, new FonCollection { { "id", 1 } }));
+
+        var unsupported = new FonCollection {
+            { "id", 2 },
+            { "owner", new FonCollection { { "name", "x" }, { "level", (byte)3 } } }
+        };
+        Assert.False(builder.TryAdd(1, unsupported));
+        Assert.Equal(1, builder.RecordCount);
+
+        var dump = builder.CreateDump();
+        try {
+            var loaded = NativeApi.ToManagedDump(dump);
+            Assert.Equal(1, loaded.Count);
+            Assert.Equal(1, loaded.Get(0).Get<int>("id"));
+        } finally {
+            NativeBindings.fon_dump_free(dump);
+        }
+    }
+
+
+    [Fact]
+    public void Builder_Misuse_Throws() {
+        var builder = new NativeDumpBuilder();
+        Assert.Throws<InvalidOperationException>(() => builder.Add("x", 1));
+        Assert.Throws<InvalidOperationException>(() => builder.EndObject());
+
+        builder.BeginRecord(0);
+        Assert.Throws<InvalidOperationException>(() => builder.BeginRecord(1));
+        Assert.Throws<InvalidOperationException>(() => builder.CreateDump());
+
+        builder.BeginObjectArray("items");
+        Assert.Throws<InvalidOperationException>(() => builder.Add("x", 1));
+    }
+}
@@ -42,6 +42,37 @@ public class NativeSerializationTests {
     }
 
 
+    [Fact]
+    public void NativeCollection_GetWithUtf8Key_MatchesStringKey() {
+        var collection = NativeBindings.fon_collection_create();
+        var inner = NativeBindings.fon_collection_create();
+        var error = new FonError();
+
+        NativeBindings.fon_collection_add_int(collection, "id", 7, ref error);
+        NativeBindings.fon_collection_add_double(collection, "ratio", 0.5, ref error);
+        NativeBindings.fon_collection_add_bool(inner, "flag", 1, ref error);
+        NativeBindings.fon_collection_add_collection(collection, "inner", inner, ref error);
+
+        Assert.Equal(FonResultCode.OK, NativeBindings.fon_collection_get_int(collection, "id"u8, out int id, ref error));
+        Assert.Equal(7, id);
+        Assert.Equal(FonResultCode.OK, NativeBindings.fon_collection_get_double(collection, "ratio"u8, out double ratio, ref error));
+        Assert.Equal(0.5, ratio);
+
+        var child = NativeBindings.fon_collection_get_collection(collection, "inner"u8, ref error);
+        Assert.Equal(FonResultCode.OK, NativeBindings.fon_collection_get_bool(child, "flag"u8, out int flag, ref error));
+        Assert.Equal(1, flag);
+
+        // A span is not NUL-terminated: only the sliced part of the key may be looked up
+        Assert.Equal(FonResultCode.OK, NativeBindings.fon_collection_get_int(collection, "idle"u8[..2], out id, ref error));
+
+        var missing = new FonError();
+        Assert.NotEqual(FonResultCode.OK, NativeBindings.fon_collection_get_int(collection, "nope"u8, out _, ref missing));
+        Assert.False(string.IsNullOrEmpty(missing.Message));
+
+        NativeBindings.fon_collection_free(collection);
+    }
+
+
     [Fact]
     public void NativeCollection_AddAndGetLong() {
         var collection = NativeBindings.fon_collection_create();
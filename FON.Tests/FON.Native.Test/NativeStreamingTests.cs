@@ -0,0 +1,134 @@
+using FON.Core;
+using FON.Native;
+using FON.Types;
+using Xunit;
+
+namespace FON.Native.Test;
+
+
+/// <summary>
+/// Tests for the streaming file handles: batched native reads and incremental native writes.
+/// </summary>
+public class NativeStreamingTests : IDisposable {
+    private readonly string testDir;
+
+    public NativeStreamingTests() {
+        testDir = Path.Combine(Path.GetTempPath(), $"fon_native_stream_{Guid.NewGuid():N}");
+        Directory.CreateDirectory(testDir);
+    }
+
+
+    public void Dispose() {
+        if (Directory.Exists(testDir)) {
+            Directory.Delete(testDir, recursive: true);
+        }
+    }
+
+
+    [Fact]
+    public async Task NativeFileWriter_ReadRecordsAsync_RoundTripsAcrossBatches() {
+        var file = new FileInfo(Path.Combine(testDir, "records.fon"));
+
+        await using (var writer = NativeFileWriter.Create(file, batchSize: 7)) {
+            var record = new FonCollection();
+            for (int i = 0; i < 100; i++) {
+                // The writer copies each record, so one instance can be reused
+                record.Remove("id");
+                record.Remove("name");
+                record.Add("id", i);
+                record.Add("name", "row " + i);
+                await writer.WriteAsync(record);
+            }
+            Assert.Equal(100, writer.Count);
+        }
+
+        var managed = await Fon.DeserializeFromFileAsync(file);
+        Assert.Equal(100, managed.Count);
+
+        int expected = 0;
+        await foreach (var (id, record) in NativeApi.ReadRecordsAsync(file, batchSize: 9, maxThreads: 2)) {
+            Assert.Equal((ulong)expected, id);
+            Assert.Equal(expected, record.Get<int>("id"));
+            Assert.Equal("row " + expected, record.Get<string>("name"));
+            expected++;
+        }
+        Assert.Equal(100, expected);
+    }
+
+
+    [Fact]
+    public async Task NativeFileWriter_Append_ContinuesUnterminatedFile() {
+        var file = new FileInfo(Path.Combine(testDir, "append.fon"));
+        File.WriteAllText(file.FullName, "id=i:0");
+
+        await using (var writer = NativeFileWriter.Create(file, append: true)) {
+            await writer.WriteAsync(new FonCollection { { "id", 1 } });
+        }
+
+        var lines = File.ReadAllLines(file.FullName);
+        Assert.Equal(["id=i:0", "id=i:1"], lines);
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_EmptyFile_YieldsNothing() {
+        var file = new FileInfo(Path.Combine(testDir, "empty.fon"));
+        File.WriteAllBytes(file.FullName, []);
+
+        int count = 0;
+        await foreach (var _ in NativeApi.ReadRecordsAsync(file)) {
+            count++;
+        }
+        Assert.Equal(0, count);
+
+        using var reader = new NativeFileReader(file);
+        Assert.Equal(IntPtr.Zero, reader.ReadBatch(10, out ulong firstId));
+        Assert.Equal(0UL, firstId);
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_BlankLineBatch_KeepsReading() {
+        var file = new FileInfo(Path.Combine(testDir, "blank.fon"));
+        File.WriteAllText(file.FullName, "id=i:0\n\nid=i:2\n\n\nid=i:5\n");
+
+        var ids = new List<ulong>();
+        await foreach (var (id, record) in NativeApi.ReadRecordsAsync(file, batchSize: 1)) {
+            Assert.Equal((int)id, record.Get<int>("id"));
+            ids.Add(id);
+        }
+        Assert.Equal([0UL, 2UL, 5UL], ids);
+
+        using var reader = new NativeFileReader(file);
+        Assert.Single(reader.ReadRecords(1)!);
+        Assert.Empty(reader.ReadRecords(1)!);
+        Assert.Single(reader.ReadRecords(3)!);
+        Assert.Single(reader.ReadRecords(4)!);
+        Assert.Null(reader.ReadRecords(4));
+    }
+
+
+    [Fact]
+    public void OpenMissingPath_Throws() {
+        var missing = new FileInfo(Path.Combine(testDir, "missing", "x.fon"));
+
+        var readError = Assert.Throws<FonNativeException>(() => new NativeFileReader(missing));
+        Assert.Equal(FonResultCode.FileNotFound, readError.Code);
+        var writeError = Assert.Throws<FonNativeException>(() => NativeFileWriter.Create(missing));
+        Assert.Equal(FonResultCode.WriteFailed, writeError.Code);
+    }
+
+
+    [Fact]
+    public void NativeWriter_ClosedUnusedHandle_CreatesEmptyFile() {
+        var path = Path.Combine(testDir, "unused.fon");
+        var error = new FonError();
+
+        var writer = NativeBindings.fon_writer_open(path, 0, ref error);
+        Assert.NotEqual(IntPtr.Zero, writer);
+        Assert.Equal(FonResultCode.InvalidArgument, NativeBindings.fon_writer_append(writer, IntPtr.Zero, ref error));
+        Assert.Equal(FonResultCode.OK, NativeBindings.fon_writer_close(writer, ref error));
+
+        Assert.Equal(0, new FileInfo(path).Length);
+    }
+}
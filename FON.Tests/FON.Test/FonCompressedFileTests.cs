@@ -0,0 +1,128 @@
+using FON.Core;
+using FON.Types;
+using System.IO.Compression;
+using System.Text;
+
+namespace FON.Test;
+
+
+public class FonCompressedFileTests {
+    [Theory]
+    [InlineData(FonCompression.Brotli)]
+    [InlineData(FonCompression.Deflate)]
+    public async Task Compressed_RoundTripsLikeThePlainFile(FonCompression compression) {
+        var plain = new FileInfo(Path.GetTempFileName());
+        var packed = new FileInfo(Path.GetTempFileName());
+        try {
+            // Line numbers skip the left-out ids, as in the plain file
+            var dump = TestDumps.Create(5000, (i, record) => record.Add("scores", new List<double> { i, i * 0.25 }), skip: i => i % 100 == 42);
+            await Fon.SerializeToFileChunkedAsync(dump, plain, chunkSize: 300);
+            await Fon.SerializeToFileCompressedAsync(dump, packed, compression, blockRecords: 300, maxDegreeOfParallelism: 4);
+            Assert.True(new FileInfo(packed.FullName).Length < new FileInfo(plain.FullName).Length / 3);
+
+            var expected = await Fon.DeserializeFromFileAsync(plain);
+            var loaded = await Fon.DeserializeFromFileAutoAsync(packed);
+            Assert.Equal(expected.Count, loaded.Count);
+            foreach (var (id, record) in expected) {
+                Assert.Equal(Fon.SerializeToString(record), Fon.SerializeToString(loaded[id]));
+            }
+
+            var streamed = 0;
+            await foreach (var (id, record) in Fon.ReadRecordsAsync(packed, maxDegreeOfParallelism: 3)) {
+                Assert.Equal(Fon.SerializeToString(expected[id]), Fon.SerializeToString(record));
+                streamed++;
+            }
+            Assert.Equal(expected.Count, streamed);
+
+            // A range across a block boundary only decodes the blocks it touches
+            var ids = new List<ulong>();
+            await foreach (var (id, record) in Fon.ReadRangeAsync(packed, 295, 10)) {
+                Assert.Equal(Fon.SerializeToString(expected[id]), Fon.SerializeToString(record));
+                ids.Add(id);
+            }
+            Assert.Equal(Enumerable.Range(295, 10).Select(i => (ulong)i), ids);
+            Assert.Null(await Fon.ReadRecordAsync(packed, (ulong)expected.Count));
+        } finally {
+            plain.Delete();
+            packed.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task Compressed_EmptyDumpAndCorruptFile() {
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileCompressedAsync(new FonDump(), file);
+            Assert.Equal(0, (await Fon.DeserializeFromFileAutoAsync(file)).Count);
+
+            await Fon.SerializeToFileCompressedAsync(TestDumps.Create(50), file);
+            var bytes = await File.ReadAllBytesAsync(file.FullName);
+            bytes[20] ^= 0xFF;
+            await File.WriteAllBytesAsync(file.FullName, bytes);
+            await Assert.ThrowsAsync<FormatException>(() => Fon.DeserializeFromCompressedFileAsync(file));
+
+            bytes[^1] ^= 0xFF;
+            await File.WriteAllBytesAsync(file.FullName, bytes);
+            await Assert.ThrowsAsync<FormatException>(() => Fon.DeserializeFromCompressedFileAsync(file));
+        } finally {
+            file.Delete();
+        }
+    }
+
+
+
+
+    [Theory]
+    [InlineData(FonCompression.Brotli)]
+    [InlineData(FonCompression.Deflate)]
+    public async Task Compressed_HighEntropyNonAsciiText_RoundTrips(FonCompression compression) {
+        // Random CJK and emoji are mostly bytes >= 0x80: a fixed-Huffman block spends 9 bits on each
+        var random = new Random(1234);
+        var dump = new FonDump();
+        for (int i = 0; i < 400; i++) {
+            var text = new StringBuilder();
+            for (int j = 0; j < 600; j++) {
+                text.Append(j % 7 == 0 ? char.ConvertFromUtf32(0x1F300 + random.Next(0x300)) : ((char)(0x4E00 + random.Next(0x5200))).ToString());
+            }
+            dump.TryAdd((ulong)i, new FonCollection { { "id", i }, { "text", text.ToString() } });
+        }
+
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            foreach (var level in new[] { CompressionLevel.Fastest, CompressionLevel.NoCompression }) {
+                await Fon.SerializeToFileCompressedAsync(dump, file, compression, level, blockRecords: 50);
+                var loaded = await Fon.DeserializeFromFileAutoAsync(file);
+                Assert.Equal(dump.Count, loaded.Count);
+                foreach (var (id, record) in dump) {
+                    Assert.Equal(record.Get<string>("text"), loaded[id].Get<string>("text"));
+                }
+            }
+        } finally {
+            file.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task Compressed_ReadRecordsTyped_RoundTrips() {
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            var dump = new FonDump();
+            for (int i = 0; i < 1000; i++) {
+                dump.TryAdd((ulong)i, FonCollection.Serialize(new GeneratedPoint { X = i, Y = -i }));
+            }
+            await Fon.SerializeToFileCompressedAsync(dump, file, blockRecords: 128);
+
+            var count = 0;
+            await foreach (var (id, point) in Fon.ReadRecordsAsync<GeneratedPoint>(file, maxDegreeOfParallelism: 2)) {
+                Assert.Equal((int)id, point.X);
+                Assert.Equal(-(int)id, point.Y);
+                count++;
+            }
+            Assert.Equal(1000, count);
+        } finally {
+            file.Delete();
+        }
+    }
+}
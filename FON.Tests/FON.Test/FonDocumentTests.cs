@@ -0,0 +1,104 @@
+using System.Text;
+using FON.Core;
+using FON.Types;
+
+namespace FON.Test;
+
+
+public class FonDocumentTests {
+    private const string Line =
+        "id=i:7,price=d:12.5,name=s:\"a, \\\"b\\\"\",flags=b:[1,0],tags=s:[\"x\",\"y\"]," +
+        "owner=o:{name=s:\"Bob\",level=o:{n=l:9000000000}},items=o:[{n=i:1},{n=i:2,child=o:{deep=i:3}}],empty=o:[]";
+
+
+    [Fact]
+    public void Parse_ViewsDecodeLikeTheCollectionParser() {
+        using var document = FonDocument.Parse(Encoding.UTF8.GetBytes("\n" + Line + "\r\n\nid=i:8\n"));
+
+        Assert.Equal(2, document.Count);
+        Assert.Equal(4, document.LineCount);
+        Assert.Equal(1UL, document.GetId(0));
+        Assert.Equal(3UL, document.GetId(1));
+
+        var record = document[0];
+        Assert.Equal(8, record.Count);
+        Assert.Equal(7, record.Get<int>("id"));
+        Assert.Equal(12.5, record.Get<double>("price"));
+        Assert.Equal("a, \"b\"", record.Get<string>("name"));
+        Assert.Equal(new List<bool> { true, false }, record.Get<List<bool>>("flags"));
+        Assert.Equal("[\"x\",\"y\"]", Encoding.UTF8.GetString(record.GetRaw("tags")));
+        Assert.Equal(9_000_000_000L, record.GetObject("owner").GetObject("level").Get<long>("n"));
+        Assert.True(record.TryGetField("price"u8, out var price));
+        Assert.Equal('d', price.TypeCode);
+        Assert.Throws<InvalidCastException>(() => record.Get<long>("id"));
+        Assert.Throws<KeyNotFoundException>(() => record.Get<int>("missing"));
+
+        var items = record.GetObjects("items");
+        Assert.Equal(2, items.Count);
+        Assert.Equal(3, items[1].GetObject("child").Get<int>("deep"));
+        var sum = 0;
+        foreach (var item in items) {
+            sum += item.Get<int>("n");
+        }
+        Assert.Equal(3, sum);
+        Assert.Equal(0, record.GetObjects("empty").Count);
+
+        var keys = new List<string>();
+        foreach (var field in record) {
+            keys.Add(field.Key);
+        }
+        Assert.Equal(["id", "price", "name", "flags", "tags", "owner", "items", "empty"], keys);
+
+        // Materializing matches parsing the same line into a collection
+        var expected = new FonCollection();
+        Fon.DeserializeInto(Encoding.UTF8.GetBytes(Line), expected);
+        Assert.Equal(Fon.SerializeToString(expected), Fon.SerializeToString(record.ToCollection()));
+        Assert.Equal("name=s:\"Bob\",level=o:{n=l:9000000000}", Encoding.UTF8.GetString(record.GetObject("owner").Raw));
+    }
+
+
+    [Fact]
+    public void Dispose_InvalidatesViews() {
+        var document = FonDocument.Parse(Encoding.UTF8.GetBytes("id=i:1"));
+        var record = document[0];
+        document.Dispose();
+
+        Assert.Throws<ObjectDisposedException>(() => record.Get<int>("id"));
+        Assert.Throws<ObjectDisposedException>(() => document[0]);
+    }
+
+
+    [Theory]
+    [InlineData("id=x:1")]
+    [InlineData("id=i1")]
+    [InlineData("o=o:{a=i:1")]
+    [InlineData("o=o:[{a=i:1},2]")]
+    public void Parse_MalformedStructure_Throws(string line) {
+        Assert.Throws<FormatException>(() => FonDocument.Parse(Encoding.UTF8.GetBytes(line)));
+    }
+
+
+    [Fact]
+    public async Task ReadDocumentsAsync_ManyBlocks_KeepsLineIds() {
+        // Enough lines for several 4MB blocks
+        var builder = new StringBuilder();
+        for (int i = 0; i < 120_000; i++) {
+            builder.Append(i % 1000 == 0 ? "" : $"id=i:{i},pad=s:\"{new string('p', 40)}\"").Append('\n');
+        }
+
+        var documents = 0;
+        var seen = 0;
+        await foreach (var document in Fon.ReadDocumentsAsync(new MemoryStream(Encoding.UTF8.GetBytes(builder.ToString())))) {
+            using (document) {
+                documents++;
+                foreach (var (id, record) in document) {
+                    Assert.Equal((int)id, record.Get<int>("id"));
+                    seen++;
+                }
+            }
+        }
+
+        Assert.True(documents > 1);
+        Assert.Equal(120_000 - 120, seen);
+    }
+}
@@ -0,0 +1,179 @@
+using System.Text;
+using FON.Core;
+using FON.Types;
+
+namespace FON.Test;
+
+
+public class FonLineIndexTests {
+    [Fact]
+    public async Task SerializeToFile_WritesSidecar_ReadRangeSeeks() {
+        var file = new FileInfo(Path.GetTempFileName());
+        var sidecar = FonLineIndex.GetPath(file);
+        Fon.LineIndex = new FonLineIndexOptions(stride: 16, "price");
+        try {
+            await Fon.SerializeToFileChunkedAsync(TestDumps.Create(1000), file, chunkSize: 7, maxDegreeOfParallelism: 4);
+            Assert.True(sidecar.Exists);
+
+            var index = FonLineIndex.Load(sidecar);
+            Assert.Equal(1000UL, index.LineCount);
+            Assert.Equal(63, index.BlockCount);
+            Assert.Equal(new FileInfo(file.FullName).Length, index.FileLength);
+
+            var record = await Fon.ReadRecordAsync(file, 517, index);
+            Assert.NotNull(record);
+            Assert.Equal(517, record.Get<int>("id"));
+            Assert.Null(await Fon.ReadRecordAsync(file, 1000, index));
+
+            var ids = new List<ulong>();
+            await foreach (var (id, item) in Fon.ReadRangeAsync(file, 990, 20)) {
+                Assert.Equal((int)id, item.Get<int>("id"));
+                ids.Add(id);
+            }
+            Assert.Equal(Enumerable.Range(990, 10).Select(i => (ulong)i), ids);
+
+            // price = id / 2, so [100, 110] covers ids 200..220 - blocks 12 and 13
+            var ranges = index.FindRanges("price", 100, 110).ToList();
+            Assert.Equal([(192UL, 32)], ranges);
+            Assert.Throws<ArgumentException>(() => index.FindRanges("name", 0, 1).ToList());
+
+            // A rewrite without an index removes the stale sidecar
+            Fon.LineIndex = null;
+            await Fon.SerializeToFileAsync(TestDumps.Create(10), file);
+            Assert.False(FonLineIndex.GetPath(file).Exists);
+            await Assert.ThrowsAsync<InvalidOperationException>(async () => await Fon.ReadRecordAsync(file, 0, index));
+        } finally {
+            Fon.LineIndex = null;
+            file.Delete();
+            sidecar.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task BuildLineIndex_MatchesTheLoaders() {
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            // BOM, empty lines and CRLF count as the dump loaders count them
+            var text = new StringBuilder("﻿");
+            for (int i = 0; i < 300; i++) {
+                text.Append(i % 10 == 3 ? "" : $"id=i:{i},v=l:{1000 - i}").Append(i % 2 == 0 ? "\r\n" : "\n");
+            }
+            await File.WriteAllTextAsync(file.FullName, text.ToString(), new UTF8Encoding(false));
+
+            var index = await Fon.BuildLineIndexAsync(file, new FonLineIndexOptions(stride: 8, "v"));
+            var saved = new MemoryStream();
+            index.Save(saved);
+            saved.Position = 0;
+            index = FonLineIndex.Load(saved);
+            Assert.Equal(300UL, index.LineCount);
+
+            var dump = await Fon.DeserializeFromFileAsync(file);
+            for (ulong id = 0; id < 300; id++) {
+                var record = await Fon.ReadRecordAsync(file, id, index);
+                if (id % 10 == 3) {
+                    Assert.Null(record);
+                } else {
+                    Assert.Equal(Fon.SerializeToString(dump[id]), Fon.SerializeToString(record!));
+                }
+            }
+
+            Assert.Equal([(296UL, 4)], index.FindRanges("v", 0, 701).ToList());
+            Assert.Empty(index.FindRanges("v", 2000, 3000));
+        } finally {
+            file.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task ReadRange_WithoutSidecar_ReusesIndexUntilFileChanges() {
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAsync(TestDumps.Create(500), file);
+            Assert.False(FonLineIndex.GetPath(file).Exists);
+
+            for (ulong id = 0; id < 500; id += 37) {
+                Assert.Equal((int)id, (await Fon.ReadRecordAsync(file, id))!.Get<int>("id"));
+            }
+
+            // A rewrite changes the length, so the index kept for the old contents is not used
+            var dump = TestDumps.Create(600);
+            dump[3]["name"] = "a much longer name than before";
+            await Fon.SerializeToFileAsync(dump, file);
+            Assert.Equal("a much longer name than before", (await Fon.ReadRecordAsync(file, 3))!.Get<string>("name"));
+            Assert.Equal(599, (await Fon.ReadRecordAsync(file, 599))!.Get<int>("id"));
+        } finally {
+            file.Delete();
+        }
+    }
+
+
+    /// <summary>
+    /// Moves the last line to the front: same length, other line breaks, record k now on line k + 1.
+    /// </summary>
+    private static void RotateLines(FileInfo file, DateTime lastWriteTimeUtc) {
+        var lines = File.ReadAllText(file.FullName).TrimEnd('\n').Split('\n');
+        File.WriteAllText(file.FullName, string.Join('\n', lines[^1..].Concat(lines[..^1])) + "\n");
+        File.SetLastWriteTimeUtc(file.FullName, lastWriteTimeUtc);
+    }
+
+
+    [Fact]
+    public async Task ReadRange_SameLengthRewrite_RejectsSidecar() {
+        var file = new FileInfo(Path.GetTempFileName());
+        var sidecar = FonLineIndex.GetPath(file);
+        Fon.LineIndex = new FonLineIndexOptions(stride: 16);
+        try {
+            await Fon.SerializeToFileAsync(TestDumps.Create(300), file);
+            var index = FonLineIndex.Load(sidecar);
+            Assert.Equal(File.GetLastWriteTimeUtc(file.FullName), index.FileLastWriteTimeUtc);
+
+            RotateLines(file, index.FileLastWriteTimeUtc.AddMinutes(1));
+            Assert.Equal(index.FileLength, new FileInfo(file.FullName).Length);
+
+            Assert.Equal(149, (await Fon.ReadRecordAsync(file, 150))!.Get<int>("id"));
+            await Assert.ThrowsAsync<InvalidOperationException>(async () => await Fon.ReadRecordAsync(file, 150, index));
+        } finally {
+            Fon.LineIndex = null;
+            file.Delete();
+            sidecar.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task ReadRange_IndexCache_EvictsAndClears() {
+        var first = new FileInfo(Path.GetTempFileName());
+        var second = new FileInfo(Path.GetTempFileName());
+        var capacity = Fon.LineIndexCacheCapacity;
+        try {
+            await Fon.SerializeToFileAsync(TestDumps.Create(300), first);
+            await Fon.SerializeToFileAsync(TestDumps.Create(300), second);
+            Fon.LineIndexCacheCapacity = 1;
+
+            // Rewrites that keep length and write time are only seen once the cached index is gone
+            Assert.Equal(150, (await Fon.ReadRecordAsync(first, 150))!.Get<int>("id"));
+            Assert.Equal(150, (await Fon.ReadRecordAsync(second, 150))!.Get<int>("id"));
+            RotateLines(first, File.GetLastWriteTimeUtc(first.FullName));
+            Assert.Equal(149, (await Fon.ReadRecordAsync(first, 150))!.Get<int>("id"));
+
+            RotateLines(first, File.GetLastWriteTimeUtc(first.FullName));
+            Fon.ClearLineIndexCache();
+            Assert.Equal(148, (await Fon.ReadRecordAsync(first, 150))!.Get<int>("id"));
+
+            Assert.Throws<ArgumentOutOfRangeException>(() => Fon.LineIndexCacheCapacity = -1);
+        } finally {
+            Fon.LineIndexCacheCapacity = capacity;
+            first.Delete();
+            second.Delete();
+        }
+    }
+
+
+    [Fact]
+    public void Load_RejectsOtherFiles() {
+        Assert.Throws<FormatException>(() => FonLineIndex.Load(new MemoryStream(Encoding.UTF8.GetBytes("id=i:1\n"))));
+        Assert.Throws<FormatException>(() => FonLineIndex.Load(new MemoryStream([0x46, 0x4E])));
+    }
+}
@@ -0,0 +1,134 @@
+using FON.Core;
+using FON.Diagnostics;
+using FON.Types;
+using System.Collections.Concurrent;
+using System.Diagnostics.Metrics;
+
+namespace FON.Test;
+
+
+public class FonMetricsTests {
+    private static void AddBlob(int i, FonCollection record) => record.Add("blob", new RawData(new byte[] { (byte)i, 1, 2, 3, 4, 5 }));
+
+
+    /// <summary>
+    /// Everything the FON meter reports while it is alive; other tests may add to it concurrently.
+    /// </summary>
+    private sealed class Recorder : IDisposable {
+        private readonly MeterListener listener = new();
+
+        public ConcurrentBag<(string instrument, double value, Dictionary<string, object?> tags)> Measurements { get; } = [];
+
+
+        public Recorder() {
+            listener.InstrumentPublished = (instrument, l) => {
+                if (instrument.Meter.Name == FonMetrics.MeterName) {
+                    l.EnableMeasurementEvents(instrument);
+                }
+            };
+            listener.SetMeasurementEventCallback<long>((instrument, value, tags, _) => Add(instrument, value, tags));
+            listener.SetMeasurementEventCallback<double>((instrument, value, tags, _) => Add(instrument, value, tags));
+            listener.Start();
+        }
+
+
+        public IEnumerable<Dictionary<string, object?>> Tags(string instrument) =>
+            Measurements.Where(m => m.instrument == instrument).Select(m => m.tags);
+
+
+        private void Add(Instrument instrument, double value, ReadOnlySpan<KeyValuePair<string, object?>> tags) {
+            var copy = new Dictionary<string, object?>();
+            foreach (var (key, tag) in tags) {
+                copy[key] = tag;
+            }
+            Measurements.Add((instrument.Name, value, copy));
+        }
+
+
+        public void Dispose() => listener.Dispose();
+    }
+
+
+
+
+    [Fact]
+    public async Task Metrics_ReportOperationsPhasesAndSelections() {
+        var file = new FileInfo(Path.GetTempFileName());
+        var originalUnpackSetting = Fon.RawUnpack;
+        try {
+            using var recorder = new Recorder();
+            var dump = TestDumps.Create(3000, AddBlob);
+            await Fon.SerializeToFilePipelineAsync(dump, file);
+            // Blobs decoded while parsing are reported by the load itself
+            Fon.RawUnpack = RawUnpackMode.Eager;
+            var loaded = await Fon.DeserializeFromFileAsync(file);
+            Fon.RawUnpack = originalUnpackSetting;
+            var loadedBytes = new FileInfo(file.FullName).Length;
+            Assert.Equal(dump.Count, loaded.Count);
+            // Decoding after the call is outside any operation and not timed
+            _ = loaded[7].Get<RawData>("blob").Unpack();
+            await Fon.SerializeToFileAutoAsync(dump, file);
+
+            Assert.True(recorder.Measurements.Any(m => m.instrument == "fon.records" && m.value == 3000
+                && (string?)m.tags["operation"] == "serialize" && (string?)m.tags["strategy"] == "pipeline"
+                && (string?)m.tags["engine"] == FonMetrics.ManagedEngine));
+            Assert.True(recorder.Measurements.Any(m => m.instrument == "fon.bytes" && m.value == loadedBytes
+                && (string?)m.tags["operation"] == "deserialize" && (string?)m.tags["strategy"] == "read-all"));
+
+            var phases = recorder.Tags("fon.phase.duration").Select(t => $"{t["operation"]}/{t["phase"]}").ToHashSet();
+            Assert.Contains("serialize/serialize", phases);
+            Assert.Contains("serialize/write", phases);
+            Assert.Contains("deserialize/read", phases);
+            Assert.Contains("deserialize/parse", phases);
+            Assert.Contains("serialize/z85", phases);
+            Assert.Contains("deserialize/z85", phases);
+            Assert.DoesNotContain("encode/z85", phases);
+
+            Assert.True(recorder.Tags("fon.strategy.selections").Any(t => (string?)t["operation"] == "serialize"));
+        } finally {
+            Fon.RawUnpack = originalUnpackSetting;
+            file.Delete();
+        }
+    }
+
+
+
+
+    [Fact]
+    public async Task AdaptiveTuning_TriesEveryStrategyAndKeepsOutputIdentical() {
+        var plain = new FileInfo(Path.GetTempFileName());
+        var tuned = new FileInfo(Path.GetTempFileName());
+        try {
+            using var recorder = new Recorder();
+            var dump = TestDumps.Create(2500, AddBlob);
+            await Fon.SerializeToFileChunkedAsync(dump, plain);
+            var expected = File.ReadAllText(plain.FullName);
+
+            Fon.AdaptiveTuning = true;
+            Fon.ResetAdaptiveTuning();
+            for (int i = 0; i < 6; i++) {
+                await Fon.SerializeToFileAutoAsync(dump, tuned);
+                Assert.Equal(expected, File.ReadAllText(tuned.FullName));
+
+                var loaded = await Fon.DeserializeFromFileAutoAsync(tuned);
+                Assert.Equal(dump.Count, loaded.Count);
+                Assert.Equal(Fon.SerializeToString(dump[42]), Fon.SerializeToString(loaded[42]));
+            }
+
+            var selected = recorder.Tags("fon.strategy.selections")
+                .Where(t => t["adaptive"] is true)
+                .Select(t => $"{t["operation"]}/{t["strategy"]}")
+                .ToHashSet();
+            foreach (var strategy in new[] { "pipeline", "chunked-half", "chunked", "chunked-double" }) {
+                Assert.Contains($"serialize/{strategy}", selected);
+            }
+            Assert.Contains("deserialize/read-all", selected);
+            Assert.Contains("deserialize/mapped", selected);
+        } finally {
+            Fon.AdaptiveTuning = false;
+            Fon.ResetAdaptiveTuning();
+            plain.Delete();
+            tuned.Delete();
+        }
+    }
+}
@@ -521,10 +521,12 @@ public class NestedObjectTests {
             var loaded1 = await Fon.DeserializeFromFileAsync(file);
             var loaded2 = await Fon.DeserializeFromFileChunkedAsync(file, chunkSize: 4);
             var loaded3 = await Fon.DeserializeFromFileAutoAsync(file);
+            var loaded4 = await Fon.DeserializeFromFileMappedAsync(file, maxDegreeOfParallelism: 4);
 
             AssertDumpEquals(dump, loaded1);
             AssertDumpEquals(dump, loaded2);
             AssertDumpEquals(dump, loaded3);
+            AssertDumpEquals(dump, loaded4);
         } finally {
             file.Delete();
         }
@@ -0,0 +1,223 @@
+using FON.Core;
+using FON.Types;
+using System.Buffers;
+using System.Text;
+
+namespace FON.Test;
+
+
+[FonSerializable]
+public class GeneratedPoint {
+    public int X { get; set; }
+    public int Y { get; set; }
+}
+
+
+[FonSerializable]
+public struct GeneratedSize {
+    public float Width { get; set; }
+    public float Height { get; set; }
+}
+
+
+[FonSerializable]
+public class GeneratedRecord {
+    public byte Level { get; set; }
+    public short Code { get; set; }
+    public int Id { get; set; }
+    public uint Flags { get; set; }
+    public long Ticks { get; set; }
+    public ulong Hash { get; set; }
+    public float Ratio { get; set; }
+    public double Score { get; set; }
+    public bool Active { get; set; }
+    public string? Name { get; set; }
+    public int? Parent { get; set; }
+    public RawData? Payload { get; set; }
+    public List<int>? Numbers { get; set; }
+    public string[]? Tags { get; set; }
+    public IList<double>? Samples { get; set; }
+    public GeneratedPoint? Origin { get; set; }
+    public GeneratedSize Size { get; set; }
+    public List<GeneratedPoint>? Path { get; set; }
+
+    // Not settable, so not a key
+    public int Computed => Id * 2;
+}
+
+
+
+
+public class SourceGeneratorTests {
+    private static GeneratedRecord CreateRecord() => new() {
+        Level = 3,
+        Code = -12,
+        Id = 42,
+        Flags = 0xF00Du,
+        Ticks = -1234567890123L,
+        Hash = ulong.MaxValue,
+        Ratio = 0.25f,
+        Score = 1.0 / 3,
+        Active = true,
+        Name = "quote \" comma , brace }",
+        Parent = 7,
+        Payload = new RawData([1, 2, 3, 4, 5]),
+        Numbers = [1, -2, 3],
+        Tags = ["a", "b,c"],
+        Samples = new List<double> { 0.5, -1.5 },
+        Origin = new GeneratedPoint { X = 1, Y = 2 },
+        Size = new GeneratedSize { Width = 10, Height = 20 },
+        Path = [new GeneratedPoint { X = 3, Y = 4 }, new GeneratedPoint { X = 5, Y = 6 }]
+    };
+
+
+    private static void AssertEqual(GeneratedRecord expected, GeneratedRecord actual) {
+        Assert.Equal(expected.Level, actual.Level);
+        Assert.Equal(expected.Code, actual.Code);
+        Assert.Equal(expected.Id, actual.Id);
+        Assert.Equal(expected.Flags, actual.Flags);
+        Assert.Equal(expected.Ticks, actual.Ticks);
+        Assert.Equal(expected.Hash, actual.Hash);
+        Assert.Equal(expected.Ratio, actual.Ratio);
+        Assert.Equal(expected.Score, actual.Score);
+        Assert.Equal(expected.Active, actual.Active);
+        Assert.Equal(expected.Name, actual.Name);
+        Assert.Equal(expected.Parent, actual.Parent);
+        Assert.Equal(expected.Payload?.Unpack().data, actual.Payload?.Unpack().data);
+        Assert.Equal(expected.Numbers, actual.Numbers);
+        Assert.Equal(expected.Tags, actual.Tags);
+        Assert.Equal(expected.Samples, actual.Samples);
+        Assert.Equal(expected.Origin?.X, actual.Origin?.X);
+        Assert.Equal(expected.Origin?.Y, actual.Origin?.Y);
+        Assert.Equal(expected.Size, actual.Size);
+        Assert.Equal(expected.Path?.Select(p => (p.X, p.Y)), actual.Path?.Select(p => (p.X, p.Y)));
+    }
+
+
+    private static byte[] SerializeRecord<T>(T record) {
+        var buffer = new ArrayBufferWriter<byte>();
+        Fon.SerializeRecord(record, buffer);
+        return buffer.WrittenSpan.ToArray();
+    }
+
+
+
+
+    [Fact]
+    public void SerializeRecord_MatchesCollectionOutput() {
+        var record = CreateRecord();
+
+        var typed = SerializeRecord(record);
+        var collection = new ArrayBufferWriter<byte>();
+        Fon.Serialize(FonCollection.Serialize(record), collection);
+
+        Assert.Equal(Encoding.UTF8.GetString(collection.WrittenSpan), Encoding.UTF8.GetString(typed));
+    }
+
+
+    [Fact]
+    public void SerializeRecord_DeserializeRecord_RoundTrips() {
+        var record = CreateRecord();
+
+        var result = Fon.DeserializeRecord<GeneratedRecord>(SerializeRecord(record));
+
+        AssertEqual(record, result);
+    }
+
+
+    [Fact]
+    public void DeserializeRecord_ReadsCollectionOutput() {
+        var record = CreateRecord();
+        var text = Fon.SerializeToString(FonCollection.Serialize(record));
+
+        var result = Fon.DeserializeRecord<GeneratedRecord>(Encoding.UTF8.GetBytes(text));
+
+        AssertEqual(record, result);
+    }
+
+
+    [Fact]
+    public void SerializeRecord_NullMembers_AreLeftOut() {
+        var text = Encoding.UTF8.GetString(SerializeRecord(new GeneratedRecord { Id = 1 }));
+
+        Assert.DoesNotContain("Name=", text);
+        Assert.DoesNotContain("Parent=", text);
+        Assert.DoesNotContain("Origin=", text);
+        Assert.DoesNotContain("Computed=", text);
+        Assert.Contains("Size=o:{Width=f:0,Height=f:0}", text);
+
+        var result = Fon.DeserializeRecord<GeneratedRecord>(Encoding.UTF8.GetBytes(text));
+        Assert.Null(result.Name);
+        Assert.Null(result.Parent);
+        Assert.Null(result.Origin);
+    }
+
+
+    [Fact]
+    public void DeserializeRecord_UnknownKeys_AreSkipped() {
+        var line = "extra=o:{a=i:1,b=s:\"}\"},X=i:5,list=i:[1,2],Y=i:6,last=d:1.5"u8;
+
+        var result = Fon.DeserializeRecord<GeneratedPoint>(line);
+
+        Assert.Equal(5, result.X);
+        Assert.Equal(6, result.Y);
+    }
+
+
+    [Fact]
+    public void DeserializeRecord_NestedUnknownScalar_IsSkipped() {
+        var line = "Origin=o:{X=i:1,Z=i:9,Y=i:2},Id=i:3"u8;
+
+        var result = Fon.DeserializeRecord<GeneratedRecord>(line);
+
+        Assert.Equal(1, result.Origin!.X);
+        Assert.Equal(2, result.Origin.Y);
+        Assert.Equal(3, result.Id);
+    }
+
+
+    [Fact]
+    public void DeserializeRecord_TypeMismatch_Throws() {
+        Assert.Throws<FormatException>(() => Fon.DeserializeRecord<GeneratedPoint>("X=s:\"one\""u8));
+        Assert.Throws<FormatException>(() => Fon.DeserializeRecord<GeneratedPoint>("X=i:[1]"u8));
+        Assert.Throws<FormatException>(() => Fon.DeserializeRecord<GeneratedPoint>("X=i:abc"u8));
+    }
+
+
+    [Fact]
+    public void CollectionSerializeDeserialize_UsesGeneratedSerializer() {
+        Assert.NotNull(FonTypeSerializers.Get<GeneratedRecord>());
+        var record = CreateRecord();
+
+        var collection = FonCollection.Serialize(record);
+        var result = collection.Deserialize<GeneratedRecord>();
+
+        Assert.IsType<FonCollection>(collection.Get("Origin"));
+        Assert.Null(collection.TryGet("Computed"));
+        AssertEqual(record, result);
+    }
+
+
+    [Fact]
+    public async Task SerializeRecordsToStream_ReadRecordsAsync_RoundTrips() {
+        var records = Enumerable.Range(0, 5000).Select(i => new GeneratedPoint { X = i, Y = -i }).ToList();
+        using var stream = new MemoryStream();
+
+        await Fon.SerializeRecordsToStreamAsync(records, stream);
+        stream.Position = 0;
+
+        var count = 0;
+        await foreach (var (id, point) in Fon.ReadRecordsAsync<GeneratedPoint>(stream, maxDegreeOfParallelism: 2)) {
+            Assert.Equal((int)id, point.X);
+            Assert.Equal(-(int)id, point.Y);
+            count++;
+        }
+        Assert.Equal(records.Count, count);
+    }
+
+
+    [Fact]
+    public void SerializeRecord_UnregisteredType_Throws() {
+        Assert.Throws<InvalidOperationException>(() => SerializeRecord(new FonCollectionTests()));
+    }
+}
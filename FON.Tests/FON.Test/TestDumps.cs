@@ -0,0 +1,29 @@
+using FON.Types;
+
+namespace FON.Test;
+
+
+/// <summary>
+/// Dumps shared by the file tests.
+/// </summary>
+internal static class TestDumps {
+    /// <summary>
+    /// Records with ids 0..count-1 holding an int "id", a double "price" (id / 2) and one of 17 "name"s.
+    /// <paramref name="extend"/> adds more values to each record; ids <paramref name="skip"/> returns true for are left out.
+    /// </summary>
+    public static FonDump Create(int count, Action<int, FonCollection>? extend = null, Func<int, bool>? skip = null) {
+        var dump = new FonDump();
+        for (int i = 0; i < count; i++) {
+            if (skip?.Invoke(i) == true) {
+                continue;
+            }
+            var record = new FonCollection();
+            record.Add("id", i);
+            record.Add("price", i * 0.5);
+            record.Add("name", $"customer {i % 17}");
+            extend?.Invoke(i, record);
+            dump.TryAdd((ulong)i, record);
+        }
+        return dump;
+    }
+}
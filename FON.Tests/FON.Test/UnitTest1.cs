@@ -1,5 +1,8 @@
+using FON.Acceleration;
 using FON.Core;
 using FON.Types;
+using System.Buffers;
+using System.Text;
 
 namespace FON.Test;
 
@@ -256,6 +259,51 @@ public class FonStringSerializationTests {
         Assert.Contains("Привет", result);
         Assert.Contains("你好", result);
     }
+
+
+    [Fact]
+    public void Serialize_BufferWriter_MatchesSerializeToString() {
+        var collection = new FonCollection {
+            { "id", -42 },
+            { "pi", 3.14159 },
+            { "text", "q\"uote\\ ctl\u0001 Привет 🌍" },
+            { "flags", new List<bool> { true, false } },
+            { "names", new List<string> { "a,b", "c]" } },
+            { "raw", new RawData([1, 2, 3, 4]) },
+            { "nested", new FonCollection { { "x", 1.5f }, { "y", new List<ulong> { ulong.MaxValue } } } }
+        };
+        var buffer = new System.Buffers.ArrayBufferWriter<byte>();
+
+        Fon.Serialize(collection, buffer);
+
+        Assert.Equal(Fon.SerializeToString(collection), System.Text.Encoding.UTF8.GetString(buffer.WrittenSpan));
+    }
+
+
+    [Fact]
+    public void Serialize_BufferWriter_UnsupportedTypeThrows() {
+        var collection = new FonCollection { { "when", DateTime.UnixEpoch } };
+
+        Assert.Throws<InvalidOperationException>(() => Fon.Serialize(collection, new System.Buffers.ArrayBufferWriter<byte>()));
+    }
+
+
+    [Fact]
+    public async Task SerializeToStreamAsync_WritesOneLinePerRecordInIdOrder() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 1000; i++) {
+            if (i % 7 != 3) {
+                dump.Add(i, new FonCollection { { "id", (int)i } });
+            }
+        }
+
+        using var stream = new MemoryStream();
+        await Fon.SerializeToStreamAsync(dump, stream, maxDegreeOfParallelism: 3);
+
+        var lines = System.Text.Encoding.UTF8.GetString(stream.ToArray()).Split('\n', StringSplitOptions.RemoveEmptyEntries);
+        Assert.Equal(dump.Count, lines.Length);
+        Assert.Equal(dump.Select(kvp => $"id=i:{kvp.Key}"), lines);
+    }
 }
 
 
@@ -331,6 +379,98 @@ public class FonCollectionTests {
         Assert.Contains("a", keys);
         Assert.Contains("b", keys);
     }
+
+
+    [Fact]
+    public void FonCollection_Enumeration_FollowsInsertionOrder() {
+        var collection = new FonCollection {
+            { "z", 1 },
+            { "a", 2 },
+            { "m", 3 }
+        };
+
+        Assert.Equal(new List<string> { "z", "a", "m" }, collection.Select(kvp => kvp.Key).ToList());
+        Assert.Equal("z=i:1,a=i:2,m=i:3", Fon.SerializeToString(collection));
+    }
+
+
+    [Fact]
+    public void FonCollection_ManyKeys_LookupAndRemoveKeepOrder() {
+        var collection = new FonCollection();
+        for (int i = 0; i < 40; i++) {
+            collection.Add($"k{i}", i);
+        }
+
+        Assert.True(collection.Remove("k3"));
+        Assert.False(collection.Remove("k3"));
+        Assert.False(collection.TryAdd("k10", -1));
+        collection["k39"] = 390;
+
+        Assert.Equal(39, collection.Count);
+        Assert.Null(collection.TryGet("k3"));
+        Assert.Equal(4, collection.Get<int>("k4"));
+        Assert.Equal(390, collection.Get<int>("k39"));
+        Assert.Equal("k4", collection.Skip(3).First().Key);
+
+        // Removing down past the index threshold keeps every remaining key reachable
+        for (int i = 0; i < 35; i++) {
+            Assert.True(collection.Remove($"k{(i < 3 ? i : i + 1)}"));
+            Assert.Equal(390, collection.Get<int>("k39"));
+        }
+        Assert.Equal(["k36", "k37", "k38", "k39"], collection.Select(e => e.Key));
+        Assert.Equal(37, collection.Get<int>("k37"));
+    }
+
+
+    [Fact]
+    public async Task FonCollection_CreateConcurrent_AcceptsParallelWriters() {
+        var collection = FonCollection.CreateConcurrent();
+
+        await Task.WhenAll(Enumerable.Range(0, 8).Select(t => Task.Run(() => {
+            for (int i = t; i < 800; i += 8) {
+                collection.Add($"k{i}", i);
+            }
+        })));
+
+        Assert.True(collection.IsConcurrent);
+        Assert.Equal(800, collection.Count);
+        Assert.Equal(123, collection.Get<int>("k123"));
+    }
+
+
+    [Fact]
+    public void FonCollection_TypedValues_RoundTripThroughAllAccessors() {
+        var collection = new FonCollection {
+            { "e", (byte)200 },
+            { "l", -5L },
+            { "f", 1.5f },
+            { "d", double.MaxValue },
+            { "b", true }
+        };
+        collection.Add<ulong>("g", ulong.MaxValue);
+        collection["i"] = 42;
+
+        Assert.Equal((byte)200, collection.Get<byte>("e"));
+        Assert.Equal(-5L, collection.Get<long>("l"));
+        Assert.Equal(1.5f, collection.Get<float>("f"));
+        Assert.Equal(double.MaxValue, collection.Get<double>("d"));
+        Assert.True(collection.Get<bool>("b"));
+        Assert.Equal(ulong.MaxValue, collection.Get<ulong>("g"));
+        Assert.Equal(42, collection.TryGetNullable<int>("i"));
+        Assert.Equal(42, collection["i"]);
+        Assert.Equal(-5L, collection.Get<object>("l"));
+        Assert.Equal("e=e:200,l=l:-5,f=f:1.5,d=d:1.7976931348623157E+308,b=b:1,g=g:18446744073709551615,i=i:42", Fon.SerializeToString(collection));
+    }
+
+
+    [Fact]
+    public void FonCollection_GetWrongType_Throws() {
+        var collection = new FonCollection { { "i", 1 } };
+
+        Assert.Throws<InvalidCastException>(() => collection.Get<long>("i"));
+        Assert.Null(collection.TryGetNullable<long>("i"));
+        Assert.Null(collection.TryGet<string>("i"));
+    }
 }
 
 
@@ -378,6 +518,73 @@ public class FonDumpTests {
         Assert.NotNull(dump.TryGet(10));
         Assert.Null(dump.TryGet(20));
     }
+
+
+    [Fact]
+    public void FonDump_Enumeration_IsInIdOrder() {
+        var dump = new FonDump();
+        dump.TryAdd(3, new FonCollection { { "v", 3 } });
+        dump.TryAdd(0, new FonCollection { { "v", 0 } });
+        dump.TryAdd(7, new FonCollection { { "v", 7 } });
+
+        Assert.Equal(new List<ulong> { 0, 3, 7 }, dump.Select(x => x.Key).ToList());
+        Assert.Equal(3, dump.Count);
+    }
+
+
+    [Fact]
+    public void FonDump_SparseIds_SwitchToDictionaryStorage() {
+        var dump = new FonDump();
+        dump.TryAdd(1, new FonCollection { { "v", 1 } });
+        dump.TryAdd(ulong.MaxValue, new FonCollection { { "v", 2 } });
+
+        Assert.Equal(2, dump.Count);
+        Assert.Equal(1, dump[1].Get<int>("v"));
+        Assert.Equal(2, dump[ulong.MaxValue].Get<int>("v"));
+        Assert.False(dump.TryAdd(1, new FonCollection()));
+    }
+
+
+    [Fact]
+    public void FonDump_FonObjects_ReflectsAndKeepsRecords() {
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection { { "v", 0 } });
+
+        dump.FonObjects.TryAdd(5, new FonCollection { { "v", 5 } });
+
+        Assert.Equal(2, dump.Count);
+        Assert.Equal(0, dump[0].Get<int>("v"));
+        Assert.Equal(5, dump[5].Get<int>("v"));
+    }
+
+
+    [Fact]
+    public void FonDump_Remove_FreesSlot() {
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection());
+        dump.TryAdd(1, new FonCollection());
+
+        Assert.True(dump.Remove(0));
+        Assert.False(dump.Remove(0));
+        Assert.Equal(1, dump.Count);
+        Assert.Throws<KeyNotFoundException>(() => dump[0]);
+        Assert.True(dump.TryAdd(0, new FonCollection()));
+    }
+
+
+    [Fact]
+    public async Task FonDump_ConcurrentTryAdd_KeepsEveryRecord() {
+        var dump = new FonDump();
+
+        await Task.WhenAll(Enumerable.Range(0, 8).Select(t => Task.Run(() => {
+            for (int i = t; i < 8000; i += 8) {
+                dump.TryAdd((ulong)i, new FonCollection { { "v", i } });
+            }
+        })));
+
+        Assert.Equal(8000, dump.Count);
+        Assert.Equal(4321, dump[4321].Get<int>("v"));
+    }
 }
 
 
@@ -440,6 +647,80 @@ public class FonMethodsTests {
     }
 
 
+    [Fact]
+    public async Task SerializeToFileAsync_WritesRecordsInIdOrder() {
+        var dump = new FonDump();
+        dump.TryAdd(10, new FonCollection { { "v", 2 } });
+        dump.TryAdd(2, new FonCollection { { "v", 1 } });
+        dump.TryAdd(0, new FonCollection { { "v", 0 } });
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            await Fon.SerializeToFileAsync(dump, tempFile);
+
+            Assert.Equal(["v=i:0", "v=i:1", "v=i:2"], await File.ReadAllLinesAsync(tempFile.FullName));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task SerializeToFileChunkedAsync_ManySmallChunks_KeepsOrder() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 3000; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (int)i }, { "pad", new string('x', (int)(i % 50)) } });
+        }
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            await Fon.SerializeToFileChunkedAsync(dump, tempFile, chunkSize: 7, maxDegreeOfParallelism: 5);
+            var lines = await File.ReadAllLinesAsync(tempFile.FullName);
+
+            Assert.Equal(3000, lines.Length);
+            for (int i = 0; i < lines.Length; i++) {
+                Assert.StartsWith($"id=i:{i},", lines[i]);
+            }
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task SerializeToFilePipelineAsync_UnsupportedValue_Throws() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 500; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (int)i } });
+        }
+        dump[250] = new FonCollection { { "when", DateTime.UnixEpoch } };
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            await Assert.ThrowsAsync<InvalidOperationException>(() => Fon.SerializeToFilePipelineAsync(dump, tempFile, maxDegreeOfParallelism: 4));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task SerializeToStreamAsync_Cancelled_Throws() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 100; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (int)i } });
+        }
+
+        using var cancellation = new CancellationTokenSource();
+        cancellation.Cancel();
+
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => Fon.SerializeToStreamAsync(dump, new MemoryStream(), cancellationToken: cancellation.Token));
+    }
+
+
     [Fact]
     public async Task DeserializeFromFileAsync_LoadsCorrectly() {
         var dump = new FonDump();
@@ -477,9 +758,255 @@ public class FonMethodsTests {
             tempFile.Delete();
         }
     }
+
+
+    [Fact]
+    public async Task DeserializeFromFileMappedAsync_LoadsCorrectly() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 500; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (int)i }, { "name", $"item_{i}" } });
+        }
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            await Fon.SerializeToFileAutoAsync(dump, tempFile);
+
+            // Many more ranges than lines per range so every range boundary is exercised
+            var result = await Fon.DeserializeFromFileMappedAsync(tempFile, maxDegreeOfParallelism: 64);
+
+            Assert.Equal(500, result.Count);
+            for (ulong i = 0; i < 500; i++) {
+                Assert.Equal((int)i, result[i].Get<int>("id"));
+                Assert.Equal($"item_{i}", result[i].Get<string>("name"));
+            }
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task DeserializeFromFileMappedAsync_KeepsLineIndicesAcrossEmptyLines() {
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            await File.WriteAllTextAsync(tempFile.FullName, "a=i:0\r\n\r\na=i:2\n\n\na=i:5");
+            var result = await Fon.DeserializeFromFileMappedAsync(tempFile, maxDegreeOfParallelism: 8);
+
+            Assert.Equal(3, result.Count);
+            Assert.Equal(0, result[0].Get<int>("a"));
+            Assert.Equal(2, result[2].Get<int>("a"));
+            Assert.Equal(5, result[5].Get<int>("a"));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task DeserializeFromFileMappedAsync_EmptyFile_ReturnsEmptyDump() {
+        var tempFile = new FileInfo(Path.GetTempFileName());
+
+        try {
+            var result = await Fon.DeserializeFromFileMappedAsync(tempFile);
+
+            Assert.Equal(0, result.Count);
+        } finally {
+            tempFile.Delete();
+        }
+    }
 }
 
 
+public class FonWriterTests {
+    [Fact]
+    public async Task WriteAsync_ManyBatches_MatchesSerializeToFile() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 1000; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (int)i }, { "name", $"r{i}" } });
+        }
+
+        var expectedFile = new FileInfo(Path.GetTempFileName());
+        var writerFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAsync(dump, expectedFile);
+
+            await using (var writer = FonWriter.Create(writerFile, batchSize: 7, maxDegreeOfParallelism: 3)) {
+                for (ulong i = 0; i < 1000; i++) {
+                    await writer.WriteAsync(dump[i]);
+                }
+                Assert.Equal(1000, writer.Count);
+            }
+
+            Assert.Equal(await File.ReadAllBytesAsync(expectedFile.FullName), await File.ReadAllBytesAsync(writerFile.FullName));
+        } finally {
+            expectedFile.Delete();
+            writerFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task Create_Append_ContinuesExistingFile() {
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            // No trailing newline: the writer has to add one before the first new record
+            await File.WriteAllTextAsync(tempFile.FullName, "x=i:0");
+
+            await using (var writer = FonWriter.Create(tempFile, append: true)) {
+                await writer.WriteAsync([new FonCollection { { "x", 1 } }, new FonCollection { { "x", 2 } }]);
+            }
+
+            var loaded = await Fon.DeserializeFromFileAsync(tempFile);
+            Assert.Equal(3, loaded.Count);
+            Assert.Equal(2, loaded[2].Get<int>("x"));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task FlushAsync_WritesPartialBatch_LeavesStreamOpen() {
+        var stream = new MemoryStream();
+        await using var writer = new FonWriter(stream, batchSize: 100, leaveOpen: true);
+
+        await writer.WriteAsync(new FonCollection { { "a", 1 } });
+        Assert.Equal(0, stream.Length);
+
+        await writer.FlushAsync();
+        Assert.Equal("a=i:1\n", System.Text.Encoding.UTF8.GetString(stream.ToArray()));
+    }
+
+
+    [Fact]
+    public async Task WriteAsync_Cancelled_KeepsBatchesForFlush() {
+        var stream = new MemoryStream();
+        await using var writer = new FonWriter(stream, batchSize: 2, maxDegreeOfParallelism: 1, leaveOpen: true);
+        using var cancelled = new CancellationTokenSource();
+        cancelled.Cancel();
+
+        for (int i = 0; i < 3; i++) {
+            await writer.WriteAsync(new FonCollection { { "i", i } });
+        }
+        // Fills the second batch, the wait for the first one is cancelled before it is written
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => writer.WriteAsync(new FonCollection { { "i", 3 } }, cancelled.Token).AsTask());
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => writer.FlushAsync(cancelled.Token));
+        Assert.Equal(0, stream.Length);
+
+        await writer.WriteAsync(new FonCollection { { "i", 4 } });
+        await writer.FlushAsync();
+        Assert.Equal("i=i:0\ni=i:1\ni=i:2\ni=i:3\ni=i:4\n", System.Text.Encoding.UTF8.GetString(stream.ToArray()));
+    }
+
+
+    [Fact]
+    public async Task WriteAsync_UnsupportedValue_FailsWriter() {
+        var stream = new MemoryStream();
+        var writer = new FonWriter(stream, batchSize: 1, maxDegreeOfParallelism: 1);
+
+        await writer.WriteAsync(new FonCollection { { "ok", 1 } });
+        await writer.WriteAsync(new FonCollection { { "date", DateTime.Now } });
+        await Assert.ThrowsAsync<InvalidOperationException>(() => writer.FlushAsync());
+        await Assert.ThrowsAsync<InvalidOperationException>(() => writer.WriteAsync(new FonCollection { { "ok", 2 } }).AsTask());
+
+        await writer.DisposeAsync();
+        Assert.Throws<ObjectDisposedException>(() => stream.Length);
+    }
+}
+
+public class FonAcceleratorTests {
+    /// <summary>
+    /// Takes only files with the .backend extension, so the Auto calls of other tests keep
+    /// going to the managed path while this one is registered.
+    /// </summary>
+    private sealed class FileBackend : IFonBackend {
+        public int Serialized;
+        public int Deserialized;
+
+        public string Name => "test";
+        public bool IsAvailable => true;
+        public string? Version => "1.0";
+
+        public bool TrySerializeToFile(FonDump dump, FileInfo file, int maxDegreeOfParallelism) {
+            if (file.Extension != ".backend") {
+                return false;
+            }
+            Interlocked.Increment(ref Serialized);
+            File.WriteAllText(file.FullName, $"count=i:{dump.Count}\n");
+            return true;
+        }
+
+        public FonDump? TryDeserializeFromFile(FileInfo file, FonReadOptions? options, int maxDegreeOfParallelism) {
+            if (file.Extension != ".backend") {
+                return null;
+            }
+            Interlocked.Increment(ref Deserialized);
+            var dump = new FonDump();
+            dump.TryAdd(0, new FonCollection { { "from", "backend" } });
+            return dump;
+        }
+    }
+
+
+    private static readonly FileBackend backend = new();
+
+    static FonAcceleratorTests() => FonAccelerator.Register(backend);
+
+
+    private static FonDump CreateDump() {
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection { { "id", 1 } });
+        dump.TryAdd(1, new FonCollection { { "id", 2 } });
+        return dump;
+    }
+
+
+
+
+    [Fact]
+    public void Register_ReportsBackend() {
+        Assert.Same(backend, FonAccelerator.Backend);
+        Assert.True(FonAccelerator.IsAvailable);
+        Assert.Equal("1.0", FonAccelerator.Version);
+    }
+
+
+    [Fact]
+    public async Task AutoMethods_DispatchToBackend() {
+        var file = new FileInfo(Path.Combine(Path.GetTempPath(), $"{Guid.NewGuid():N}.backend"));
+        try {
+            var serialized = backend.Serialized;
+            await Fon.SerializeToFileAutoAsync(CreateDump(), file);
+            Assert.Equal(serialized + 1, backend.Serialized);
+            Assert.Equal("count=i:2\n", await File.ReadAllTextAsync(file.FullName));
+
+            var deserialized = backend.Deserialized;
+            var loaded = await Fon.DeserializeFromFileAutoAsync(file);
+            Assert.Equal(deserialized + 1, backend.Deserialized);
+            Assert.Equal("backend", loaded[0].Get<string>("from"));
+        } finally {
+            file.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task AutoMethods_BackendDeclines_FallBackToManaged() {
+        var file = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAutoAsync(CreateDump(), file);
+            var loaded = await Fon.DeserializeFromFileAutoAsync(file);
+
+            Assert.Equal(2, loaded.Count);
+            Assert.Equal(2, loaded[1].Get<int>("id"));
+        } finally {
+            file.Delete();
+        }
+    }
+}
+
 public class RawDataTests {
     [Fact]
     public void RawData_Constructor_StoresData() {
@@ -513,4 +1040,147 @@ public class RawDataTests {
 
         Assert.Equal(originalData, unpacked.data);
     }
+
+
+    [Theory]
+    [InlineData(64)]
+    [InlineData(319)]
+    [InlineData(4096 + 2)]
+    public void RawData_PackUnpack_LargeBuffers_RoundTrip(int length) {
+        // Long enough for the vectorized blocks plus a scalar tail and padding
+        var originalData = new byte[length];
+        new Random(length).NextBytes(originalData);
+
+        var packed = new RawData(originalData.ToArray()).Pack();
+        Assert.Equal((length + 3) / 4 * 5 + (length % 4 == 0 ? 0 : 1), packed.encoded.Length);
+
+        var unpacked = new RawData(packed.encoded.AsSpan()).Unpack();
+        Assert.Equal(originalData, unpacked.data);
+    }
+
+
+    [Theory]
+    [InlineData('"')]
+    [InlineData('\n')]
+    [InlineData('é')]
+    public void RawData_Unpack_InvalidCharacter_ReportsPosition(char invalid) {
+        var encoded = new RawData(new byte[256]).Pack().encoded.ToCharArray();
+        encoded[123] = invalid;
+
+        var ex = Assert.Throws<FormatException>(() => new RawData(encoded.AsSpan()).Unpack());
+        Assert.Contains("position 123", ex.Message);
+    }
+
+    [Fact]
+    public void RawData_FromEncoded_DecodesIntoCallerBuffer() {
+        var originalData = new byte[] { 9, 8, 7, 6, 5, 4, 3 };
+        var text = Encoding.ASCII.GetBytes("xx" + new RawData(originalData.ToArray()).Pack().encoded + "yy");
+
+        // A slice of a bigger buffer, as it comes out of a parser
+        var raw = RawData.FromEncoded(text.AsMemory(2, text.Length - 4));
+        Assert.True(raw.IsPacked);
+        Assert.Equal(originalData.Length, raw.GetDecodedLength());
+
+        Assert.False(raw.TryDecodeTo(new byte[originalData.Length - 1], out _));
+
+        var destination = new byte[originalData.Length];
+        Assert.True(raw.TryDecodeTo(destination, out int written));
+        Assert.Equal(originalData.Length, written);
+        Assert.Equal(originalData, destination);
+        Assert.True(raw.IsPacked);
+    }
+
+
+    [Fact]
+    public void RawData_UnpackIntoPool_ReturnsMemoryOnDispose() {
+        var originalData = Enumerable.Range(0, 1000).Select(i => (byte)i).ToArray();
+        var packed = new RawData(originalData.ToArray()).Pack().encoded;
+
+        var raw = new RawData(packed.AsSpan()).Unpack(MemoryPool<byte>.Shared);
+        Assert.False(raw.IsPacked);
+        Assert.Equal(originalData, raw.Memory.ToArray());
+
+        raw.Dispose();
+        Assert.True(raw.Memory.IsEmpty);
+    }
+
+
+    [Fact]
+    public async Task RawData_Serialize_LeavesMemoryBackedValueUnchanged() {
+        var buffer = Enumerable.Range(0, 300).Select(i => (byte)(i * 7)).ToArray();
+        var raw = new RawData(buffer.AsMemory(10, 257));
+
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection { { "blob", raw } });
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAutoAsync(dump, tempFile);
+            Assert.False(raw.IsPacked);
+            Assert.Equal(buffer.AsSpan(10, 257).ToArray(), raw.Memory.ToArray());
+
+            var result = await Fon.DeserializeFromFileAutoAsync(tempFile);
+            var loaded = result[0].Get<RawData>("blob")!;
+            Assert.True(loaded.IsPacked);
+            Assert.Equal(raw.data, loaded.Unpack().data);
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+    [Fact]
+    public async Task RawData_LazyUnpack_DecodesOnFirstAccess() {
+        var originalData = new byte[] { 1, 2, 3, 4, 5 };
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection { { "blob", new RawData(originalData.ToArray()) } });
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        var originalMode = Fon.RawUnpack;
+        try {
+            await Fon.SerializeToFileAutoAsync(dump, tempFile);
+
+            Fon.RawUnpack = RawUnpackMode.Lazy;
+            var result = await Fon.DeserializeFromFileAutoAsync(tempFile);
+
+            var loaded = result[0].Get<RawData>("blob")!;
+            Assert.True(loaded.IsPacked);
+            Assert.Equal(originalData, loaded.data);
+            Assert.False(loaded.IsPacked);
+
+            // Packing releases the decode; the next read decodes again
+            Assert.True(loaded.Pack().IsPacked);
+            Assert.Equal(originalData, loaded.Memory.ToArray());
+            Assert.False(loaded.IsPacked);
+        } finally {
+            Fon.RawUnpack = originalMode;
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public void FonDump_UnpackRawParallel_DecodesNestedValues() {
+        var encoded = Enumerable.Range(0, 5)
+            .Select(i => new RawData(Enumerable.Repeat((byte)i, 100 + i).ToArray()).Pack().encoded)
+            .ToArray();
+
+        var dump = new FonDump();
+        for (ulong id = 0; id < 50; id++) {
+            dump.TryAdd(id, new FonCollection {
+                { "blob", new RawData(encoded[0].AsSpan()) },
+                { "list", new List<RawData> { new(encoded[1].AsSpan()), new(encoded[2].AsSpan()) } },
+                { "meta", new FonCollection { { "inner", new RawData(encoded[3].AsSpan()) } } },
+                { "items", new List<FonCollection> { new() { { "x", new RawData(encoded[4].AsSpan()) } } } }
+            });
+        }
+
+        Assert.Equal(250, dump.UnpackRawParallel());
+        Assert.Equal(0, dump.UnpackRawParallel());
+
+        var record = dump[49];
+        Assert.Equal(Enumerable.Repeat((byte)0, 100), record.Get<RawData>("blob").Memory.ToArray());
+        Assert.Equal(Enumerable.Repeat((byte)2, 102), record.Get<List<RawData>>("list")[1].data);
+        Assert.Equal(Enumerable.Repeat((byte)3, 103), record.Get<FonCollection>("meta").Get<RawData>("inner").data);
+        Assert.Equal(Enumerable.Repeat((byte)4, 104), record.Get<List<FonCollection>>("items")[0].Get<RawData>("x").data);
+    }
 }
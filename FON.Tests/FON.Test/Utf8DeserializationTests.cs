@@ -0,0 +1,534 @@
+using System.Buffers;
+using System.Text;
+using FON.Core;
+using FON.Types;
+
+namespace FON.Test;
+
+
+public class Utf8DeserializationTests {
+    private static async Task<FonDump> LoadAsync(byte[] content, FonReadOptions? options = null, bool chunked = false) {
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await File.WriteAllBytesAsync(tempFile.FullName, content);
+            return chunked
+                ? await Fon.DeserializeFromFileChunkedAsync(tempFile, options: options)
+                : await Fon.DeserializeFromFileAsync(tempFile, options: options);
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task Deserialize_CrLfLineEndings_TrimsCarriageReturn() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("a=i:1\r\nb=s:\"two\"\r\n"));
+
+        Assert.Equal(2, loaded.Count);
+        Assert.Equal(1, loaded[0].Get<int>("a"));
+        Assert.Equal("two", loaded[1].Get<string>("b"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_LeadingBom_IsSkipped() {
+        var loaded = await LoadAsync([0xEF, 0xBB, 0xBF, .. Encoding.UTF8.GetBytes("id=i:7\n")]);
+
+        Assert.Equal(7, loaded[0].Get<int>("id"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_EmptyLines_KeepLineIndices() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("x=i:0\n\nx=i:2"));
+
+        Assert.Equal(2, loaded.Count);
+        Assert.Equal(0, loaded[0].Get<int>("x"));
+        Assert.Null(loaded.TryGet(1));
+        Assert.Equal(2, loaded[2].Get<int>("x"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_MultiByteUtf8_DecodesStrings() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("text=s:\"Привет 🌍\",list=s:[\"你好\",\"a\\\"b\"]\n"));
+
+        Assert.Equal("Привет 🌍", loaded[0].Get<string>("text"));
+        Assert.Equal(new List<string> { "你好", "a\"b" }, loaded[0].Get<List<string>>("list"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_SpecialFloatingPointValues_Parse() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("a=d:NaN,b=d:-Infinity,c=f:1E+20,d=d:-0.5\n"));
+
+        Assert.True(double.IsNaN(loaded[0].Get<double>("a")));
+        Assert.Equal(double.NegativeInfinity, loaded[0].Get<double>("b"));
+        Assert.Equal(1e20f, loaded[0].Get<float>("c"));
+        Assert.Equal(-0.5, loaded[0].Get<double>("d"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_InvalidNumber_Throws() {
+        var ex = await Assert.ThrowsAsync<AggregateException>(() => LoadAsync(Encoding.UTF8.GetBytes("a=i:12x\n")));
+        Assert.IsType<FormatException>(ex.InnerException);
+    }
+
+
+    [Fact]
+    public async Task RoundTrip_StringEndingWithBackslash_InNestedObject() {
+        var dump = new FonDump();
+        dump.TryAdd(0, new FonCollection {
+            { "wrap", new FonCollection { { "path", "C:\\dir\\" } } },
+            { "after", 5 }
+        });
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAsync(dump, tempFile);
+            var loaded = await Fon.DeserializeFromFileAsync(tempFile);
+
+            Assert.Equal("C:\\dir\\", loaded[0].Get<FonCollection>("wrap").Get<string>("path"));
+            Assert.Equal(5, loaded[0].Get<int>("after"));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task DeserializeChunked_EscapedBackslashBeforeQuote_FindsClosingBrackets() {
+        // The char-path scanners must not read \\" as an escaped quote
+        var line = "wrap=o:{path=s:\"C:\\\\dir\\\\\",tags=s:[\"a]\\\\\",\"}\"]},items=o:[{n=i:1},{n=i:2}],after=i:5\n";
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes(line), chunked: true);
+
+        var wrap = loaded[0].Get<FonCollection>("wrap");
+        Assert.Equal("C:\\dir\\", wrap.Get<string>("path"));
+        Assert.Equal(new List<string> { "a]\\", "}" }, wrap.Get<List<string>>("tags"));
+        Assert.Equal(2, loaded[0].Get<List<FonCollection>>("items").Count);
+        Assert.Equal(5, loaded[0].Get<int>("after"));
+    }
+
+
+    private const string PrimitiveArrayLine =
+        "i=i:[2147483647,-2147483648,0,+5,0012345678],l=l:[9223372036854775807,-9223372036854775808,123456789012345678]," +
+        "e=e:[255,0],t=t:[-32768,32767],u=u:[4294967295],g=g:[18446744073709551615],d=d:[0.5,-1E+300],f=f:[1.25,]," +
+        "b=b:[1,0,1],empty=i:[]\n";
+
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task Deserialize_PrimitiveArrays_ParseIntoTypedLists(bool chunked) {
+        var record = (await LoadAsync(Encoding.UTF8.GetBytes(PrimitiveArrayLine), chunked: chunked))[0];
+
+        Assert.Equal(new List<int> { int.MaxValue, int.MinValue, 0, 5, 12345678 }, record.Get<List<int>>("i"));
+        Assert.Equal(new List<long> { long.MaxValue, long.MinValue, 123456789012345678 }, record.Get<List<long>>("l"));
+        Assert.Equal(new List<byte> { 255, 0 }, record.Get<List<byte>>("e"));
+        Assert.Equal(new List<short> { short.MinValue, short.MaxValue }, record.Get<List<short>>("t"));
+        Assert.Equal(new List<uint> { uint.MaxValue }, record.Get<List<uint>>("u"));
+        Assert.Equal(new List<ulong> { ulong.MaxValue }, record.Get<List<ulong>>("g"));
+        Assert.Equal(new List<double> { 0.5, -1e300 }, record.Get<List<double>>("d"));
+        Assert.Equal(new List<float> { 1.25f }, record.Get<List<float>>("f"));
+        Assert.Equal(new List<bool> { true, false, true }, record.Get<List<bool>>("b"));
+        Assert.Empty(record.Get<List<int>>("empty"));
+    }
+
+
+    [Theory]
+    [InlineData("x=i:[1,2147483648]")]
+    [InlineData("x=e:[256]")]
+    [InlineData("x=l:[1,,2]")]
+    [InlineData("x=i:[12345678x]")]
+    public async Task Deserialize_InvalidPrimitiveArray_Throws(string line) {
+        await Assert.ThrowsAnyAsync<Exception>(() => LoadAsync(Encoding.UTF8.GetBytes(line)));
+    }
+
+
+    [Fact]
+    public void PrimitiveArrays_SpanAccessAndBothWriters_Agree() {
+        var samples = Enumerable.Range(0, 1000).Select(i => i * 0.25 - 100).ToArray();
+        var collection = new FonCollection();
+        collection.AddArray<double>("samples", samples);
+        collection.AddArray<long>("ids", [1L, -2L, long.MaxValue]);
+        collection.Add("flags", new List<bool> { true, false });
+
+        Assert.True(collection.GetSpan<double>("samples").SequenceEqual(samples));
+        // The span views the stored list, nothing is copied
+        collection.Get<List<double>>("samples")[0] = 42;
+        Assert.Equal(42, collection.GetSpan<double>("samples")[0]);
+
+        var text = Fon.SerializeToString(collection);
+        var buffer = new ArrayBufferWriter<byte>();
+        Fon.Serialize(collection, buffer);
+
+        Assert.Equal(text, Encoding.UTF8.GetString(buffer.WrittenSpan));
+        Assert.Contains("ids=l:[1,-2,9223372036854775807]", text);
+        Assert.Contains("flags=b:[1,0]", text);
+        Assert.StartsWith("samples=d:[42,-99.75,-99.5,", text);
+    }
+
+
+    [Fact]
+    public void FonObject_CheckKeyName_AcceptsOnlyWhitelistedChars() {
+        Assert.True(FonObject.CheckKeyName("snake_case-Key09"));
+        Assert.True(FonObject.CheckKeyName(new string('k', 100)));
+        Assert.False(FonObject.CheckKeyName("with space"));
+        Assert.False(FonObject.CheckKeyName("ключ"));
+        Assert.False(FonObject.CheckKeyName(new string('k', 100) + "="));
+    }
+
+
+    private static async Task<List<(ulong id, FonCollection record)>> ReadAllAsync(byte[] content, int? maxDop = null) {
+        var records = new List<(ulong id, FonCollection record)>();
+        await foreach (var item in Fon.ReadRecordsAsync(new MemoryStream(content), maxDop)) {
+            records.Add(item);
+        }
+        return records;
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_BomCrLfAndEmptyLines_KeepLineIds() {
+        var records = await ReadAllAsync([0xEF, 0xBB, 0xBF, .. Encoding.UTF8.GetBytes("x=i:0\r\n\r\nx=i:2\r\nx=i:3")]);
+
+        Assert.Equal([0UL, 2UL, 3UL], records.Select(r => r.id));
+        Assert.Equal([0, 2, 3], records.Select(r => r.record.Get<int>("x")));
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_SpansManyBlocks_YieldsEveryLineInOrder() {
+        // Roughly 6MB of lines: crosses the 4MB block boundary mid-line and includes one line longer than a block
+        var sb = new StringBuilder();
+        const int lines = 120_000;
+        for (int i = 0; i < lines; i++) {
+            sb.Append("id=i:").Append(i).Append(",pad=s:\"").Append('x', 40).Append("\"\n");
+        }
+        sb.Append("big=s:\"").Append('y', 5 * 1024 * 1024).Append("\"\n");
+        sb.Append("id=i:-1\n");
+
+        var records = await ReadAllAsync(Encoding.UTF8.GetBytes(sb.ToString()), maxDop: 2);
+
+        Assert.Equal(lines + 2, records.Count);
+        for (int i = 0; i < lines; i++) {
+            Assert.Equal((ulong)i, records[i].id);
+            Assert.Equal(i, records[i].record.Get<int>("id"));
+        }
+        Assert.Equal(5 * 1024 * 1024, records[lines].record.Get<string>("big").Length);
+        Assert.Equal(-1, records[lines + 1].record.Get<int>("id"));
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_FromFile_MatchesDeserializeFromFile() {
+        var dump = new FonDump();
+        for (ulong i = 0; i < 500; i++) {
+            dump.TryAdd(i, new FonCollection { { "id", (long)i }, { "name", $"n{i}" } });
+        }
+
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await Fon.SerializeToFileAsync(dump, tempFile);
+
+            ulong expected = 0;
+            await foreach (var (id, record) in Fon.ReadRecordsAsync(tempFile)) {
+                Assert.Equal(expected, id);
+                Assert.Equal($"n{id}", record.Get<string>("name"));
+                expected++;
+            }
+            Assert.Equal(500UL, expected);
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_InvalidLine_ThrowsFormatException() {
+        await Assert.ThrowsAsync<FormatException>(() => ReadAllAsync(Encoding.UTF8.GetBytes("a=i:1\na=i:12x\n")));
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_EarlyBreak_StopsReading() {
+        var content = Encoding.UTF8.GetBytes(string.Concat(Enumerable.Range(0, 1000).Select(i => $"id=i:{i}\n")));
+
+        await foreach (var (id, record) in Fon.ReadRecordsAsync(new MemoryStream(content))) {
+            Assert.Equal(0UL, id);
+            break;
+        }
+    }
+
+
+    private const string ProjectionLine =
+        "id=i:7,note=s:\"a \\\"quoted\\\" ]}, text\",blob=r:\"nm=QNzY&b1A+]nf\",meta=o:{owner=s:\"ann\",tags=s:[\"x]\",\"y\"],size=i:3}," +
+        "items=o:[{a=i:1,b=s:\"}\"},{a=i:2}],scores=d:[1.5,2.5],name=s:\"last\"\n";
+
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task ReadOptions_TopLevelKeys_SkipsEverythingElse(bool chunked) {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes(ProjectionLine), new FonReadOptions("name", "id"), chunked);
+
+        var record = loaded[0];
+        Assert.Equal(2, record.Count);
+        Assert.Equal(7, record.Get<int>("id"));
+        Assert.Equal("last", record.Get<string>("name"));
+        Assert.Null(record.TryGet("meta"));
+    }
+
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task ReadOptions_DottedPaths_DescendIntoObjectsAndObjectArrays(bool chunked) {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes(ProjectionLine), new FonReadOptions("meta.owner", "items.a", "scores"), chunked);
+
+        var record = loaded[0];
+        var meta = record.Get<FonCollection>("meta");
+        Assert.Equal(1, meta.Count);
+        Assert.Equal("ann", meta.Get<string>("owner"));
+
+        var items = record.Get<List<FonCollection>>("items");
+        Assert.Equal([1, 2], items.Select(item => item.Get<int>("a")));
+        Assert.Equal([1, 1], items.Select(item => item.Count));
+
+        Assert.Equal(new List<double> { 1.5, 2.5 }, record.Get<List<double>>("scores"));
+    }
+
+
+    [Fact]
+    public async Task ReadOptions_ShorterPathWins_KeepsWholeObject() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes(ProjectionLine), new FonReadOptions("meta.owner", "meta"));
+
+        Assert.Equal(3, loaded[0].Get<FonCollection>("meta").Count);
+    }
+
+
+    [Fact]
+    public async Task ReadRecordsAsync_WithReadOptions_ProjectsEveryRecord() {
+        var content = Encoding.UTF8.GetBytes(ProjectionLine + "\n" + ProjectionLine);
+
+        var records = new List<(ulong id, FonCollection record)>();
+        await foreach (var item in Fon.ReadRecordsAsync(new MemoryStream(content), options: new FonReadOptions("id"))) {
+            records.Add(item);
+        }
+
+        Assert.Equal([0UL, 2UL], records.Select(r => r.id));
+        Assert.Equal([1, 1], records.Select(r => r.record.Count));
+    }
+
+
+    [Fact]
+    public void ReadOptions_InvalidKeys_Throw() {
+        Assert.Throws<ArgumentException>(() => new FonReadOptions());
+        Assert.Throws<ArgumentException>(() => new FonReadOptions("a..b"));
+        Assert.Throws<ArgumentException>(() => new FonReadOptions(""));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_RepeatedSchema_SharesKeyStrings() {
+        var tempFile = new FileInfo(Path.GetTempFileName());
+        try {
+            await File.WriteAllTextAsync(tempFile.FullName, "id=i:1,name=s:\"a\"\nid=i:2,name=s:\"b\"\nother=i:3\nid=i:4,name=s:\"d\"\n");
+            // One thread, so every record goes through the same key table
+            var loaded = await Fon.DeserializeFromFileAsync(tempFile, maxDegreeOfParallelism: 1);
+
+            var first = loaded[0].Select(e => e.Key).ToArray();
+            var last = loaded[3].Select(e => e.Key).ToArray();
+            Assert.Equal(["id", "name"], last);
+            Assert.Same(first[0], last[0]);
+            Assert.Same(first[1], last[1]);
+            Assert.Equal(3, loaded[2].Get<int>("other"));
+            Assert.Equal("d", loaded[3].Get<string>("name"));
+        } finally {
+            tempFile.Delete();
+        }
+    }
+
+
+    [Fact]
+    public async Task Deserialize_SharedShape_ChangingOneRecordLeavesOthersIntact() {
+        // More keys than the linear-scan limit, so the shared shape carries a hash index too
+        var line = string.Join(",", Enumerable.Range(0, 12).Select(i => $"k{i}=i:{i}"));
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes(line + "\n" + line + "\n" + line + "\n" + "k0=i:0,k1=i:1\n"));
+
+        loaded[0].Add("extra", 1);
+        Assert.True(loaded[1].Remove("k3"));
+        loaded[2]["k5"] = 50;
+
+        Assert.Equal(13, loaded[0].Count);
+        Assert.Equal(1, loaded[0].Get<int>("extra"));
+        Assert.Equal(11, loaded[1].Count);
+        Assert.Null(loaded[1].TryGetNullable<int>("k3"));
+        Assert.Equal(11, loaded[1].Get<int>("k11"));
+        Assert.Equal(12, loaded[2].Count);
+        Assert.Equal(50, loaded[2].Get<int>("k5"));
+        Assert.Equal(5, loaded[1].Get<int>("k5"));
+        Assert.Null(loaded[2].TryGetNullable<int>("extra"));
+        Assert.Equal(3, loaded[2].Get<int>("k3"));
+        Assert.Equal(["k0", "k1"], loaded[3].Select(e => e.Key));
+    }
+
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task FloatingPoint_WritersMatchBclAndParseBackBitExact(bool chunked) {
+        var random = new Random(24);
+        var doubles = new List<double> { 0, -0.0, 1, -42, 999_999_999_999_999, 1e15, 0.1, 1e-7, 1e21, 5e-324, double.MaxValue, double.NaN, double.NegativeInfinity };
+        var floats = new List<float> { 0, -0f, 9_999_999, 1e7f, 0.3f, 1e-10f, float.MaxValue, float.Epsilon, float.PositiveInfinity };
+        while (doubles.Count < 1000) {
+            // NaN payloads do not survive "NaN", so random bit patterns stay finite
+            var d = BitConverter.Int64BitsToDouble(random.NextInt64(long.MinValue, long.MaxValue));
+            var f = BitConverter.Int32BitsToSingle(random.Next(int.MinValue, int.MaxValue));
+            if (double.IsFinite(d) && float.IsFinite(f)) {
+                doubles.Add(d);
+                floats.Add(f);
+            }
+            doubles.Add(Math.Round(random.NextDouble() * 1000 - 500, random.Next(6)));
+            floats.Add((float)Math.Round(random.NextDouble() * 100, random.Next(4)));
+        }
+
+        var collection = new FonCollection { { "d", doubles }, { "f", floats }, { "one", -7.0 }, { "half", 0.5f } };
+        var text = Fon.SerializeToString(collection);
+        var buffer = new ArrayBufferWriter<byte>();
+        Fon.Serialize(collection, buffer);
+
+        Assert.Equal(text, Encoding.UTF8.GetString(buffer.WrittenSpan));
+        Assert.Contains("d=d:[" + string.Join(",", doubles.Select(d => d.ToString(System.Globalization.CultureInfo.InvariantCulture))) + "]", text);
+        Assert.Contains("f=f:[" + string.Join(",", floats.Select(f => f.ToString(System.Globalization.CultureInfo.InvariantCulture))) + "]", text);
+
+        var loaded = (await LoadAsync(buffer.WrittenSpan.ToArray(), chunked: chunked))[0];
+        Assert.Equal(doubles.Select(BitConverter.DoubleToInt64Bits), loaded.Get<List<double>>("d").Select(BitConverter.DoubleToInt64Bits));
+        Assert.Equal(floats.Select(BitConverter.SingleToInt32Bits), loaded.Get<List<float>>("f").Select(BitConverter.SingleToInt32Bits));
+        Assert.Equal(-7.0, loaded.Get<double>("one"));
+        Assert.Equal(0.5f, loaded.Get<float>("half"));
+    }
+
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public async Task FloatingPoint_ForeignSpellings_ParseLikeTheBcl(bool chunked) {
+        // Forms other writers (the Rust crate among them) print, including mantissas too long for the fast path
+        string[] values = ["1e-7", "1E+21", "-0", ".5", "5.", "0.000001234", "123456789012345678901234", "2.2250738585072014e-308", "9007199254740993"];
+        var line = string.Join(",", values.Select((v, i) => $"d{i}=d:{v},f{i}=f:{v}")) + ",pinf=d:inf,ninf=f:-inf,arr=d:[inf,-1.5e3]";
+
+        var loaded = (await LoadAsync(Encoding.UTF8.GetBytes(line), chunked: chunked))[0];
+
+        for (int i = 0; i < values.Length; i++) {
+            var expected = double.Parse(values[i], System.Globalization.CultureInfo.InvariantCulture);
+            Assert.Equal(BitConverter.DoubleToInt64Bits(expected), BitConverter.DoubleToInt64Bits(loaded.Get<double>($"d{i}")));
+            Assert.Equal(float.Parse(values[i], System.Globalization.CultureInfo.InvariantCulture), loaded.Get<float>($"f{i}"));
+        }
+        Assert.Equal(double.PositiveInfinity, loaded.Get<double>("pinf"));
+        Assert.Equal(float.NegativeInfinity, loaded.Get<float>("ninf"));
+        Assert.Equal(new List<double> { double.PositiveInfinity, -1500 }, loaded.Get<List<double>>("arr"));
+    }
+
+
+    [Fact]
+    public async Task Deserialize_LongLines_StructuralIndexMatchesCharParser() {
+        // Long enough to be indexed; the filler moves quotes and backslash runs across the 64-byte blocks
+        var builder = new StringBuilder();
+        for (int pad = 0; pad < 130; pad++) {
+            var filler = new string('x', pad);
+            builder.Append($$$"""pad=s:"{{{filler}}}",a=s:"\\",b=s:"q\"],{\\\"",deep=o:[{k=o:{s=s:["]}\"","{{{filler}}}\\"],n=i:[1,2]}},{k=o:{}}],path=s:"C:\\dir\\",r=s:"{{{filler}}}\\\\",last=i:{{{pad}}}""");
+            builder.Append('\n');
+        }
+        var content = Encoding.UTF8.GetBytes(builder.ToString());
+
+        var loaded = await LoadAsync(content);
+        var expected = await LoadAsync(content, chunked: true);
+        using var document = FonDocument.Parse(content);
+
+        Assert.Equal(130, loaded.Count);
+        Assert.Equal(130, document.Count);
+        for (int i = 0; i < 130; i++) {
+            var line = Fon.SerializeToString(expected[(ulong)i]);
+            Assert.Equal(line, Fon.SerializeToString(loaded[(ulong)i]));
+            Assert.Equal(line, Fon.SerializeToString(document[i].ToCollection()));
+
+            var record = document[i];
+            Assert.Equal("\\", record.Get<string>("a"));
+            Assert.Equal("q\"],{\\\"", record.Get<string>("b"));
+            Assert.Equal("C:\\dir\\", record.Get<string>("path"));
+            Assert.Equal(i, record.Get<int>("last"));
+            var deep = record.GetObjects("deep");
+            Assert.Equal(2, deep.Count);
+            Assert.Equal(new List<string> { "]}\"", new string('x', i) + "\\" }, deep[0].GetObject("k").Get<List<string>>("s"));
+            Assert.Equal(0, deep[1].GetObject("k").Count);
+        }
+
+        var unterminated = Encoding.UTF8.GetBytes("items=o:[{n=s:\"" + new string('x', 100) + "]},after=i:1");
+        Assert.Throws<FormatException>(() => Fon.DeserializeInto(unterminated, new FonCollection()));
+    }
+
+
+    [Fact]
+    public void DeserializeInto_WithPool_ReusesNestedCollectionsAndLists() {
+        var pool = new FonCollectionPool();
+        var target = pool.Rent();
+        Fon.DeserializeInto("id=i:1,owner=o:{n=i:1},items=o:[{n=i:2},{n=i:3}],ints=i:[1,2,3]"u8, target, pool);
+        var owner = target.Get<FonCollection>("owner");
+        var ints = target.Get<List<int>>("ints");
+
+        var line = "id=i:2,owner=o:{n=i:4,m=d:0.5},items=o:[{n=i:5}],ints=i:[7]"u8;
+        Fon.DeserializeInto(line, target, pool);
+
+        Assert.Same(owner, target.Get<FonCollection>("owner"));
+        Assert.Same(ints, target.Get<List<int>>("ints"));
+        Assert.Equal(Encoding.UTF8.GetString(line), Fon.SerializeToString(target));
+
+        // Once warm, a parse-serialize-return loop over a record without strings allocates nothing
+        var buffer = new ArrayBufferWriter<byte>(256);
+        for (int i = 0; i < 100; i++) {
+            Fon.DeserializeInto(line, target, pool);
+            Fon.Serialize(target, buffer);
+            buffer.ResetWrittenCount();
+        }
+        var before = GC.GetAllocatedBytesForCurrentThread();
+        for (int i = 0; i < 1000; i++) {
+            Fon.DeserializeInto(line, target, pool);
+            Fon.Serialize(target, buffer);
+            buffer.ResetWrittenCount();
+        }
+        Assert.True(GC.GetAllocatedBytesForCurrentThread() - before < 1024);
+    }
+
+
+    [Fact]
+    public async Task Reset_SharedShapeRecord_LeavesOtherRecordsIntact() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("a=i:1,b=i:2\na=i:3,b=i:4\n"));
+
+        loaded[0].Reset();
+        Assert.Equal(0, loaded[0].Count);
+        loaded[0].Add("c", 5);
+
+        Assert.Equal(["c"], loaded[0].Select(e => e.Key));
+        Assert.Equal(["a", "b"], loaded[1].Select(e => e.Key));
+        Assert.Equal(4, loaded[1].Get<int>("b"));
+    }
+
+
+    [Fact]
+    public async Task Pool_ReturnDump_EmptiesDumpAndRecyclesRecords() {
+        var loaded = await LoadAsync(Encoding.UTF8.GetBytes("a=i:1\nb=o:{c=i:2}\n"));
+        var records = loaded.Select(e => e.Value).ToList();
+        var pool = new FonCollectionPool(capacity: 4);
+
+        pool.Return(loaded);
+
+        Assert.Equal(0, loaded.Count);
+        var rented = pool.Rent();
+        Assert.Contains(rented, records);
+        Assert.Equal(0, rented.Count);
+        loaded.Add(0, rented);
+        Assert.Equal(1, loaded.Count);
+    }
+}
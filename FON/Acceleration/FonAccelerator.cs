@@ -3,36 +3,39 @@ namespace FON.Acceleration;
 
 /// <summary>
 /// Manages native acceleration for FON serialization.
-/// Automatically detects and uses native library if available.
+/// The native package registers its <see cref="IFonBackend"/> here when it is loaded (module
+/// initializer), or explicitly at startup; no reflection or assembly probing is involved, so
+/// detection works under trimming and NativeAOT.
 /// </summary>
 public static class FonAccelerator {
-    private static bool? _isAvailable;
-    private static string? _version;
+    private static IFonBackend? _backend;
 
 
     /// <summary>
-    /// Check if native acceleration is available.
+    /// The registered backend, available or not (null if none was registered).
+    /// </summary>
+    public static IFonBackend? Backend => Volatile.Read(ref _backend);
+
+
+    /// <summary>
+    /// Installs <paramref name="backend"/>, replacing any previous one.
     /// </summary>
-    public static bool IsAvailable {
-        get {
-            _isAvailable ??= CheckNativeAvailability();
-            return _isAvailable.Value;
-        }
+    public static void Register(IFonBackend backend) {
+        ArgumentNullException.ThrowIfNull(backend);
+        Volatile.Write(ref _backend, backend);
     }
 
 
+    /// <summary>
+    /// Check if native acceleration is available.
+    /// </summary>
+    public static bool IsAvailable => Backend?.IsAvailable ?? false;
+
+
     /// <summary>
     /// Native library version (null if not available).
     /// </summary>
-    public static string? Version {
-        get {
-            if (!IsAvailable) {
-                return null;
-            }
-            _version ??= GetNativeVersion();
-            return _version;
-        }
-    }
+    public static string? Version => Backend is { IsAvailable: true } backend ? backend.Version : null;
 
 
     /// <summary>
@@ -47,40 +50,8 @@ public static class FonAccelerator {
     internal static bool ShouldUseNative => !ForceManaged && IsAvailable;
 
 
-
-    private static bool CheckNativeAvailability() {
-        try {
-            var runtimeAssembly = System.Reflection.Assembly.Load("FON.Native.Runtime");
-            if (runtimeAssembly == null) {
-                return false;
-            }
-
-            var loaderType = runtimeAssembly.GetType("FON.Native.NativeLoader");
-            if (loaderType == null) {
-                return false;
-            }
-
-            var isAvailableProp = loaderType.GetProperty("IsAvailable");
-            if (isAvailableProp == null) {
-                return false;
-            }
-
-            return (bool)(isAvailableProp.GetValue(null) ?? false);
-        } catch {
-            return false;
-        }
-    }
-
-
-
-    private static string? GetNativeVersion() {
-        try {
-            var runtimeAssembly = System.Reflection.Assembly.Load("FON.Native.Runtime");
-            var loaderType = runtimeAssembly?.GetType("FON.Native.NativeLoader");
-            var getVersionMethod = loaderType?.GetMethod("GetVersion");
-            return getVersionMethod?.Invoke(null, null) as string;
-        } catch {
-            return null;
-        }
-    }
+    /// <summary>
+    /// Backend the Auto methods should offer work to, or null for the managed path.
+    /// </summary>
+    internal static IFonBackend? ActiveBackend => ShouldUseNative ? Backend : null;
 }
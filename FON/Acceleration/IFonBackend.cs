@@ -0,0 +1,42 @@
+using FON.Core;
+using FON.Types;
+
+namespace FON.Acceleration;
+
+
+/// <summary>
+/// Alternative implementation of the bulk file operations, e.g. the native library
+/// (FON.Native.Runtime). Registered with <see cref="FonAccelerator.Register"/>; while it is
+/// available and <see cref="FonAccelerator.ForceManaged"/> is off, the Auto methods
+/// (<see cref="Fon.SerializeToFileAutoAsync"/>, <see cref="Fon.DeserializeFromFileAutoAsync"/>)
+/// offer it the work first.
+/// </summary>
+/// <remarks>
+/// The Try methods run on the thread pool and may decline any call (e.g. a value type the backend
+/// cannot represent); the managed implementation then handles it, so results never depend on
+/// whether a backend is installed.
+/// </remarks>
+public interface IFonBackend {
+    string Name { get; }
+
+    /// <summary>
+    /// False when the backend cannot run in this process (e.g. the native binary is missing).
+    /// Checked lazily, before the first dispatch.
+    /// </summary>
+    bool IsAvailable { get; }
+
+    string? Version { get; }
+
+
+    /// <summary>
+    /// Writes <paramref name="dump"/> to <paramref name="file"/> as UTF-8 lines in id order,
+    /// the same text the managed serializers produce. Returns false to decline.
+    /// </summary>
+    bool TrySerializeToFile(FonDump dump, FileInfo file, int maxDegreeOfParallelism);
+
+    /// <summary>
+    /// Parses <paramref name="file"/> into a new dump keyed by line number, honoring
+    /// <paramref name="options"/> like the managed parser does. Returns null to decline.
+    /// </summary>
+    FonDump? TryDeserializeFromFile(FileInfo file, FonReadOptions? options, int maxDegreeOfParallelism);
+}
@@ -4,7 +4,19 @@ namespace FON.Core;
 
 
 public partial class Fon {
-    public static bool DeserializeRawUnpack { get; set; } = false;
+    /// <summary>
+    /// What the deserializers do with RawData values. Default: <see cref="RawUnpackMode.None"/>.
+    /// </summary>
+    public static RawUnpackMode RawUnpack { get; set; } = RawUnpackMode.None;
+
+    /// <summary>
+    /// True when RawData is decoded while parsing; shorthand for <see cref="RawUnpack"/> ==
+    /// <see cref="RawUnpackMode.Eager"/> (false sets <see cref="RawUnpackMode.None"/>).
+    /// </summary>
+    public static bool DeserializeRawUnpack {
+        get => RawUnpack == RawUnpackMode.Eager;
+        set => RawUnpack = value ? RawUnpackMode.Eager : RawUnpackMode.None;
+    }
 
 
     private static int maxDepth = 64;
@@ -24,6 +36,38 @@ public partial class Fon {
     }
 
 
+    /// <summary>
+    /// When set, parsed collections with the same keys in the same order as the previous one share a single
+    /// key array and lookup index instead of each holding a copy. Keys are interned either way. Default: true.
+    /// </summary>
+    public static bool ShareKeyShapes { get; set; } = true;
+
+
+    /// <summary>
+    /// When set, the file serializers also write a <see cref="FonLineIndex"/> sidecar (<c>data.fon.idx</c>)
+    /// for <see cref="ReadRangeAsync"/>. When null (the default) a sidecar left from an earlier write is removed.
+    /// </summary>
+    public static FonLineIndexOptions? LineIndex { get; set; }
+
+
+    /// <summary>
+    /// When set, <see cref="SerializeToFileAutoAsync"/> and <see cref="DeserializeFromFileAutoAsync"/> time
+    /// every managed call and pick the strategy (and chunk size) that was fastest for inputs of that size,
+    /// instead of the fixed <see cref="ParallelMethodThreshold"/> and <see cref="MappedFileThreshold"/>.
+    /// The first calls of each size class try every strategy once. Default: false.
+    /// </summary>
+    public static bool AdaptiveTuning { get; set; }
+
+
+    /// <summary>
+    /// Forgets the throughput <see cref="AdaptiveTuning"/> has observed, e.g. after the data moved to other storage.
+    /// </summary>
+    public static void ResetAdaptiveTuning() {
+        serializeTuner.Reset();
+        deserializeTuner.Reset();
+    }
+
+
     public static readonly Dictionary<Type, char> SupportTypes = new() {
         { typeof(byte),         'e' },
         { typeof(short),        't' },
@@ -52,10 +96,32 @@ public partial class Fon {
 
 
 
-    private static Type? GetType(char type) {
-        if (!SupportTypes.ContainsValue(type)) {
-            return null;
+    internal static Type? GetType(char type) {
+        // Runs once per parsed key, so the built-in codes skip the dictionary scan (and its allocations)
+        return type switch {
+            'e' => typeof(byte),
+            't' => typeof(short),
+            'i' => typeof(int),
+            'u' => typeof(uint),
+            'l' => typeof(long),
+            'g' => typeof(ulong),
+            'f' => typeof(float),
+            'd' => typeof(double),
+            's' => typeof(string),
+            'b' => typeof(bool),
+            'r' => typeof(RawData),
+            'o' => typeof(FonCollection),
+            _ => FindSupportType(type)
+        };
+    }
+
+
+    private static Type? FindSupportType(char type) {
+        foreach (var (supported, code) in SupportTypes) {
+            if (code == type) {
+                return supported;
+            }
         }
-        return SupportTypes.FirstOrDefault(x => x.Value == type).Key;
+        return null;
     }
 }
@@ -0,0 +1,118 @@
+using System.Diagnostics;
+using System.Numerics;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Strategy picker behind <see cref="Fon.AdaptiveTuning"/>. Calls are grouped by size (record count
+/// or file bytes) into power-of-two buckets; per bucket every strategy ("arm") keeps a moving average
+/// of the throughput it achieved. A bucket first tries each arm once, the fixed-threshold choice
+/// first, then keeps taking the fastest one and re-tries the least sampled arm every
+/// <see cref="ExploreEvery"/>th call so a changed machine or disk is noticed.
+/// </summary>
+internal sealed class FonAutoTuner {
+    /// <summary>
+    /// Weight of the newest sample in the moving average.
+    /// </summary>
+    private const double Alpha = 0.3;
+
+    private const int ExploreEvery = 16;
+
+    private readonly string[] arms;
+    private readonly Dictionary<int, Bucket> buckets = [];
+    private readonly object sync = new();
+
+
+    public FonAutoTuner(params string[] arms) {
+        this.arms = arms;
+    }
+
+
+    public string this[int arm] => arms[arm];
+
+
+
+    /// <summary>
+    /// Arm for the next call of <paramref name="size"/>, out of the first <paramref name="candidates"/>
+    /// (all by default). <paramref name="fallback"/> is what the fixed thresholds would pick.
+    /// </summary>
+    public int Choose(long size, int fallback, int candidates = int.MaxValue) {
+        candidates = Math.Min(candidates, arms.Length);
+        if (candidates <= 1) {
+            return fallback;
+        }
+
+        lock (sync) {
+            var bucket = GetBucket(size);
+            bucket.Calls++;
+
+            if (bucket.Samples[fallback] == 0) {
+                return fallback;
+            }
+
+            var best = fallback;
+            var least = fallback;
+            for (int arm = 0; arm < candidates; arm++) {
+                if (bucket.Samples[arm] == 0) {
+                    return arm;
+                }
+                if (bucket.Throughput[arm] > bucket.Throughput[best]) {
+                    best = arm;
+                }
+                if (bucket.Samples[arm] < bucket.Samples[least]) {
+                    least = arm;
+                }
+            }
+
+            return bucket.Calls % ExploreEvery == 0 ? least : best;
+        }
+    }
+
+
+    /// <summary>
+    /// Feeds back <paramref name="amount"/> (records or bytes) processed by <paramref name="arm"/>
+    /// since <paramref name="startTimestamp"/>.
+    /// </summary>
+    public void Record(long size, int arm, long amount, long startTimestamp) {
+        var seconds = Stopwatch.GetElapsedTime(startTimestamp).TotalSeconds;
+        if (seconds <= 0) {
+            return;
+        }
+        var throughput = amount / seconds;
+
+        lock (sync) {
+            var bucket = GetBucket(size);
+            bucket.Throughput[arm] = bucket.Samples[arm] == 0
+                ? throughput
+                : Alpha * throughput + (1 - Alpha) * bucket.Throughput[arm];
+            bucket.Samples[arm]++;
+        }
+    }
+
+
+    public void Reset() {
+        lock (sync) {
+            buckets.Clear();
+        }
+    }
+
+
+
+    private Bucket GetBucket(long size) {
+        var key = BitOperations.Log2((ulong)Math.Max(1, size));
+        if (!buckets.TryGetValue(key, out var bucket)) {
+            bucket = new Bucket(arms.Length);
+            buckets.Add(key, bucket);
+        }
+        return bucket;
+    }
+
+
+
+    private sealed class Bucket(int arms) {
+        public readonly double[] Throughput = new double[arms];
+        public readonly int[] Samples = new int[arms];
+        public long Calls;
+    }
+}
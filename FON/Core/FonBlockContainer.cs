@@ -0,0 +1,323 @@
+using Microsoft.Win32.SafeHandles;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Collections.Concurrent;
+using System.IO.Compression;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Layout of a block-compressed FON file: a header, independently compressed blocks of whole lines
+/// and a footer listing where each block sits and how many lines it holds.
+/// </summary>
+/// <remarks>
+/// <code>
+/// header   magic[8] version[1] codec[1] reserved[2]
+/// block    compressed UTF-8 lines, each ending in '\n'
+/// footer   (offset[8] compressed[4] length[4] lines[4]) per block
+/// trailer  footerOffset[8] blockCount[4] magic[8]
+/// </code>
+/// Integers are little-endian. The magic starts with 0x89, which no UTF-8 text does, so plain
+/// FON files are never mistaken for containers.
+/// </remarks>
+internal sealed class FonBlockContainer {
+    public const int HeaderLength = 12;
+    public const int EntryLength = 20;
+    public const int TrailerLength = 20;
+    private const byte Version = 1;
+
+    public static ReadOnlySpan<byte> Magic => [0x89, (byte)'F', (byte)'O', (byte)'N', (byte)'Z', (byte)'\r', (byte)'\n', 0x1A];
+
+
+    private FonBlockContainer(FonCompression compression, FonBlockInfo[] blocks, ulong lineCount) {
+        Compression = compression;
+        Blocks = blocks;
+        LineCount = lineCount;
+    }
+
+
+    public FonCompression Compression { get; }
+
+    public FonBlockInfo[] Blocks { get; }
+
+    public ulong LineCount { get; }
+
+
+
+
+    public static bool IsContainer(FileInfo file) {
+        using var handle = File.OpenHandle(file.FullName, FileMode.Open, FileAccess.Read, FileShare.Read);
+        Span<byte> head = stackalloc byte[8];
+        return RandomAccess.Read(handle, head, 0) == head.Length && head.SequenceEqual(Magic);
+    }
+
+
+    /// <exception cref="FormatException">Header, trailer or block table are malformed.</exception>
+    public static FonBlockContainer Open(SafeFileHandle handle) {
+        var fileLength = RandomAccess.GetLength(handle);
+        Span<byte> header = stackalloc byte[HeaderLength];
+        Span<byte> trailer = stackalloc byte[TrailerLength];
+        if (fileLength < HeaderLength + TrailerLength
+            || RandomAccess.Read(handle, header, 0) != HeaderLength
+            || RandomAccess.Read(handle, trailer, fileLength - TrailerLength) != TrailerLength
+            || !header[..8].SequenceEqual(Magic)
+            || !trailer[12..].SequenceEqual(Magic)) {
+            throw new FormatException("Not a compressed FON file");
+        }
+        if (header[8] != Version) {
+            throw new FormatException($"Unsupported compressed FON version {header[8]}");
+        }
+        var compression = (FonCompression)header[9];
+        if (compression is not (FonCompression.Brotli or FonCompression.Deflate)) {
+            throw new FormatException($"Unknown block codec {header[9]}");
+        }
+
+        var footerOffset = BinaryPrimitives.ReadInt64LittleEndian(trailer);
+        var blockCount = BinaryPrimitives.ReadInt32LittleEndian(trailer[8..]);
+        if (blockCount < 0 || footerOffset < HeaderLength || footerOffset + (long)blockCount * EntryLength != fileLength - TrailerLength) {
+            throw new FormatException("Corrupt block table");
+        }
+
+        var table = new byte[blockCount * EntryLength];
+        if (RandomAccess.Read(handle, table, footerOffset) != table.Length) {
+            throw new FormatException("Truncated block table");
+        }
+
+        var blocks = new FonBlockInfo[blockCount];
+        ulong lineCount = 0;
+        for (int i = 0; i < blockCount; i++) {
+            var entry = table.AsSpan(i * EntryLength, EntryLength);
+            var offset = BinaryPrimitives.ReadInt64LittleEndian(entry);
+            var compressed = BinaryPrimitives.ReadInt32LittleEndian(entry[8..]);
+            var length = BinaryPrimitives.ReadInt32LittleEndian(entry[12..]);
+            var lines = BinaryPrimitives.ReadInt32LittleEndian(entry[16..]);
+            if (offset < HeaderLength || compressed < 0 || length < 0 || lines < 0 || offset + compressed > footerOffset) {
+                throw new FormatException("Corrupt block table");
+            }
+            blocks[i] = new FonBlockInfo(offset, compressed, length, lineCount, lines);
+            lineCount += (ulong)lines;
+        }
+
+        return new FonBlockContainer(compression, blocks, lineCount);
+    }
+
+
+
+
+    /// <summary>
+    /// Reads and decodes one block into a buffer rented from <see cref="ArrayPool{T}.Shared"/>,
+    /// holding <see cref="FonBlockInfo.Length"/> bytes of lines. Safe to call from several threads.
+    /// </summary>
+    public byte[] ReadBlock(SafeFileHandle handle, int index) {
+        var block = Blocks[index];
+        var compressed = ArrayPool<byte>.Shared.Rent(block.CompressedLength);
+        var text = ArrayPool<byte>.Shared.Rent(Math.Max(1, block.Length));
+        try {
+            if (RandomAccess.Read(handle, compressed.AsSpan(0, block.CompressedLength), block.Offset) != block.CompressedLength
+                || Decompress(Compression, compressed, block.CompressedLength, text.AsSpan(0, block.Length)) != block.Length) {
+                throw new FormatException($"Corrupt compressed block {index}");
+            }
+            return text;
+        } catch {
+            ArrayPool<byte>.Shared.Return(text);
+            throw;
+        } finally {
+            ArrayPool<byte>.Shared.Return(compressed);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Compresses <paramref name="text"/> into a rented buffer; returns the compressed length.
+    /// </summary>
+    public static int Compress(FonCompression compression, CompressionLevel level, ReadOnlySpan<byte> text, out byte[] buffer) {
+        if (compression == FonCompression.Brotli) {
+            buffer = ArrayPool<byte>.Shared.Rent(BrotliEncoder.GetMaxCompressedLength(text.Length));
+            var quality = level switch {
+                CompressionLevel.NoCompression => 0,
+                CompressionLevel.Fastest => 1,
+                CompressionLevel.SmallestSize => 11,
+                _ => 4
+            };
+            if (!BrotliEncoder.TryCompress(text, buffer, out var written, quality, window: 22)) {
+                ArrayPool<byte>.Shared.Return(buffer);
+                throw new InvalidOperationException("Brotli block compression failed");
+            }
+            return written;
+        }
+
+        // DeflateStream gives no output bound: zlib-ng's fastest level emits fixed-Huffman blocks, 9 bits
+        // per byte >= 0x80, so start there and let the buffer grow past it if needed
+        var output = new PooledOutputStream(text.Length + (text.Length >> 3) + 64);
+        try {
+            using (var deflate = new DeflateStream(output, level, leaveOpen: true)) {
+                deflate.Write(text);
+            }
+        } catch {
+            ArrayPool<byte>.Shared.Return(output.Buffer);
+            throw;
+        }
+        buffer = output.Buffer;
+        return output.Written;
+    }
+
+
+    private static int Decompress(FonCompression compression, byte[] compressed, int compressedLength, Span<byte> text) {
+        if (compression == FonCompression.Brotli) {
+            return BrotliDecoder.TryDecompress(compressed.AsSpan(0, compressedLength), text, out var written) ? written : -1;
+        }
+
+        using var deflate = new DeflateStream(new MemoryStream(compressed, 0, compressedLength, writable: false), CompressionMode.Decompress);
+        try {
+            var read = deflate.ReadAtLeast(text, text.Length, throwOnEndOfStream: false);
+            return read == text.Length && deflate.Read(stackalloc byte[1]) == 0 ? read : -1;
+        } catch (InvalidDataException) {
+            return -1;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Write-only stream into an <see cref="ArrayPool{T}.Shared"/> buffer that is swapped for a larger
+    /// one when it fills up. The caller owns <see cref="Buffer"/> afterwards.
+    /// </summary>
+    private sealed class PooledOutputStream(int capacity) : Stream {
+        public byte[] Buffer { get; private set; } = ArrayPool<byte>.Shared.Rent(capacity);
+
+        public int Written { get; private set; }
+
+        public override bool CanRead => false;
+        public override bool CanSeek => false;
+        public override bool CanWrite => true;
+        public override long Length => Written;
+        public override long Position { get => Written; set => throw new NotSupportedException(); }
+
+        public override void Write(byte[] buffer, int offset, int count) => Write(buffer.AsSpan(offset, count));
+
+        public override void Write(ReadOnlySpan<byte> data) {
+            if (Buffer.Length - Written < data.Length) {
+                var grown = ArrayPool<byte>.Shared.Rent((int)Math.Min(Array.MaxLength, Math.Max((long)Written + data.Length, Buffer.Length * 2L)));
+                Buffer.AsSpan(0, Written).CopyTo(grown);
+                ArrayPool<byte>.Shared.Return(Buffer);
+                Buffer = grown;
+            }
+            data.CopyTo(Buffer.AsSpan(Written));
+            Written += data.Length;
+        }
+
+        public override void Flush() { }
+        public override int Read(byte[] buffer, int offset, int count) => throw new NotSupportedException();
+        public override long Seek(long offset, SeekOrigin origin) => throw new NotSupportedException();
+        public override void SetLength(long value) => throw new NotSupportedException();
+    }
+}
+
+
+
+
+/// <summary>
+/// Where a block sits in the file, its decoded length and the first line it holds.
+/// </summary>
+internal readonly record struct FonBlockInfo(long Offset, int CompressedLength, int Length, ulong FirstLine, int LineCount);
+
+
+
+
+/// <summary>
+/// Write side of <see cref="FonBlockContainer"/> for the chunk pipeline: workers compress their chunk
+/// with <see cref="Encode"/>, the ordered writer emits blocks with <see cref="WriteBlockAsync"/>.
+/// </summary>
+internal sealed class FonBlockEncoder : IDisposable {
+    private readonly FonCompression compression;
+    private readonly CompressionLevel level;
+    private readonly ConcurrentDictionary<int, EncodedBlock> encoded = new();
+    private readonly List<FonBlockInfo> blocks = [];
+    private long position;
+    private ulong lineCount;
+
+
+    public FonBlockEncoder(FonCompression compression, CompressionLevel level) {
+        if (compression is not (FonCompression.Brotli or FonCompression.Deflate)) {
+            throw new ArgumentOutOfRangeException(nameof(compression));
+        }
+        this.compression = compression;
+        this.level = level;
+    }
+
+
+    public async ValueTask WriteHeaderAsync(Stream stream, CancellationToken cancellationToken) {
+        var header = new byte[FonBlockContainer.HeaderLength];
+        FonBlockContainer.Magic.CopyTo(header);
+        header[8] = 1;
+        header[9] = (byte)compression;
+        await stream.WriteAsync(header, cancellationToken);
+        position = header.Length;
+    }
+
+
+    /// <summary>
+    /// Compresses the lines of <paramref name="chunk"/>; runs on the worker that serialized them.
+    /// </summary>
+    public void Encode(int chunk, ReadOnlySpan<byte> text) {
+        if (text.IsEmpty) {
+            return;
+        }
+        var length = FonBlockContainer.Compress(compression, level, text, out var buffer);
+        encoded[chunk] = new EncodedBlock(buffer, length, text.Length, text.Count((byte)'\n'));
+    }
+
+
+    /// <summary>
+    /// Writes the block of <paramref name="chunk"/>; chunks must come in order.
+    /// </summary>
+    public async ValueTask WriteBlockAsync(Stream stream, int chunk, CancellationToken cancellationToken) {
+        if (!encoded.TryRemove(chunk, out var block)) {
+            // Only null records, nothing to write
+            return;
+        }
+        try {
+            await stream.WriteAsync(block.Buffer.AsMemory(0, block.CompressedLength), cancellationToken);
+        } finally {
+            ArrayPool<byte>.Shared.Return(block.Buffer);
+        }
+        blocks.Add(new FonBlockInfo(position, block.CompressedLength, block.Length, lineCount, block.LineCount));
+        position += block.CompressedLength;
+        lineCount += (ulong)block.LineCount;
+    }
+
+
+    public async ValueTask WriteFooterAsync(Stream stream, CancellationToken cancellationToken) {
+        var footer = new byte[blocks.Count * FonBlockContainer.EntryLength + FonBlockContainer.TrailerLength];
+        for (int i = 0; i < blocks.Count; i++) {
+            var entry = footer.AsSpan(i * FonBlockContainer.EntryLength);
+            BinaryPrimitives.WriteInt64LittleEndian(entry, blocks[i].Offset);
+            BinaryPrimitives.WriteInt32LittleEndian(entry[8..], blocks[i].CompressedLength);
+            BinaryPrimitives.WriteInt32LittleEndian(entry[12..], blocks[i].Length);
+            BinaryPrimitives.WriteInt32LittleEndian(entry[16..], blocks[i].LineCount);
+        }
+        var trailer = footer.AsSpan(blocks.Count * FonBlockContainer.EntryLength);
+        BinaryPrimitives.WriteInt64LittleEndian(trailer, position);
+        BinaryPrimitives.WriteInt32LittleEndian(trailer[8..], blocks.Count);
+        FonBlockContainer.Magic.CopyTo(trailer[12..]);
+        await stream.WriteAsync(footer, cancellationToken);
+    }
+
+
+    public void Dispose() {
+        // Blocks compressed ahead of a failed write
+        foreach (var block in encoded.Values) {
+            ArrayPool<byte>.Shared.Return(block.Buffer);
+        }
+        encoded.Clear();
+    }
+
+
+
+
+    private readonly record struct EncodedBlock(byte[] Buffer, int CompressedLength, int Length, int LineCount);
+}
@@ -0,0 +1,153 @@
+using FON.Diagnostics;
+using FON.Types;
+using Microsoft.Win32.SafeHandles;
+using System.Diagnostics;
+using System.IO.Compression;
+using System.Runtime.CompilerServices;
+using System.Runtime.ExceptionServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Block-compressed FON files: runs of whole lines compressed independently, with a block table at
+/// the end (see <see cref="FonBlockContainer"/>). Blocks are compressed and decoded in parallel, and
+/// a reader can start at any block, so random access needs no separate line index.
+/// </summary>
+public partial class Fon {
+    /// <summary>
+    /// Records per block written by <see cref="SerializeToFileCompressedAsync"/> by default.
+    /// </summary>
+    public const int DefaultCompressedBlockRecords = 1000;
+
+
+
+
+    /// <summary>
+    /// Serializes the dump into a block-compressed file. Every chunk of <paramref name="blockRecords"/>
+    /// records becomes one block, compressed by the worker that serialized it in the chunked pipeline
+    /// of <see cref="SerializeToFileChunkedAsync"/>. Lines are numbered as in the uncompressed file.
+    /// </summary>
+    /// <remarks>
+    /// <see cref="DeserializeFromFileAutoAsync"/>, <see cref="ReadRecordsAsync(FileInfo, int?, FonReadOptions?, CancellationToken)"/>
+    /// and <see cref="ReadRangeAsync"/> recognize the format by its header. No line index sidecar is
+    /// written; the block table takes its place.
+    /// </remarks>
+    public static async Task SerializeToFileCompressedAsync(FonDump dump, FileInfo fileInfo, FonCompression compression = FonCompression.Brotli, CompressionLevel level = CompressionLevel.Fastest, int blockRecords = DefaultCompressedBlockRecords, int? maxDegreeOfParallelism = null, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(dump);
+        var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        using var encoder = new FonBlockEncoder(compression, level);
+        var started = FonMetrics.StartOperation();
+        long bytes;
+
+        await using (var fileStream = new FileStream(
+            fileInfo.FullName,
+            FileMode.Create,
+            FileAccess.Write,
+            FileShare.None,
+            bufferSize: 256 * 1024,
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        )) {
+            await encoder.WriteHeaderAsync(fileStream, cancellationToken);
+            bytes = await SerializeRecordsAsync(dump.GetOrderedRecords(), fileStream, blockRecords, parallelism, cancellationToken, encoder: encoder);
+            await encoder.WriteFooterAsync(fileStream, cancellationToken);
+        }
+
+        WriteLineIndex(fileInfo, null);
+        FonMetrics.RecordOperation("serialize", "compressed", FonMetrics.ManagedEngine, dump.Count, bytes, started);
+    }
+
+
+
+
+    /// <summary>
+    /// Loads a block-compressed file; blocks are read, decoded and parsed in parallel.
+    /// </summary>
+    /// <exception cref="FormatException">The file is not block-compressed or is corrupt.</exception>
+    public static Task<FonDump> DeserializeFromCompressedFileAsync(FileInfo file, int? maxDegreeOfParallelism = null, FonReadOptions? options = null) {
+        var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        return Task.Run(() => DeserializeFromCompressedFile(file, parallelism, options?.Selection));
+    }
+
+
+    private static FonDump DeserializeFromCompressedFile(FileInfo file, int parallelism, KeySelection? selection) {
+        var started = FonMetrics.StartOperation();
+        using var handle = File.OpenHandle(file.FullName, FileMode.Open, FileAccess.Read, FileShare.Read, FileOptions.RandomAccess);
+        var container = FonBlockContainer.Open(handle);
+        if (container.LineCount > (ulong)Array.MaxLength) {
+            throw new FormatException("Too many lines for a dump");
+        }
+
+        var records = new FonCollection?[container.LineCount];
+        LineParser<FonCollection> parse = line => DeserializeLineOptimized(line, selection);
+        try {
+            Parallel.For(0, container.Blocks.Length, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, b => {
+                foreach (var (id, record) in ParseCompressedBlock(container, handle, b, 0, ulong.MaxValue, parse)) {
+                    records[id] = record;
+                }
+            });
+        } catch (AggregateException ex) when (ex.InnerException is FormatException format) {
+            // Surface a corrupt block as documented, not wrapped by Parallel.For
+            ExceptionDispatchInfo.Throw(format);
+        }
+
+        var dump = new FonDump(records);
+        FonMetrics.RecordOperation("deserialize", "compressed", FonMetrics.ManagedEngine, dump.Count, container.Blocks.Sum(b => (long)b.Length), started);
+        return dump;
+    }
+
+
+
+
+    /// <summary>
+    /// Streams the records on lines [start, end) of a block-compressed file. Only blocks overlapping the
+    /// range are read; up to <paramref name="maxDegreeOfParallelism"/> of them are decoded ahead, each
+    /// line through <paramref name="parse"/>.
+    /// </summary>
+    private static async IAsyncEnumerable<(ulong id, TRecord record)> ReadCompressedRecordsAsync<TRecord>(FileInfo file, int? maxDegreeOfParallelism, LineParser<TRecord> parse, ulong start, ulong end, [EnumeratorCancellation] CancellationToken cancellationToken) {
+        var readAhead = Math.Max(1, maxDegreeOfParallelism ?? Environment.ProcessorCount);
+        using var handle = File.OpenHandle(file.FullName, FileMode.Open, FileAccess.Read, FileShare.Read, FileOptions.RandomAccess);
+        var container = FonBlockContainer.Open(handle);
+        var blocks = container.Blocks;
+        var pending = new Queue<Task<List<(ulong id, TRecord record)>>>(readAhead);
+
+        // The first block that reaches past start
+        var next = 0;
+        while (next < blocks.Length && blocks[next].FirstLine + (ulong)blocks[next].LineCount <= start) {
+            next++;
+        }
+
+        try {
+            while (true) {
+                while (pending.Count < readAhead && next < blocks.Length && blocks[next].FirstLine < end) {
+                    var index = next++;
+                    pending.Enqueue(Task.Run(() => ParseCompressedBlock(container, handle, index, start, end, parse), cancellationToken));
+                }
+
+                if (!pending.TryDequeue(out var task)) {
+                    break;
+                }
+
+                foreach (var record in await task) {
+                    yield return record;
+                }
+            }
+        } finally {
+            // Let in-flight blocks finish before the handle closes
+            while (pending.TryDequeue(out var task)) {
+                try {
+                    await task;
+                } catch (Exception) {
+                    // The first failure was already surfaced to the caller
+                }
+            }
+        }
+    }
+
+
+    private static List<(ulong id, TRecord record)> ParseCompressedBlock<TRecord>(FonBlockContainer container, SafeFileHandle handle, int index, ulong start, ulong end, LineParser<TRecord> parse) {
+        var block = container.Blocks[index];
+        var line = block.FirstLine;
+        return ParseLineRange(new LineBlock(container.ReadBlock(handle, index), block.Length, IsFirst: false), skipBom: false, ref line, start, end, parse);
+    }
+}
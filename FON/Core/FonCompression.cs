@@ -0,0 +1,17 @@
+namespace FON.Core;
+
+
+/// <summary>
+/// Codec of the blocks of a compressed FON file (<see cref="Fon.SerializeToFileCompressedAsync"/>).
+/// </summary>
+public enum FonCompression : byte {
+    /// <summary>
+    /// Brotli; the better ratio on the repeated keys of FON lines.
+    /// </summary>
+    Brotli = 1,
+
+    /// <summary>
+    /// Raw Deflate; faster to decode, somewhat larger.
+    /// </summary>
+    Deflate = 2
+}
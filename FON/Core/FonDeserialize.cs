@@ -1,33 +1,79 @@
+using FON.Acceleration;
+using FON.Diagnostics;
 using FON.Types;
 using System.Buffers;
 using System.Collections;
+using System.Diagnostics;
 using System.Globalization;
+using System.IO.MemoryMappedFiles;
 using System.Runtime.CompilerServices;
 using System.Text;
 
 namespace FON.Core;
 
 public partial class Fon {
+    /// <summary>
+    /// Files at or above this size are deserialized through the memory-mapped path by
+    /// <see cref="DeserializeFromFileAutoAsync"/>. Below it the whole file is read into memory. Default: 500MB.
+    /// </summary>
+    public static long MappedFileThreshold { get; set; } = 500L * 1024 * 1024;
+
+    /// <summary>
+    /// Arms of <see cref="DeserializeFromFileAutoAsync"/> under <see cref="AdaptiveTuning"/>.
+    /// </summary>
+    private static readonly FonAutoTuner deserializeTuner = new("read-all", "mapped");
+
+    private const int ReadAllArm = 0;
+    private const int MappedArm = 1;
+
+
+    /// <summary>
+    /// Upper bound for one worker range in <see cref="DeserializeFromFileMappedAsync"/>.
+    /// Bounds the memory held by in-flight workers to roughly parallelism * 64MB.
+    /// </summary>
+    private const int MappedRangeBytes = 64 * 1024 * 1024;
+
+    private static readonly SearchValues<char> valueTerminators = SearchValues.Create(",]\r\n");
+
+
+
+
     /// <summary>
     /// Optimized parallel deserialization.
-    /// Reads file once, parses in parallel.
+    /// Reads file once as raw UTF-8, parses lines in parallel straight from the bytes.
+    /// <paramref name="options"/> can restrict parsing to selected keys.
     /// </summary>
-    public static async Task<FonDump> DeserializeFromFileAsync(FileInfo file, int? maxDegreeOfParallelism = null) {
+    public static async Task<FonDump> DeserializeFromFileAsync(FileInfo file, int? maxDegreeOfParallelism = null, FonReadOptions? options = null) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        var selection = options?.Selection;
+
+        // A single byte[] cannot hold it - parse through the mapping instead
+        if (file.Length > Array.MaxLength) {
+            return await DeserializeFromFileMappedAsync(file, parallelism, options);
+        }
 
-        // Read all lines in one pass
-        var lines = await ReadAllLinesOptimizedAsync(file);
-        var fonDump = new FonDump(lines.Length);
+        // Read all bytes in one pass, no transcoding
+        var started = FonMetrics.StartOperation();
+        var bytes = await File.ReadAllBytesAsync(file.FullName);
+        FonMetrics.RecordPhase("read", "deserialize", started);
 
-        // Parallel parsing of all lines
-        Parallel.For(0, lines.Length, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
-            if (!string.IsNullOrEmpty(lines[i])) {
-                var collection = DeserializeLineOptimized(lines[i].AsSpan());
-                fonDump.TryAdd((ulong)i, collection);
+        // Estimate line count: average line ~50KB for our data
+        var lines = SplitLinesUtf8(bytes, (int)Math.Max(100, bytes.Length / 50000));
+        var records = new FonCollection?[lines.Count];
+
+        // Parallel parsing of all lines, each straight into its line slot
+        var parsing = Stopwatch.GetTimestamp();
+        Parallel.For(0, lines.Count, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
+            var (start, length) = lines[i];
+            if (length > 0) {
+                records[i] = DeserializeLineOptimized(new ReadOnlySpan<byte>(bytes, start, length), selection);
             }
         });
+        FonMetrics.RecordPhase("parse", "deserialize", parsing);
 
-        return fonDump;
+        var dump = new FonDump(records);
+        FonMetrics.RecordOperation("deserialize", "read-all", FonMetrics.ManagedEngine, dump.Count, bytes.Length, started);
+        return dump;
     }
 
 
@@ -37,8 +83,9 @@ public partial class Fon {
     /// Optimized deserialization with chunked reading.
     /// Better for very large files - less memory pressure.
     /// </summary>
-    public static async Task<FonDump> DeserializeFromFileChunkedAsync(FileInfo file, int chunkSize = 10000, int? maxDegreeOfParallelism = null) {
+    public static async Task<FonDump> DeserializeFromFileChunkedAsync(FileInfo file, int chunkSize = 10000, int? maxDegreeOfParallelism = null, FonReadOptions? options = null) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        var started = FonMetrics.StartOperation();
         var fonDump = new FonDump();
 
         await using var fileStream = new FileStream(
@@ -60,82 +107,219 @@ public partial class Fon {
             lineBuffer.Add(line);
 
             if (lineBuffer.Count >= chunkSize) {
-                await ProcessChunkAsync(fonDump, lineBuffer, globalIndex, parallelism);
+                await ProcessChunkAsync(fonDump, lineBuffer, globalIndex, parallelism, options?.Selection);
                 globalIndex += (ulong)lineBuffer.Count;
                 lineBuffer.Clear();
             }
         }
 
         if (lineBuffer.Count > 0) {
-            await ProcessChunkAsync(fonDump, lineBuffer, globalIndex, parallelism);
+            await ProcessChunkAsync(fonDump, lineBuffer, globalIndex, parallelism, options?.Selection);
         }
 
+        FonMetrics.RecordOperation("deserialize", "chunked", FonMetrics.ManagedEngine, fonDump.Count, fileStream.Length, started);
         return fonDump;
     }
 
 
 
 
+    /// <summary>
+    /// Memory-mapped parallel deserialization.
+    /// The file is cut into byte ranges aligned to '\n' and every worker parses its own range,
+    /// so reading is no longer bound to a single thread. Best for very large files on fast storage.
+    /// </summary>
+    public static Task<FonDump> DeserializeFromFileMappedAsync(FileInfo file, int? maxDegreeOfParallelism = null, FonReadOptions? options = null) {
+        var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        return Task.Run(() => DeserializeFromFileMapped(file, parallelism, options?.Selection));
+    }
+
+
+
+
     /// <summary>
     /// Automatic selection of best deserialization method.
+    /// A registered <see cref="IFonBackend"/> (native acceleration) is offered the file first;
+    /// block-compressed files go to <see cref="DeserializeFromCompressedFileAsync"/>.
+    /// With <see cref="AdaptiveTuning"/> files that fit in one array go to whichever of read-all and
+    /// mapped parsed their size class fastest so far, instead of the <see cref="MappedFileThreshold"/> cutoff.
     /// </summary>
-    public static async Task<FonDump> DeserializeFromFileAutoAsync(FileInfo file, int? maxDegreeOfParallelism = null) {
+    public static async Task<FonDump> DeserializeFromFileAutoAsync(FileInfo file, int? maxDegreeOfParallelism = null, FonReadOptions? options = null) {
+        if (FonBlockContainer.IsContainer(file)) {
+            FonMetrics.RecordSelection("deserialize", "compressed", FonMetrics.ManagedEngine, adaptive: false, file.Length);
+            return await DeserializeFromCompressedFileAsync(file, maxDegreeOfParallelism, options);
+        }
+
+        if (FonAccelerator.ActiveBackend is { } backend) {
+            var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+            var started = Stopwatch.GetTimestamp();
+            if (await Task.Run(() => backend.TryDeserializeFromFile(file, options, parallelism)) is { } dump) {
+                FonMetrics.RecordSelection("deserialize", "backend", backend.Name, adaptive: false, file.Length);
+                FonMetrics.RecordOperation("deserialize", "backend", backend.Name, dump.Count, file.Length, started);
+                return dump;
+            }
+        }
+
         var fileSize = file.Length;
 
-        // For files < 500MB - load everything into memory and parse in parallel
-        // For files >= 500MB - use chunked approach
-        if (fileSize < 500 * 1024 * 1024) {
-            return await DeserializeFromFileAsync(file, maxDegreeOfParallelism);
-        } else {
-            return await DeserializeFromFileChunkedAsync(file, 10000, maxDegreeOfParallelism);
+        // Below MappedFileThreshold - load everything into memory and parse in parallel
+        // At or above - parse memory-mapped ranges in parallel
+        var fallback = fileSize < MappedFileThreshold ? ReadAllArm : MappedArm;
+        var adaptive = AdaptiveTuning;
+        // Read-all is only a candidate while the file fits in one array
+        var arm = adaptive ? deserializeTuner.Choose(fileSize, fallback, fileSize <= Array.MaxLength ? 2 : 1) : fallback;
+        FonMetrics.RecordSelection("deserialize", deserializeTuner[arm], FonMetrics.ManagedEngine, adaptive, fileSize);
+
+        var armStarted = Stopwatch.GetTimestamp();
+        var result = arm == ReadAllArm
+            ? await DeserializeFromFileAsync(file, maxDegreeOfParallelism, options)
+            : await DeserializeFromFileMappedAsync(file, maxDegreeOfParallelism, options);
+
+        if (adaptive) {
+            deserializeTuner.Record(fileSize, arm, fileSize, armStarted);
         }
+        return result;
     }
 
 
 
 
-    private static async Task ProcessChunkAsync(FonDump fonDump, List<string> lines, ulong startIndex, int parallelism) {
-        var results = new FonCollection?[lines.Count];
+    private static FonDump DeserializeFromFileMapped(FileInfo file, int parallelism, KeySelection? selection) {
+        var fileSize = file.Length;
+        if (fileSize == 0) {
+            return new FonDump();
+        }
+        var started = FonMetrics.StartOperation();
+
+        using var mappedFile = MemoryMappedFile.CreateFromFile(file.FullName, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+        using var accessor = mappedFile.CreateViewAccessor(0, fileSize, MemoryMappedFileAccess.Read);
+
+        // Enough ranges to keep every core busy and to keep each range bounded
+        var rangeCount = (int)Math.Max(parallelism, (fileSize + MappedRangeBytes - 1) / MappedRangeBytes);
+        var bounds = new long[rangeCount + 1];
+        bounds[rangeCount] = fileSize;
+        for (int i = 1; i < rangeCount; i++) {
+            var nominal = fileSize / rangeCount * i;
+            bounds[i] = FindNextLineStart(accessor, Math.Max(nominal, bounds[i - 1]), fileSize);
+        }
 
-        Parallel.For(0, lines.Count, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
-            if (!string.IsNullOrEmpty(lines[i])) {
-                results[i] = DeserializeLineOptimized(lines[i].AsSpan());
-            }
+        var rangeResults = new FonCollection?[rangeCount][];
+        var options = new ParallelOptions { MaxDegreeOfParallelism = parallelism };
+        var phases = FonMetrics.PhasesEnabled ? new long[2] : null;
+
+        // Every range is read and parsed independently; line numbers are local to the range
+        Parallel.For(0, rangeCount, options, i => {
+            rangeResults[i] = ParseMappedRange(accessor, bounds[i], bounds[i + 1], skipBom: i == 0, selection, phases);
+        });
+
+        if (phases != null) {
+            FonMetrics.RecordPhaseTicks("read", "deserialize", phases[0]);
+            FonMetrics.RecordPhaseTicks("parse", "deserialize", phases[1]);
+        }
+
+        // Prefix count of lines turns local line numbers into global ones
+        var firstLine = new ulong[rangeCount];
+        ulong totalLines = 0;
+        for (int i = 0; i < rangeCount; i++) {
+            firstLine[i] = totalLines;
+            totalLines += (ulong)rangeResults[i].Length;
+        }
+
+        if (totalLines > (ulong)Array.MaxLength) {
+            throw new NotSupportedException($"File has {totalLines} lines, more than a FonDump can hold");
+        }
+
+        var records = new FonCollection?[totalLines];
+        Parallel.For(0, rangeCount, options, i => {
+            rangeResults[i].CopyTo(records, (long)firstLine[i]);
         });
 
-        for (int i = 0; i < results.Length; i++) {
-            if (results[i] != null) {
-                fonDump.TryAdd(startIndex + (ulong)i, results[i]!);
+        var dump = new FonDump(records);
+        FonMetrics.RecordOperation("deserialize", "mapped", FonMetrics.ManagedEngine, dump.Count, fileSize, started);
+        return dump;
+    }
+
+
+
+
+    /// <summary>
+    /// Returns the offset just past the first '\n' at or after <paramref name="position"/>, or the end of the file.
+    /// </summary>
+    private static long FindNextLineStart(MemoryMappedViewAccessor accessor, long position, long fileSize) {
+        var probe = ArrayPool<byte>.Shared.Rent(64 * 1024);
+        try {
+            while (position < fileSize) {
+                var count = (int)Math.Min(probe.Length, fileSize - position);
+                accessor.ReadArray(position, probe, 0, count);
+
+                var newLine = probe.AsSpan(0, count).IndexOf((byte)'\n');
+                if (newLine >= 0) {
+                    return position + newLine + 1;
+                }
+                position += count;
             }
+            return fileSize;
+        } finally {
+            ArrayPool<byte>.Shared.Return(probe);
         }
     }
 
 
 
 
-    private static async Task<string[]> ReadAllLinesOptimizedAsync(FileInfo file) {
-        // Optimized reading of all lines
-        await using var fileStream = new FileStream(
-            file.FullName,
-            FileMode.Open,
-            FileAccess.Read,
-            FileShare.Read,
-            bufferSize: 256 * 1024,
-            FileOptions.Asynchronous | FileOptions.SequentialScan
-        );
+    /// <summary>
+    /// Parses one range; with <paramref name="phases"/> the read and parse time of the range is added to
+    /// its two slots.
+    /// </summary>
+    private static FonCollection?[] ParseMappedRange(MemoryMappedViewAccessor accessor, long start, long end, bool skipBom, KeySelection? selection, long[]? phases = null) {
+        var length = checked((int)(end - start));
+        if (length == 0) {
+            return [];
+        }
 
-        using var reader = new StreamReader(fileStream, Encoding.UTF8, detectEncodingFromByteOrderMarks: true, bufferSize: 256 * 1024);
+        var buffer = ArrayPool<byte>.Shared.Rent(length);
+        try {
+            var started = phases != null ? Stopwatch.GetTimestamp() : 0;
+            accessor.ReadArray(start, buffer, 0, length);
+            if (phases != null) {
+                var read = Stopwatch.GetTimestamp();
+                Interlocked.Add(ref phases[0], read - started);
+                started = read;
+            }
 
-        // Estimate line count: average line ~50KB for our data
-        var estimatedLines = (int)Math.Max(100, file.Length / 50000);
-        var lines = new List<string>(estimatedLines);
+            var bytes = new ReadOnlySpan<byte>(buffer, 0, length);
+            var lines = SplitLinesUtf8(bytes, Math.Max(16, length / 50000), skipBom);
+            var results = new FonCollection?[lines.Count];
 
-        string? line;
-        while ((line = await reader.ReadLineAsync()) != null) {
-            lines.Add(line);
+            for (int i = 0; i < lines.Count; i++) {
+                var (lineStart, lineLength) = lines[i];
+                if (lineLength > 0) {
+                    results[i] = DeserializeLineOptimized(bytes.Slice(lineStart, lineLength), selection);
+                }
+            }
+
+            if (phases != null) {
+                Interlocked.Add(ref phases[1], Stopwatch.GetTimestamp() - started);
+            }
+            return results;
+        } finally {
+            ArrayPool<byte>.Shared.Return(buffer);
         }
+    }
+
+
 
-        return lines.ToArray();
+
+    private static async Task ProcessChunkAsync(FonDump fonDump, List<string> lines, ulong startIndex, int parallelism, KeySelection? selection) {
+        var results = new FonCollection?[lines.Count];
+
+        Parallel.For(0, lines.Count, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
+            if (!string.IsNullOrEmpty(lines[i])) {
+                results[i] = DeserializeLineOptimized(lines[i].AsSpan(), selection);
+            }
+        });
+
+        fonDump.AddRange(startIndex, results);
     }
 
 
@@ -143,19 +327,21 @@ public partial class Fon {
 
     /// <summary>
     /// Optimized line parsing using Span and SIMD.
+    /// With a <paramref name="selection"/> only the selected keys are materialized.
     /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveOptimization)]
-    private static FonCollection DeserializeLineOptimized(ReadOnlySpan<char> chars) {
-        return ParseCollectionBody(chars, 0);
+    private static FonCollection DeserializeLineOptimized(ReadOnlySpan<char> chars, KeySelection? selection = null) {
+        return ParseCollectionBody(chars, 0, selection);
     }
 
 
 
 
     [MethodImpl(MethodImplOptions.AggressiveOptimization)]
-    private static FonCollection ParseCollectionBody(ReadOnlySpan<char> chars, int depth) {
-        var fonList = new FonCollection();
+    private static FonCollection ParseCollectionBody(ReadOnlySpan<char> chars, int depth, KeySelection? selection = null) {
+        var builder = new FonCollectionBuilder(depth, ShareKeyShapes);
         int position = 0;
+        int found = 0;
 
         while (position < chars.Length) {
             var remaining = chars.Slice(position);
@@ -165,7 +351,8 @@ public partial class Fon {
                 break;
             }
 
-            var key = remaining.Slice(0, eqIndex).ToString();
+            var keySpan = remaining.Slice(0, eqIndex);
+            var selected = selection?.IndexOf(keySpan) ?? 0;
             position += eqIndex + 1;
             remaining = chars.Slice(position);
 
@@ -182,45 +369,122 @@ public partial class Fon {
             position += 2;
             remaining = chars.Slice(position);
 
-            object data;
+            if (selected < 0) {
+                position += SkipValue(remaining, typeChar);
+                continue;
+            }
+
+            var key = selection == null ? FonKeyCache.Get(keySpan) : selection.GetName(selected);
+            var child = selection?.GetChild(selected);
+
+            FonValue data;
             int consumed;
 
             if (remaining.Length > 0 && remaining[0] == '[') {
-                (data, consumed) = DeserializeArrayOptimized(remaining, type, typeChar, depth + 1);
+                (var list, consumed) = DeserializeArrayOptimized(remaining, type, typeChar, depth + 1, child);
+                data = FonValue.FromList(list, typeChar);
             } else {
-                (data, consumed) = DeserializeValueOptimized(remaining, type, typeChar, depth);
+                (data, consumed) = DeserializeValueOptimized(remaining, type, typeChar, depth, child);
             }
 
-            fonList.Add(key, data);
+            builder.Add(key, data);
             position += consumed;
 
+            // Every selected key is in, the rest of the body is not even scanned
+            if (selection != null && ++found == selection.Count) {
+                break;
+            }
+
             if (position < chars.Length && chars[position] == ',') {
                 position++;
             }
         }
 
-        return fonList;
+        return builder.Build();
     }
 
 
 
 
+    /// <summary>
+    /// Returns how many chars the value at the start of <paramref name="chars"/> spans (including the
+    /// trailing ','), without parsing it.
+    /// </summary>
+    private static int SkipValue(ReadOnlySpan<char> chars, char typeChar) {
+        int end;
+
+        if (chars.Length > 0 && chars[0] == '[') {
+            end = FindClosingBracket(chars) + 1;
+        } else if (typeChar == 'o') {
+            if (chars.Length == 0 || chars[0] != '{') {
+                throw new FormatException("Object must start with '{'");
+            }
+            end = FindClosingBrace(chars) + 1;
+        } else if (typeChar == 's' || typeChar == 'r') {
+            if (chars.Length == 0 || chars[0] != '"') {
+                throw new FormatException("String must start with '\"'");
+            }
+            var endQuote = FindStringEnd(chars, 1);
+            end = endQuote < 0 ? chars.Length : endQuote + 1;
+        } else {
+            end = FindValueEnd(chars);
+        }
+
+        if (end < chars.Length && chars[end] == ',') {
+            end++;
+        }
+        return end;
+    }
+
+
+
+
+    /// <summary>
+    /// Returns the index of the closing quote of a string whose content starts at <paramref name="start"/>,
+    /// honoring backslash escapes. Returns -1 if the string is not terminated.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    private static (object data, int consumed) DeserializeValueOptimized(ReadOnlySpan<char> chars, Type type, char typeChar, int depth) {
+    private static int FindStringEnd(ReadOnlySpan<char> chars, int start) {
+        int position = start;
+
+        while (position < chars.Length) {
+            var next = chars.Slice(position).IndexOfAny('"', '\\');
+            if (next < 0) {
+                return -1;
+            }
+            position += next;
+
+            if (chars[position] == '"') {
+                return position;
+            }
+            // Skip the escaped char
+            position += 2;
+        }
+
+        return -1;
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static (FonValue data, int consumed) DeserializeValueOptimized(ReadOnlySpan<char> chars, Type type, char typeChar, int depth, KeySelection? selection = null) {
         if (typeChar == 'o') {
             if (chars.Length == 0 || chars[0] != '{') {
                 throw new FormatException("Object must start with '{'");
             }
-            var (obj, consumed) = DeserializeObjectOptimized(chars, depth + 1);
-            return (obj, consumed);
+            var (obj, consumed) = DeserializeObjectOptimized(chars, depth + 1, selection);
+            return (FonValue.FromReference('o', obj), consumed);
         }
 
         if (typeChar == 's') {
-            return DeserializeStringOptimized(chars);
+            var (text, consumed) = DeserializeStringOptimized(chars);
+            return (FonValue.FromReference('s', text), consumed);
         }
 
         if (typeChar == 'r') {
-            return DeserializeRawOptimized(chars);
+            var (raw, consumed) = DeserializeRawOptimized(chars);
+            return (FonValue.FromReference('r', raw), consumed);
         }
 
         var endIndex = FindValueEnd(chars);
@@ -233,16 +497,16 @@ public partial class Fon {
             }
         }
 
-        object value = typeChar switch {
-            'e' => byte.Parse(valueSpan),
-            't' => short.Parse(valueSpan),
-            'i' => int.Parse(valueSpan),
-            'u' => uint.Parse(valueSpan),
-            'l' => long.Parse(valueSpan),
-            'g' => ulong.Parse(valueSpan),
-            'f' => float.Parse(valueSpan, CultureInfo.InvariantCulture),
-            'd' => double.Parse(valueSpan, CultureInfo.InvariantCulture),
-            'b' => valueSpan[0] != '0',
+        FonValue value = typeChar switch {
+            'e' => FonValue.Create(byte.Parse(valueSpan)),
+            't' => FonValue.Create(short.Parse(valueSpan)),
+            'i' => FonValue.Create(int.Parse(valueSpan)),
+            'u' => FonValue.Create(uint.Parse(valueSpan)),
+            'l' => FonValue.Create(long.Parse(valueSpan)),
+            'g' => FonValue.Create(ulong.Parse(valueSpan)),
+            'f' => FonValue.Create(ParseFloat(valueSpan)),
+            'd' => FonValue.Create(ParseDouble(valueSpan)),
+            'b' => FonValue.Create(valueSpan[0] != '0'),
             _ => throw new NotSupportedException($"Type '{typeChar}' is not supported")
         };
 
@@ -254,19 +518,14 @@ public partial class Fon {
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     private static int FindValueEnd(ReadOnlySpan<char> chars) {
-        for (int i = 0; i < chars.Length; i++) {
-            var c = chars[i];
-            if (c == ',' || c == ']' || c == '\r' || c == '\n') {
-                return i;
-            }
-        }
-        return chars.Length;
+        var index = chars.IndexOfAny(valueTerminators);
+        return index < 0 ? chars.Length : index;
     }
 
 
 
 
-    private static (IList data, int consumed) DeserializeArrayOptimized(ReadOnlySpan<char> chars, Type elementType, char typeChar, int depth) {
+    private static (IList data, int consumed) DeserializeArrayOptimized(ReadOnlySpan<char> chars, Type elementType, char typeChar, int depth, KeySelection? selection = null) {
         if (depth > Fon.MaxDepth) {
             throw new FormatException($"Maximum nesting depth exceeded ({Fon.MaxDepth})");
         }
@@ -278,6 +537,15 @@ public partial class Fon {
         var closeIndex = FindClosingBracket(chars);
         var arrayContent = chars.Slice(1, closeIndex - 1);
 
+        if (IsPrimitiveArrayCode(typeChar)) {
+            var primitives = ParsePrimitiveArray(arrayContent, typeChar);
+            var primitiveConsumed = closeIndex + 1;
+            if (primitiveConsumed < chars.Length && chars[primitiveConsumed] == ',') {
+                primitiveConsumed++;
+            }
+            return (primitives, primitiveConsumed);
+        }
+
         var list = CreateTypedList(elementType, typeChar);
 
         if (arrayContent.Length == 0) {
@@ -291,8 +559,8 @@ public partial class Fon {
         int position = 0;
         while (position < arrayContent.Length) {
             var remaining = arrayContent.Slice(position);
-            var (value, valueConsumed) = DeserializeValueOptimized(remaining, elementType, typeChar, depth);
-            list.Add(value);
+            var (value, valueConsumed) = DeserializeValueOptimized(remaining, elementType, typeChar, depth, selection);
+            list.Add(value.ToObject());
             position += valueConsumed;
         }
 
@@ -309,27 +577,11 @@ public partial class Fon {
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     private static int FindClosingBracket(ReadOnlySpan<char> chars) {
-        int depth = 0;
-        bool inString = false;
-
-        for (int i = 0; i < chars.Length; i++) {
-            var c = chars[i];
-
-            if (c == '"' && (i == 0 || chars[i - 1] != '\\')) {
-                inString = !inString;
-            } else if (!inString) {
-                if (c == '[') {
-                    depth++;
-                } else if (c == ']') {
-                    depth--;
-                    if (depth == 0) {
-                        return i;
-                    }
-                }
-            }
+        var index = FindClosing(chars, '[', ']');
+        if (index < 0) {
+            throw new FormatException("Closing bracket not found");
         }
-
-        throw new FormatException("Closing bracket not found");
+        return index;
     }
 
 
@@ -337,33 +589,56 @@ public partial class Fon {
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     private static int FindClosingBrace(ReadOnlySpan<char> chars) {
+        var index = FindClosing(chars, '{', '}');
+        if (index < 0) {
+            throw new FormatException("Closing brace not found");
+        }
+        return index;
+    }
+
+
+
+
+    /// <summary>
+    /// Finds the bracket matching chars[0], jumping between interesting chars with IndexOfAny
+    /// instead of walking one char at a time. Quoted strings are skipped as a whole.
+    /// </summary>
+    private static int FindClosing(ReadOnlySpan<char> chars, char open, char close) {
         int depth = 0;
-        bool inString = false;
-
-        for (int i = 0; i < chars.Length; i++) {
-            var c = chars[i];
-
-            if (c == '"' && (i == 0 || chars[i - 1] != '\\')) {
-                inString = !inString;
-            } else if (!inString) {
-                if (c == '{') {
-                    depth++;
-                } else if (c == '}') {
-                    depth--;
-                    if (depth == 0) {
-                        return i;
-                    }
+        int position = 0;
+
+        while (position < chars.Length) {
+            var next = chars.Slice(position).IndexOfAny('"', open, close);
+            if (next < 0) {
+                return -1;
+            }
+            position += next;
+
+            var c = chars[position];
+            if (c == '"') {
+                var end = FindStringEnd(chars, position + 1);
+                if (end < 0) {
+                    return -1;
                 }
+                position = end + 1;
+                continue;
+            }
+
+            if (c == open) {
+                depth++;
+            } else if (--depth == 0) {
+                return position;
             }
+            position++;
         }
 
-        throw new FormatException("Closing brace not found");
+        return -1;
     }
 
 
 
 
-    private static (FonCollection data, int consumed) DeserializeObjectOptimized(ReadOnlySpan<char> chars, int depth) {
+    private static (FonCollection data, int consumed) DeserializeObjectOptimized(ReadOnlySpan<char> chars, int depth, KeySelection? selection = null) {
         if (depth > Fon.MaxDepth) {
             throw new FormatException($"Maximum nesting depth exceeded ({Fon.MaxDepth})");
         }
@@ -375,7 +650,7 @@ public partial class Fon {
         var closeIndex = FindClosingBrace(chars);
         var body = chars.Slice(1, closeIndex - 1);
 
-        var collection = ParseCollectionBody(body, depth);
+        var collection = ParseCollectionBody(body, depth, selection);
 
         var consumed = closeIndex + 1;
         if (consumed < chars.Length && chars[consumed] == ',') {
@@ -416,13 +691,9 @@ public partial class Fon {
             throw new FormatException("String must start with '\"'");
         }
 
-        // Find closing quote
-        int endQuote = 1;
-        while (endQuote < chars.Length) {
-            if (chars[endQuote] == '"' && chars[endQuote - 1] != '\\') {
-                break;
-            }
-            endQuote++;
+        var endQuote = FindStringEnd(chars, 1);
+        if (endQuote < 0) {
+            endQuote = chars.Length;
         }
 
         var stringContent = chars.Slice(1, endQuote - 1);
@@ -497,18 +768,18 @@ public partial class Fon {
             throw new FormatException("RawData must start with '\"'");
         }
 
-        // Find closing quote
-        int endQuote = 1;
-        while (endQuote < chars.Length && chars[endQuote] != '"') {
-            endQuote++;
+        // Z85 has no quotes or escapes, the first quote closes
+        var endQuote = chars.Slice(1).IndexOf('"') + 1;
+        if (endQuote == 0) {
+            endQuote = chars.Length;
         }
 
-        var base64Content = chars.Slice(1, endQuote - 1);
-        var rawData = new RawData(base64Content);
-
-        if (DeserializeRawUnpack) {
-            rawData.Unpack();
-        }
+        var encodedContent = chars.Slice(1, endQuote - 1);
+        var rawData = RawUnpack switch {
+            RawUnpackMode.Eager => RawData.Decode(encodedContent),
+            RawUnpackMode.Lazy => new RawData(encodedContent).DecodeOnAccess(),
+            _ => new RawData(encodedContent)
+        };
 
         var consumed = endQuote + 1;
         if (consumed < chars.Length && chars[consumed] == ',') {
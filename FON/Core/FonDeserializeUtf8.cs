@@ -0,0 +1,717 @@
+using FON.Types;
+using System.Buffers;
+using System.Buffers.Text;
+using System.Collections;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Text;
+
+namespace FON.Core;
+
+/// <summary>
+/// UTF-8 twins of the char-based parser in FonDeserialize.cs.
+/// Works directly on the raw file bytes: no transcoding to UTF-16 and no string per line.
+/// Strings are only created for keys and s: values.
+/// </summary>
+public partial class Fon {
+    private static ReadOnlySpan<byte> Utf8Bom => [0xEF, 0xBB, 0xBF];
+
+    private static readonly SearchValues<byte> valueTerminatorsUtf8 = SearchValues.Create(",]\r\n"u8);
+
+
+
+
+    /// <summary>
+    /// Splits a UTF-8 buffer into lines using vectorized IndexOf.
+    /// Returns (start, length) pairs with the trailing '\r' already trimmed.
+    /// A leading BOM is skipped only when <paramref name="skipBom"/> is set (i.e. at the start of the file).
+    /// </summary>
+    private static List<(int start, int length)> SplitLinesUtf8(ReadOnlySpan<byte> bytes, int estimatedLines, bool skipBom = true) {
+        var lines = new List<(int start, int length)>(estimatedLines);
+        int position = 0;
+
+        if (skipBom && bytes.StartsWith(Utf8Bom)) {
+            position = Utf8Bom.Length;
+        }
+
+        while (position < bytes.Length) {
+            var newLine = bytes.Slice(position).IndexOf((byte)'\n');
+            var length = newLine < 0 ? bytes.Length - position : newLine;
+
+            var trimmed = length;
+            if (trimmed > 0 && bytes[position + trimmed - 1] == (byte)'\r') {
+                trimmed--;
+            }
+            lines.Add((position, trimmed));
+
+            if (newLine < 0) {
+                break;
+            }
+            position += newLine + 1;
+        }
+
+        return lines;
+    }
+
+
+
+
+    /// <summary>
+    /// Optimized line parsing directly on UTF-8 bytes.
+    /// With a <paramref name="selection"/> only the selected keys are materialized.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveOptimization)]
+    internal static FonCollection DeserializeLineOptimized(ReadOnlySpan<byte> bytes, KeySelection? selection = null) {
+        var index = FonStructuralIndex.Build(bytes);
+        var collection = ParseCollectionBody(bytes, 0, selection, index: index);
+        FonStructuralIndex.Return(index);
+        return collection;
+    }
+
+
+
+
+    /// <summary>
+    /// Tape counterpart of <see cref="DeserializeLineOptimized(ReadOnlySpan{byte}, KeySelection?)"/> for <see cref="FonDocument"/>: records the
+    /// key and value offsets of every line of <paramref name="text"/> instead of building collections.
+    /// Returns the number of lines; <paramref name="records"/> is rented from the array pool.
+    /// </summary>
+    internal static int BuildTape(ReadOnlySpan<byte> text, bool skipBom, FonTape tape, ref FonDocumentRecord[] records, out int recordCount) {
+        var lines = SplitLinesUtf8(text, Math.Max(16, text.Length / 100), skipBom);
+        records = ArrayPool<FonDocumentRecord>.Shared.Rent(Math.Max(1, lines.Count));
+        recordCount = 0;
+
+        for (int i = 0; i < lines.Count; i++) {
+            var (start, length) = lines[i];
+            if (length == 0) {
+                continue;
+            }
+            var tapeStart = tape.Count;
+            var index = FonStructuralIndex.Build(text.Slice(start, length));
+            ParseTapeBody(text, start, length, tape, 0, index, start);
+            FonStructuralIndex.Return(index);
+            records[recordCount++] = new FonDocumentRecord(i, tapeStart, tape.Count, start, length);
+        }
+        return lines.Count;
+    }
+
+
+
+
+    /// <summary>
+    /// Adds the fields of the body at text[start..start+length] to the tape. Checks the same structure
+    /// as <see cref="ParseCollectionBody(ReadOnlySpan{byte}, int, KeySelection?, FonCollection?, FonStructuralIndex?, int)"/> but leaves primitive values unparsed. <paramref name="index"/>
+    /// covers the line starting at text[<paramref name="lineStart"/>].
+    /// </summary>
+    private static void ParseTapeBody(ReadOnlySpan<byte> text, int start, int length, FonTape tape, int depth, FonStructuralIndex? index, int lineStart) {
+        int position = start;
+        int end = start + length;
+
+        while (position < end) {
+            var eqIndex = text.Slice(position, end - position).IndexOf((byte)'=');
+            if (eqIndex < 0) {
+                break;
+            }
+
+            var keyOffset = position;
+            position += eqIndex + 1;
+            if (end - position < 2 || text[position + 1] != (byte)':') {
+                throw new FormatException($"Invalid format at position {position - start}");
+            }
+
+            var typeChar = (char)text[position];
+            if (GetType(typeChar) == null) {
+                throw new FormatException($"Unknown type '{typeChar}' at position {position - start}");
+            }
+
+            position += 2;
+            var remaining = text.Slice(position, end - position);
+            int consumed;
+
+            if (remaining.Length > 0 && remaining[0] == (byte)'[') {
+                if (depth + 1 > MaxDepth) {
+                    throw new FormatException($"Maximum nesting depth exceeded ({MaxDepth})");
+                }
+                consumed = FindClosingBracket(remaining, index, position - lineStart) + 1;
+                var entry = tape.Add(keyOffset, eqIndex, typeChar, true, position, consumed);
+                if (typeChar == 'o') {
+                    ParseTapeObjects(text, position + 1, consumed - 2, tape, depth + 1, index, lineStart);
+                }
+                tape.Close(entry);
+            } else if (typeChar == 'o') {
+                if (remaining.Length == 0 || remaining[0] != (byte)'{') {
+                    throw new FormatException("Object must start with '{'");
+                }
+                if (depth + 1 > MaxDepth) {
+                    throw new FormatException($"Maximum nesting depth exceeded ({MaxDepth})");
+                }
+                consumed = FindClosingBrace(remaining, index, position - lineStart) + 1;
+                var entry = tape.Add(keyOffset, eqIndex, typeChar, false, position, consumed);
+                ParseTapeBody(text, position + 1, consumed - 2, tape, depth + 1, index, lineStart);
+                tape.Close(entry);
+            } else {
+                consumed = SkipValue(remaining, typeChar, index, position - lineStart);
+                // SkipValue counts the trailing ',', the value itself ends before it
+                var valueLength = consumed > 0 && remaining[consumed - 1] == (byte)',' ? consumed - 1 : consumed;
+                tape.Add(keyOffset, eqIndex, typeChar, false, position, valueLength);
+                consumed = valueLength;
+            }
+
+            position += consumed;
+            if (position < end && text[position] == (byte)',') {
+                position++;
+            }
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Adds one keyless 'o' entry per element of an object array, each followed by its fields.
+    /// </summary>
+    private static void ParseTapeObjects(ReadOnlySpan<byte> text, int start, int length, FonTape tape, int depth, FonStructuralIndex? index, int lineStart) {
+        int position = start;
+        int end = start + length;
+
+        while (position < end) {
+            if (text[position] != (byte)'{') {
+                throw new FormatException("Object must start with '{'");
+            }
+            var consumed = FindClosingBrace(text.Slice(position, end - position), index, position - lineStart) + 1;
+            var element = tape.Add(position, 0, 'o', false, position, consumed);
+            ParseTapeBody(text, position + 1, consumed - 2, tape, depth + 1, index, lineStart);
+            tape.Close(element);
+
+            position += consumed;
+            if (position < end && text[position] == (byte)',') {
+                position++;
+            }
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Decodes a value recorded on a tape; <paramref name="raw"/> is the value text the tape points at.
+    /// </summary>
+    internal static FonValue DecodeTapeValue(ReadOnlySpan<byte> raw, char typeChar, bool isArray) {
+        var type = GetType(typeChar)!;
+        if (isArray) {
+            var (list, _) = DeserializeArrayOptimized(raw, type, typeChar, 1);
+            return FonValue.FromList(list, typeChar);
+        }
+        return DeserializeValueOptimized(raw, type, typeChar, 0).data;
+    }
+
+
+
+
+    /// <summary>
+    /// Parses one record (a single line, without the newline) into <paramref name="target"/>, replacing what
+    /// it held. With a <paramref name="pool"/> the old nested values go back to it and the new nested
+    /// collections and lists are rented from it, so a warm loop of parse, change, serialize and
+    /// <see cref="FonCollectionPool.Return(FonCollection)"/> allocates next to nothing.
+    /// </summary>
+    /// <exception cref="FormatException">The line is malformed; <paramref name="target"/> then holds the keys parsed so far.</exception>
+    public static void DeserializeInto(ReadOnlySpan<byte> line, FonCollection target, FonCollectionPool? pool = null) {
+        ArgumentNullException.ThrowIfNull(target);
+        if (line.StartsWith(Utf8Bom)) {
+            line = line.Slice(Utf8Bom.Length);
+        }
+
+        if (pool != null) {
+            pool.Recycle(target);
+        } else {
+            target.Reset();
+        }
+
+        var previous = FonCollectionPool.Parsing;
+        FonCollectionPool.Parsing = pool;
+        var index = FonStructuralIndex.Build(line);
+        try {
+            ParseCollectionBody(line, 0, target: target, index: index);
+        } finally {
+            FonCollectionPool.Parsing = previous;
+            FonStructuralIndex.Return(index);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Parses the fields of a line or object body. <paramref name="index"/>, when there is one, indexes
+    /// the whole line and <paramref name="origin"/> is where <paramref name="bytes"/> starts in it.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveOptimization)]
+    private static FonCollection ParseCollectionBody(ReadOnlySpan<byte> bytes, int depth, KeySelection? selection = null, FonCollection? target = null, FonStructuralIndex? index = null, int origin = 0) {
+        var builder = new FonCollectionBuilder(depth, ShareKeyShapes, target);
+        int position = 0;
+        int found = 0;
+
+        while (position < bytes.Length) {
+            var remaining = bytes.Slice(position);
+
+            var eqIndex = remaining.IndexOf((byte)'=');
+            if (eqIndex < 0) {
+                break;
+            }
+
+            var keySpan = remaining.Slice(0, eqIndex);
+            var selected = selection?.IndexOf(keySpan) ?? 0;
+            position += eqIndex + 1;
+            remaining = bytes.Slice(position);
+
+            if (remaining.Length < 2 || remaining[1] != (byte)':') {
+                throw new FormatException($"Invalid format at position {position}");
+            }
+
+            var typeChar = (char)remaining[0];
+            var type = GetType(typeChar);
+            if (type == null) {
+                throw new FormatException($"Unknown type '{typeChar}' at position {position}");
+            }
+
+            position += 2;
+            remaining = bytes.Slice(position);
+
+            if (selected < 0) {
+                position += SkipValue(remaining, typeChar, index, origin + position);
+                continue;
+            }
+
+            var key = selection == null ? FonKeyCache.Get(keySpan) : selection.GetName(selected);
+            var child = selection?.GetChild(selected);
+
+            FonValue data;
+            int consumed;
+
+            if (remaining.Length > 0 && remaining[0] == (byte)'[') {
+                (var list, consumed) = DeserializeArrayOptimized(remaining, type, typeChar, depth + 1, child, index, origin + position);
+                data = FonValue.FromList(list, typeChar);
+            } else {
+                (data, consumed) = DeserializeValueOptimized(remaining, type, typeChar, depth, child, index, origin + position);
+            }
+
+            builder.Add(key, data);
+            position += consumed;
+
+            // Every selected key is in, the rest of the body is not even scanned
+            if (selection != null && ++found == selection.Count) {
+                break;
+            }
+
+            if (position < bytes.Length && bytes[position] == (byte)',') {
+                position++;
+            }
+        }
+
+        return builder.Build();
+    }
+
+
+
+
+    /// <summary>
+    /// Returns how many bytes the value at the start of <paramref name="bytes"/> spans (including the
+    /// trailing ','), without parsing it. Uses the same bracket and string-end scanning as the parser.
+    /// </summary>
+    internal static int SkipValue(ReadOnlySpan<byte> bytes, char typeChar, FonStructuralIndex? index = null, int origin = 0) {
+        int end;
+
+        if (bytes.Length > 0 && bytes[0] == (byte)'[') {
+            end = FindClosingBracket(bytes, index, origin) + 1;
+        } else if (typeChar == 'o') {
+            if (bytes.Length == 0 || bytes[0] != (byte)'{') {
+                throw new FormatException("Object must start with '{'");
+            }
+            end = FindClosingBrace(bytes, index, origin) + 1;
+        } else if (typeChar == 's' || typeChar == 'r') {
+            if (bytes.Length == 0 || bytes[0] != (byte)'"') {
+                throw new FormatException("String must start with '\"'");
+            }
+            var endQuote = FindStringEnd(bytes, 1, index, origin);
+            end = endQuote < 0 ? bytes.Length : endQuote + 1;
+        } else {
+            end = FindValueEnd(bytes, index, origin);
+        }
+
+        if (end < bytes.Length && bytes[end] == (byte)',') {
+            end++;
+        }
+        return end;
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static (FonValue data, int consumed) DeserializeValueOptimized(ReadOnlySpan<byte> bytes, Type type, char typeChar, int depth, KeySelection? selection = null, FonStructuralIndex? index = null, int origin = 0) {
+        if (typeChar == 'o') {
+            if (bytes.Length == 0 || bytes[0] != (byte)'{') {
+                throw new FormatException("Object must start with '{'");
+            }
+            var (obj, consumed) = DeserializeObjectOptimized(bytes, depth + 1, selection, index, origin);
+            return (FonValue.FromReference('o', obj), consumed);
+        }
+
+        if (typeChar == 's') {
+            var (text, consumed) = DeserializeStringOptimized(bytes, index, origin);
+            return (FonValue.FromReference('s', text), consumed);
+        }
+
+        if (typeChar == 'r') {
+            var (raw, consumed) = DeserializeRawOptimized(bytes);
+            return (FonValue.FromReference('r', raw), consumed);
+        }
+
+        var endIndex = FindValueEnd(bytes, index, origin);
+        var valueSpan = bytes.Slice(0, endIndex);
+        var consumed2 = endIndex;
+
+        if (consumed2 < bytes.Length && bytes[consumed2] == (byte)',') {
+            consumed2++;
+        }
+
+        FonValue value = typeChar switch {
+            'e' => FonValue.Create(ParseByteUtf8(valueSpan)),
+            't' => FonValue.Create(ParseInt16Utf8(valueSpan)),
+            'i' => FonValue.Create(ParseInt32Utf8(valueSpan)),
+            'u' => FonValue.Create(ParseUInt32Utf8(valueSpan)),
+            'l' => FonValue.Create(ParseInt64Utf8(valueSpan)),
+            'g' => FonValue.Create(ParseUInt64Utf8(valueSpan)),
+            'f' => FonValue.Create(ParseFloatUtf8(valueSpan)),
+            'd' => FonValue.Create(ParseDoubleUtf8(valueSpan)),
+            'b' => FonValue.Create(valueSpan[0] != (byte)'0'),
+            _ => throw new NotSupportedException($"Type '{typeChar}' is not supported")
+        };
+
+        return (value, consumed2);
+    }
+
+
+
+
+    internal static FormatException InvalidNumber(char typeChar, ReadOnlySpan<byte> valueSpan) {
+        return new FormatException($"Invalid value '{Encoding.UTF8.GetString(valueSpan)}' for type '{typeChar}'");
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static int FindValueEnd(ReadOnlySpan<byte> bytes, FonStructuralIndex? index = null, int origin = 0) {
+        if (index == null) {
+            var end = bytes.IndexOfAny(valueTerminatorsUtf8);
+            return end < 0 ? bytes.Length : end;
+        }
+
+        var limit = origin + bytes.Length;
+        for (var position = index.NextStructural(origin, limit); position >= 0; position = index.NextStructural(position + 1, limit)) {
+            if (bytes[position - origin] is (byte)',' or (byte)']' or (byte)'\r' or (byte)'\n') {
+                return position - origin;
+            }
+        }
+        return bytes.Length;
+    }
+
+
+
+
+    internal static (IList data, int consumed) DeserializeArrayOptimized(ReadOnlySpan<byte> bytes, Type elementType, char typeChar, int depth, KeySelection? selection = null, FonStructuralIndex? index = null, int origin = 0) {
+        if (depth > Fon.MaxDepth) {
+            throw new FormatException($"Maximum nesting depth exceeded ({Fon.MaxDepth})");
+        }
+
+        if (bytes[0] != (byte)'[') {
+            throw new FormatException("Array must start with '['");
+        }
+
+        var closeIndex = FindClosingBracket(bytes, index, origin);
+        var arrayContent = bytes.Slice(1, closeIndex - 1);
+
+        if (IsPrimitiveArrayCode(typeChar)) {
+            var primitives = ParsePrimitiveArray(arrayContent, typeChar);
+            var primitiveConsumed = closeIndex + 1;
+            if (primitiveConsumed < bytes.Length && bytes[primitiveConsumed] == (byte)',') {
+                primitiveConsumed++;
+            }
+            return (primitives, primitiveConsumed);
+        }
+
+        var list = FonCollectionPool.Parsing?.RentList(typeChar) ?? CreateTypedList(elementType, typeChar);
+
+        if (arrayContent.Length == 0) {
+            var consumed = closeIndex + 1;
+            if (consumed < bytes.Length && bytes[consumed] == (byte)',') {
+                consumed++;
+            }
+            return (list, consumed);
+        }
+
+        int position = 0;
+        while (position < arrayContent.Length) {
+            var remaining = arrayContent.Slice(position);
+            var (value, valueConsumed) = DeserializeValueOptimized(remaining, elementType, typeChar, depth, selection, index, origin + 1 + position);
+            list.Add(value.ToObject());
+            position += valueConsumed;
+        }
+
+        var totalConsumed = closeIndex + 1;
+        if (totalConsumed < bytes.Length && bytes[totalConsumed] == (byte)',') {
+            totalConsumed++;
+        }
+
+        return (list, totalConsumed);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int FindClosingBracket(ReadOnlySpan<byte> bytes, FonStructuralIndex? index = null, int origin = 0) {
+        var close = index == null ? FindClosing(bytes, (byte)'[', (byte)']') : FindClosing(bytes, (byte)'[', (byte)']', index, origin);
+        if (close < 0) {
+            throw new FormatException("Closing bracket not found");
+        }
+        return close;
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int FindClosingBrace(ReadOnlySpan<byte> bytes, FonStructuralIndex? index = null, int origin = 0) {
+        var close = index == null ? FindClosing(bytes, (byte)'{', (byte)'}') : FindClosing(bytes, (byte)'{', (byte)'}', index, origin);
+        if (close < 0) {
+            throw new FormatException("Closing brace not found");
+        }
+        return close;
+    }
+
+
+
+
+    /// <summary>
+    /// Finds the bracket matching bytes[0], jumping between interesting bytes with IndexOfAny
+    /// instead of walking one byte at a time. Quoted strings are skipped as a whole.
+    /// </summary>
+    private static int FindClosing(ReadOnlySpan<byte> bytes, byte open, byte close) {
+        int depth = 0;
+        int position = 0;
+
+        while (position < bytes.Length) {
+            var next = bytes.Slice(position).IndexOfAny((byte)'"', open, close);
+            if (next < 0) {
+                return -1;
+            }
+            position += next;
+
+            var c = bytes[position];
+            if (c == (byte)'"') {
+                var end = FindStringEnd(bytes, position + 1);
+                if (end < 0) {
+                    return -1;
+                }
+                position = end + 1;
+                continue;
+            }
+
+            if (c == open) {
+                depth++;
+            } else if (--depth == 0) {
+                return position;
+            }
+            position++;
+        }
+
+        return -1;
+    }
+
+
+    /// <summary>
+    /// Same as above over the structural bitmap: strings are already masked out, so only the brackets
+    /// themselves are visited.
+    /// </summary>
+    private static int FindClosing(ReadOnlySpan<byte> bytes, byte open, byte close, FonStructuralIndex index, int origin) {
+        int depth = 0;
+        var limit = origin + bytes.Length;
+
+        for (var position = index.NextStructural(origin, limit); position >= 0; position = index.NextStructural(position + 1, limit)) {
+            var c = bytes[position - origin];
+            if (c == open) {
+                depth++;
+            } else if (c == close && --depth == 0) {
+                return position - origin;
+            }
+        }
+
+        return -1;
+    }
+
+
+
+
+    /// <summary>
+    /// Returns the index of the closing quote of a string whose content starts at <paramref name="start"/>,
+    /// honoring backslash escapes. Returns -1 if the string is not terminated.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int FindStringEnd(ReadOnlySpan<byte> bytes, int start, FonStructuralIndex? index = null, int origin = 0) {
+        if (index != null) {
+            var end = index.NextQuote(origin + start, origin + bytes.Length);
+            return end < 0 ? -1 : end - origin;
+        }
+
+        int position = start;
+
+        while (position < bytes.Length) {
+            var next = bytes.Slice(position).IndexOfAny((byte)'"', (byte)'\\');
+            if (next < 0) {
+                return -1;
+            }
+            position += next;
+
+            if (bytes[position] == (byte)'"') {
+                return position;
+            }
+            // Skip the escaped byte
+            position += 2;
+        }
+
+        return -1;
+    }
+
+
+
+
+    private static (FonCollection data, int consumed) DeserializeObjectOptimized(ReadOnlySpan<byte> bytes, int depth, KeySelection? selection = null, FonStructuralIndex? index = null, int origin = 0) {
+        if (depth > Fon.MaxDepth) {
+            throw new FormatException($"Maximum nesting depth exceeded ({Fon.MaxDepth})");
+        }
+
+        if (bytes[0] != (byte)'{') {
+            throw new FormatException("Object must start with '{'");
+        }
+
+        var closeIndex = FindClosingBrace(bytes, index, origin);
+        var body = bytes.Slice(1, closeIndex - 1);
+
+        var collection = ParseCollectionBody(body, depth, selection, index: index, origin: origin + 1);
+
+        var consumed = closeIndex + 1;
+        if (consumed < bytes.Length && bytes[consumed] == (byte)',') {
+            consumed++;
+        }
+
+        return (collection, consumed);
+    }
+
+
+
+
+    internal static (string data, int consumed) DeserializeStringOptimized(ReadOnlySpan<byte> bytes, FonStructuralIndex? index = null, int origin = 0) {
+        if (bytes[0] != (byte)'"') {
+            throw new FormatException("String must start with '\"'");
+        }
+
+        var endQuote = FindStringEnd(bytes, 1, index, origin);
+        if (endQuote < 0) {
+            endQuote = bytes.Length;
+        }
+
+        var stringContent = bytes.Slice(1, endQuote - 1);
+
+        // Check if escape sequence processing is needed
+        var backslashIndex = stringContent.IndexOf((byte)'\\');
+        string result;
+
+        if (backslashIndex < 0) {
+            // No escape sequences - decode directly
+            result = Encoding.UTF8.GetString(stringContent);
+        } else {
+            // Has escapes - process
+            result = UnescapeString(stringContent);
+        }
+
+        var consumed = endQuote + 1;
+        if (consumed < bytes.Length && bytes[consumed] == (byte)',') {
+            consumed++;
+        }
+
+        return (result, consumed);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveOptimization)]
+    private static string UnescapeString(ReadOnlySpan<byte> bytes) {
+        // Escapes are ASCII, so unescaping in UTF-8 never grows the data
+        var maxLength = bytes.Length;
+        byte[]? rentedArray = null;
+
+        Span<byte> buffer = maxLength <= 1024
+            ? stackalloc byte[maxLength]
+            : (rentedArray = ArrayPool<byte>.Shared.Rent(maxLength));
+
+        try {
+            int writePos = 0;
+
+            for (int i = 0; i < bytes.Length; i++) {
+                if (bytes[i] == (byte)'\\' && i + 1 < bytes.Length) {
+                    i++;
+                    buffer[writePos++] = bytes[i] switch {
+                        (byte)'"' => (byte)'"',
+                        (byte)'\\' => (byte)'\\',
+                        (byte)'n' => (byte)'\n',
+                        (byte)'r' => (byte)'\r',
+                        (byte)'t' => (byte)'\t',
+                        (byte)'b' => (byte)'\b',
+                        (byte)'f' => (byte)'\f',
+                        (byte)'/' => (byte)'/',
+                        _ => bytes[i]
+                    };
+                } else {
+                    buffer[writePos++] = bytes[i];
+                }
+            }
+
+            return Encoding.UTF8.GetString(buffer.Slice(0, writePos));
+        } finally {
+            if (rentedArray != null) {
+                ArrayPool<byte>.Shared.Return(rentedArray);
+            }
+        }
+    }
+
+
+
+
+    internal static (RawData data, int consumed) DeserializeRawOptimized(ReadOnlySpan<byte> bytes) {
+        if (bytes[0] != (byte)'"') {
+            throw new FormatException("RawData must start with '\"'");
+        }
+
+        // Z85 alphabet has no quotes, so the first quote closes the value
+        var endQuote = bytes.Slice(1).IndexOf((byte)'"');
+        endQuote = endQuote < 0 ? bytes.Length : endQuote + 1;
+
+        // The source buffer is reused after this line: decode straight out of it, or keep one copy of the text
+        var encodedContent = bytes.Slice(1, endQuote - 1);
+        var rawData = RawUnpack switch {
+            RawUnpackMode.Eager => RawData.Decode(encodedContent),
+            RawUnpackMode.Lazy => RawData.CopyEncoded(encodedContent).DecodeOnAccess(),
+            _ => RawData.CopyEncoded(encodedContent)
+        };
+
+        var consumed = endQuote + 1;
+        if (consumed < bytes.Length && bytes[consumed] == (byte)',') {
+            consumed++;
+        }
+
+        return (rawData, consumed);
+    }
+}
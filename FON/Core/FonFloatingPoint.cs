@@ -0,0 +1,249 @@
+using System.Buffers.Text;
+using System.Globalization;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Fast paths for f and d values. Formatting keeps the shortest round-trip form of
+/// <see cref="double.TryFormat(Span{byte}, out int, ReadOnlySpan{char}, IFormatProvider?)"/> but writes small
+/// integral values through the integer formatter, which prints the same digits without the shortest-digit search.
+/// Parsing takes Clinger's exact fast path for short decimals and falls back to the BCL for everything else.
+/// </summary>
+public partial class Fon {
+    // Below these magnitudes .NET prints integral values without an exponent, exactly like the integer formatter
+    private const double MaxPlainIntegralDouble = 1e15;
+    private const float MaxPlainIntegralSingle = 1e7f;
+
+    // Mantissas up to 2^53 (2^24) and powers of ten up to 10^22 (10^10) are exact, so one multiply or divide rounds correctly
+    private const ulong MaxExactDoubleMantissa = 1UL << 53;
+    private const ulong MaxExactSingleMantissa = 1UL << 24;
+    private const int MaxExactDoublePower = 22;
+    private const int MaxExactSinglePower = 10;
+
+    private static readonly double[] doublePowersOfTen = [
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    ];
+
+    private static readonly float[] singlePowersOfTen = [
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+    ];
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsPlainIntegral(double value) {
+        // NaN fails the range check; -0 must keep its sign, which the integer formatter would drop
+        return Math.Abs(value) < MaxPlainIntegralDouble && value == (long)value && (value != 0 || !double.IsNegative(value));
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsPlainIntegral(float value) {
+        return Math.Abs(value) < MaxPlainIntegralSingle && value == (int)value && (value != 0 || !float.IsNegative(value));
+    }
+
+
+
+
+    /// <summary>
+    /// Formats a number as invariant UTF-8, taking the integer path for integral f and d values.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static bool TryFormatNumber<T>(T value, Span<byte> destination, out int written) where T : IUtf8SpanFormattable {
+        // typeof(T) checks are folded by the JIT and the (double)(object) unboxing casts cost nothing
+        if (typeof(T) == typeof(double)) {
+            double d = (double)(object)value;
+            if (IsPlainIntegral(d)) {
+                return ((long)d).TryFormat(destination, out written, default, CultureInfo.InvariantCulture);
+            }
+        } else if (typeof(T) == typeof(float)) {
+            float f = (float)(object)value;
+            if (IsPlainIntegral(f)) {
+                return ((int)f).TryFormat(destination, out written, default, CultureInfo.InvariantCulture);
+            }
+        }
+        return value.TryFormat(destination, out written, default, CultureInfo.InvariantCulture);
+    }
+
+
+
+
+    /// <summary>
+    /// Splits a plain decimal ("-12.5", "1e-7", "0.001") into a mantissa of at most 19 digits and a power of ten.
+    /// Returns false for anything else, including NaN, infinities and longer mantissas.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool TryParseDecimal<TChar>(ReadOnlySpan<TChar> span, out ulong mantissa, out int exponent, out bool negative)
+        where TChar : unmanaged, IBinaryInteger<TChar> {
+        mantissa = 0;
+        exponent = 0;
+        negative = false;
+
+        int i = 0;
+        if (span.Length > 0 && uint.CreateTruncating(span[0]) == '-') {
+            negative = true;
+            i++;
+        }
+
+        int digits = 0;
+        int significant = 0;
+        uint c;
+        while (i < span.Length && (c = uint.CreateTruncating(span[i]) - '0') <= 9) {
+            if (mantissa != 0 || c != 0) {
+                mantissa = mantissa * 10 + c;
+                significant++;
+            }
+            digits++;
+            i++;
+        }
+        if (i < span.Length && uint.CreateTruncating(span[i]) == '.') {
+            i++;
+            while (i < span.Length && (c = uint.CreateTruncating(span[i]) - '0') <= 9) {
+                if (mantissa != 0 || c != 0) {
+                    mantissa = mantissa * 10 + c;
+                    significant++;
+                }
+                exponent--;
+                digits++;
+                i++;
+            }
+        }
+        if (digits == 0 || significant > 19) {
+            return false;
+        }
+
+        if (i < span.Length && (uint.CreateTruncating(span[i]) | 0x20) == 'e') {
+            i++;
+            bool negativeExponent = false;
+            if (i < span.Length && uint.CreateTruncating(span[i]) is '-' or '+') {
+                negativeExponent = uint.CreateTruncating(span[i]) == '-';
+                i++;
+            }
+            int start = i;
+            int value = 0;
+            // Four digits are far past any finite exponent, more would only risk overflow
+            while (i < span.Length && i - start < 4 && (c = uint.CreateTruncating(span[i]) - '0') <= 9) {
+                value = value * 10 + (int)c;
+                i++;
+            }
+            if (i == start) {
+                return false;
+            }
+            exponent += negativeExponent ? -value : value;
+        }
+        return i == span.Length;
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool TryParseDoubleFast<TChar>(ReadOnlySpan<TChar> span, out double value) where TChar : unmanaged, IBinaryInteger<TChar> {
+        if (!TryParseDecimal(span, out ulong mantissa, out int exponent, out bool negative)
+            || mantissa > MaxExactDoubleMantissa || exponent < -MaxExactDoublePower || exponent > MaxExactDoublePower) {
+            value = 0;
+            return false;
+        }
+        value = exponent < 0 ? mantissa / doublePowersOfTen[-exponent] : mantissa * doublePowersOfTen[exponent];
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool TryParseSingleFast<TChar>(ReadOnlySpan<TChar> span, out float value) where TChar : unmanaged, IBinaryInteger<TChar> {
+        if (!TryParseDecimal(span, out ulong mantissa, out int exponent, out bool negative)
+            || mantissa > MaxExactSingleMantissa || exponent < -MaxExactSinglePower || exponent > MaxExactSinglePower) {
+            value = 0;
+            return false;
+        }
+        // Float arithmetic on purpose: rounding through double first could round twice
+        value = exponent < 0 ? mantissa / singlePowersOfTen[-exponent] : mantissa * singlePowersOfTen[exponent];
+        if (negative) {
+            value = -value;
+        }
+        return true;
+    }
+
+
+
+
+    /// <summary>
+    /// Recognizes the "inf" / "-inf" spelling the Rust crate prints; the BCL only accepts "Infinity".
+    /// </summary>
+    private static bool TryParseRustInfinity<TChar>(ReadOnlySpan<TChar> span, out bool negative) where TChar : unmanaged, IBinaryInteger<TChar> {
+        negative = span.Length == 4 && uint.CreateTruncating(span[0]) == '-';
+        var rest = negative ? span[1..] : span;
+        return rest.Length == 3
+            && uint.CreateTruncating(rest[0]) == 'i' && uint.CreateTruncating(rest[1]) == 'n' && uint.CreateTruncating(rest[2]) == 'f';
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static float ParseFloatUtf8(ReadOnlySpan<byte> valueSpan) {
+        if (TryParseSingleFast(valueSpan, out float value)) {
+            return value;
+        }
+        if (Utf8Parser.TryParse(valueSpan, out value, out int consumed) && consumed == valueSpan.Length) {
+            return value;
+        }
+        if (TryParseRustInfinity(valueSpan, out bool negative)) {
+            return negative ? float.NegativeInfinity : float.PositiveInfinity;
+        }
+        // Utf8Parser does not understand NaN/Infinity, which float.ToString emits
+        return float.Parse(valueSpan, NumberStyles.Float | NumberStyles.AllowThousands, CultureInfo.InvariantCulture);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static double ParseDoubleUtf8(ReadOnlySpan<byte> valueSpan) {
+        if (TryParseDoubleFast(valueSpan, out double value)) {
+            return value;
+        }
+        if (Utf8Parser.TryParse(valueSpan, out value, out int consumed) && consumed == valueSpan.Length) {
+            return value;
+        }
+        if (TryParseRustInfinity(valueSpan, out bool negative)) {
+            return negative ? double.NegativeInfinity : double.PositiveInfinity;
+        }
+        // Utf8Parser does not understand NaN/Infinity, which double.ToString emits
+        return double.Parse(valueSpan, NumberStyles.Float | NumberStyles.AllowThousands, CultureInfo.InvariantCulture);
+    }
+
+
+
+
+    internal static float ParseFloat(ReadOnlySpan<char> valueSpan) {
+        if (TryParseSingleFast(valueSpan, out float value)) {
+            return value;
+        }
+        if (TryParseRustInfinity(valueSpan, out bool negative)) {
+            return negative ? float.NegativeInfinity : float.PositiveInfinity;
+        }
+        return float.Parse(valueSpan, CultureInfo.InvariantCulture);
+    }
+
+
+
+
+    internal static double ParseDouble(ReadOnlySpan<char> valueSpan) {
+        if (TryParseDoubleFast(valueSpan, out double value)) {
+            return value;
+        }
+        if (TryParseRustInfinity(valueSpan, out bool negative)) {
+            return negative ? double.NegativeInfinity : double.PositiveInfinity;
+        }
+        return double.Parse(valueSpan, CultureInfo.InvariantCulture);
+    }
+}
@@ -0,0 +1,76 @@
+using System.Runtime.CompilerServices;
+using System.Text;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Interns record keys while parsing, so a file of identical records shares one string per key
+/// instead of allocating it again on every line.
+/// </summary>
+/// <remarks>
+/// Each thread owns a small direct-mapped table keyed by a hash of the key span: lookups take no
+/// lock and there is nothing to merge, a key seen on several threads is at most one string per thread.
+/// A colliding key simply replaces the slot. Only short ASCII keys are cached (the common case for
+/// FON keys); anything else is decoded as before.
+/// </remarks>
+internal static class FonKeyCache {
+    private const int Slots = 1024;
+    private const int MaxKeyLength = 64;
+
+    [ThreadStatic]
+    private static string?[]? table;
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static string Get(ReadOnlySpan<byte> utf8) {
+        if (utf8.Length > MaxKeyLength || !Ascii.IsValid(utf8)) {
+            return Encoding.UTF8.GetString(utf8);
+        }
+
+        var slots = table ??= new string?[Slots];
+        ref var slot = ref slots[Hash(utf8) & (Slots - 1)];
+        if (slot is { } cached && cached.Length == utf8.Length && Ascii.Equals(utf8, cached)) {
+            return cached;
+        }
+        return slot = Encoding.ASCII.GetString(utf8);
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static string Get(ReadOnlySpan<char> chars) {
+        if (chars.Length > MaxKeyLength || !Ascii.IsValid(chars)) {
+            return chars.ToString();
+        }
+
+        var slots = table ??= new string?[Slots];
+        ref var slot = ref slots[Hash(chars) & (Slots - 1)];
+        if (slot is { } cached && chars.SequenceEqual(cached)) {
+            return cached;
+        }
+        return slot = chars.ToString();
+    }
+
+
+
+
+    // FNV-1a over the ASCII code units, so both overloads agree on the slot of a key
+    private static int Hash(ReadOnlySpan<byte> key) {
+        uint hash = 2166136261;
+        foreach (var b in key) {
+            hash = (hash ^ b) * 16777619;
+        }
+        return (int)(hash ^ (hash >> 15));
+    }
+
+
+    private static int Hash(ReadOnlySpan<char> key) {
+        uint hash = 2166136261;
+        foreach (var c in key) {
+            hash = (hash ^ c) * 16777619;
+        }
+        return (int)(hash ^ (hash >> 15));
+    }
+}
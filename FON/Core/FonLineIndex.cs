@@ -0,0 +1,354 @@
+using FON.Types;
+using System.Text;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// What the file serializers put into the line index sidecar. See <see cref="Fon.LineIndex"/>.
+/// </summary>
+public sealed class FonLineIndexOptions {
+    public const int DefaultStride = 128;
+
+    /// <summary>
+    /// Every Stride-th line gets its byte offset recorded; a lookup reads at most Stride - 1 lines too many.
+    /// </summary>
+    public int Stride { get; }
+
+    /// <summary>
+    /// Top-level numeric keys to keep per-block min/max values (zone maps) for.
+    /// </summary>
+    public IReadOnlyList<string> Keys { get; }
+
+
+    public FonLineIndexOptions(int stride = DefaultStride, params string[] keys) {
+        ArgumentOutOfRangeException.ThrowIfLessThan(stride, 1);
+        ArgumentNullException.ThrowIfNull(keys);
+        if (keys.Any(string.IsNullOrEmpty)) {
+            throw new ArgumentException("Keys must not be empty", nameof(keys));
+        }
+
+        Stride = stride;
+        Keys = keys.Distinct().ToArray();
+    }
+}
+
+
+
+
+/// <summary>
+/// Sparse index over the lines of a FON file: the byte offset of every <see cref="Stride"/>-th line,
+/// plus optional min/max values of numeric keys per block of Stride lines. Lets
+/// <see cref="Fon.ReadRangeAsync"/> seek to a line instead of parsing everything before it.
+/// </summary>
+/// <remarks>
+/// Lines are numbered like the dump loaders do, so a line number is the id the record gets when the
+/// file is loaded. The sidecar (<c>data.fon.idx</c>) is little-endian binary; it remembers the length and
+/// last write time of the file it was built for, and a difference in either marks it stale (so does
+/// copying the file, which gives the copy a new write time).
+/// </remarks>
+public sealed class FonLineIndex {
+    /// <summary>
+    /// Appended to the data file name to get the sidecar file name.
+    /// </summary>
+    public const string FileExtension = ".idx";
+
+    private const uint Magic = 0x58444E46; // "FNDX"
+    private const int Version = 2;
+
+    private readonly long[] offsets;
+    private readonly string[] keys;
+    private readonly double[][] minimums;
+    private readonly double[][] maximums;
+
+
+    internal FonLineIndex(int stride, ulong lineCount, long fileLength, DateTime fileLastWriteTimeUtc, long[] offsets, string[] keys, double[][] minimums, double[][] maximums) {
+        Stride = stride;
+        LineCount = lineCount;
+        FileLength = fileLength;
+        FileLastWriteTimeUtc = fileLastWriteTimeUtc;
+        this.offsets = offsets;
+        this.keys = keys;
+        this.minimums = minimums;
+        this.maximums = maximums;
+    }
+
+
+    public int Stride { get; }
+
+    /// <summary>
+    /// Number of lines in the file, empty ones included.
+    /// </summary>
+    public ulong LineCount { get; }
+
+    /// <summary>
+    /// Length of the file the index was built for.
+    /// </summary>
+    public long FileLength { get; }
+
+    /// <summary>
+    /// Last write time (UTC) of the file the index was built for.
+    /// </summary>
+    public DateTime FileLastWriteTimeUtc { get; }
+
+    /// <summary>
+    /// Keys with zone maps.
+    /// </summary>
+    public IReadOnlyList<string> Keys => keys;
+
+    /// <summary>
+    /// Number of blocks of <see cref="Stride"/> lines (the last one may be shorter).
+    /// </summary>
+    public int BlockCount => offsets.Length;
+
+
+    /// <summary>
+    /// Sidecar file of <paramref name="file"/>: the same name with <see cref="FileExtension"/> appended.
+    /// </summary>
+    public static FileInfo GetPath(FileInfo file) => new(file.FullName + FileExtension);
+
+
+
+
+    /// <summary>
+    /// Line ranges whose blocks may hold a <paramref name="key"/> value in [min, max]; every other block
+    /// is known not to. Adjacent blocks are merged, so each range can be passed to <see cref="Fon.ReadRangeAsync"/>.
+    /// </summary>
+    /// <exception cref="ArgumentException">The key has no zone map.</exception>
+    public IEnumerable<(ulong start, int count)> FindRanges(string key, double min, double max) {
+        var k = Array.IndexOf(keys, key);
+        if (k < 0) {
+            throw new ArgumentException($"Key '{key}' is not indexed", nameof(key));
+        }
+        return FindRanges(minimums[k], maximums[k], min, max);
+    }
+
+
+    private IEnumerable<(ulong start, int count)> FindRanges(double[] blockMin, double[] blockMax, double min, double max) {
+        ulong start = 0;
+        int count = 0;
+        for (int block = 0; block < offsets.Length; block++) {
+            var first = (ulong)block * (ulong)Stride;
+            var lines = (int)Math.Min((ulong)Stride, LineCount - first);
+
+            // Empty blocks keep +inf/-inf and never match
+            if (blockMin[block] <= max && blockMax[block] >= min) {
+                if (count > 0 && start + (ulong)count == first && count <= int.MaxValue - lines) {
+                    count += lines;
+                    continue;
+                }
+                if (count > 0) {
+                    yield return (start, count);
+                }
+                start = first;
+                count = lines;
+            }
+        }
+        if (count > 0) {
+            yield return (start, count);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// First line of the block holding <paramref name="line"/> and where it starts in the file.
+    /// </summary>
+    internal (ulong line, long offset) Seek(ulong line) {
+        var block = (int)(line / (ulong)Stride);
+        return ((ulong)block * (ulong)Stride, offsets[block]);
+    }
+
+
+    internal bool Matches(long fileLength, DateTime lastWriteTimeUtc) => fileLength == FileLength && lastWriteTimeUtc == FileLastWriteTimeUtc;
+
+
+    internal void EnsureMatches(FileInfo file, long fileLength, DateTime lastWriteTimeUtc) {
+        if (fileLength != FileLength) {
+            throw new InvalidOperationException($"Line index is stale: built for {FileLength} bytes, '{file.Name}' has {fileLength}");
+        }
+        if (lastWriteTimeUtc != FileLastWriteTimeUtc) {
+            throw new InvalidOperationException($"Line index is stale: built for '{file.Name}' as written at {FileLastWriteTimeUtc:O}, the file was written at {lastWriteTimeUtc:O}");
+        }
+    }
+
+
+
+
+    public void Save(FileInfo file) {
+        using var stream = new FileStream(file.FullName, FileMode.Create, FileAccess.Write, FileShare.None);
+        Save(stream);
+    }
+
+
+    public void Save(Stream stream) {
+        using var writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen: true);
+        writer.Write(Magic);
+        writer.Write(Version);
+        writer.Write(Stride);
+        writer.Write(LineCount);
+        writer.Write(FileLength);
+        writer.Write(FileLastWriteTimeUtc.Ticks);
+        writer.Write(offsets.Length);
+        writer.Write(keys.Length);
+        foreach (var key in keys) {
+            writer.Write(key);
+        }
+
+        foreach (var offset in offsets) {
+            writer.Write(offset);
+        }
+        for (int k = 0; k < keys.Length; k++) {
+            for (int block = 0; block < offsets.Length; block++) {
+                writer.Write(minimums[k][block]);
+                writer.Write(maximums[k][block]);
+            }
+        }
+    }
+
+
+
+
+    /// <exception cref="FormatException">The file is not a line index.</exception>
+    public static FonLineIndex Load(FileInfo file) {
+        using var stream = new FileStream(file.FullName, FileMode.Open, FileAccess.Read, FileShare.Read);
+        return Load(stream);
+    }
+
+
+    /// <exception cref="FormatException">The stream does not hold a line index.</exception>
+    public static FonLineIndex Load(Stream stream) {
+        using var reader = new BinaryReader(stream, Encoding.UTF8, leaveOpen: true);
+        try {
+            if (reader.ReadUInt32() != Magic) {
+                throw new FormatException("Not a FON line index");
+            }
+            var version = reader.ReadInt32();
+            if (version != Version) {
+                throw new FormatException($"Unsupported line index version {version}");
+            }
+
+            var stride = reader.ReadInt32();
+            var lineCount = reader.ReadUInt64();
+            var fileLength = reader.ReadInt64();
+            var lastWriteTicks = reader.ReadInt64();
+            var blockCount = reader.ReadInt32();
+            var keyCount = reader.ReadInt32();
+            if (stride < 1 || blockCount < 0 || keyCount < 0 || (ulong)blockCount != (lineCount + (ulong)stride - 1) / (ulong)stride
+                || lastWriteTicks < DateTime.MinValue.Ticks || lastWriteTicks > DateTime.MaxValue.Ticks) {
+                throw new FormatException("Corrupt line index header");
+            }
+
+            var keys = new string[keyCount];
+            for (int k = 0; k < keyCount; k++) {
+                keys[k] = reader.ReadString();
+            }
+
+            var offsets = new long[blockCount];
+            for (int block = 0; block < blockCount; block++) {
+                offsets[block] = reader.ReadInt64();
+            }
+            var minimums = new double[keyCount][];
+            var maximums = new double[keyCount][];
+            for (int k = 0; k < keyCount; k++) {
+                minimums[k] = new double[blockCount];
+                maximums[k] = new double[blockCount];
+                for (int block = 0; block < blockCount; block++) {
+                    minimums[k][block] = reader.ReadDouble();
+                    maximums[k][block] = reader.ReadDouble();
+                }
+            }
+
+            return new FonLineIndex(stride, lineCount, fileLength, new DateTime(lastWriteTicks, DateTimeKind.Utc), offsets, keys, minimums, maximums);
+        } catch (EndOfStreamException) {
+            throw new FormatException("Truncated line index");
+        }
+    }
+}
+
+
+
+
+/// <summary>
+/// Collects a <see cref="FonLineIndex"/> line by line, while a file is written or scanned.
+/// </summary>
+internal sealed class FonLineIndexBuilder {
+    private readonly int stride;
+    private readonly string[] keys;
+    private readonly List<long> offsets = [];
+    private readonly List<double>[] minimums;
+    private readonly List<double>[] maximums;
+    private ulong lineCount;
+    private long length;
+
+
+    public FonLineIndexBuilder(FonLineIndexOptions options) {
+        stride = options.Stride;
+        keys = options.Keys.ToArray();
+        minimums = new List<double>[keys.Length];
+        maximums = new List<double>[keys.Length];
+        for (int k = 0; k < keys.Length; k++) {
+            minimums[k] = [];
+            maximums[k] = [];
+        }
+    }
+
+
+    public bool HasKeys => keys.Length > 0;
+
+
+    /// <summary>
+    /// Adds the next line, starting at <paramref name="offset"/>; <paramref name="record"/> is null for an empty line.
+    /// </summary>
+    public void AddLine(long offset, FonCollection? record) {
+        if (lineCount % (ulong)stride == 0) {
+            offsets.Add(offset);
+            for (int k = 0; k < keys.Length; k++) {
+                minimums[k].Add(double.PositiveInfinity);
+                maximums[k].Add(double.NegativeInfinity);
+            }
+        }
+        lineCount++;
+
+        if (record == null) {
+            return;
+        }
+        for (int k = 0; k < keys.Length; k++) {
+            if (record.TryGetValue(keys[k], out var value) && value.TryGetNumber(out var number)) {
+                var last = offsets.Count - 1;
+                minimums[k][last] = Math.Min(minimums[k][last], number);
+                maximums[k][last] = Math.Max(maximums[k][last], number);
+            }
+        }
+    }
+
+
+    /// <summary>
+    /// Adds the lines a chunk of <see cref="Fon.WriteLines"/> output holds: one per non-null record, each ending in '\n'.
+    /// </summary>
+    public void AddChunk(ReadOnlySpan<byte> written, ArraySegment<FonCollection?> records, int start, int end) {
+        var position = 0;
+        for (int i = start; i < end; i++) {
+            if (records[i] is { } record) {
+                AddLine(length + position, record);
+                position += written.Slice(position).IndexOf((byte)'\n') + 1;
+            }
+        }
+        length += written.Length;
+    }
+
+
+    public FonLineIndex Build(long fileLength, DateTime lastWriteTimeUtc) {
+        return new FonLineIndex(
+            stride, lineCount, fileLength, lastWriteTimeUtc, offsets.ToArray(), keys,
+            minimums.Select(list => list.ToArray()).ToArray(),
+            maximums.Select(list => list.ToArray()).ToArray());
+    }
+
+
+    /// <summary>
+    /// Index of what <see cref="AddChunk"/> saw, for <paramref name="written"/> once it is closed.
+    /// </summary>
+    public FonLineIndex Build(FileInfo written) => Build(length, File.GetLastWriteTimeUtc(written.FullName));
+}
@@ -0,0 +1,245 @@
+using FON.Types;
+using System.Buffers.Binary;
+using System.Buffers.Text;
+using System.Collections;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Typed fast paths for primitive arrays (e, t, i, u, l, g, f, d, b). Elements are parsed straight into
+/// the backing array of an exactly sized <see cref="List{T}"/>, never through the boxing <see cref="IList"/>
+/// members; integers go through a SWAR parser that converts eight digits per step.
+/// </summary>
+public partial class Fon {
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static bool IsPrimitiveArrayCode(char typeChar) => typeChar is 'e' or 't' or 'i' or 'u' or 'l' or 'g' or 'f' or 'd' or 'b';
+
+
+
+
+    /// <summary>
+    /// Parses the content between '[' and ']' of a primitive array into a typed list.
+    /// </summary>
+    internal static IList ParsePrimitiveArray(ReadOnlySpan<byte> content, char typeChar) {
+        return typeChar switch {
+            'e' => ParseList<byte>(content, typeChar),
+            't' => ParseList<short>(content, typeChar),
+            'i' => ParseList<int>(content, typeChar),
+            'u' => ParseList<uint>(content, typeChar),
+            'l' => ParseList<long>(content, typeChar),
+            'g' => ParseList<ulong>(content, typeChar),
+            'f' => ParseList<float>(content, typeChar),
+            'd' => ParseList<double>(content, typeChar),
+            'b' => ParseList<bool>(content, typeChar),
+            _ => throw new NotSupportedException($"Type '{typeChar}' is not a primitive array type")
+        };
+    }
+
+
+    /// <summary>
+    /// Char-path twin of <see cref="ParsePrimitiveArray(ReadOnlySpan{byte}, char)"/>.
+    /// </summary>
+    internal static IList ParsePrimitiveArray(ReadOnlySpan<char> content, char typeChar) {
+        return typeChar switch {
+            'e' => ParseList<byte>(content, typeChar),
+            't' => ParseList<short>(content, typeChar),
+            'i' => ParseList<int>(content, typeChar),
+            'u' => ParseList<uint>(content, typeChar),
+            'l' => ParseList<long>(content, typeChar),
+            'g' => ParseList<ulong>(content, typeChar),
+            'f' => ParseList<float>(content, typeChar),
+            'd' => ParseList<double>(content, typeChar),
+            'b' => ParseList<bool>(content, typeChar),
+            _ => throw new NotSupportedException($"Type '{typeChar}' is not a primitive array type")
+        };
+    }
+
+
+
+
+    private static List<T> ParseList<T>(ReadOnlySpan<byte> content, char typeChar) where T : unmanaged {
+        // Numbers hold no commas, so the element count is known before parsing
+        var length = content.Count((byte)',') + 1;
+        var list = FonCollectionPool.Parsing?.RentList<T>(typeChar) ?? new List<T>(length);
+        CollectionsMarshal.SetCount(list, length);
+        var items = CollectionsMarshal.AsSpan(list);
+
+        int count = 0;
+        int position = 0;
+        while (position < content.Length) {
+            var rest = content.Slice(position);
+            var comma = rest.IndexOf((byte)',');
+            var element = comma < 0 ? rest : rest.Slice(0, comma);
+            items[count++] = ParseElement<T>(element, typeChar);
+            position += comma < 0 ? rest.Length : comma + 1;
+        }
+
+        // A trailing comma leaves one slot unused
+        CollectionsMarshal.SetCount(list, count);
+        return list;
+    }
+
+
+    private static List<T> ParseList<T>(ReadOnlySpan<char> content, char typeChar) where T : unmanaged {
+        var list = new List<T>(content.Count(',') + 1);
+        CollectionsMarshal.SetCount(list, list.Capacity);
+        var items = CollectionsMarshal.AsSpan(list);
+
+        int count = 0;
+        int position = 0;
+        while (position < content.Length) {
+            var rest = content.Slice(position);
+            var comma = rest.IndexOf(',');
+            var element = comma < 0 ? rest : rest.Slice(0, comma);
+            items[count++] = ParseElement<T>(element, typeChar);
+            position += comma < 0 ? rest.Length : comma + 1;
+        }
+
+        CollectionsMarshal.SetCount(list, count);
+        return list;
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T ParseElement<T>(ReadOnlySpan<byte> element, char typeChar) {
+        // typeof(T) checks are folded by the JIT and (T)(object) does not box for value types
+        if (typeof(T) == typeof(byte)) return (T)(object)ParseByteUtf8(element);
+        if (typeof(T) == typeof(short)) return (T)(object)ParseInt16Utf8(element);
+        if (typeof(T) == typeof(int)) return (T)(object)ParseInt32Utf8(element);
+        if (typeof(T) == typeof(uint)) return (T)(object)ParseUInt32Utf8(element);
+        if (typeof(T) == typeof(long)) return (T)(object)ParseInt64Utf8(element);
+        if (typeof(T) == typeof(ulong)) return (T)(object)ParseUInt64Utf8(element);
+        if (typeof(T) == typeof(float)) return (T)(object)ParseFloatUtf8(element);
+        if (typeof(T) == typeof(double)) return (T)(object)ParseDoubleUtf8(element);
+        if (typeof(T) == typeof(bool)) return (T)(object)(element[0] != (byte)'0');
+        throw new NotSupportedException($"Type '{typeChar}' is not a primitive array type");
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static T ParseElement<T>(ReadOnlySpan<char> element, char typeChar) {
+        if (typeof(T) == typeof(byte)) return (T)(object)byte.Parse(element);
+        if (typeof(T) == typeof(short)) return (T)(object)short.Parse(element);
+        if (typeof(T) == typeof(int)) return (T)(object)int.Parse(element);
+        if (typeof(T) == typeof(uint)) return (T)(object)uint.Parse(element);
+        if (typeof(T) == typeof(long)) return (T)(object)long.Parse(element);
+        if (typeof(T) == typeof(ulong)) return (T)(object)ulong.Parse(element);
+        if (typeof(T) == typeof(float)) return (T)(object)ParseFloat(element);
+        if (typeof(T) == typeof(double)) return (T)(object)ParseDouble(element);
+        if (typeof(T) == typeof(bool)) return (T)(object)(element[0] != '0');
+        throw new NotSupportedException($"Type '{typeChar}' is not a primitive array type");
+    }
+
+
+
+
+    // Integer parsers: the SWAR path takes plain `-?digits` and anything else (a '+' sign, overflow,
+    // garbage) falls back to Utf8Parser, so accepted input and errors are exactly what they were.
+
+    internal static byte ParseByteUtf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && !negative && magnitude <= byte.MaxValue) {
+            return (byte)magnitude;
+        }
+        return Utf8Parser.TryParse(value, out byte result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('e', value);
+    }
+
+
+    internal static short ParseInt16Utf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && magnitude <= (negative ? 32768UL : (ulong)short.MaxValue)) {
+            return (short)(negative ? -(long)magnitude : (long)magnitude);
+        }
+        return Utf8Parser.TryParse(value, out short result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('t', value);
+    }
+
+
+    internal static int ParseInt32Utf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && magnitude <= (negative ? 2147483648UL : int.MaxValue)) {
+            return (int)(negative ? -(long)magnitude : (long)magnitude);
+        }
+        return Utf8Parser.TryParse(value, out int result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('i', value);
+    }
+
+
+    internal static uint ParseUInt32Utf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && !negative && magnitude <= uint.MaxValue) {
+            return (uint)magnitude;
+        }
+        return Utf8Parser.TryParse(value, out uint result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('u', value);
+    }
+
+
+    internal static long ParseInt64Utf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && magnitude <= (negative ? 9223372036854775808UL : long.MaxValue)) {
+            return negative ? (long)(0UL - magnitude) : (long)magnitude;
+        }
+        return Utf8Parser.TryParse(value, out long result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('l', value);
+    }
+
+
+    internal static ulong ParseUInt64Utf8(ReadOnlySpan<byte> value) {
+        if (TryParseDigits(value, out bool negative, out ulong magnitude) && !negative) {
+            return magnitude;
+        }
+        return Utf8Parser.TryParse(value, out ulong result, out int consumed) && consumed == value.Length ? result : throw InvalidNumber('g', value);
+    }
+
+
+
+
+    /// <summary>
+    /// Reads `-?[0-9]{1,19}` (19 digits always fit in a ulong). Returns false for anything else.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool TryParseDigits(ReadOnlySpan<byte> value, out bool negative, out ulong magnitude) {
+        negative = value.Length > 0 && value[0] == (byte)'-';
+        var digits = negative ? value.Slice(1) : value;
+        magnitude = 0;
+        if (digits.Length == 0 || digits.Length > 19) {
+            return false;
+        }
+
+        int position = 0;
+        if (BitConverter.IsLittleEndian) {
+            while (digits.Length - position >= 8) {
+                var chunk = BinaryPrimitives.ReadUInt64LittleEndian(digits.Slice(position));
+                if (!IsEightDigits(chunk)) {
+                    return false;
+                }
+                magnitude = magnitude * 100_000_000 + ParseEightDigits(chunk);
+                position += 8;
+            }
+        }
+
+        for (; position < digits.Length; position++) {
+            uint digit = (uint)(digits[position] - '0');
+            if (digit > 9) {
+                return false;
+            }
+            magnitude = magnitude * 10 + digit;
+        }
+        return true;
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool IsEightDigits(ulong chunk) {
+        // Every byte is 0x30..0x39: high nibble 3, and adding 6 does not carry out of the low nibble
+        return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static uint ParseEightDigits(ulong chunk) {
+        // Little-endian: the first digit is the lowest byte. Pairs, then quads, then the whole word
+        chunk -= 0x3030303030303030;
+        chunk = chunk * 10 + (chunk >> 8);
+        chunk = ((chunk & 0x000000FF000000FF) * (100 + (1000000UL << 32)) + ((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000UL << 32))) >> 32;
+        return (uint)chunk;
+    }
+}
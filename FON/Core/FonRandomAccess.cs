@@ -0,0 +1,274 @@
+using FON.Types;
+using System.Buffers;
+using System.Collections.Concurrent;
+using System.Runtime.CompilerServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Random access into FON files through a <see cref="FonLineIndex"/>: seek to the block holding a line
+/// and parse only the lines asked for.
+/// </summary>
+public partial class Fon {
+    /// <summary>
+    /// Bytes read per block by <see cref="ReadRangeAsync"/>; small, since a lookup usually needs a few lines.
+    /// </summary>
+    private const int RandomAccessBlockBytes = 64 * 1024;
+
+    /// <summary>
+    /// Indexes <see cref="ReadRangeAsync"/> loaded or built itself, by full path; an entry is reused
+    /// while the file keeps the length and last write time it was indexed at.
+    /// </summary>
+    private static readonly ConcurrentDictionary<string, CachedLineIndex> lineIndexCache = new();
+    private static long lineIndexCacheClock;
+    private static int lineIndexCacheCapacity = 64;
+
+
+    /// <summary>
+    /// Number of files whose line index <see cref="ReadRangeAsync"/> keeps between calls; past it the
+    /// least recently read file is dropped. 0 turns the cache off. Default: 64.
+    /// </summary>
+    public static int LineIndexCacheCapacity {
+        get => lineIndexCacheCapacity;
+        set {
+            ArgumentOutOfRangeException.ThrowIfNegative(value);
+            lineIndexCacheCapacity = value;
+            TrimLineIndexCache();
+        }
+    }
+
+
+    /// <summary>
+    /// Drops every line index <see cref="ReadRangeAsync"/> keeps, e.g. after reading many files once.
+    /// </summary>
+    public static void ClearLineIndexCache() => lineIndexCache.Clear();
+
+
+
+
+    /// <summary>
+    /// Reads the record on line <paramref name="id"/>. Returns null for an empty line or a line past the end.
+    /// See <see cref="ReadRangeAsync"/>.
+    /// </summary>
+    public static async Task<FonCollection?> ReadRecordAsync(FileInfo file, ulong id, FonLineIndex? index = null, FonReadOptions? options = null, CancellationToken cancellationToken = default) {
+        await foreach (var (_, record) in ReadRangeAsync(file, id, 1, index, options, cancellationToken)) {
+            return record;
+        }
+        return null;
+    }
+
+
+
+
+    /// <summary>
+    /// Reads the records on lines [start, start + count), keyed by line number like the dump loaders;
+    /// empty lines are skipped. Only the block of lines the range starts in is read past.
+    /// </summary>
+    /// <remarks>
+    /// Without an <paramref name="index"/> the sidecar (<c>file.idx</c>) is loaded; if it is missing or stale
+    /// the file is scanned once to build one in memory. Either way the index is kept (see
+    /// <see cref="LineIndexCacheCapacity"/>) and reused by later calls on the same path until the file's
+    /// length or last write time changes, so only the first read of a file pays for the load or the scan. Nothing is written next to the file;
+    /// set <see cref="LineIndex"/> before writing it, or save the index of
+    /// <see cref="BuildLineIndexAsync(FileInfo, FonLineIndexOptions?, CancellationToken)"/>, to make the first read cheap too.
+    /// A block-compressed file seeks through its own block table and ignores <paramref name="index"/>.
+    /// </remarks>
+    /// <exception cref="InvalidOperationException">The given index was built for another version of the file (other length or write time).</exception>
+    public static async IAsyncEnumerable<(ulong id, FonCollection record)> ReadRangeAsync(FileInfo file, ulong start, int count, FonLineIndex? index = null, FonReadOptions? options = null, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(file);
+        ArgumentOutOfRangeException.ThrowIfNegative(count);
+
+        var selection = options?.Selection;
+        LineParser<FonCollection> parse = text => DeserializeLineOptimized(text, selection);
+
+        if (FonBlockContainer.IsContainer(file)) {
+            await foreach (var item in ReadCompressedRecordsAsync(file, null, parse, start, start + (ulong)count, cancellationToken)) {
+                yield return item;
+            }
+            yield break;
+        }
+
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Open,
+            FileAccess.Read,
+            FileShare.Read,
+            bufferSize: 1,
+            FileOptions.Asynchronous | FileOptions.RandomAccess
+        );
+
+        if (index == null) {
+            index = await GetCachedLineIndexAsync(file, fileStream, cancellationToken);
+        } else {
+            index.EnsureMatches(file, fileStream.Length, File.GetLastWriteTimeUtc(file.FullName));
+        }
+
+        if (count == 0 || start >= index.LineCount) {
+            yield break;
+        }
+
+        var end = start + Math.Min((ulong)count, index.LineCount - start);
+        var (line, offset) = index.Seek(start);
+        fileStream.Position = offset;
+
+        var reader = new LineBlockReader(fileStream, RandomAccessBlockBytes);
+        try {
+            while (line < end && await reader.ReadBlockAsync(cancellationToken) is { } block) {
+                var records = ParseLineRange(block, skipBom: offset == 0, ref line, start, end, parse);
+                foreach (var record in records) {
+                    yield return record;
+                }
+            }
+        } finally {
+            reader.Dispose();
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Builds the line index of an existing file by reading it once; numeric keys in
+    /// <paramref name="options"/> are parsed for the zone maps, nothing else is.
+    /// Call <see cref="FonLineIndex.Save(FileInfo)"/> with <see cref="FonLineIndex.GetPath"/> to keep it.
+    /// </summary>
+    public static async Task<FonLineIndex> BuildLineIndexAsync(FileInfo file, FonLineIndexOptions? options = null, CancellationToken cancellationToken = default) {
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Open,
+            FileAccess.Read,
+            FileShare.Read,
+            bufferSize: 1,
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+
+        // Taken before the scan, so a write during it leaves the index stale rather than wrong
+        var lastWrite = File.GetLastWriteTimeUtc(file.FullName);
+        return await BuildLineIndexAsync(fileStream, options ?? new FonLineIndexOptions(), lastWrite, cancellationToken);
+    }
+
+
+
+
+    private static async Task<FonLineIndex> BuildLineIndexAsync(Stream stream, FonLineIndexOptions options, DateTime lastWriteTimeUtc, CancellationToken cancellationToken) {
+        var builder = new FonLineIndexBuilder(options);
+        var selection = builder.HasKeys ? new FonReadOptions(options.Keys).Selection : null;
+        var reader = new LineBlockReader(stream, ReadRecordsBlockBytes);
+        long blockOffset = 0;
+        try {
+            while (await reader.ReadBlockAsync(cancellationToken) is { } block) {
+                IndexLineBlock(block, blockOffset, builder, selection);
+                blockOffset += block.Length;
+            }
+        } finally {
+            reader.Dispose();
+        }
+        return builder.Build(blockOffset, lastWriteTimeUtc);
+    }
+
+
+
+
+    private static async Task<FonLineIndex> GetCachedLineIndexAsync(FileInfo file, FileStream fileStream, CancellationToken cancellationToken) {
+        var length = fileStream.Length;
+        var lastWrite = File.GetLastWriteTimeUtc(file.FullName);
+        if (lineIndexCache.TryGetValue(file.FullName, out var cached) && cached.Index.Matches(length, lastWrite)) {
+            cached.LastUse = Interlocked.Increment(ref lineIndexCacheClock);
+            return cached.Index;
+        }
+
+        var index = TryLoadLineIndex(file, length, lastWrite) ?? await BuildLineIndexAsync(fileStream, new FonLineIndexOptions(), lastWrite, cancellationToken);
+        fileStream.Position = 0;
+        if (lineIndexCacheCapacity > 0) {
+            lineIndexCache[file.FullName] = new CachedLineIndex(index) { LastUse = Interlocked.Increment(ref lineIndexCacheClock) };
+            TrimLineIndexCache();
+        }
+        return index;
+    }
+
+
+    private static void TrimLineIndexCache() {
+        while (lineIndexCache.Count > lineIndexCacheCapacity) {
+            KeyValuePair<string, CachedLineIndex>? oldest = null;
+            foreach (var entry in lineIndexCache) {
+                if (oldest == null || entry.Value.LastUse < oldest.Value.Value.LastUse) {
+                    oldest = entry;
+                }
+            }
+            if (oldest is not { } evict) {
+                break;
+            }
+            lineIndexCache.TryRemove(evict);
+        }
+    }
+
+
+
+
+    private static FonLineIndex? TryLoadLineIndex(FileInfo file, long fileLength, DateTime lastWriteTimeUtc) {
+        var path = FonLineIndex.GetPath(file);
+        if (!path.Exists) {
+            return null;
+        }
+        try {
+            var index = FonLineIndex.Load(path);
+            return index.Matches(fileLength, lastWriteTimeUtc) ? index : null;
+        } catch (FormatException) {
+            return null;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Feeds the lines of one block to the index builder and returns the block's pooled buffer.
+    /// </summary>
+    private static void IndexLineBlock(LineBlock block, long blockOffset, FonLineIndexBuilder builder, KeySelection? selection) {
+        try {
+            var bytes = new ReadOnlySpan<byte>(block.Buffer, 0, block.Length);
+            var lines = SplitLinesUtf8(bytes, Math.Max(16, block.Length / 50000), skipBom: block.IsFirst);
+            foreach (var (start, length) in lines) {
+                var record = selection != null && length > 0 ? DeserializeLineOptimized(bytes.Slice(start, length), selection) : null;
+                builder.AddLine(blockOffset + start, record);
+            }
+        } finally {
+            ArrayPool<byte>.Shared.Return(block.Buffer);
+        }
+    }
+
+
+
+
+    private sealed class CachedLineIndex(FonLineIndex index) {
+        public FonLineIndex Index { get; } = index;
+        public long LastUse;
+    }
+
+
+
+
+    /// <summary>
+    /// Parses the lines of a block that fall into [start, end) with <paramref name="parse"/> and returns the block's pooled buffer.
+    /// <paramref name="line"/> is the number of the block's first line and is moved past the block.
+    /// </summary>
+    private static List<(ulong id, TRecord record)> ParseLineRange<TRecord>(LineBlock block, bool skipBom, ref ulong line, ulong start, ulong end, LineParser<TRecord> parse) {
+        try {
+            var bytes = new ReadOnlySpan<byte>(block.Buffer, 0, block.Length);
+            var lines = SplitLinesUtf8(bytes, 16, skipBom: skipBom && block.IsFirst);
+            var records = new List<(ulong id, TRecord record)>();
+
+            for (int i = 0; i < lines.Count && line < end; i++, line++) {
+                var (offset, length) = lines[i];
+                if (line >= start && length > 0) {
+                    records.Add((line, parse(bytes.Slice(offset, length))));
+                }
+            }
+
+            return records;
+        } finally {
+            ArrayPool<byte>.Shared.Return(block.Buffer);
+        }
+    }
+}
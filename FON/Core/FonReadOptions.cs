@@ -0,0 +1,142 @@
+using System.Text;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Options for the deserializers.
+/// With <see cref="Keys"/> set only the listed keys are materialized; every other value is skipped
+/// structurally (bracket/quote scanning only), so large strings, RawData and nested objects that are
+/// not asked for cost neither parsing nor allocations.
+/// </summary>
+public sealed class FonReadOptions {
+    /// <summary>
+    /// Keys to keep. A dotted path ("meta.owner") descends into o: values, and into every element
+    /// of an o: array. A path that ends early or lands on a non-object value keeps the whole value.
+    /// </summary>
+    public IReadOnlyList<string> Keys { get; }
+
+    internal KeySelection Selection { get; }
+
+
+    public FonReadOptions(params string[] keys) : this((IEnumerable<string>)keys) { }
+
+    public FonReadOptions(IEnumerable<string> keys) {
+        ArgumentNullException.ThrowIfNull(keys);
+
+        Keys = keys.ToArray();
+        if (Keys.Count == 0) {
+            throw new ArgumentException("At least one key is required", nameof(keys));
+        }
+
+        var root = new KeySelection.Builder();
+        foreach (var path in Keys) {
+            if (string.IsNullOrEmpty(path)) {
+                throw new ArgumentException("Keys must not be empty", nameof(keys));
+            }
+
+            var node = root;
+            var segments = path.Split('.');
+            for (int i = 0; i < segments.Length; i++) {
+                if (segments[i].Length == 0) {
+                    throw new ArgumentException($"Key path '{path}' has an empty segment", nameof(keys));
+                }
+                node = node.Add(segments[i], last: i == segments.Length - 1);
+                if (node == null) {
+                    // A shorter path already selects this value whole
+                    break;
+                }
+            }
+        }
+
+        Selection = root.Build();
+    }
+}
+
+
+
+
+/// <summary>
+/// One level of a key allow-list. Lookups compare raw key bytes/chars, so a skipped key is never
+/// turned into a string and a kept key reuses the selection's own string instance.
+/// </summary>
+/// <remarks>
+/// Allow-lists are short, a linear scan beats hashing the key span.
+/// </remarks>
+internal sealed class KeySelection {
+    private readonly string[] names;
+    private readonly byte[][] utf8Names;
+    private readonly KeySelection?[] children;
+
+
+    private KeySelection(string[] names, KeySelection?[] children) {
+        this.names = names;
+        this.children = children;
+        utf8Names = Array.ConvertAll(names, Encoding.UTF8.GetBytes);
+    }
+
+
+    public int Count => names.Length;
+
+    public string GetName(int index) => names[index];
+
+    /// <summary>
+    /// Selection for the value under key <paramref name="index"/>, or null when the whole value is kept.
+    /// </summary>
+    public KeySelection? GetChild(int index) => children[index];
+
+    public int IndexOf(ReadOnlySpan<byte> key) {
+        for (int i = 0; i < utf8Names.Length; i++) {
+            if (key.SequenceEqual(utf8Names[i])) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    public int IndexOf(ReadOnlySpan<char> key) {
+        for (int i = 0; i < names.Length; i++) {
+            if (key.SequenceEqual(names[i])) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+
+
+
+    internal sealed class Builder {
+        // null value = the whole value is selected
+        private readonly List<(string name, Builder? child)> entries = [];
+
+
+        /// <summary>
+        /// Adds one path segment and returns the builder of the next level,
+        /// or null when the value is selected whole (last segment, or already selected whole).
+        /// </summary>
+        public Builder? Add(string name, bool last) {
+            var index = entries.FindIndex(e => e.name == name);
+            if (index < 0) {
+                var child = last ? null : new Builder();
+                entries.Add((name, child));
+                return child;
+            }
+
+            if (entries[index].child == null) {
+                return null;
+            }
+            if (last) {
+                entries[index] = (name, null);
+                return null;
+            }
+            return entries[index].child;
+        }
+
+        public KeySelection Build() {
+            return new KeySelection(
+                entries.Select(e => e.name).ToArray(),
+                entries.Select(e => e.child?.Build()).ToArray());
+        }
+    }
+}
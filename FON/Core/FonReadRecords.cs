@@ -0,0 +1,307 @@
+using FON.Types;
+using System.Buffers;
+using System.Runtime.CompilerServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Streaming deserialization: records are yielded as they are parsed instead of being
+/// collected into a <see cref="FonDump"/>, so memory stays bounded regardless of file size.
+/// </summary>
+public partial class Fon {
+    /// <summary>
+    /// Bytes read per block by <see cref="ReadRecordsAsync(Stream, int?, FonReadOptions?, CancellationToken)"/>.
+    /// Blocks are cut at the last newline, so a block grows only for a single longer line.
+    /// </summary>
+    private const int ReadRecordsBlockBytes = 4 * 1024 * 1024;
+
+
+
+
+    /// <summary>
+    /// Streams the records of a FON file in line order. See <see cref="ReadRecordsAsync(Stream, int?, FonReadOptions?, CancellationToken)"/>.
+    /// Block-compressed files (<see cref="SerializeToFileCompressedAsync"/>) are decoded block by block.
+    /// </summary>
+    public static async IAsyncEnumerable<(ulong id, FonCollection record)> ReadRecordsAsync(FileInfo file, int? maxDegreeOfParallelism = null, FonReadOptions? options = null, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        if (FonBlockContainer.IsContainer(file)) {
+            var selection = options?.Selection;
+            await foreach (var item in ReadCompressedRecordsAsync(file, maxDegreeOfParallelism, line => DeserializeLineOptimized(line, selection), 0, ulong.MaxValue, cancellationToken)) {
+                yield return item;
+            }
+            yield break;
+        }
+
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Open,
+            FileAccess.Read,
+            FileShare.Read,
+            bufferSize: 1, // Reads are block-sized already, skip FileStream's own buffer
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+
+        await foreach (var item in ReadRecordsAsync(fileStream, maxDegreeOfParallelism, options, cancellationToken)) {
+            yield return item;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Streams the records of UTF-8 FON text in line order, keyed by line number like the dump loaders.
+    /// The stream is read in newline-aligned blocks; up to <paramref name="maxDegreeOfParallelism"/>
+    /// blocks are parsed ahead in parallel while the caller consumes earlier records. Reading stops
+    /// while that many blocks are waiting, so a slow consumer holds back the reader (backpressure).
+    /// </summary>
+    /// <remarks>
+    /// Memory is bounded by roughly (maxDegreeOfParallelism + 1) blocks of 4MB plus the parsed records
+    /// of those blocks. A parse error surfaces as <see cref="FormatException"/> once the caller reaches
+    /// the failing block. The stream is not closed.
+    /// </remarks>
+    public static async IAsyncEnumerable<(ulong id, FonCollection record)> ReadRecordsAsync(Stream stream, int? maxDegreeOfParallelism = null, FonReadOptions? options = null, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(stream);
+
+        var selection = options?.Selection;
+        await foreach (var item in ReadLineRecordsAsync(stream, maxDegreeOfParallelism, line => DeserializeLineOptimized(line, selection), cancellationToken)) {
+            yield return item;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Reads a FON file as read-only documents. See <see cref="ReadDocumentsAsync(Stream, CancellationToken)"/>.
+    /// </summary>
+    public static async IAsyncEnumerable<FonDocument> ReadDocumentsAsync(FileInfo file, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Open,
+            FileAccess.Read,
+            FileShare.Read,
+            bufferSize: 1,
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+
+        await foreach (var document in ReadDocumentsAsync(fileStream, cancellationToken)) {
+            yield return document;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Reads UTF-8 FON text as a sequence of <see cref="FonDocument"/>s, one per newline-aligned block of
+    /// about 4MB. Each document owns its block and tape; dispose it to hand both back before reading far
+    /// ahead. Record ids continue across documents, so they match the line numbers of the dump loaders.
+    /// The stream is not closed.
+    /// </summary>
+    public static async IAsyncEnumerable<FonDocument> ReadDocumentsAsync(Stream stream, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(stream);
+
+        var reader = new LineBlockReader(stream, ReadRecordsBlockBytes);
+        ulong nextId = 0;
+        try {
+            while (await reader.ReadBlockAsync(cancellationToken) is { } block) {
+                var document = FonDocument.FromPooledBlock(block.Buffer, block.Length, block.IsFirst, nextId);
+                nextId += (ulong)document.LineCount;
+                yield return document;
+            }
+        } finally {
+            reader.Dispose();
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Block pipeline behind the ReadRecordsAsync overloads; <paramref name="parse"/> turns one
+    /// non-empty line into a record and runs on the thread pool.
+    /// </summary>
+    private static async IAsyncEnumerable<(ulong id, TRecord record)> ReadLineRecordsAsync<TRecord>(Stream stream, int? maxDegreeOfParallelism, LineParser<TRecord> parse, [EnumeratorCancellation] CancellationToken cancellationToken) {
+        var readAhead = Math.Max(1, maxDegreeOfParallelism ?? Environment.ProcessorCount);
+        var pending = new Queue<Task<ParsedBlock<TRecord>>>(readAhead);
+        var reader = new LineBlockReader(stream, ReadRecordsBlockBytes);
+        ulong nextId = 0;
+
+        try {
+            while (true) {
+                while (pending.Count < readAhead && await reader.ReadBlockAsync(cancellationToken) is { } block) {
+                    pending.Enqueue(Task.Run(() => ParseLineBlock(block, parse)));
+                }
+
+                if (!pending.TryDequeue(out var next)) {
+                    break;
+                }
+
+                var parsed = await next;
+                foreach (var (line, record) in parsed.Records) {
+                    yield return (nextId + (ulong)line, record);
+                }
+                nextId += (ulong)parsed.LineCount;
+            }
+        } finally {
+            // Consumer stopped early or a block failed: let in-flight parses finish before the blocks are gone
+            while (pending.TryDequeue(out var task)) {
+                try {
+                    await task;
+                } catch (Exception) {
+                    // The first failure was already surfaced to the caller
+                }
+            }
+            reader.Dispose();
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Parses one newline-aligned block and returns its pooled buffer. Records carry their line
+    /// index within the block (empty lines have none), so callers can number them by line.
+    /// </summary>
+    private static ParsedBlock<TRecord> ParseLineBlock<TRecord>(LineBlock block, LineParser<TRecord> parse) {
+        try {
+            var bytes = new ReadOnlySpan<byte>(block.Buffer, 0, block.Length);
+            var lines = SplitLinesUtf8(bytes, Math.Max(16, block.Length / 50000), skipBom: block.IsFirst);
+            var records = new List<(int line, TRecord record)>(lines.Count);
+
+            for (int i = 0; i < lines.Count; i++) {
+                var (start, length) = lines[i];
+                if (length > 0) {
+                    records.Add((i, parse(bytes.Slice(start, length))));
+                }
+            }
+
+            return new ParsedBlock<TRecord>(lines.Count, records);
+        } finally {
+            ArrayPool<byte>.Shared.Return(block.Buffer);
+        }
+    }
+
+
+
+
+    private delegate TRecord LineParser<TRecord>(ReadOnlySpan<byte> line);
+
+    private readonly record struct ParsedBlock<TRecord>(int LineCount, List<(int line, TRecord record)> Records);
+
+
+
+
+    /// <summary>
+    /// A run of whole lines in a pooled buffer. Ownership passes to <see cref="ParseLineBlock{TRecord}"/>.
+    /// </summary>
+    private readonly record struct LineBlock(byte[] Buffer, int Length, bool IsFirst);
+
+
+
+
+    /// <summary>
+    /// Reads a stream in blocks that end right after a '\n' (or at the end of the stream).
+    /// The partial line after the last newline is carried over to the next block.
+    /// </summary>
+    private sealed class LineBlockReader : IDisposable {
+        private readonly Stream stream;
+        private readonly int blockBytes;
+        private byte[] carry = [];
+        private int carryLength;
+        private bool endOfStream;
+        private bool isFirst = true;
+
+
+        public LineBlockReader(Stream stream, int blockBytes) {
+            this.stream = stream;
+            this.blockBytes = blockBytes;
+        }
+
+
+        public async ValueTask<LineBlock?> ReadBlockAsync(CancellationToken cancellationToken) {
+            if (endOfStream && carryLength == 0) {
+                return null;
+            }
+
+            var buffer = ArrayPool<byte>.Shared.Rent(Math.Max(blockBytes, carryLength * 2));
+            carry.AsSpan(0, carryLength).CopyTo(buffer);
+            var filled = carryLength;
+            var searched = carryLength;
+            carryLength = 0;
+
+            try {
+                while (true) {
+                    while (!endOfStream && filled < buffer.Length) {
+                        var read = await stream.ReadAsync(buffer.AsMemory(filled), cancellationToken);
+                        if (read == 0) {
+                            endOfStream = true;
+                        }
+                        filled += read;
+                    }
+
+                    if (endOfStream) {
+                        if (filled == 0) {
+                            ArrayPool<byte>.Shared.Return(buffer);
+                            return null;
+                        }
+                        return TakeBlock(buffer, filled);
+                    }
+
+                    // Carried bytes hold no newline, only the freshly read part needs a look
+                    var lastNewLine = buffer.AsSpan(searched, filled - searched).LastIndexOf((byte)'\n');
+                    if (lastNewLine >= 0) {
+                        var end = searched + lastNewLine + 1;
+                        SetCarry(buffer.AsSpan(end, filled - end));
+                        return TakeBlock(buffer, end);
+                    }
+
+                    // A single line longer than the buffer - grow and keep reading
+                    searched = filled;
+                    var grown = ArrayPool<byte>.Shared.Rent((int)Math.Min(Array.MaxLength, buffer.Length * 2L));
+                    if (grown.Length <= filled) {
+                        ArrayPool<byte>.Shared.Return(grown);
+                        throw new FormatException("Line exceeds the maximum array length");
+                    }
+                    buffer.AsSpan(0, filled).CopyTo(grown);
+                    ArrayPool<byte>.Shared.Return(buffer);
+                    buffer = grown;
+                }
+            } catch {
+                ArrayPool<byte>.Shared.Return(buffer);
+                throw;
+            }
+        }
+
+
+        public void Dispose() {
+            if (carry.Length > 0) {
+                ArrayPool<byte>.Shared.Return(carry);
+            }
+            carry = [];
+            carryLength = 0;
+        }
+
+
+
+
+        private LineBlock TakeBlock(byte[] buffer, int length) {
+            var block = new LineBlock(buffer, length, isFirst);
+            isFirst = false;
+            return block;
+        }
+
+
+        private void SetCarry(ReadOnlySpan<byte> rest) {
+            if (carry.Length < rest.Length) {
+                if (carry.Length > 0) {
+                    ArrayPool<byte>.Shared.Return(carry);
+                }
+                carry = ArrayPool<byte>.Shared.Rent(rest.Length);
+            }
+            rest.CopyTo(carry);
+            carryLength = rest.Length;
+        }
+    }
+}
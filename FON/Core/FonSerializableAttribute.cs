@@ -0,0 +1,18 @@
+namespace FON.Core;
+
+
+/// <summary>
+/// Generates a reflection-free serializer for the type (FON.Generators). Public read/write
+/// properties become FON keys: primitives and strings from <see cref="Fon.SupportTypes"/>,
+/// <see cref="Types.RawData"/>, lists / arrays of those, and other <c>[FonSerializable]</c> types
+/// as <c>o:</c> objects (or arrays of objects). An unsupported property type is a compile error.
+/// </summary>
+/// <remarks>
+/// The generated <see cref="IFonTypeSerializer{T}"/> registers itself on module load and is then
+/// picked up by <see cref="Fon.SerializeRecord{T}"/>, <see cref="Fon.DeserializeRecord{T}"/>,
+/// <see cref="Fon.ReadRecordsAsync{T}(Stream, int?, CancellationToken)"/> and
+/// <see cref="Types.FonCollection.Serialize{T}"/> / <see cref="Types.FonCollection.Deserialize{T}"/>.
+/// The type needs a parameterless constructor.
+/// </remarks>
+[AttributeUsage(AttributeTargets.Class | AttributeTargets.Struct, Inherited = false)]
+public sealed class FonSerializableAttribute : Attribute { }
@@ -1,8 +1,12 @@
+using FON.Acceleration;
+using FON.Diagnostics;
 using FON.Types;
 using System.Buffers;
 using System.Collections;
-using System.Collections.Concurrent;
+using System.Diagnostics;
 using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using System.Text;
 
 namespace FON.Core;
@@ -15,45 +19,42 @@ public partial class Fon {
     /// </summary>
     public static int ParallelMethodThreshold { get; set; } = 2000;
 
-
     /// <summary>
-    /// UTF-8 encoding without BOM. The default Encoding.UTF8 emits a BOM
-    /// which the native parser would otherwise treat as part of the first key.
+    /// Arms of <see cref="SerializeToFileAutoAsync"/> under <see cref="AdaptiveTuning"/>: Pipeline, or Chunked
+    /// with half, once or twice the chunk size of the fixed formula.
     /// </summary>
-    private static readonly UTF8Encoding utf8NoBom = new UTF8Encoding(encoderShouldEmitUTF8Identifier: false);
+    private static readonly FonAutoTuner serializeTuner = new("pipeline", "chunked-half", "chunked", "chunked-double");
+
+    private const int PipelineArm = 0;
+    private const int ChunkedArm = 2;
 
 
 
 
     /// <summary>
     /// Parallel serialization to file.
-    /// Each FonCollection is serialized in parallel, then written sequentially.
+    /// Records are serialized in parallel straight to UTF-8, then written sequentially.
     /// </summary>
     public static async Task SerializeToFileAsync(FonDump dump, FileInfo fileInfo, int? maxDegreeOfParallelism = null) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
-        var orderedItems = dump.FonObjects.OrderBy(x => x.Key).ToArray();
-        var serializedLines = new string[orderedItems.Length];
 
-        // Parallel serialization to strings
-        Parallel.For(0, orderedItems.Length, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
-            serializedLines[i] = SerializeToString(orderedItems[i].Value);
-        });
+        var started = FonMetrics.StartOperation();
+        var index = CreateLineIndexBuilder();
+        long bytes;
 
-        // Sequential write to file
-        await using var fileStream = new FileStream(
+        await using (var fileStream = new FileStream(
             fileInfo.FullName,
             FileMode.Create,
             FileAccess.Write,
             FileShare.None,
             bufferSize: 64 * 1024,
             FileOptions.Asynchronous | FileOptions.SequentialScan
-        );
-
-        await using var writer = new StreamWriter(fileStream, utf8NoBom, bufferSize: 64 * 1024);
-
-        foreach (var line in serializedLines) {
-            await writer.WriteLineAsync(line);
+        )) {
+            bytes = await SerializeRecordsAsync(dump.GetOrderedRecords(), fileStream, SerializeChunkRecords, parallelism, CancellationToken.None, index);
         }
+
+        WriteLineIndex(fileInfo, index?.Build(fileInfo));
+        FonMetrics.RecordOperation("serialize", "basic", FonMetrics.ManagedEngine, dump.Count, bytes, started);
     }
 
 
@@ -61,53 +62,29 @@ public partial class Fon {
 
     /// <summary>
     /// Parallel serialization using pipeline (producer-consumer).
-    /// Serialization and writing happen simultaneously.
+    /// Serialization and writing happen simultaneously: small chunks go through the ring of
+    /// pooled UTF-8 buffers, so the first records hit the file almost immediately.
     /// </summary>
     public static async Task SerializeToFilePipelineAsync(FonDump dump, FileInfo fileInfo, int? maxDegreeOfParallelism = null) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
-        var orderedItems = dump.FonObjects.OrderBy(x => x.Key).ToArray();
 
-        // Use ConcurrentDictionary to store results while preserving order
-        var results = new ConcurrentDictionary<int, string>();
-        var nextToWrite = 0;
-        var completedCount = 0;
-        var totalCount = orderedItems.Length;
+        var started = FonMetrics.StartOperation();
+        var index = CreateLineIndexBuilder();
+        long bytes;
 
-        await using var fileStream = new FileStream(
+        await using (var fileStream = new FileStream(
             fileInfo.FullName,
             FileMode.Create,
             FileAccess.Write,
             FileShare.None,
             bufferSize: 64 * 1024,
-            FileOptions.Asynchronous | FileOptions.SequentialScan);
-
-        await using var writer = new StreamWriter(fileStream, utf8NoBom, bufferSize: 64 * 1024);
-
-        // Semaphore for signaling new ready results
-        using var newResultAvailable = new SemaphoreSlim(0);
-
-        // Start parallel serialization
-        var serializationTask = Task.Run(() => {
-            Parallel.For(0, orderedItems.Length, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
-                var serialized = SerializeToString(orderedItems[i].Value);
-                results[i] = serialized;
-                Interlocked.Increment(ref completedCount);
-                newResultAvailable.Release();
-            });
-        });
-
-        // Write results as they become ready (in correct order)
-        while (nextToWrite < totalCount) {
-            await newResultAvailable.WaitAsync();
-
-            // Write all consecutive ready results
-            while (results.TryRemove(nextToWrite, out var line)) {
-                await writer.WriteLineAsync(line);
-                nextToWrite++;
-            }
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        )) {
+            bytes = await SerializeRecordsAsync(dump.GetOrderedRecords(), fileStream, PipelineChunkRecords, parallelism, CancellationToken.None, index);
         }
 
-        await serializationTask;
+        WriteLineIndex(fileInfo, index?.Build(fileInfo));
+        FonMetrics.RecordOperation("serialize", "pipeline", FonMetrics.ManagedEngine, dump.Count, bytes, started);
     }
 
 
@@ -116,38 +93,29 @@ public partial class Fon {
     /// <summary>
     /// Optimized parallel serialization with chunks.
     /// Serializes data in portions to reduce memory pressure on large files.
+    /// Each worker serializes a contiguous chunk into a pooled UTF-8 buffer while earlier
+    /// chunks are flushed in order, at most 2 * parallelism chunks in memory.
     /// </summary>
     public static async Task SerializeToFileChunkedAsync(FonDump dump, FileInfo fileInfo, int chunkSize = 1000, int? maxDegreeOfParallelism = null) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
-        var orderedItems = dump.FonObjects.OrderBy(x => x.Key).ToArray();
 
-        await using var fileStream = new FileStream(
+        var started = FonMetrics.StartOperation();
+        var index = CreateLineIndexBuilder();
+        long bytes;
+
+        await using (var fileStream = new FileStream(
             fileInfo.FullName,
             FileMode.Create,
             FileAccess.Write,
             FileShare.None,
             bufferSize: 256 * 1024,
             FileOptions.Asynchronous | FileOptions.SequentialScan
-        );
-
-        await using var writer = new StreamWriter(fileStream, utf8NoBom, bufferSize: 256 * 1024);
-
-        // Process data in chunks
-        for (int chunkStart = 0; chunkStart < orderedItems.Length; chunkStart += chunkSize) {
-            var chunkEnd = Math.Min(chunkStart + chunkSize, orderedItems.Length);
-            var currentChunkSize = chunkEnd - chunkStart;
-            var serializedChunk = new string[currentChunkSize];
-
-            // Parallel chunk serialization
-            Parallel.For(0, currentChunkSize, new ParallelOptions { MaxDegreeOfParallelism = parallelism }, i => {
-                serializedChunk[i] = SerializeToString(orderedItems[chunkStart + i].Value);
-            });
-
-            // Sequential chunk write
-            foreach (var line in serializedChunk) {
-                await writer.WriteLineAsync(line);
-            }
+        )) {
+            bytes = await SerializeRecordsAsync(dump.GetOrderedRecords(), fileStream, chunkSize, parallelism, CancellationToken.None, index);
         }
+
+        WriteLineIndex(fileInfo, index?.Build(fileInfo));
+        FonMetrics.RecordOperation("serialize", "chunked", FonMetrics.ManagedEngine, dump.Count, bytes, started);
     }
 
 
@@ -155,25 +123,84 @@ public partial class Fon {
 
     /// <summary>
     /// Automatic selection of best serialization method based on data size.
-    /// Optimized based on benchmarks:
+    /// Optimized based on benchmarks (FON.Benchmarks, category "tuning"):
     /// - Pipeline: better for very small data (less synchronization overhead)
     /// - Chunked: better for medium and large data (less memory pressure)
+    /// A registered <see cref="IFonBackend"/> (native acceleration) is offered the dump first.
+    /// With <see cref="AdaptiveTuning"/> the choice and chunk size follow the throughput observed so far.
     /// </summary>
     public static Task SerializeToFileAutoAsync(FonDump dump, FileInfo fileInfo, int? maxDegreeOfParallelism = null) {
-        var count = dump.FonObjects.Count;
+        if (FonAccelerator.ActiveBackend is { } backend) {
+            return SerializeToFileBackendAsync(backend, dump, fileInfo, maxDegreeOfParallelism);
+        }
+        return SerializeToFileManagedAutoAsync(dump, fileInfo, maxDegreeOfParallelism);
+    }
+
+
+
+    private static async Task SerializeToFileBackendAsync(IFonBackend backend, FonDump dump, FileInfo fileInfo, int? maxDegreeOfParallelism) {
         var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        var started = Stopwatch.GetTimestamp();
+        if (!await Task.Run(() => backend.TrySerializeToFile(dump, fileInfo, parallelism))) {
+            await SerializeToFileManagedAutoAsync(dump, fileInfo, maxDegreeOfParallelism);
+            return;
+        }
+        FonMetrics.RecordSelection("serialize", "backend", backend.Name, adaptive: false, dump.Count);
+        FonMetrics.RecordOperation("serialize", "backend", backend.Name, dump.Count, new FileInfo(fileInfo.FullName).Length, started);
+
+        // The backend writes the file on its own, the index comes from reading it back
+        var options = LineIndex;
+        WriteLineIndex(fileInfo, options == null ? null : await BuildLineIndexAsync(fileInfo, options));
+    }
+
+
+
+    private static FonLineIndexBuilder? CreateLineIndexBuilder() => LineIndex is { } options ? new FonLineIndexBuilder(options) : null;
+
 
-        if (count < ParallelMethodThreshold) {
-            // For small data - Pipeline with less overhead
-            return SerializeToFilePipelineAsync(dump, fileInfo, parallelism);
+    /// <summary>
+    /// Saves the sidecar of a freshly written file, or removes one left over from an earlier write.
+    /// Build the index once the file is closed, so it records the file's final write time.
+    /// </summary>
+    private static void WriteLineIndex(FileInfo fileInfo, FonLineIndex? index) {
+        var path = FonLineIndex.GetPath(fileInfo);
+        if (index != null) {
+            index.Save(path);
+        } else if (path.Exists) {
+            path.Delete();
+        }
+    }
+
+
+
+    private static async Task SerializeToFileManagedAutoAsync(FonDump dump, FileInfo fileInfo, int? maxDegreeOfParallelism) {
+        var count = dump.Count;
+        var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+
+        // For small data - Pipeline with less overhead
+        // For medium and large - Chunked
+        var fallback = count < ParallelMethodThreshold ? PipelineArm : ChunkedArm;
+        var adaptive = AdaptiveTuning;
+        var arm = adaptive ? serializeTuner.Choose(count, fallback) : fallback;
+        FonMetrics.RecordSelection("serialize", serializeTuner[arm], FonMetrics.ManagedEngine, adaptive, count);
+
+        // Optimal chunk size: large enough for efficient parallelization,
+        // but not too large to avoid memory pressure
+        // Formula: ~50-100 chunks, minimum 500 records per chunk
+        var targetChunks = Math.Max(parallelism * 4, 50);
+        var chunkSize = Math.Max(500, Math.Min(2000, count / targetChunks));
+
+        var started = Stopwatch.GetTimestamp();
+        if (arm == PipelineArm) {
+            await SerializeToFilePipelineAsync(dump, fileInfo, parallelism);
         } else {
-            // For medium and large - Chunked
-            // Optimal chunk size: large enough for efficient parallelization,
-            // but not too large to avoid memory pressure
-            // Formula: ~50-100 chunks, minimum 500 records per chunk
-            var targetChunks = Math.Max(parallelism * 4, 50);
-            var chunkSize = Math.Max(500, Math.Min(2000, count / targetChunks));
-            return SerializeToFileChunkedAsync(dump, fileInfo, chunkSize, parallelism);
+            // Arms 1..3 scale the formula by 1/2, 1 and 2
+            var scaled = arm == ChunkedArm ? chunkSize : arm < ChunkedArm ? chunkSize / 2 : chunkSize * 2;
+            await SerializeToFileChunkedAsync(dump, fileInfo, scaled, parallelism);
+        }
+
+        if (adaptive) {
+            serializeTuner.Record(count, arm, count, started);
         }
     }
 
@@ -195,7 +222,7 @@ public partial class Fon {
     /// </summary>
     public static string SerializeToString(FonCollection fonCollection) {
         // Preliminary size estimation (approximately 100 bytes per element + data)
-        var sb = new StringBuilder(fonCollection.Count() * 200);
+        var sb = new StringBuilder(fonCollection.Count * 200);
         SerializeBody(sb, fonCollection);
         return sb.ToString();
     }
@@ -204,25 +231,39 @@ public partial class Fon {
 
 
     private static void SerializeBody(StringBuilder sb, FonCollection fonCollection) {
-        bool isFirst = true;
-        foreach (var kvp in fonCollection) {
-            if (isFirst) {
-                isFirst = false;
-            } else {
+        fonCollection.GetEntries(out var keys, out var values);
+        for (int i = 0; i < keys.Length; i++) {
+            if (i > 0) {
                 sb.Append(',');
             }
 
-            SerializeKeyValue(sb, kvp.Key, kvp.Value);
+            SerializeKeyValue(sb, keys[i], in values[i]);
         }
     }
 
 
 
 
-    private static void SerializeKeyValue(StringBuilder sb, string key, object value) {
+    private static void SerializeKeyValue(StringBuilder sb, string key, in FonValue value) {
         sb.Append(key);
         sb.Append('=');
-        SerializeObject(sb, value);
+
+        if (value.TypeCode == '\0') {
+            // Not a FON type - the object path reports what exactly is unsupported
+            SerializeObject(sb, value.ToObject());
+            return;
+        }
+
+        sb.Append(value.TypeCode);
+        sb.Append(':');
+
+        if (value.IsArray) {
+            SerializeArray(sb, value.TypeCode, (IList)value.Reference!);
+        } else if (value.Reference is { } reference) {
+            SerializeBaseObject(sb, value.TypeCode, reference);
+        } else {
+            SerializePrimitive(sb, in value);
+        }
     }
 
 
@@ -231,12 +272,8 @@ public partial class Fon {
     private static void SerializeObject(StringBuilder sb, object value) {
         if (value is IList list) {
             var arrayArgs = value.GetType().GenericTypeArguments;
-            if (arrayArgs.Length == 0) {
-                throw new InvalidOperationException($"Attempt to serialize list with undetermined item types. Type: {value.GetType().FullName}");
-            }
-
-            if (GetTypeShort(arrayArgs[0]) is not char shortType) {
-                throw new InvalidOperationException($"Unsupported list item type for serialization. Item type: {arrayArgs[0].FullName}");
+            if (arrayArgs.Length == 0 || GetTypeShort(arrayArgs[0]) is not char shortType) {
+                throw UnsupportedValue(value);
             }
 
             sb.Append(shortType);
@@ -244,7 +281,7 @@ public partial class Fon {
             SerializeArray(sb, shortType, list);
         } else {
             if (GetTypeShort(value.GetType()) is not char shortType) {
-                throw new InvalidOperationException($"Unsupported type for serialization. Type: {value.GetType().FullName}");
+                throw UnsupportedValue(value);
             }
 
             sb.Append(shortType);
@@ -256,73 +293,52 @@ public partial class Fon {
 
 
 
-    private static void SerializeBaseObject(StringBuilder sb, char shortType, object value) {
-        // Use Span for number formatting without allocations
-        Span<char> buffer = stackalloc char[32];
+    private static InvalidOperationException UnsupportedValue(object value) {
+        if (value is IList) {
+            var arrayArgs = value.GetType().GenericTypeArguments;
+            if (arrayArgs.Length == 0) {
+                return new InvalidOperationException($"Attempt to serialize list with undetermined item types. Type: {value.GetType().FullName}");
+            }
+            return new InvalidOperationException($"Unsupported list item type for serialization. Item type: {arrayArgs[0].FullName}");
+        }
+        return new InvalidOperationException($"Unsupported type for serialization. Type: {value.GetType().FullName}");
+    }
+
+
+
 
+    private static void SerializeBaseObject(StringBuilder sb, char shortType, object value) {
         switch (shortType) {
             case 'e':
-                if (((byte)value).TryFormat(buffer, out int bytesWritten)) {
-                    sb.Append(buffer[..bytesWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (byte)value);
             break;
 
             case 't':
-                if (((short)value).TryFormat(buffer, out int shortWritten)) {
-                    sb.Append(buffer[..shortWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (short)value);
             break;
 
             case 'i':
-                if (((int)value).TryFormat(buffer, out int intWritten)) {
-                    sb.Append(buffer[..intWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (int)value);
             break;
 
             case 'u':
-                if (((uint)value).TryFormat(buffer, out int uintWritten)) {
-                    sb.Append(buffer[..uintWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (uint)value);
             break;
 
             case 'l':
-                if (((long)value).TryFormat(buffer, out int longWritten)) {
-                    sb.Append(buffer[..longWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (long)value);
             break;
 
             case 'g':
-                if (((ulong)value).TryFormat(buffer, out int ulongWritten)) {
-                    sb.Append(buffer[..ulongWritten]);
-                } else {
-                    sb.Append(value.ToString());
-                }
+                AppendFormatted(sb, (ulong)value);
             break;
 
             case 'f':
-                if (((float)value).TryFormat(buffer, out int floatWritten, default, CultureInfo.InvariantCulture)) {
-                    sb.Append(buffer[..floatWritten]);
-                } else {
-                    sb.Append(((float)value).ToString(CultureInfo.InvariantCulture));
-                }
+                AppendFormatted(sb, (float)value);
             break;
 
             case 'd':
-                if (((double)value).TryFormat(buffer, out int doubleWritten, default, CultureInfo.InvariantCulture)) {
-                    sb.Append(buffer[..doubleWritten]);
-                } else {
-                    sb.Append(((double)value).ToString(CultureInfo.InvariantCulture));
-                }
+                AppendFormatted(sb, (double)value);
             break;
 
             case 'b':
@@ -351,6 +367,79 @@ public partial class Fon {
 
 
 
+    /// <summary>
+    /// Writes a primitive stored inline in a <see cref="FonValue"/> without boxing it.
+    /// </summary>
+    private static void SerializePrimitive(StringBuilder sb, in FonValue value) {
+        switch (value.TypeCode) {
+            case 'e':
+                AppendFormatted(sb, value.Byte);
+            break;
+
+            case 't':
+                AppendFormatted(sb, value.Int16);
+            break;
+
+            case 'i':
+                AppendFormatted(sb, value.Int32);
+            break;
+
+            case 'u':
+                AppendFormatted(sb, value.UInt32);
+            break;
+
+            case 'l':
+                AppendFormatted(sb, value.Int64);
+            break;
+
+            case 'g':
+                AppendFormatted(sb, value.UInt64);
+            break;
+
+            case 'f':
+                AppendFormatted(sb, value.Single);
+            break;
+
+            case 'd':
+                AppendFormatted(sb, value.Double);
+            break;
+
+            case 'b':
+                sb.Append(value.Boolean ? '1' : '0');
+            break;
+
+            default:
+                throw new Exception($"Unsupported type: {value.TypeCode}");
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Appends a number in invariant form, formatting it straight into the builder's chunk.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static void AppendFormatted<T>(StringBuilder sb, T value) where T : ISpanFormattable {
+        if (typeof(T) == typeof(double)) {
+            double d = (double)(object)value;
+            if (IsPlainIntegral(d)) {
+                sb.Append(CultureInfo.InvariantCulture, $"{(long)d}");
+                return;
+            }
+        } else if (typeof(T) == typeof(float)) {
+            float f = (float)(object)value;
+            if (IsPlainIntegral(f)) {
+                sb.Append(CultureInfo.InvariantCulture, $"{(int)f}");
+                return;
+            }
+        }
+        sb.Append(CultureInfo.InvariantCulture, $"{value}");
+    }
+
+
+
+
     private static void SerializeString(StringBuilder sb, string str) {
         sb.Append('"');
 
@@ -401,7 +490,18 @@ public partial class Fon {
 
     private static void SerializeRaw(StringBuilder sb, RawData raw) {
         sb.Append('"');
-        sb.Append(raw.Pack().encoded);
+        if (raw.IsPacked) {
+            sb.Append(raw.encoded);
+        } else {
+            // Encode beside the value instead of packing it, the caller's bytes stay as they are
+            char[] chars = ArrayPool<char>.Shared.Rent(raw.GetEncodedLength());
+            try {
+                raw.TryEncodeTo(chars, out int written);
+                sb.Append(chars, 0, written);
+            } finally {
+                ArrayPool<char>.Shared.Return(chars);
+            }
+        }
         sb.Append('"');
     }
 
@@ -409,19 +509,66 @@ public partial class Fon {
 
 
     private static void SerializeArray(StringBuilder sb, char shortType, IList array) {
+        if (TrySerializePrimitiveArray(sb, array)) {
+            return;
+        }
+
         sb.Append('[');
 
-        bool isFirst = true;
-        foreach (var item in array) {
-            if (isFirst) {
-                isFirst = false;
-            } else {
+        // Indexed, since foreach over IList would box the list's enumerator
+        for (int i = 0; i < array.Count; i++) {
+            if (i > 0) {
                 sb.Append(',');
             }
 
-            SerializeBaseObject(sb, shortType, item);
+            SerializeBaseObject(sb, shortType, array[i]!);
         }
 
         sb.Append(']');
     }
+
+
+
+
+    /// <summary>
+    /// Appends a primitive <see cref="List{T}"/> straight from its backing array, without the
+    /// boxing enumerator. Returns false for every other list type.
+    /// </summary>
+    private static bool TrySerializePrimitiveArray(StringBuilder sb, IList array) {
+        switch (array) {
+            case List<int> ints: AppendSpan(sb, CollectionsMarshal.AsSpan(ints)); return true;
+            case List<long> longs: AppendSpan(sb, CollectionsMarshal.AsSpan(longs)); return true;
+            case List<float> floats: AppendSpan(sb, CollectionsMarshal.AsSpan(floats)); return true;
+            case List<double> doubles: AppendSpan(sb, CollectionsMarshal.AsSpan(doubles)); return true;
+            case List<byte> bytes: AppendSpan(sb, CollectionsMarshal.AsSpan(bytes)); return true;
+            case List<short> shorts: AppendSpan(sb, CollectionsMarshal.AsSpan(shorts)); return true;
+            case List<uint> uints: AppendSpan(sb, CollectionsMarshal.AsSpan(uints)); return true;
+            case List<ulong> ulongs: AppendSpan(sb, CollectionsMarshal.AsSpan(ulongs)); return true;
+            case List<bool> bools:
+                sb.Append('[');
+                var flags = CollectionsMarshal.AsSpan(bools);
+                for (int i = 0; i < flags.Length; i++) {
+                    if (i > 0) {
+                        sb.Append(',');
+                    }
+                    sb.Append(flags[i] ? '1' : '0');
+                }
+                sb.Append(']');
+                return true;
+            default:
+                return false;
+        }
+    }
+
+
+    private static void AppendSpan<T>(StringBuilder sb, Span<T> items) where T : ISpanFormattable {
+        sb.Append('[');
+        for (int i = 0; i < items.Length; i++) {
+            if (i > 0) {
+                sb.Append(',');
+            }
+            AppendFormatted(sb, items[i]);
+        }
+        sb.Append(']');
+    }
 }
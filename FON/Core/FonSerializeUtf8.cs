@@ -0,0 +1,567 @@
+using FON.Diagnostics;
+using FON.Types;
+using System.Buffers;
+using System.Collections;
+using System.Diagnostics;
+using System.Globalization;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Channels;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// UTF-8 twin of the StringBuilder serializer: writes records straight into an
+/// <see cref="IBufferWriter{T}"/> so file and stream output never materializes a string per record.
+/// </summary>
+public partial class Fon {
+    /// <summary>
+    /// Records handed to one worker at a time by the UTF-8 file/stream serializers.
+    /// </summary>
+    private const int SerializeChunkRecords = 256;
+
+    /// <summary>
+    /// Smaller chunks for <see cref="SerializeToFilePipelineAsync"/>: lower latency to the first write.
+    /// </summary>
+    private const int PipelineChunkRecords = 32;
+
+    /// <summary>
+    /// Characters inside a string value that need an escape sequence.
+    /// </summary>
+    private static readonly SearchValues<char> stringEscapeChars = SearchValues.Create(
+        "\\\"\u0000\u0001\u0002\u0003\u0004\u0005\u0006\u0007\u0008\u0009\u000A\u000B\u000C\u000D\u000E\u000F" +
+        "\u0010\u0011\u0012\u0013\u0014\u0015\u0016\u0017\u0018\u0019\u001A\u001B\u001C\u001D\u001E\u001F");
+
+
+
+
+    /// <summary>
+    /// Writes one record (without a trailing newline) as UTF-8 into <paramref name="writer"/>.
+    /// Produces the same text as <see cref="SerializeToString"/>.
+    /// </summary>
+    public static void Serialize(FonCollection fonCollection, IBufferWriter<byte> writer) {
+        ArgumentNullException.ThrowIfNull(fonCollection);
+        ArgumentNullException.ThrowIfNull(writer);
+        WriteBody(writer, fonCollection);
+    }
+
+
+
+
+    /// <summary>
+    /// Streams the dump as UTF-8 lines (no BOM) into <paramref name="stream"/>. Records are serialized
+    /// in parallel chunks into pooled buffers, then written in id order. The stream is not closed.
+    /// </summary>
+    public static async Task SerializeToStreamAsync(FonDump dump, Stream stream, int? maxDegreeOfParallelism = null, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(dump);
+        ArgumentNullException.ThrowIfNull(stream);
+
+        var parallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount;
+        var started = FonMetrics.StartOperation();
+        var bytes = await SerializeRecordsAsync(dump.GetOrderedRecords(), stream, SerializeChunkRecords, parallelism, cancellationToken);
+        await stream.FlushAsync(cancellationToken);
+        FonMetrics.RecordOperation("serialize", "stream", FonMetrics.ManagedEngine, dump.Count, bytes, started);
+    }
+
+
+
+
+    /// <summary>
+    /// Pipelined chunked writer. Workers take a free buffer from a bounded ring, claim the next
+    /// contiguous chunk of records and serialize it; the writer flushes finished chunks in order
+    /// and hands their buffers back, so serialization and I/O overlap instead of alternating.
+    /// </summary>
+    /// <remarks>
+    /// A worker claims its chunk only after it holds a buffer, so the lowest unwritten chunk always
+    /// has one and the ring can never fill up with chunks the writer is not ready for yet.
+    /// At most <c>2 * parallelism</c> chunks are in memory at once. With <paramref name="index"/> the
+    /// writer also records where the lines of each chunk start, on the chunk it is about to write.
+    /// With <paramref name="encoder"/> every worker compresses its chunk into one block and the writer
+    /// emits blocks instead of text. Returns the UTF-8 bytes serialized; while a listener is attached the
+    /// time workers spent serializing and compressing and the writer spent writing go to <see cref="FonMetrics"/>.
+    /// </remarks>
+    private static async Task<long> SerializeRecordsAsync(ArraySegment<FonCollection?> records, Stream stream, int chunkSize, int parallelism, CancellationToken cancellationToken, FonLineIndexBuilder? index = null, FonBlockEncoder? encoder = null) {
+        chunkSize = Math.Max(1, chunkSize);
+        parallelism = Math.Max(1, parallelism);
+
+        var chunkCount = (int)((records.Count + (long)chunkSize - 1) / chunkSize);
+        if (chunkCount == 0) {
+            return 0;
+        }
+
+        var ringSize = Math.Min(parallelism * 2, chunkCount);
+        var workerCount = Math.Min(parallelism, chunkCount);
+        var ring = new PooledBufferWriter[ringSize];
+        var free = Channel.CreateBounded<PooledBufferWriter>(ringSize);
+        var ready = Channel.CreateBounded<(int chunk, PooledBufferWriter buffer)>(ringSize);
+        for (int i = 0; i < ringSize; i++) {
+            ring[i] = new PooledBufferWriter();
+            free.Writer.TryWrite(ring[i]);
+        }
+
+        using var cancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellationToken);
+        var nextChunk = -1;
+        var timed = FonMetrics.PhasesEnabled;
+        long serializeTicks = 0, compressTicks = 0, writeTicks = 0, bytes = 0;
+
+        var workers = new Task[workerCount];
+        for (int w = 0; w < workerCount; w++) {
+            workers[w] = Task.Run(async () => {
+                try {
+                    while (await free.Reader.WaitToReadAsync(cancellation.Token)) {
+                        if (!free.Reader.TryRead(out var buffer)) {
+                            continue;
+                        }
+
+                        var chunk = Interlocked.Increment(ref nextChunk);
+                        if (chunk >= chunkCount) {
+                            return;
+                        }
+
+                        buffer.Clear();
+                        var chunkStart = chunk * chunkSize;
+                        var started = timed ? Stopwatch.GetTimestamp() : 0;
+                        WriteLines(buffer, records, chunkStart, (int)Math.Min((long)chunkStart + chunkSize, records.Count));
+                        if (timed) {
+                            var serialized = Stopwatch.GetTimestamp();
+                            Interlocked.Add(ref serializeTicks, serialized - started);
+                            started = serialized;
+                        }
+                        if (encoder != null) {
+                            encoder.Encode(chunk, buffer.WrittenSpan);
+                            if (timed) {
+                                Interlocked.Add(ref compressTicks, Stopwatch.GetTimestamp() - started);
+                            }
+                        }
+                        await ready.Writer.WriteAsync((chunk, buffer), cancellation.Token);
+                    }
+                } catch (Exception ex) {
+                    // Fail the writer right away, the other workers may be waiting for buffers it holds
+                    ready.Writer.TryComplete(ex);
+                    throw;
+                }
+            }, cancellation.Token);
+        }
+
+        // Complete the ready queue once every worker is done (failures complete it earlier)
+        var completion = Task.WhenAll(workers).ContinueWith(
+            _ => ready.Writer.TryComplete(),
+            CancellationToken.None, TaskContinuationOptions.ExecuteSynchronously, TaskScheduler.Default);
+
+        try {
+            // Out-of-order chunks wait here; chunk k sits at k % ringSize, unique while at most ringSize are in flight
+            var pending = new PooledBufferWriter?[ringSize];
+            var nextToWrite = 0;
+
+            await foreach (var (chunk, buffer) in ready.Reader.ReadAllAsync(cancellation.Token)) {
+                pending[chunk % ringSize] = buffer;
+
+                while (nextToWrite < chunkCount && pending[nextToWrite % ringSize] is { } next) {
+                    pending[nextToWrite % ringSize] = null;
+                    if (index != null) {
+                        var chunkStart = nextToWrite * chunkSize;
+                        index.AddChunk(next.WrittenSpan, records, chunkStart, (int)Math.Min((long)chunkStart + chunkSize, records.Count));
+                    }
+                    var started = timed ? Stopwatch.GetTimestamp() : 0;
+                    if (encoder != null) {
+                        await encoder.WriteBlockAsync(stream, nextToWrite, cancellation.Token);
+                    } else {
+                        await stream.WriteAsync(next.WrittenMemory, cancellation.Token);
+                    }
+                    if (timed) {
+                        writeTicks += Stopwatch.GetTimestamp() - started;
+                    }
+                    bytes += next.WrittenCount;
+                    free.Writer.TryWrite(next);
+                    nextToWrite++;
+                }
+
+                if (nextToWrite == chunkCount) {
+                    break;
+                }
+            }
+
+            if (nextToWrite < chunkCount) {
+                // Workers finished early only if they were cancelled
+                cancellation.Token.ThrowIfCancellationRequested();
+            }
+
+            if (timed) {
+                FonMetrics.RecordPhaseTicks("serialize", "serialize", serializeTicks);
+                if (encoder != null) {
+                    FonMetrics.RecordPhaseTicks("compress", "serialize", compressTicks);
+                }
+                FonMetrics.RecordPhaseTicks("write", "serialize", writeTicks);
+            }
+            return bytes;
+        } catch {
+            cancellation.Cancel();
+            throw;
+        } finally {
+            // Wake workers still waiting for a buffer and let them exit before the buffers go back to the pool
+            free.Writer.TryComplete();
+            try {
+                await completion;
+                await Task.WhenAll(workers);
+            } catch (Exception) when (cancellation.IsCancellationRequested) {
+                // Already surfacing the original failure or cancellation
+            }
+
+            foreach (var buffer in ring) {
+                buffer.Dispose();
+            }
+        }
+    }
+
+
+
+
+    internal static void WriteLines(IBufferWriter<byte> writer, ArraySegment<FonCollection?> records, int start, int end) {
+        for (int i = start; i < end; i++) {
+            if (records[i] is { } record) {
+                WriteBody(writer, record);
+                WriteByte(writer, (byte)'\n');
+            }
+        }
+    }
+
+
+
+
+    private static void WriteBody(IBufferWriter<byte> writer, FonCollection fonCollection) {
+        fonCollection.GetEntries(out var keys, out var values);
+        for (int i = 0; i < keys.Length; i++) {
+            WriteKeyValue(writer, keys[i], in values[i], separator: i > 0);
+        }
+    }
+
+
+
+
+    private static void WriteKeyValue(IBufferWriter<byte> writer, string key, in FonValue value, bool separator) {
+        if (value.TypeCode == '\0') {
+            throw UnsupportedValue(value.ToObject());
+        }
+
+        // ",key=t:" in one reservation
+        var span = writer.GetSpan(Encoding.UTF8.GetMaxByteCount(key.Length) + 4);
+        int length = 0;
+        if (separator) {
+            span[length++] = (byte)',';
+        }
+        length += Encoding.UTF8.GetBytes(key, span.Slice(length));
+        span[length++] = (byte)'=';
+        span[length++] = (byte)value.TypeCode;
+        span[length++] = (byte)':';
+        writer.Advance(length);
+
+        if (value.IsArray) {
+            WriteArray(writer, value.TypeCode, (IList)value.Reference!);
+        } else if (value.Reference is { } reference) {
+            WriteBaseObject(writer, value.TypeCode, reference);
+        } else {
+            WritePrimitive(writer, in value);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Writes a primitive stored inline in a <see cref="FonValue"/> without boxing it.
+    /// </summary>
+    private static void WritePrimitive(IBufferWriter<byte> writer, in FonValue value) {
+        switch (value.TypeCode) {
+            case 'e':
+                WriteFormatted(writer, value.Byte);
+            break;
+
+            case 't':
+                WriteFormatted(writer, value.Int16);
+            break;
+
+            case 'i':
+                WriteFormatted(writer, value.Int32);
+            break;
+
+            case 'u':
+                WriteFormatted(writer, value.UInt32);
+            break;
+
+            case 'l':
+                WriteFormatted(writer, value.Int64);
+            break;
+
+            case 'g':
+                WriteFormatted(writer, value.UInt64);
+            break;
+
+            case 'f':
+                WriteFormatted(writer, value.Single);
+            break;
+
+            case 'd':
+                WriteFormatted(writer, value.Double);
+            break;
+
+            case 'b':
+                WriteByte(writer, value.Boolean ? (byte)'1' : (byte)'0');
+            break;
+
+            default:
+                throw new Exception($"Unsupported type: {value.TypeCode}");
+        }
+    }
+
+
+
+
+    private static void WriteBaseObject(IBufferWriter<byte> writer, char shortType, object value) {
+        switch (shortType) {
+            case 'e':
+                WriteFormatted(writer, (byte)value);
+            break;
+
+            case 't':
+                WriteFormatted(writer, (short)value);
+            break;
+
+            case 'i':
+                WriteFormatted(writer, (int)value);
+            break;
+
+            case 'u':
+                WriteFormatted(writer, (uint)value);
+            break;
+
+            case 'l':
+                WriteFormatted(writer, (long)value);
+            break;
+
+            case 'g':
+                WriteFormatted(writer, (ulong)value);
+            break;
+
+            case 'f':
+                WriteFormatted(writer, (float)value);
+            break;
+
+            case 'd':
+                WriteFormatted(writer, (double)value);
+            break;
+
+            case 'b':
+                WriteByte(writer, (bool)value ? (byte)'1' : (byte)'0');
+            break;
+
+            case 's':
+                WriteString(writer, (string)value);
+            break;
+
+            case 'r':
+                WriteRaw(writer, (RawData)value);
+            break;
+
+            case 'o':
+                WriteByte(writer, (byte)'{');
+                WriteBody(writer, (FonCollection)value);
+                WriteByte(writer, (byte)'}');
+            break;
+
+            default:
+                throw new Exception($"Unsupported type: {shortType}");
+        }
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static void WriteFormatted<T>(IBufferWriter<byte> writer, T value) where T : IUtf8SpanFormattable {
+        // 32 bytes covers every integer and the round-trip form of float/double
+        var span = writer.GetSpan(32);
+        if (!TryFormatNumber(value, span, out int written)) {
+            span = writer.GetSpan(128);
+            if (!TryFormatNumber(value, span, out written)) {
+                throw new InvalidOperationException($"Unable to format value {value}");
+            }
+        }
+        writer.Advance(written);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal static void WriteByte(IBufferWriter<byte> writer, byte value) {
+        var span = writer.GetSpan(1);
+        span[0] = value;
+        writer.Advance(1);
+    }
+
+
+
+
+    internal static void WriteString(IBufferWriter<byte> writer, string str) {
+        WriteByte(writer, (byte)'"');
+
+        var remaining = str.AsSpan();
+        while (remaining.Length > 0) {
+            // Copy the run without escapes in one transcoding call
+            var escapeIndex = remaining.IndexOfAny(stringEscapeChars);
+            var run = escapeIndex < 0 ? remaining : remaining.Slice(0, escapeIndex);
+            if (run.Length > 0) {
+                Encoding.UTF8.GetBytes(run, writer);
+            }
+            if (escapeIndex < 0) {
+                break;
+            }
+
+            WriteEscape(writer, remaining[escapeIndex]);
+            remaining = remaining.Slice(escapeIndex + 1);
+        }
+
+        WriteByte(writer, (byte)'"');
+    }
+
+
+
+
+    private static void WriteEscape(IBufferWriter<byte> writer, char c) {
+        var span = writer.GetSpan(6);
+        span[0] = (byte)'\\';
+
+        switch (c) {
+            case '\\':
+            case '"':
+                span[1] = (byte)c;
+                writer.Advance(2);
+            break;
+
+            case '\n':
+                span[1] = (byte)'n';
+                writer.Advance(2);
+            break;
+
+            case '\r':
+                span[1] = (byte)'r';
+                writer.Advance(2);
+            break;
+
+            case '\t':
+                span[1] = (byte)'t';
+                writer.Advance(2);
+            break;
+
+            case '\b':
+                span[1] = (byte)'b';
+                writer.Advance(2);
+            break;
+
+            case '\f':
+                span[1] = (byte)'f';
+                writer.Advance(2);
+            break;
+
+            default:
+                span[1] = (byte)'u';
+                ((uint)c).TryFormat(span.Slice(2), out _, "X4", CultureInfo.InvariantCulture);
+                writer.Advance(6);
+            break;
+        }
+    }
+
+
+
+
+    internal static void WriteRaw(IBufferWriter<byte> writer, RawData raw) {
+        WriteByte(writer, (byte)'"');
+
+        // Z85 is ASCII: encode (or copy the packed text) straight into the output
+        int length = raw.GetEncodedLength();
+        raw.TryEncodeTo(writer.GetSpan(length), out int written);
+        writer.Advance(written);
+
+        WriteByte(writer, (byte)'"');
+    }
+
+
+
+
+    private static void WriteArray(IBufferWriter<byte> writer, char shortType, IList array) {
+        if (TryWritePrimitiveArray(writer, array)) {
+            return;
+        }
+
+        WriteByte(writer, (byte)'[');
+
+        // Indexed, since foreach over IList would box the list's enumerator
+        for (int i = 0; i < array.Count; i++) {
+            if (i > 0) {
+                WriteByte(writer, (byte)',');
+            }
+
+            WriteBaseObject(writer, shortType, array[i]!);
+        }
+
+        WriteByte(writer, (byte)']');
+    }
+
+
+
+
+    /// <summary>
+    /// Writes a primitive <see cref="List{T}"/> straight from its backing array, without the
+    /// boxing enumerator. Returns false for every other list type.
+    /// </summary>
+    private static bool TryWritePrimitiveArray(IBufferWriter<byte> writer, IList array) {
+        switch (array) {
+            case List<int> ints: WriteSpan(writer, CollectionsMarshal.AsSpan(ints)); return true;
+            case List<long> longs: WriteSpan(writer, CollectionsMarshal.AsSpan(longs)); return true;
+            case List<float> floats: WriteSpan(writer, CollectionsMarshal.AsSpan(floats)); return true;
+            case List<double> doubles: WriteSpan(writer, CollectionsMarshal.AsSpan(doubles)); return true;
+            case List<byte> bytes: WriteSpan(writer, CollectionsMarshal.AsSpan(bytes)); return true;
+            case List<short> shorts: WriteSpan(writer, CollectionsMarshal.AsSpan(shorts)); return true;
+            case List<uint> uints: WriteSpan(writer, CollectionsMarshal.AsSpan(uints)); return true;
+            case List<ulong> ulongs: WriteSpan(writer, CollectionsMarshal.AsSpan(ulongs)); return true;
+            case List<bool> bools:
+                var flags = CollectionsMarshal.AsSpan(bools);
+                var span = writer.GetSpan(flags.Length * 2 + 2);
+                span[0] = (byte)'[';
+                int position = 1;
+                for (int i = 0; i < flags.Length; i++) {
+                    if (i > 0) {
+                        span[position++] = (byte)',';
+                    }
+                    span[position++] = flags[i] ? (byte)'1' : (byte)'0';
+                }
+                span[position++] = (byte)']';
+                writer.Advance(position);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+
+    private static void WriteSpan<T>(IBufferWriter<byte> writer, Span<T> items) where T : IUtf8SpanFormattable {
+        WriteByte(writer, (byte)'[');
+        for (int i = 0; i < items.Length; i++) {
+            // One span per element covers the separator and the widest integer or round-trip float
+            var span = writer.GetSpan(33);
+            int offset = 0;
+            if (i > 0) {
+                span[offset++] = (byte)',';
+            }
+            if (TryFormatNumber(items[i], span.Slice(offset), out int written)) {
+                writer.Advance(offset + written);
+            } else {
+                writer.Advance(offset);
+                WriteFormatted(writer, items[i]);
+            }
+        }
+        WriteByte(writer, (byte)']');
+    }
+}
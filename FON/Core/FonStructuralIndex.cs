@@ -0,0 +1,231 @@
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// simdjson-style structural index of one UTF-8 line: a bitmap of the unescaped quotes and a bitmap
+/// of the structural bytes outside strings (<c>{ } [ ] ,</c> and line breaks), one bit per byte.
+/// The parser and the tape builder find string ends, matching brackets and value ends with bit scans
+/// over it, instead of rescanning the bytes of a value once per nesting level.
+/// </summary>
+/// <remarks>
+/// The line is classified 64 bytes at a time with Vector128 compares (scalar without acceleration).
+/// Escapes are resolved with simdjson's odd-backslash-run carry and the in-string mask is the prefix
+/// xor of the quote bits (a carry-less multiply with PCLMULQDQ), both carried from block to block.
+/// Positions are relative to the start of the indexed line. Each thread keeps one index for reuse.
+/// </remarks>
+internal sealed class FonStructuralIndex {
+    /// <summary>
+    /// Shorter lines keep the IndexOfAny scanners: indexing them costs more than it saves.
+    /// </summary>
+    internal const int MinLength = 64;
+
+    /// <summary>
+    /// Bitmaps of longer lines (2 MB and up) are not kept for the next line.
+    /// </summary>
+    private const int MaxCachedWords = 32 * 1024;
+
+    private const ulong EvenBits = 0x5555555555555555;
+
+    [ThreadStatic]
+    private static FonStructuralIndex? cached;
+
+    private ulong[] quotes = [];
+    private ulong[] structurals = [];
+
+
+
+
+    /// <summary>
+    /// Indexes <paramref name="line"/>; null when it is shorter than <see cref="MinLength"/>.
+    /// Hand the index back with <see cref="Return"/> once the line is parsed.
+    /// </summary>
+    public static FonStructuralIndex? Build(ReadOnlySpan<byte> line) {
+        if (line.Length < MinLength) {
+            return null;
+        }
+
+        var index = cached ?? new FonStructuralIndex();
+        cached = null;
+        index.Classify(line);
+        return index;
+    }
+
+
+    public static void Return(FonStructuralIndex? index) {
+        if (index != null && index.quotes.Length <= MaxCachedWords) {
+            cached = index;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Position of the first unescaped quote in [<paramref name="from"/>, <paramref name="limit"/>), or -1.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public int NextQuote(int from, int limit) => Next(quotes, from, limit);
+
+
+    /// <summary>
+    /// Position of the first structural byte outside strings in [<paramref name="from"/>, <paramref name="limit"/>), or -1.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public int NextStructural(int from, int limit) => Next(structurals, from, limit);
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int Next(ulong[] bits, int from, int limit) {
+        if (from >= limit) {
+            return -1;
+        }
+
+        var word = from >> 6;
+        var last = (limit - 1) >> 6;
+        var mask = bits[word] & (ulong.MaxValue << (from & 63));
+        while (mask == 0) {
+            if (++word > last) {
+                return -1;
+            }
+            mask = bits[word];
+        }
+
+        var position = (word << 6) + BitOperations.TrailingZeroCount(mask);
+        return position < limit ? position : -1;
+    }
+
+
+
+
+    private void Classify(ReadOnlySpan<byte> line) {
+        var words = (line.Length + 63) >> 6;
+        if (quotes.Length < words) {
+            quotes = new ulong[words];
+            structurals = new ulong[words];
+        }
+
+        // 1 when the previous block ended in an odd run of backslashes, all ones when it ended inside a string
+        ulong escapeCarry = 0;
+        ulong inString = 0;
+        Span<byte> tail = stackalloc byte[64];
+
+        for (int word = 0; word < words; word++) {
+            var block = line.Slice(word << 6);
+            if (block.Length < 64) {
+                tail.Clear();
+                block.CopyTo(tail);
+            }
+
+            var (quote, backslash, structural) = ClassifyBlock(block.Length < 64 ? tail : block);
+
+            quote &= ~FindEscaped(backslash, ref escapeCarry);
+            var stringMask = PrefixXor(quote) ^ inString;
+            inString = (ulong)((long)stringMask >> 63);
+
+            quotes[word] = quote;
+            structurals[word] = structural & ~stringMask;
+        }
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static (ulong quote, ulong backslash, ulong structural) ClassifyBlock(ReadOnlySpan<byte> block) =>
+        Vector128.IsHardwareAccelerated ? ClassifyVector(block) : ClassifyScalar(block);
+
+
+    private static (ulong quote, ulong backslash, ulong structural) ClassifyVector(ReadOnlySpan<byte> block) {
+        ref var start = ref MemoryMarshal.GetReference(block);
+        ulong quote = 0, backslash = 0, structural = 0;
+
+        for (int k = 0; k < 4; k++) {
+            var chunk = Vector128.LoadUnsafe(ref start, (nuint)(k * 16));
+            var structuralBytes = Vector128.Equals(chunk, Vector128.Create((byte)'{'))
+                | Vector128.Equals(chunk, Vector128.Create((byte)'}'))
+                | Vector128.Equals(chunk, Vector128.Create((byte)'['))
+                | Vector128.Equals(chunk, Vector128.Create((byte)']'))
+                | Vector128.Equals(chunk, Vector128.Create((byte)','))
+                | Vector128.Equals(chunk, Vector128.Create((byte)'\r'))
+                | Vector128.Equals(chunk, Vector128.Create((byte)'\n'));
+
+            var shift = k * 16;
+            quote |= (ulong)Vector128.Equals(chunk, Vector128.Create((byte)'"')).ExtractMostSignificantBits() << shift;
+            backslash |= (ulong)Vector128.Equals(chunk, Vector128.Create((byte)'\\')).ExtractMostSignificantBits() << shift;
+            structural |= (ulong)structuralBytes.ExtractMostSignificantBits() << shift;
+        }
+
+        return (quote, backslash, structural);
+    }
+
+
+    private static (ulong quote, ulong backslash, ulong structural) ClassifyScalar(ReadOnlySpan<byte> block) {
+        ulong quote = 0, backslash = 0, structural = 0;
+
+        for (int i = 0; i < 64; i++) {
+            var bit = 1UL << i;
+            switch (block[i]) {
+                case (byte)'"':
+                    quote |= bit;
+                    break;
+                case (byte)'\\':
+                    backslash |= bit;
+                    break;
+                case (byte)'{' or (byte)'}' or (byte)'[' or (byte)']' or (byte)',' or (byte)'\r' or (byte)'\n':
+                    structural |= bit;
+                    break;
+            }
+        }
+
+        return (quote, backslash, structural);
+    }
+
+
+
+
+    /// <summary>
+    /// Bits of the bytes that follow an unescaped backslash: escaped quotes, and the second backslash of a \\ pair.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static ulong FindEscaped(ulong backslash, ref ulong carry) {
+        if (backslash == 0) {
+            var escaped = carry;
+            carry = 0;
+            return escaped;
+        }
+
+        backslash &= ~carry;
+        var followsEscape = backslash << 1 | carry;
+        var oddStarts = backslash & ~EvenBits & ~followsEscape;
+        var evenStartedRuns = oddStarts + backslash;
+        carry = evenStartedRuns < backslash ? 1UL : 0UL;
+        return (EvenBits ^ (evenStartedRuns << 1)) & followsEscape;
+    }
+
+
+    /// <summary>
+    /// Bit i becomes the xor of bits 0..i: set from an opening quote up to, not including, its closing quote.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static ulong PrefixXor(ulong bits) {
+        if (Pclmulqdq.IsSupported) {
+            return Pclmulqdq.CarrylessMultiply(Vector128.CreateScalar(bits), Vector128.Create(ulong.MaxValue), 0).ToScalar();
+        }
+
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+}
@@ -0,0 +1,56 @@
+using FON.Types;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Typed serializer for <typeparamref name="T"/>, emitted by the <see cref="FonSerializableAttribute"/> generator.
+/// </summary>
+public interface IFonTypeSerializer<T> {
+    /// <summary>
+    /// Writes the body of one record (the keys of <paramref name="value"/>, no newline).
+    /// </summary>
+    void Write(ref FonUtf8Writer writer, T value);
+
+    /// <summary>
+    /// Reads keys until the end of the record or object; unknown keys are skipped.
+    /// </summary>
+    T Read(ref FonUtf8Reader reader);
+
+    FonCollection ToCollection(T value);
+
+    T FromCollection(FonCollection collection);
+}
+
+
+
+
+/// <summary>
+/// Registry of generated serializers, one static slot per type (no dictionary lookup, no reflection).
+/// </summary>
+public static class FonTypeSerializers {
+    /// <summary>
+    /// Called by the generated module initializers; may also register hand-written serializers.
+    /// </summary>
+    public static void Register<T>(IFonTypeSerializer<T> serializer) {
+        ArgumentNullException.ThrowIfNull(serializer);
+        Slot<T>.Serializer = serializer;
+    }
+
+    public static IFonTypeSerializer<T>? Get<T>() => Slot<T>.Serializer;
+
+    /// <summary>
+    /// Like <see cref="Get{T}"/>, but throws when nothing is registered. Generated code uses it for
+    /// nested <c>[FonSerializable]</c> types that come from other assemblies.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">No serializer is registered for <typeparamref name="T"/>.</exception>
+    public static IFonTypeSerializer<T> GetRequired<T>() {
+        return Slot<T>.Serializer ?? throw new InvalidOperationException(
+            $"No FON serializer is registered for {typeof(T)}; mark the type [FonSerializable]");
+    }
+
+
+    private static class Slot<T> {
+        public static IFonTypeSerializer<T>? Serializer;
+    }
+}
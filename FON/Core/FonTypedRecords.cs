@@ -0,0 +1,157 @@
+using FON.Types;
+using System.Buffers;
+using System.Runtime.CompilerServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Typed records: values of <c>[FonSerializable]</c> types are written and read through their
+/// generated <see cref="IFonTypeSerializer{T}"/>, straight between UTF-8 and the properties,
+/// without a <see cref="FonCollection"/> in between. The text is the same as for the collection
+/// holding the same keys, so both APIs read each other's files.
+/// </summary>
+public partial class Fon {
+    /// <summary>
+    /// Flush threshold of <see cref="SerializeRecordsToStreamAsync{T}"/>.
+    /// </summary>
+    private const int TypedRecordsFlushBytes = 1024 * 1024;
+
+
+
+
+    /// <summary>
+    /// Writes one record (without a trailing newline) as UTF-8 into <paramref name="writer"/>.
+    /// </summary>
+    /// <exception cref="InvalidOperationException"><typeparamref name="T"/> has no generated serializer.</exception>
+    public static void SerializeRecord<T>(T record, IBufferWriter<byte> writer) {
+        if (record is null) {
+            throw new ArgumentNullException(nameof(record));
+        }
+        ArgumentNullException.ThrowIfNull(writer);
+        var fonWriter = new FonUtf8Writer(writer);
+        FonTypeSerializers.GetRequired<T>().Write(ref fonWriter, record);
+    }
+
+
+    /// <summary>
+    /// Parses one record (a single line, without the newline). Keys <typeparamref name="T"/> does
+    /// not have are skipped; properties missing from the line keep their initial value.
+    /// </summary>
+    /// <exception cref="FormatException">The line is malformed or a key has a different type than its property.</exception>
+    public static T DeserializeRecord<T>(ReadOnlySpan<byte> line) {
+        var serializer = FonTypeSerializers.GetRequired<T>();
+        if (line.StartsWith(Utf8Bom)) {
+            line = line.Slice(Utf8Bom.Length);
+        }
+        var reader = new FonUtf8Reader(line);
+        return serializer.Read(ref reader);
+    }
+
+
+
+
+    /// <summary>
+    /// Writes <paramref name="records"/> as UTF-8 lines (no BOM) into <paramref name="stream"/>, in order.
+    /// Records are serialized on the calling thread into a pooled buffer that is flushed about every 1MB,
+    /// so memory does not grow with the number of records. The stream is not closed.
+    /// </summary>
+    public static async Task SerializeRecordsToStreamAsync<T>(IEnumerable<T> records, Stream stream, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(records);
+        ArgumentNullException.ThrowIfNull(stream);
+        var serializer = FonTypeSerializers.GetRequired<T>();
+
+        using var buffer = new PooledBufferWriter();
+        foreach (var record in records) {
+            if (record is null) {
+                continue;
+            }
+            WriteTypedLine(serializer, buffer, record);
+            if (buffer.WrittenCount >= TypedRecordsFlushBytes) {
+                await stream.WriteAsync(buffer.WrittenMemory, cancellationToken);
+                buffer.Clear();
+            }
+        }
+
+        if (buffer.WrittenCount > 0) {
+            await stream.WriteAsync(buffer.WrittenMemory, cancellationToken);
+        }
+        await stream.FlushAsync(cancellationToken);
+    }
+
+
+    public static async Task SerializeRecordsToFileAsync<T>(IEnumerable<T> records, FileInfo file, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(file);
+
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Create,
+            FileAccess.Write,
+            FileShare.None,
+            bufferSize: 1, // Writes are ~1MB already, skip FileStream's own buffer
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+        await SerializeRecordsToStreamAsync(records, fileStream, cancellationToken);
+    }
+
+
+
+
+    /// <summary>
+    /// Streams the records of a FON file as <typeparamref name="T"/>. See <see cref="ReadRecordsAsync{T}(Stream, int?, CancellationToken)"/>.
+    /// Block-compressed files (<see cref="SerializeToFileCompressedAsync"/>) are decoded block by block.
+    /// </summary>
+    public static async IAsyncEnumerable<(ulong id, T record)> ReadRecordsAsync<T>(FileInfo file, int? maxDegreeOfParallelism = null, [EnumeratorCancellation] CancellationToken cancellationToken = default) {
+        if (FonBlockContainer.IsContainer(file)) {
+            await foreach (var item in ReadCompressedRecordsAsync(file, maxDegreeOfParallelism, TypedLineParser<T>(), 0, ulong.MaxValue, cancellationToken)) {
+                yield return item;
+            }
+            yield break;
+        }
+
+        await using var fileStream = new FileStream(
+            file.FullName,
+            FileMode.Open,
+            FileAccess.Read,
+            FileShare.Read,
+            bufferSize: 1, // Reads are block-sized already, skip FileStream's own buffer
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+
+        await foreach (var item in ReadRecordsAsync<T>(fileStream, maxDegreeOfParallelism, cancellationToken)) {
+            yield return item;
+        }
+    }
+
+
+    /// <summary>
+    /// Streams the records of UTF-8 FON text as <typeparamref name="T"/>, in line order and keyed by
+    /// line number. Same block pipeline, parallelism and backpressure as
+    /// <see cref="ReadRecordsAsync(Stream, int?, FonReadOptions?, CancellationToken)"/>, but each line
+    /// is parsed by the generated serializer straight into a new <typeparamref name="T"/>.
+    /// </summary>
+    public static IAsyncEnumerable<(ulong id, T record)> ReadRecordsAsync<T>(Stream stream, int? maxDegreeOfParallelism = null, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(stream);
+        return ReadLineRecordsAsync(stream, maxDegreeOfParallelism, TypedLineParser<T>(), cancellationToken);
+    }
+
+
+
+
+    private static LineParser<T> TypedLineParser<T>() {
+        var serializer = FonTypeSerializers.GetRequired<T>();
+        return line => {
+            var reader = new FonUtf8Reader(line);
+            return serializer.Read(ref reader);
+        };
+    }
+
+
+
+
+    private static void WriteTypedLine<T>(IFonTypeSerializer<T> serializer, IBufferWriter<byte> writer, T record) {
+        var fonWriter = new FonUtf8Writer(writer);
+        serializer.Write(ref fonWriter, record);
+        WriteByte(writer, (byte)'\n');
+    }
+}
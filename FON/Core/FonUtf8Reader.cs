@@ -0,0 +1,251 @@
+using FON.Types;
+using System.Buffers.Text;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Forward-only reader over the UTF-8 body of one FON record, for the serializers the
+/// <see cref="FonSerializableAttribute"/> generator emits. Values are parsed straight into the
+/// target properties: no <see cref="FonCollection"/>, no boxing, and strings only for s: values.
+/// </summary>
+/// <remarks>
+/// Loop on <see cref="TryReadProperty"/>, then call the Read method matching the property
+/// (it checks the type code) or <see cref="Skip"/>. <see cref="TryReadProperty"/> returns false at
+/// the end of the record, or at the '}' closing the object opened by <see cref="BeginObject"/>.
+/// </remarks>
+public ref struct FonUtf8Reader {
+    private readonly ReadOnlySpan<byte> bytes;
+    private int position;
+    private int depth;
+    private char typeCode;
+    private bool isArray;
+    private int scalarLength;
+
+
+    public FonUtf8Reader(ReadOnlySpan<byte> bytes) {
+        this.bytes = bytes;
+    }
+
+
+    /// <summary>
+    /// Type code of the current value (see <see cref="Fon.SupportTypes"/>).
+    /// </summary>
+    public readonly char TypeCode => typeCode;
+
+    /// <summary>
+    /// True when the current value is an array (<c>[...]</c>).
+    /// </summary>
+    public readonly bool IsArray => isArray;
+
+    public readonly int Position => position;
+
+
+
+
+    /// <summary>
+    /// Moves to the next key. False at the end of the record or of the current object.
+    /// </summary>
+    public bool TryReadProperty(out ReadOnlySpan<byte> key) {
+        if (position < bytes.Length && bytes[position] == (byte)',') {
+            position++;
+        }
+
+        if (position >= bytes.Length) {
+            key = default;
+            return false;
+        }
+
+        if (bytes[position] == (byte)'}') {
+            if (depth == 0) {
+                throw new FormatException($"Unexpected '}}' at position {position}");
+            }
+            position++;
+            depth--;
+            key = default;
+            return false;
+        }
+
+        var remaining = bytes.Slice(position);
+        var eqIndex = remaining.IndexOf((byte)'=');
+        if (eqIndex < 0 || remaining.Length < eqIndex + 3 || remaining[eqIndex + 2] != (byte)':') {
+            throw new FormatException($"Invalid format at position {position}");
+        }
+
+        key = remaining.Slice(0, eqIndex);
+        typeCode = (char)remaining[eqIndex + 1];
+        if (!Fon.SupportTypes.ContainsValue(typeCode)) {
+            throw new FormatException($"Unknown type '{typeCode}' at position {position + eqIndex + 1}");
+        }
+
+        position += eqIndex + 3;
+        isArray = position < bytes.Length && bytes[position] == (byte)'[';
+        return true;
+    }
+
+
+    /// <summary>
+    /// Skips the current value, e.g. for a key the target type does not have.
+    /// </summary>
+    public void Skip() {
+        if (isArray || typeCode is 'o' or 's' or 'r') {
+            position += Fon.SkipValue(bytes.Slice(position), typeCode);
+        } else {
+            // Fon.SkipValue expects an object body already cut at its '}'
+            Scalar(typeCode);
+            EndScalar();
+        }
+    }
+
+
+
+
+    public byte ReadByte() => Utf8Parser.TryParse(Scalar('e'), out byte value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public short ReadInt16() => Utf8Parser.TryParse(Scalar('t'), out short value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public int ReadInt32() => Utf8Parser.TryParse(Scalar('i'), out int value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public uint ReadUInt32() => Utf8Parser.TryParse(Scalar('u'), out uint value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public long ReadInt64() => Utf8Parser.TryParse(Scalar('l'), out long value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public ulong ReadUInt64() => Utf8Parser.TryParse(Scalar('g'), out ulong value, out int consumed) && Consumed(consumed) ? value : throw Invalid();
+
+    public float ReadSingle() {
+        var value = Fon.ParseFloatUtf8(Scalar('f'));
+        EndScalar();
+        return value;
+    }
+
+    public double ReadDouble() {
+        var value = Fon.ParseDoubleUtf8(Scalar('d'));
+        EndScalar();
+        return value;
+    }
+
+    public bool ReadBoolean() {
+        var span = Scalar('b');
+        if (span.IsEmpty) {
+            throw Invalid();
+        }
+        EndScalar();
+        return span[0] != (byte)'0';
+    }
+
+    public string ReadString() {
+        Expect('s', false);
+        var (value, consumed) = Fon.DeserializeStringOptimized(bytes.Slice(position));
+        position += consumed;
+        return value;
+    }
+
+    /// <summary>
+    /// Reads an r: value, unpacked according to <see cref="Fon.RawUnpack"/> like the collection parser.
+    /// </summary>
+    public RawData ReadRawData() {
+        Expect('r', false);
+        var (value, consumed) = Fon.DeserializeRawOptimized(bytes.Slice(position));
+        position += consumed;
+        return value;
+    }
+
+
+    /// <summary>
+    /// Reads an array of primitives, strings or RawData into a new list.
+    /// </summary>
+    public List<T> ReadList<T>() {
+        if (typeof(T) == typeof(FonCollection) || !Fon.SupportTypes.TryGetValue(typeof(T), out var expected)) {
+            throw new NotSupportedException($"Type {typeof(T)} is not a FON array element type");
+        }
+        Expect(expected, true);
+        var (list, consumed) = Fon.DeserializeArrayOptimized(bytes.Slice(position), typeof(T), typeCode, depth + 1);
+        position += consumed;
+        return (List<T>)list;
+    }
+
+
+
+
+    /// <summary>
+    /// Enters the current <c>o:{...}</c> value; read its keys until <see cref="TryReadProperty"/> returns false.
+    /// </summary>
+    public void BeginObject() {
+        Expect('o', false);
+        Enter((byte)'{');
+    }
+
+
+    /// <summary>
+    /// Enters the current <c>o:[...]</c> value; then loop on <see cref="TryBeginArrayObject"/>.
+    /// </summary>
+    public void BeginObjectArray() {
+        Expect('o', true);
+        Enter((byte)'[');
+    }
+
+
+    /// <summary>
+    /// Enters the next object of the array; false (with the array consumed) at its ']'.
+    /// </summary>
+    public bool TryBeginArrayObject() {
+        if (position < bytes.Length && bytes[position] == (byte)',') {
+            position++;
+        }
+        if (position < bytes.Length && bytes[position] == (byte)']') {
+            position++;
+            depth--;
+            return false;
+        }
+        Enter((byte)'{');
+        return true;
+    }
+
+
+
+
+    // Objects and arrays count one level each, the same limit as the collection parser
+    private void Enter(byte open) {
+        if (position >= bytes.Length || bytes[position] != open) {
+            throw new FormatException($"Expected '{(char)open}' at position {position}");
+        }
+        if (depth + 1 > Fon.MaxDepth) {
+            throw new FormatException($"Maximum nesting depth exceeded ({Fon.MaxDepth})");
+        }
+        position++;
+        depth++;
+    }
+
+
+    private void Expect(char expected, bool array) {
+        if (typeCode != expected || isArray != array) {
+            var found = isArray ? $"array of '{typeCode}'" : $"'{typeCode}'";
+            var wanted = array ? $"array of '{expected}'" : $"'{expected}'";
+            throw new FormatException($"Expected {wanted} at position {position}, found {found}");
+        }
+    }
+
+
+    private ReadOnlySpan<byte> Scalar(char expected) {
+        Expect(expected, false);
+        var remaining = bytes.Slice(position);
+        var end = remaining.IndexOfAny((byte)',', (byte)'}');
+        scalarLength = end < 0 ? remaining.Length : end;
+        return remaining.Slice(0, scalarLength);
+    }
+
+
+    private bool Consumed(int consumed) {
+        if (consumed != scalarLength) {
+            return false;
+        }
+        position += consumed;
+        return true;
+    }
+
+
+    private void EndScalar() => position += scalarLength;
+
+
+    private readonly FormatException Invalid() => Fon.InvalidNumber(typeCode, bytes.Slice(position, scalarLength));
+}
@@ -0,0 +1,197 @@
+using FON.Types;
+using System.Buffers;
+using System.Runtime.CompilerServices;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Writes one FON record straight to UTF-8, key by key, without building a <see cref="FonCollection"/>.
+/// Used by the serializers the <see cref="FonSerializableAttribute"/> generator emits; the output
+/// is byte-for-byte what the collection serializers write for the same keys and values.
+/// </summary>
+/// <remarks>
+/// Keys are written as given (the generator checks them at compile time). Null strings, RawData,
+/// lists and objects are left out, like the collection serializers leave out null values.
+/// </remarks>
+public ref struct FonUtf8Writer {
+    private readonly IBufferWriter<byte> output;
+    private bool needsSeparator;
+
+
+    public FonUtf8Writer(IBufferWriter<byte> output) {
+        ArgumentNullException.ThrowIfNull(output);
+        this.output = output;
+    }
+
+
+
+
+    public void WriteByte(ReadOnlySpan<byte> key, byte value) {
+        WriteKey(key, 'e');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteInt16(ReadOnlySpan<byte> key, short value) {
+        WriteKey(key, 't');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteInt32(ReadOnlySpan<byte> key, int value) {
+        WriteKey(key, 'i');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteUInt32(ReadOnlySpan<byte> key, uint value) {
+        WriteKey(key, 'u');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteInt64(ReadOnlySpan<byte> key, long value) {
+        WriteKey(key, 'l');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteUInt64(ReadOnlySpan<byte> key, ulong value) {
+        WriteKey(key, 'g');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteSingle(ReadOnlySpan<byte> key, float value) {
+        WriteKey(key, 'f');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteDouble(ReadOnlySpan<byte> key, double value) {
+        WriteKey(key, 'd');
+        Fon.WriteFormatted(output, value);
+    }
+
+    public void WriteBoolean(ReadOnlySpan<byte> key, bool value) {
+        WriteKey(key, 'b');
+        Fon.WriteByte(output, value ? (byte)'1' : (byte)'0');
+    }
+
+    public void WriteString(ReadOnlySpan<byte> key, string? value) {
+        if (value == null) {
+            return;
+        }
+        WriteKey(key, 's');
+        Fon.WriteString(output, value);
+    }
+
+    public void WriteRawData(ReadOnlySpan<byte> key, RawData? value) {
+        if (value == null) {
+            return;
+        }
+        WriteKey(key, 'r');
+        Fon.WriteRaw(output, value);
+    }
+
+
+
+
+    /// <summary>
+    /// Writes a list of primitives, strings or RawData. Elements are written unboxed.
+    /// </summary>
+    public void WriteArray<T>(ReadOnlySpan<byte> key, IList<T>? values) {
+        if (values == null) {
+            return;
+        }
+
+        WriteKey(key, TypeCodeOf<T>());
+        Fon.WriteByte(output, (byte)'[');
+        for (int i = 0; i < values.Count; i++) {
+            if (i > 0) {
+                Fon.WriteByte(output, (byte)',');
+            }
+            WriteElement(values[i]);
+        }
+        Fon.WriteByte(output, (byte)']');
+    }
+
+
+
+
+    /// <summary>
+    /// Starts an <c>o:{...}</c> value; write its keys, then call <see cref="EndObject"/>.
+    /// </summary>
+    public void BeginObject(ReadOnlySpan<byte> key) {
+        WriteKey(key, 'o');
+        Fon.WriteByte(output, (byte)'{');
+        needsSeparator = false;
+    }
+
+    public void EndObject() {
+        Fon.WriteByte(output, (byte)'}');
+        needsSeparator = true;
+    }
+
+
+    /// <summary>
+    /// Starts an <c>o:[...]</c> value. Each element is <see cref="BeginArrayObject"/>, its keys,
+    /// <see cref="EndObject"/>; the array ends with <see cref="EndObjectArray"/>.
+    /// </summary>
+    public void BeginObjectArray(ReadOnlySpan<byte> key) {
+        WriteKey(key, 'o');
+        Fon.WriteByte(output, (byte)'[');
+        needsSeparator = false;
+    }
+
+    public void BeginArrayObject() {
+        if (needsSeparator) {
+            Fon.WriteByte(output, (byte)',');
+        }
+        Fon.WriteByte(output, (byte)'{');
+        needsSeparator = false;
+    }
+
+    public void EndObjectArray() {
+        Fon.WriteByte(output, (byte)']');
+        needsSeparator = true;
+    }
+
+
+
+
+    private void WriteKey(ReadOnlySpan<byte> key, char typeCode) {
+        var span = output.GetSpan(key.Length + 4);
+        int length = 0;
+        if (needsSeparator) {
+            span[length++] = (byte)',';
+        }
+        key.CopyTo(span.Slice(length));
+        length += key.Length;
+        span[length++] = (byte)'=';
+        span[length++] = (byte)typeCode;
+        span[length++] = (byte)':';
+        output.Advance(length);
+        needsSeparator = true;
+    }
+
+
+    // typeof(T) checks are folded by the JIT and (X)(object)value does not box for value types
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private readonly void WriteElement<T>(T value) {
+        if (typeof(T) == typeof(byte)) Fon.WriteFormatted(output, (byte)(object)value!);
+        else if (typeof(T) == typeof(short)) Fon.WriteFormatted(output, (short)(object)value!);
+        else if (typeof(T) == typeof(int)) Fon.WriteFormatted(output, (int)(object)value!);
+        else if (typeof(T) == typeof(uint)) Fon.WriteFormatted(output, (uint)(object)value!);
+        else if (typeof(T) == typeof(long)) Fon.WriteFormatted(output, (long)(object)value!);
+        else if (typeof(T) == typeof(ulong)) Fon.WriteFormatted(output, (ulong)(object)value!);
+        else if (typeof(T) == typeof(float)) Fon.WriteFormatted(output, (float)(object)value!);
+        else if (typeof(T) == typeof(double)) Fon.WriteFormatted(output, (double)(object)value!);
+        else if (typeof(T) == typeof(bool)) Fon.WriteByte(output, (bool)(object)value! ? (byte)'1' : (byte)'0');
+        else if (typeof(T) == typeof(string)) Fon.WriteString(output, (string)(object)value!);
+        else if (typeof(T) == typeof(RawData)) Fon.WriteRaw(output, (RawData)(object)value!);
+        else throw new NotSupportedException($"Type {typeof(T)} is not a FON array element type");
+    }
+
+
+    private static char TypeCodeOf<T>() {
+        if (typeof(T) == typeof(FonCollection) || !Fon.SupportTypes.TryGetValue(typeof(T), out var typeCode)) {
+            throw new NotSupportedException($"Type {typeof(T)} is not a FON array element type");
+        }
+        return typeCode;
+    }
+}
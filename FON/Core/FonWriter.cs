@@ -0,0 +1,250 @@
+using FON.Types;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Incremental writer for FON output: records are appended one line each as they are produced,
+/// without collecting them into a <see cref="FonDump"/> first.
+///
+/// Records are grouped into batches of <c>batchSize</c>; each full batch is serialized to UTF-8 on
+/// the thread pool while the caller keeps writing. Up to <c>maxDegreeOfParallelism</c> batches are in
+/// flight, finished ones are written to the stream in submission order, so memory follows the batch
+/// size instead of the dataset size. A record must not be modified until it has been flushed.
+/// Not thread-safe.
+/// </summary>
+public sealed class FonWriter : IAsyncDisposable {
+    /// <summary>
+    /// Records per serialization batch when none is given.
+    /// </summary>
+    public const int DefaultBatchSize = 256;
+
+    private readonly Stream stream;
+    private readonly bool leaveOpen;
+    private readonly int batchSize;
+    private readonly int maxInFlight;
+
+    // Batches being serialized, oldest first; written out strictly in this order
+    private readonly Queue<(Task task, PooledBufferWriter buffer, FonCollection?[] records)> inFlight = new();
+    private readonly Stack<PooledBufferWriter> freeBuffers = new();
+    private readonly Stack<FonCollection?[]> freeBatches = new();
+
+    private FonCollection?[] batch;
+    private int batchCount;
+    private bool failed;
+    private bool disposed;
+
+
+    /// <summary>
+    /// Writes to <paramref name="stream"/> from its current position. The stream is closed on
+    /// <see cref="DisposeAsync"/> unless <paramref name="leaveOpen"/> is set.
+    /// </summary>
+    public FonWriter(Stream stream, int batchSize = DefaultBatchSize, int? maxDegreeOfParallelism = null, bool leaveOpen = false) {
+        ArgumentNullException.ThrowIfNull(stream);
+        ArgumentOutOfRangeException.ThrowIfLessThan(batchSize, 1);
+
+        this.stream = stream;
+        this.leaveOpen = leaveOpen;
+        this.batchSize = batchSize;
+        maxInFlight = Math.Max(1, maxDegreeOfParallelism ?? Environment.ProcessorCount);
+        batch = new FonCollection?[batchSize];
+    }
+
+
+
+
+    /// <summary>
+    /// Opens <paramref name="file"/> for writing. With <paramref name="append"/> existing records are
+    /// kept and new ones follow them, so a restarted producer continues the file instead of rewriting it.
+    /// A missing trailing newline is added first to keep the last old record on its own line.
+    /// </summary>
+    public static FonWriter Create(FileInfo file, bool append = false, int batchSize = DefaultBatchSize, int? maxDegreeOfParallelism = null) {
+        ArgumentNullException.ThrowIfNull(file);
+
+        var fileStream = new FileStream(
+            file.FullName,
+            append ? FileMode.OpenOrCreate : FileMode.Create,
+            append ? FileAccess.ReadWrite : FileAccess.Write,
+            FileShare.Read,
+            bufferSize: 64 * 1024,
+            FileOptions.Asynchronous | FileOptions.SequentialScan
+        );
+
+        try {
+            if (append && fileStream.Length > 0) {
+                fileStream.Seek(-1, SeekOrigin.End);
+                var last = fileStream.ReadByte();
+                fileStream.Seek(0, SeekOrigin.End);
+                if (last != '\n') {
+                    fileStream.WriteByte((byte)'\n');
+                }
+            }
+        } catch {
+            fileStream.Dispose();
+            throw;
+        }
+
+        return new FonWriter(fileStream, batchSize, maxDegreeOfParallelism);
+    }
+
+
+
+
+    /// <summary>
+    /// Records accepted so far. Record k of this writer ends up on line k of the output
+    /// (counted from where the writer started).
+    /// </summary>
+    public long Count { get; private set; }
+
+
+
+
+    /// <summary>
+    /// Queues one record. Completes synchronously unless the record fills a batch and the
+    /// in-flight limit is reached, in which case the oldest batch is written out first.
+    /// If that wait is cancelled before the batch reaches the stream, the record stays accepted and
+    /// the batch is written by the next flush; a write cancelled halfway fails the writer.
+    /// </summary>
+    public ValueTask WriteAsync(FonCollection record, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(record);
+        ThrowIfUnusable();
+
+        batch[batchCount++] = record;
+        Count++;
+
+        return batchCount == batchSize ? SubmitBatchAsync(cancellationToken) : ValueTask.CompletedTask;
+    }
+
+
+    /// <summary>
+    /// Queues records in order. Same as calling <see cref="WriteAsync(FonCollection, CancellationToken)"/> for each one.
+    /// </summary>
+    public async ValueTask WriteAsync(IEnumerable<FonCollection> records, CancellationToken cancellationToken = default) {
+        ArgumentNullException.ThrowIfNull(records);
+
+        foreach (var record in records) {
+            await WriteAsync(record, cancellationToken);
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Serializes the partial batch, writes everything still in flight and flushes the stream.
+    /// Cancellation behaves as in <see cref="WriteAsync(FonCollection, CancellationToken)"/>.
+    /// </summary>
+    public async Task FlushAsync(CancellationToken cancellationToken = default) {
+        ThrowIfUnusable();
+
+        if (batchCount > 0) {
+            Enqueue();
+        }
+        while (inFlight.Count > 0) {
+            await WriteOldestAsync(cancellationToken);
+        }
+        await stream.FlushAsync(cancellationToken);
+    }
+
+
+
+
+    /// <summary>
+    /// Flushes pending records and closes the stream (unless left open).
+    /// After a failed batch nothing more is written and the file ends at the last good batch.
+    /// </summary>
+    public async ValueTask DisposeAsync() {
+        if (disposed) {
+            return;
+        }
+
+        try {
+            if (!failed) {
+                await FlushAsync();
+            }
+        } finally {
+            disposed = true;
+
+            // Only left over after a failure: wait for the workers before their buffers go back to the pool
+            while (inFlight.TryDequeue(out var entry)) {
+                try {
+                    await entry.task;
+                } catch (Exception) {
+                    // The first failure was already surfaced to the caller
+                }
+                entry.buffer.Dispose();
+            }
+            while (freeBuffers.TryPop(out var buffer)) {
+                buffer.Dispose();
+            }
+
+            if (!leaveOpen) {
+                await stream.DisposeAsync();
+            }
+        }
+    }
+
+
+
+
+    private async ValueTask SubmitBatchAsync(CancellationToken cancellationToken) {
+        // Queue first so a wait cancelled below never loses the batch; it is still written on flush
+        Enqueue();
+        while (inFlight.Count > maxInFlight) {
+            await WriteOldestAsync(cancellationToken);
+        }
+    }
+
+
+    private void Enqueue() {
+        var buffer = freeBuffers.TryPop(out var reused) ? reused : new PooledBufferWriter();
+        var records = batch;
+        var count = batchCount;
+
+        batch = freeBatches.TryPop(out var next) ? next : new FonCollection?[batchSize];
+        batchCount = 0;
+
+        var task = Task.Run(() => {
+            buffer.Clear();
+            Fon.WriteLines(buffer, records, 0, count);
+        });
+        inFlight.Enqueue((task, buffer, records));
+    }
+
+
+    private async ValueTask WriteOldestAsync(CancellationToken cancellationToken) {
+        var (task, buffer, records) = inFlight.Peek();
+        try {
+            await task.WaitAsync(cancellationToken);
+        } catch (OperationCanceledException) when (cancellationToken.IsCancellationRequested) {
+            // Nothing of the batch was written, it stays at the head of the queue
+            throw;
+        } catch {
+            failed = true;
+            throw;
+        }
+        cancellationToken.ThrowIfCancellationRequested();
+
+        try {
+            await stream.WriteAsync(buffer.WrittenMemory, cancellationToken);
+        } catch {
+            // Part of the batch may be in the stream now; later batches must not follow a gap,
+            // the line numbers would shift
+            failed = true;
+            throw;
+        }
+
+        inFlight.Dequeue();
+        freeBuffers.Push(buffer);
+        Array.Clear(records);
+        freeBatches.Push(records);
+    }
+
+
+    private void ThrowIfUnusable() {
+        ObjectDisposedException.ThrowIf(disposed, this);
+        if (failed) {
+            throw new InvalidOperationException("FonWriter failed on an earlier batch and cannot write further records");
+        }
+    }
+}
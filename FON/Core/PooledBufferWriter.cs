@@ -0,0 +1,75 @@
+using System.Buffers;
+
+namespace FON.Core;
+
+
+/// <summary>
+/// Growable <see cref="IBufferWriter{T}"/> over an <see cref="ArrayPool{T}"/> buffer.
+/// Meant to be reused: <see cref="Clear"/> keeps the rented buffer for the next batch.
+/// </summary>
+internal sealed class PooledBufferWriter : IBufferWriter<byte>, IDisposable {
+    private byte[] buffer;
+    private int written;
+
+
+    public PooledBufferWriter(int initialCapacity = 64 * 1024) {
+        buffer = ArrayPool<byte>.Shared.Rent(Math.Max(initialCapacity, 256));
+    }
+
+
+    public int WrittenCount => written;
+
+    public ReadOnlyMemory<byte> WrittenMemory => buffer.AsMemory(0, written);
+
+    public ReadOnlySpan<byte> WrittenSpan => buffer.AsSpan(0, written);
+
+    public void Clear() => written = 0;
+
+    public void Advance(int count) {
+        if ((uint)count > (uint)(buffer.Length - written)) {
+            throw new ArgumentOutOfRangeException(nameof(count));
+        }
+        written += count;
+    }
+
+    public Memory<byte> GetMemory(int sizeHint = 0) {
+        EnsureCapacity(sizeHint);
+        return buffer.AsMemory(written);
+    }
+
+    public Span<byte> GetSpan(int sizeHint = 0) {
+        EnsureCapacity(sizeHint);
+        return buffer.AsSpan(written);
+    }
+
+    public void Dispose() {
+        var rented = buffer;
+        buffer = [];
+        written = 0;
+        if (rented.Length > 0) {
+            ArrayPool<byte>.Shared.Return(rented);
+        }
+    }
+
+
+
+
+    private void EnsureCapacity(int sizeHint) {
+        var required = Math.Max(sizeHint, 1);
+        if (buffer.Length - written >= required) {
+            return;
+        }
+
+        var newSize = (int)Math.Min(Array.MaxLength, Math.Max((long)written + required, buffer.Length * 2L));
+        if (newSize - written < required) {
+            throw new OutOfMemoryException("Serialized chunk exceeds the maximum array length");
+        }
+
+        var grown = ArrayPool<byte>.Shared.Rent(newSize);
+        buffer.AsSpan(0, written).CopyTo(grown);
+        if (buffer.Length > 0) {
+            ArrayPool<byte>.Shared.Return(buffer);
+        }
+        buffer = grown;
+    }
+}
@@ -0,0 +1,24 @@
+namespace FON.Core;
+
+
+/// <summary>
+/// What the deserializers do with RawData values (<see cref="Fon.RawUnpack"/>).
+/// </summary>
+public enum RawUnpackMode {
+    /// <summary>
+    /// Keep the Z85 text; call <see cref="Types.RawData.Unpack()"/> (or
+    /// <see cref="Types.FonDump.UnpackRawParallel"/>) to decode.
+    /// </summary>
+    None,
+
+    /// <summary>
+    /// Decode inline on the parse thread.
+    /// </summary>
+    Eager,
+
+    /// <summary>
+    /// Keep the Z85 text and decode on first access to <see cref="Types.RawData.data"/> /
+    /// <see cref="Types.RawData.Memory"/>, so blobs that are never read are never decoded.
+    /// </summary>
+    Lazy
+}
@@ -0,0 +1,41 @@
+using System.Diagnostics.Tracing;
+
+namespace FON.Diagnostics;
+
+
+/// <summary>
+/// Events of the <c>FON</c> event source (dotnet-trace, PerfView, an <see cref="EventListener"/>):
+/// the strategy every Auto call picked and how long calls and their phases took.
+/// See <see cref="FonMetrics"/> for the same data as metrics.
+/// </summary>
+[EventSource(Name = "FON")]
+public sealed class FonEventSource : EventSource {
+    public static readonly FonEventSource Log = new();
+
+
+    private FonEventSource() { }
+
+
+    [Event(1, Level = EventLevel.Informational, Message = "{0}: {1} on {2} (adaptive: {3}, size {4})")]
+    public void StrategySelected(string operation, string strategy, string engine, bool adaptive, long size) {
+        if (IsEnabled()) {
+            WriteEvent(1, operation, strategy, engine, adaptive, size);
+        }
+    }
+
+
+    [Event(2, Level = EventLevel.Informational, Message = "{0} {1} on {2}: {3} records, {4} bytes in {5} ms")]
+    public void OperationCompleted(string operation, string strategy, string engine, long records, long bytes, double milliseconds) {
+        if (IsEnabled()) {
+            WriteEvent(2, operation, strategy, engine, records, bytes, milliseconds);
+        }
+    }
+
+
+    [Event(3, Level = EventLevel.Verbose, Message = "{1} {0}: {2} ms")]
+    public void PhaseCompleted(string phase, string operation, double milliseconds) {
+        if (IsEnabled(EventLevel.Verbose, EventKeywords.All)) {
+            WriteEvent(3, phase, operation, milliseconds);
+        }
+    }
+}
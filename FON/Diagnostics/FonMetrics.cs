@@ -0,0 +1,120 @@
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+using System.Diagnostics.Tracing;
+using System.Runtime.CompilerServices;
+
+namespace FON.Diagnostics;
+
+
+/// <summary>
+/// Instruments of the <c>FON</c> <see cref="Meter"/>, readable with dotnet-counters, OpenTelemetry or a
+/// <see cref="MeterListener"/>. The same data also goes out as events of <see cref="FonEventSource"/>.
+/// </summary>
+/// <remarks>
+/// <list type="table">
+/// <item><term>fon.records, fon.bytes</term><description>Records and bytes moved by the file and stream methods; the rate is the throughput. Tags: operation, strategy, engine.</description></item>
+/// <item><term>fon.operation.duration</term><description>Seconds per file or stream call. Same tags.</description></item>
+/// <item><term>fon.phase.duration</term><description>Seconds spent in a phase: read, parse, serialize, compress, write, z85. Tags: phase, operation.
+/// Z85 time is summed over the RawData values a call encodes or decodes (on any thread it runs on) and reported once with it;
+/// Z85 work outside a file or stream call, e.g. values decoded lazily after the call returned, is not timed.</description></item>
+/// <item><term>fon.strategy.selections</term><description>What an Auto method picked. Tags: operation, strategy, engine, adaptive.</description></item>
+/// </list>
+/// Timing costs two timestamps per call (per RawData value for Z85) and nothing at all while no
+/// listener is attached to the histogram or to the Verbose phase events. The
+/// native runtime counts its P/Invoke calls on its own <c>FON.Native</c> meter.
+/// </remarks>
+public static class FonMetrics {
+    public const string MeterName = "FON";
+
+    /// <summary>
+    /// The engine tag of calls served by the managed code; backend calls carry <see cref="Acceleration.IFonBackend.Name"/>.
+    /// </summary>
+    public const string ManagedEngine = "managed";
+
+    private static readonly Meter meter = new(MeterName, typeof(FonMetrics).Assembly.GetName().Version?.ToString());
+
+    private static readonly Counter<long> records = meter.CreateCounter<long>("fon.records", "{record}", "Records serialized or deserialized");
+    private static readonly Counter<long> bytes = meter.CreateCounter<long>("fon.bytes", "By", "UTF-8 bytes written or read");
+    private static readonly Histogram<double> operationDuration = meter.CreateHistogram<double>("fon.operation.duration", "s", "Duration of a file or stream call");
+    private static readonly Histogram<double> phaseDuration = meter.CreateHistogram<double>("fon.phase.duration", "s", "Time spent in one phase of a call");
+    private static readonly Counter<long> selections = meter.CreateCounter<long>("fon.strategy.selections", "{selection}", "Strategies picked by the Auto methods");
+
+
+    // Z85 ticks of the file or stream call running in this async flow, null outside one or while nobody listens
+    private static readonly AsyncLocal<StrongBox<long>?> z85Ticks = new();
+
+
+    /// <summary>
+    /// True while anyone listens for phase timings; hot paths check it before taking timestamps.
+    /// </summary>
+    internal static bool PhasesEnabled => phaseDuration.Enabled || FonEventSource.Log.IsEnabled(EventLevel.Verbose, EventKeywords.All);
+
+
+
+
+    /// <summary>
+    /// Opens a file or stream call: returns its start timestamp and starts collecting the Z85 time of
+    /// this async flow, which <see cref="RecordOperation"/> reports. Call it from the method that records
+    /// the operation, so the collection ends with that method.
+    /// </summary>
+    internal static long StartOperation() {
+        z85Ticks.Value = PhasesEnabled ? new StrongBox<long>() : null;
+        return Stopwatch.GetTimestamp();
+    }
+
+
+    internal static void RecordOperation(string operation, string strategy, string engine, long recordCount, long byteCount, long startTimestamp) {
+        var elapsed = Stopwatch.GetElapsedTime(startTimestamp).TotalSeconds;
+        var tags = new TagList {
+            { "operation", operation },
+            { "strategy", strategy },
+            { "engine", engine }
+        };
+        records.Add(recordCount, tags);
+        bytes.Add(byteCount, tags);
+        operationDuration.Record(elapsed, tags);
+        FonEventSource.Log.OperationCompleted(operation, strategy, engine, recordCount, byteCount, elapsed * 1000);
+
+        if (z85Ticks.Value is { } z85) {
+            z85Ticks.Value = null;
+            if (Volatile.Read(ref z85.Value) is > 0 and var ticks) {
+                RecordPhaseTicks("z85", operation, ticks);
+            }
+        }
+    }
+
+
+    internal static void RecordPhase(string phase, string operation, long startTimestamp) {
+        var elapsed = Stopwatch.GetElapsedTime(startTimestamp).TotalSeconds;
+        phaseDuration.Record(elapsed, new KeyValuePair<string, object?>("phase", phase), new KeyValuePair<string, object?>("operation", operation));
+        FonEventSource.Log.PhaseCompleted(phase, operation, elapsed * 1000);
+    }
+
+
+    /// <summary>
+    /// Phase time summed up by the caller, e.g. the awaited writes spread over a pipelined call.
+    /// </summary>
+    internal static void RecordPhaseTicks(string phase, string operation, long stopwatchTicks) {
+        var elapsed = (double)stopwatchTicks / Stopwatch.Frequency;
+        phaseDuration.Record(elapsed, new KeyValuePair<string, object?>("phase", phase), new KeyValuePair<string, object?>("operation", operation));
+        FonEventSource.Log.PhaseCompleted(phase, operation, elapsed * 1000);
+    }
+
+
+    /// <summary>
+    /// Z85 runs once per RawData value, too often to record each run: the ticks add up in the running
+    /// call (see <see cref="StartOperation"/>) until it reports them. Null when no call collects them.
+    /// </summary>
+    internal static StrongBox<long>? Z85Ticks => PhasesEnabled ? z85Ticks.Value : null;
+
+
+    internal static void RecordSelection(string operation, string strategy, string engine, bool adaptive, long size) {
+        selections.Add(1, new TagList {
+            { "operation", operation },
+            { "strategy", strategy },
+            { "engine", engine },
+            { "adaptive", adaptive }
+        });
+        FonEventSource.Log.StrategySelected(operation, strategy, engine, adaptive, size);
+    }
+}
@@ -1,5 +1,7 @@
+using FON.Core;
 using System.Collections.Concurrent;
 using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 
 namespace FON.Types;
 
@@ -9,20 +11,82 @@ namespace FON.Types;
 /// FonCollections (nested objects) or lists of any supported type.
 /// </summary>
 /// <remarks>
+/// Values are kept as <see cref="FonValue"/> slots, so primitives added or read through
+/// <see cref="Add{T}(string, T)"/> and <see cref="Get{T}(string)"/> are never boxed.
+/// The object-typed members (indexer, enumerator) box primitives on access.
+///
+/// By default entries live in parallel key/value arrays in insertion order: lookups
+/// scan linearly for small records and go through a hash index above
+/// <see cref="IndexThreshold"/> keys. Enumeration and serialization follow insertion order.
+/// This storage is not thread-safe; use <see cref="CreateConcurrent"/> when several threads
+/// modify the same collection (enumeration order is then unspecified).
+///
+/// Parsed records with the same keys in the same order share one key array and index
+/// (<see cref="FonShape"/>); the first change that adds or removes a key gives the collection its own copy.
+///
 /// Cycles are the caller's responsibility: placing a FonCollection inside
 /// itself (directly or transitively through nested values or lists) is not
 /// detected. Serialization will recurse until the call stack overflows.
 /// </remarks>
 public class FonCollection : IEnumerable<KeyValuePair<string, object>>, IDisposable {
-    private ConcurrentDictionary<string, object> Collection = new();
+    /// <summary>
+    /// Number of keys above which lookups use a hash index instead of a linear scan.
+    /// </summary>
+    private const int IndexThreshold = 8;
+
+    private string[] keys;
+    private FonValue[] values;
+    private int count;
+    private Dictionary<string, int>? index;
+    // keys (and index) belong to a FonShape and must be copied before they change
+    private bool keysShared;
+
+    // Opt-in thread-safe storage, replaces the arrays when set
+    private readonly ConcurrentDictionary<string, FonValue>? concurrent;
+
+
+    public FonCollection() {
+        keys = [];
+        values = [];
+    }
+
+    public FonCollection(int capacity) {
+        keys = capacity > 0 ? new string[capacity] : [];
+        values = capacity > 0 ? new FonValue[capacity] : [];
+    }
+
+    private FonCollection(ConcurrentDictionary<string, FonValue> concurrent) : this() {
+        this.concurrent = concurrent;
+    }
+
+    private FonCollection(FonShape shape, FonValue[] values) {
+        keys = shape.Keys;
+        index = shape.Index;
+        keysShared = true;
+        this.values = values;
+        count = shape.Keys.Length;
+    }
+
+
+    /// <summary>
+    /// Creates a collection backed by a <see cref="ConcurrentDictionary{TKey, TValue}"/>
+    /// that is safe to modify from several threads at once.
+    /// </summary>
+    public static FonCollection CreateConcurrent() => new(new ConcurrentDictionary<string, FonValue>());
+
+    public bool IsConcurrent => concurrent != null;
+
+    public int Count => concurrent?.Count ?? count;
 
     public object this[string key] {
-        get => Collection[key];
-        set => Collection[key] = value;
+        get => Get(key);
+        set => Set(key, FonValue.FromObject(value));
     }
 
     public void Dispose() {
-        foreach (var value in Collection.Values) {
+        GetEntries(out _, out var entries);
+        foreach (ref readonly var entry in entries) {
+            var value = entry.Reference;
             if (value is IDisposable disposable) {
                 disposable.Dispose();
             } else if (value is System.Collections.IList list) {
@@ -33,49 +97,142 @@ public class FonCollection : IEnumerable<KeyValuePair<string, object>>, IDisposa
                 }
             }
         }
-        Collection.Clear();
+
+        if (concurrent != null) {
+            concurrent.Clear();
+        } else if (keysShared) {
+            keys = [];
+            keysShared = false;
+            Array.Clear(values, 0, count);
+            count = 0;
+            index = null;
+        } else {
+            Array.Clear(keys, 0, count);
+            Array.Clear(values, 0, count);
+            count = 0;
+            index = null;
+        }
     }
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public IEnumerator<KeyValuePair<string, object>> GetEnumerator() => Collection.GetEnumerator();
+    /// <summary>
+    /// Removes every entry but keeps the allocated capacity, so refilling the collection does not grow it again.
+    /// Nested values are dropped, not disposed; <see cref="FonCollectionPool.Return(FonCollection)"/> recycles them too.
+    /// </summary>
+    public void Reset() {
+        if (concurrent != null) {
+            concurrent.Clear();
+            return;
+        }
+
+        if (keysShared) {
+            // The keys belong to a shape other records still use
+            keys = values.Length > 0 ? new string[values.Length] : [];
+            keysShared = false;
+            index = null;
+        } else {
+            Array.Clear(keys, 0, count);
+            index?.Clear();
+        }
+        Array.Clear(values, 0, count);
+        count = 0;
+    }
+
+    public IEnumerator<KeyValuePair<string, object>> GetEnumerator() {
+        if (concurrent != null) {
+            return EnumerateConcurrent(concurrent);
+        }
+        return EnumerateFlat(keys, values, count);
+    }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     System.Collections.IEnumerator System.Collections.IEnumerable.GetEnumerator() => GetEnumerator();
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public void Add(string key, object value) {
-        if (!Collection.TryAdd(key, value)) {
-            throw new InvalidOperationException($"Object with key {key} already exists in the collection");
+    public void Add(string key, object value) => AddValue(key, FonValue.FromObject(value));
+
+    /// <summary>
+    /// Adds a value without boxing it when <typeparamref name="T"/> is a supported primitive.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public void Add<T>(string key, T value) => AddValue(key, FonValue.Create(value));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public bool TryAdd(string key, object value) => TryAddValue(key, FonValue.FromObject(value));
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public bool TryAdd<T>(string key, T value) => TryAddValue(key, FonValue.Create(value));
+
+    public bool Remove(string key) {
+        if (concurrent != null) {
+            return concurrent.Remove(key, out _);
+        }
+
+        var position = IndexOf(key);
+        if (position < 0) {
+            return false;
         }
+
+        UnshareKeys(keys.Length);
+        // Shift the tail down to keep insertion order
+        count--;
+        Array.Copy(keys, position + 1, keys, position, count - position);
+        Array.Copy(values, position + 1, values, position, count - position);
+        keys[count] = null!;
+        values[count] = default;
+        RemoveFromIndex(key, position);
+        return true;
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public bool TryAdd(string key, object value) => Collection.TryAdd(key, value);
+    public object Get(string key) => GetValue(key).ToObject();
 
+    /// <summary>
+    /// Reads a value without boxing it when <typeparamref name="T"/> is a supported primitive.
+    /// Throws <see cref="InvalidCastException"/> if the stored value is of another type.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public bool Remove(string key) => Collection.Remove(key, out _);
+    public T Get<T>(string key) => GetValue(key).Get<T>();
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public object Get(string key) => Collection[key];
+    public object? TryGet(string key) => TryGetValue(key, out var value) ? value.ToObject() : null;
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public T Get<T>(string key) => (T)Collection[key];
+    public T? TryGet<T>(string key) where T : class => TryGetValue(key, out var value) && value.ToObject() is T result ? result : null;
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public object? TryGet(string key) => Collection.TryGetValue(key, out object? value) ? value : null;
+    public T? TryGetNullable<T>(string key) where T : struct => TryGetValue(key, out var value) && value.TryGet(out T result) ? result : null;
 
+    /// <summary>
+    /// Views a primitive array (e.g. an f: or d: value, stored as <see cref="List{T}"/>) without copying it.
+    /// The span is invalid once the list is changed.
+    /// </summary>
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public T? TryGet<T>(string key) where T : class => Collection.TryGetValue(key, out object? value) && value is T ? (T)value : null;
+    public ReadOnlySpan<T> GetSpan<T>(string key) where T : unmanaged => CollectionsMarshal.AsSpan(Get<List<T>>(key));
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public T? TryGetNullable<T>(string key) where T : struct => Collection.TryGetValue(key, out object? value) && value is T ? (T)value : null;
+    /// <summary>
+    /// Adds a primitive array, copied once into an exactly sized <see cref="List{T}"/>.
+    /// </summary>
+    public void AddArray<T>(string key, ReadOnlySpan<T> items) where T : unmanaged {
+        var list = new List<T>(items.Length);
+        CollectionsMarshal.SetCount(list, items.Length);
+        items.CopyTo(CollectionsMarshal.AsSpan(list));
+        AddValue(key, FonValue.FromObject(list));
+    }
 
 
 
 
+    /// <summary>
+    /// Builds a collection from the public properties of <paramref name="obj"/>. Uses the generated
+    /// serializer for <c>[FonSerializable]</c> types, reflection otherwise.
+    /// </summary>
     public static FonCollection Serialize<T>(T obj) {
+        if (FonTypeSerializers.Get<T>() is { } serializer) {
+            return serializer.ToCollection(obj);
+        }
+
         var properties = typeof(T).GetProperties(System.Reflection.BindingFlags.Public | System.Reflection.BindingFlags.Instance);
-        var collection = new FonCollection();
+        var collection = new FonCollection(properties.Length);
 
         foreach (var property in properties) {
             var value = property.GetValue(obj);
@@ -89,14 +246,22 @@ public class FonCollection : IEnumerable<KeyValuePair<string, object>>, IDisposa
 
 
 
+    /// <summary>
+    /// Creates a <typeparamref name="T"/> and fills its public properties from the matching keys.
+    /// Uses the generated serializer for <c>[FonSerializable]</c> types, reflection otherwise.
+    /// </summary>
     public T Deserialize<T>() where T : new() {
+        if (FonTypeSerializers.Get<T>() is { } serializer) {
+            return serializer.FromCollection(this);
+        }
+
         T result = new T();
         object boxedResult = result;
 
         var properties = typeof(T).GetProperties(System.Reflection.BindingFlags.Public | System.Reflection.BindingFlags.Instance);
 
         foreach (var property in properties) {
-            if (Collection.TryGetValue(property.Name, out var value) && value.GetType().IsAssignableFrom(property.PropertyType)) {
+            if (TryGetValue(property.Name, out var entry) && entry.ToObject() is { } value && value.GetType().IsAssignableFrom(property.PropertyType)) {
                 property.SetValue(boxedResult, value);
             }
         }
@@ -104,4 +269,217 @@ public class FonCollection : IEnumerable<KeyValuePair<string, object>>, IDisposa
         return (T)boxedResult;
     }
 
+
+
+
+    /// <summary>
+    /// Adds a typed value slot. Used by the parsers so primitives go in unboxed.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal void AddValue(string key, in FonValue value) {
+        if (!TryAddValue(key, value)) {
+            throw new InvalidOperationException($"Object with key {key} already exists in the collection");
+        }
+    }
+
+    internal bool TryAddValue(string key, in FonValue value) {
+        ArgumentNullException.ThrowIfNull(key);
+
+        if (concurrent != null) {
+            return concurrent.TryAdd(key, value);
+        }
+
+        if (IndexOf(key) >= 0) {
+            return false;
+        }
+        Append(key, value);
+        return true;
+    }
+
+
+
+    /// <summary>
+    /// Collection over <paramref name="values"/> (one per key of <paramref name="shape"/>), sharing the shape's keys.
+    /// </summary>
+    internal static FonCollection FromShape(FonShape shape, FonValue[] values) => new(shape, values);
+
+
+    /// <summary>
+    /// Moves the keys and index of this collection into a new shape that later records can share.
+    /// </summary>
+    internal FonShape ShareKeys() {
+        var shapeKeys = count == keys.Length ? keys : keys.AsSpan(0, count).ToArray();
+        var shape = new FonShape(shapeKeys, index);
+        keys = shapeKeys;
+        keysShared = true;
+        return shape;
+    }
+
+
+
+    /// <summary>
+    /// Entries in enumeration order. Flat storage hands out its arrays without copying;
+    /// concurrent storage falls back to a snapshot.
+    /// </summary>
+    internal void GetEntries(out ReadOnlySpan<string> entryKeys, out ReadOnlySpan<FonValue> entryValues) {
+        if (concurrent != null) {
+            var snapshot = concurrent.ToArray();
+            var snapshotKeys = new string[snapshot.Length];
+            var snapshotValues = new FonValue[snapshot.Length];
+            for (int i = 0; i < snapshot.Length; i++) {
+                (snapshotKeys[i], snapshotValues[i]) = snapshot[i];
+            }
+            entryKeys = snapshotKeys;
+            entryValues = snapshotValues;
+            return;
+        }
+
+        entryKeys = keys.AsSpan(0, count);
+        entryValues = values.AsSpan(0, count);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private FonValue GetValue(string key) => TryGetValue(key, out var value) ? value : throw new KeyNotFoundException($"The given key '{key}' was not present in the collection");
+
+
+
+    internal bool TryGetValue(string key, out FonValue value) {
+        if (concurrent != null) {
+            return concurrent.TryGetValue(key, out value);
+        }
+
+        var position = IndexOf(key);
+        if (position < 0) {
+            value = default;
+            return false;
+        }
+        value = values[position];
+        return true;
+    }
+
+
+
+    private void Set(string key, in FonValue value) {
+        if (concurrent != null) {
+            concurrent[key] = value;
+            return;
+        }
+
+        var position = IndexOf(key);
+        if (position >= 0) {
+            values[position] = value;
+        } else {
+            Append(key, value);
+        }
+    }
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private int IndexOf(string key) {
+        if (index != null) {
+            return index.TryGetValue(key, out var position) ? position : -1;
+        }
+
+        var span = keys.AsSpan(0, count);
+        for (int i = 0; i < span.Length; i++) {
+            if (string.Equals(span[i], key)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+
+
+    private void Append(string key, in FonValue value) {
+        if (count == keys.Length) {
+            var newSize = Math.Max(4, keys.Length * 2);
+            UnshareKeys(newSize);
+            Array.Resize(ref keys, newSize);
+            Array.Resize(ref values, newSize);
+        } else {
+            UnshareKeys(keys.Length);
+        }
+
+        keys[count] = key;
+        values[count] = value;
+        count++;
+
+        if (index != null) {
+            index.Add(key, count - 1);
+        } else if (count > IndexThreshold) {
+            RebuildIndex();
+        }
+    }
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private void UnshareKeys(int capacity) {
+        if (!keysShared) {
+            return;
+        }
+        var own = new string[capacity];
+        keys.AsSpan(0, count).CopyTo(own);
+        keys = own;
+        if (index != null) {
+            index = new Dictionary<string, int>(index, StringComparer.Ordinal);
+        }
+        keysShared = false;
+    }
+
+
+
+    /// <summary>
+    /// Drops <paramref name="key"/> from the index after the keys behind <paramref name="position"/>
+    /// moved down one slot. Only those keys are renumbered; the index is not rebuilt.
+    /// </summary>
+    private void RemoveFromIndex(string key, int position) {
+        if (index == null) {
+            return;
+        }
+        if (count <= IndexThreshold) {
+            index = null;
+            return;
+        }
+
+        index.Remove(key);
+        for (int i = position; i < count; i++) {
+            index[keys[i]] = i;
+        }
+    }
+
+
+
+    private void RebuildIndex() {
+        if (count <= IndexThreshold) {
+            index = null;
+            return;
+        }
+
+        index = new Dictionary<string, int>(count, StringComparer.Ordinal);
+        for (int i = 0; i < count; i++) {
+            index.Add(keys[i], i);
+        }
+    }
+
+
+
+    private static IEnumerator<KeyValuePair<string, object>> EnumerateFlat(string[] keys, FonValue[] values, int count) {
+        for (int i = 0; i < count; i++) {
+            yield return new KeyValuePair<string, object>(keys[i], values[i].ToObject());
+        }
+    }
+
+
+
+    private static IEnumerator<KeyValuePair<string, object>> EnumerateConcurrent(ConcurrentDictionary<string, FonValue> concurrent) {
+        foreach (var (key, value) in concurrent) {
+            yield return new KeyValuePair<string, object>(key, value.ToObject());
+        }
+    }
 }
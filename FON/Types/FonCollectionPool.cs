@@ -0,0 +1,188 @@
+using FON.Core;
+using System.Collections;
+using System.Runtime.CompilerServices;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Recycles <see cref="FonCollection"/>s together with the nested collections and lists they hold, so a loop
+/// that parses, changes and writes one record at a time stops allocating once the pool is warm.
+/// </summary>
+/// <remarks>
+/// <see cref="Return(FonCollection)"/> resets a collection (keeping its capacity) and takes back everything
+/// nested in it; <see cref="Fon.DeserializeInto"/> fills a reused collection and rents the nested ones from
+/// the pool. A returned collection, and every collection or list that was inside it, must no longer be used.
+/// The pool keeps at most <c>capacity</c> collections and as many lists per element type; extra returns are
+/// left to the GC. All members are safe to call concurrently.
+/// </remarks>
+public sealed class FonCollectionPool {
+    public const int DefaultCapacity = 64;
+
+    /// <summary>
+    /// Lists that held more elements than this are dropped instead of keeping their memory alive in the pool.
+    /// </summary>
+    private const int MaxRetainedListCapacity = 64 * 1024;
+
+    // Element type codes that have a pooled list, index i holds lists of listTypes[i]
+    private const string ListTypeCodes = "etiulgfdbsro";
+
+    private static readonly Type[] listTypes = [
+        typeof(List<byte>), typeof(List<short>), typeof(List<int>), typeof(List<uint>), typeof(List<long>), typeof(List<ulong>),
+        typeof(List<float>), typeof(List<double>), typeof(List<bool>), typeof(List<string>), typeof(List<RawData>), typeof(List<FonCollection>)
+    ];
+
+    /// <summary>
+    /// Set by <see cref="Fon.DeserializeInto"/> while it parses, so nested collections and lists come from the pool.
+    /// </summary>
+    [ThreadStatic]
+    internal static FonCollectionPool? Parsing;
+
+    private readonly Slots<FonCollection> collections;
+    private readonly Slots<IList>[] lists;
+
+
+    public FonCollectionPool(int capacity = DefaultCapacity) {
+        ArgumentOutOfRangeException.ThrowIfLessThan(capacity, 1);
+        collections = new Slots<FonCollection>(capacity);
+        lists = new Slots<IList>[ListTypeCodes.Length];
+        for (int i = 0; i < lists.Length; i++) {
+            lists[i] = new Slots<IList>(capacity);
+        }
+    }
+
+
+    /// <summary>
+    /// Process-wide pool.
+    /// </summary>
+    public static FonCollectionPool Shared { get; } = new();
+
+
+
+
+    /// <summary>
+    /// Takes an empty collection from the pool, or creates one when the pool is empty.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public FonCollection Rent() => collections.TryTake() ?? new FonCollection();
+
+
+    /// <summary>
+    /// Resets <paramref name="collection"/> and keeps it, its nested collections and its lists for later rents.
+    /// </summary>
+    public void Return(FonCollection collection) {
+        ArgumentNullException.ThrowIfNull(collection);
+        Recycle(collection);
+        if (!collection.IsConcurrent) {
+            collections.TryPut(collection);
+        }
+    }
+
+
+    /// <summary>
+    /// Returns every record of <paramref name="dump"/> and empties it (see <see cref="FonDump.Reset"/>).
+    /// </summary>
+    public void Return(FonDump dump) {
+        ArgumentNullException.ThrowIfNull(dump);
+        foreach (var (_, record) in dump) {
+            Return(record);
+        }
+        dump.Reset();
+    }
+
+
+
+
+    /// <summary>
+    /// Empties <paramref name="collection"/> and takes back what was nested in it, but not the collection itself.
+    /// </summary>
+    internal void Recycle(FonCollection collection) {
+        collection.GetEntries(out _, out var entries);
+        foreach (ref readonly var entry in entries) {
+            if (entry.IsArray) {
+                ReturnList(entry.TypeCode, entry.Reference as IList);
+            } else if (entry.Reference is FonCollection nested) {
+                Return(nested);
+            }
+        }
+        collection.Reset();
+    }
+
+
+    /// <summary>
+    /// Takes an empty list of <paramref name="typeCode"/> elements, or null when none is pooled.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal IList? RentList(char typeCode) {
+        var slot = ListTypeCodes.IndexOf(typeCode);
+        return slot < 0 ? null : lists[slot].TryTake();
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    internal List<T>? RentList<T>(char typeCode) => RentList(typeCode) as List<T>;
+
+
+    private void ReturnList(char typeCode, IList? list) {
+        var slot = ListTypeCodes.IndexOf(typeCode);
+        // Arrays and other IList implementations a caller added are not ours to reuse
+        if (slot < 0 || list == null || list.GetType() != listTypes[slot]) {
+            return;
+        }
+        if (list is List<FonCollection> children) {
+            foreach (var child in children) {
+                if (child != null) {
+                    Return(child);
+                }
+            }
+        }
+        if (((ICollection)list).Count > MaxRetainedListCapacity) {
+            return;
+        }
+        list.Clear();
+        lists[slot].TryPut(list);
+    }
+
+
+
+
+    /// <summary>
+    /// Fixed set of slots taken and filled with compare-exchange; the first slot is checked before the array.
+    /// </summary>
+    private sealed class Slots<T> where T : class {
+        private readonly T?[] items;
+        private T? first;
+
+
+        public Slots(int capacity) {
+            items = new T?[capacity - 1];
+        }
+
+
+        public T? TryTake() {
+            var item = first;
+            if (item != null && Interlocked.CompareExchange(ref first, null, item) == item) {
+                return item;
+            }
+            for (int i = 0; i < items.Length; i++) {
+                item = items[i];
+                if (item != null && Interlocked.CompareExchange(ref items[i], null, item) == item) {
+                    return item;
+                }
+            }
+            return null;
+        }
+
+
+        public void TryPut(T item) {
+            if (first == null && Interlocked.CompareExchange(ref first, item, null) == null) {
+                return;
+            }
+            for (int i = 0; i < items.Length; i++) {
+                if (Interlocked.CompareExchange(ref items[i], item, null) == null) {
+                    return;
+                }
+            }
+        }
+    }
+}
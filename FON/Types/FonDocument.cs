@@ -0,0 +1,247 @@
+using FON.Core;
+using System.Buffers;
+using System.Runtime.CompilerServices;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Read-only parse of UTF-8 FON text. Instead of a <see cref="FonCollection"/> graph, one pass records
+/// where every key and value sits in a flat tape of offsets and type codes into the original buffer;
+/// values are decoded only when read through a <see cref="FonRecordView"/>.
+/// </summary>
+/// <remarks>
+/// A field costs one 24-byte tape entry, nothing is allocated per record or per value. The tape is
+/// rented from <see cref="ArrayPool{T}"/> and <see cref="Dispose"/> hands it (and the text buffer, for
+/// documents read by <see cref="Fon.ReadDocumentsAsync(Stream, CancellationToken)"/>) back in one go;
+/// views throw <see cref="ObjectDisposedException"/> afterwards. Structure is checked while parsing,
+/// primitive values only when they are read. Reads may run concurrently, but not with Dispose.
+/// </remarks>
+public sealed class FonDocument : IDisposable {
+    private readonly ReadOnlyMemory<byte> text;
+    private readonly ulong firstId;
+    private byte[]? ownedBuffer;
+    private FonTape? tape;
+    private FonDocumentRecord[] records;
+    private readonly int count;
+
+
+    private FonDocument(ReadOnlyMemory<byte> text, byte[]? ownedBuffer, bool skipBom, ulong firstId) {
+        this.text = text;
+        this.ownedBuffer = ownedBuffer;
+        this.firstId = firstId;
+
+        // Roughly one entry per 16 bytes of text, the tape grows if the fields are denser
+        var built = new FonTape(Math.Max(16, text.Length / 16));
+        records = [];
+        try {
+            LineCount = Fon.BuildTape(text.Span, skipBom, built, ref records, out count);
+        } catch {
+            built.Dispose();
+            ReturnRecords();
+            throw;
+        }
+        tape = built;
+    }
+
+
+    /// <summary>
+    /// Parses newline-separated records. The buffer is used in place and must stay unchanged until the
+    /// document is disposed. Records are numbered by line from <paramref name="firstId"/>, empty lines have none.
+    /// </summary>
+    /// <exception cref="FormatException">The text is malformed.</exception>
+    public static FonDocument Parse(ReadOnlyMemory<byte> utf8, ulong firstId = 0) => new(utf8, null, skipBom: true, firstId);
+
+
+    /// <summary>
+    /// Document over a pooled block; takes ownership of <paramref name="buffer"/>, also when parsing fails.
+    /// </summary>
+    internal static FonDocument FromPooledBlock(byte[] buffer, int length, bool skipBom, ulong firstId) {
+        try {
+            return new FonDocument(buffer.AsMemory(0, length), buffer, skipBom, firstId);
+        } catch {
+            ArrayPool<byte>.Shared.Return(buffer);
+            throw;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Number of records (non-empty lines).
+    /// </summary>
+    public int Count => count;
+
+    /// <summary>
+    /// Number of lines, empty ones included: the id span the document covers.
+    /// </summary>
+    public int LineCount { get; }
+
+    public FonRecordView this[int index] {
+        get {
+            var record = GetRecord(index);
+            return new FonRecordView(this, record.TapeStart, record.TapeEnd, record.BodyOffset, record.BodyLength);
+        }
+    }
+
+    /// <summary>
+    /// Line-number id of the record at <paramref name="index"/>, as the dump loaders would assign it.
+    /// </summary>
+    public ulong GetId(int index) => firstId + (ulong)GetRecord(index).Line;
+
+    public Enumerator GetEnumerator() => new(this);
+
+    public void Dispose() {
+        tape?.Dispose();
+        tape = null;
+        ReturnRecords();
+        if (ownedBuffer != null) {
+            ArrayPool<byte>.Shared.Return(ownedBuffer);
+            ownedBuffer = null;
+        }
+    }
+
+
+
+
+    internal ReadOnlySpan<byte> Text {
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        get {
+            ObjectDisposedException.ThrowIf(tape == null, this);
+            return text.Span;
+        }
+    }
+
+    internal ReadOnlySpan<FonTapeEntry> Tape {
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        get => (tape ?? throw new ObjectDisposedException(nameof(FonDocument))).Entries;
+    }
+
+
+    private ref readonly FonDocumentRecord GetRecord(int index) {
+        ObjectDisposedException.ThrowIf(tape == null, this);
+        if ((uint)index >= (uint)count) {
+            throw new ArgumentOutOfRangeException(nameof(index));
+        }
+        return ref records[index];
+    }
+
+
+    private void ReturnRecords() {
+        if (records.Length > 0) {
+            ArrayPool<FonDocumentRecord>.Shared.Return(records);
+        }
+        records = [];
+    }
+
+
+
+
+    /// <summary>
+    /// Yields (id, record) pairs in line order without allocating.
+    /// </summary>
+    public struct Enumerator {
+        private readonly FonDocument document;
+        private int index;
+
+
+        internal Enumerator(FonDocument document) {
+            this.document = document;
+            index = -1;
+        }
+
+
+        public readonly (ulong id, FonRecordView record) Current => (document.GetId(index), document[index]);
+
+        public bool MoveNext() => ++index < document.Count;
+    }
+}
+
+
+
+
+/// <summary>
+/// One key and its value: offsets into the document text. Field entries of a nested object (or the
+/// elements of an object array) follow their parent directly; <see cref="End"/> is the index after the
+/// last of them, so siblings are found by jumping from End to End.
+/// </summary>
+internal struct FonTapeEntry {
+    public int KeyOffset;
+    public int KeyLength;
+    public int ValueOffset;
+    public int ValueLength;
+    public int End;
+    public char TypeCode;
+    public bool IsArray;
+}
+
+
+
+
+/// <summary>
+/// A record of a <see cref="FonDocument"/>: its line, its tape range and the text of its body.
+/// </summary>
+internal readonly record struct FonDocumentRecord(int Line, int TapeStart, int TapeEnd, int BodyOffset, int BodyLength);
+
+
+
+
+/// <summary>
+/// Growable tape in a pooled array, the arena of one document.
+/// </summary>
+internal sealed class FonTape : IDisposable {
+    private FonTapeEntry[] entries;
+    private int count;
+
+
+    public FonTape(int capacity) {
+        entries = ArrayPool<FonTapeEntry>.Shared.Rent(capacity);
+    }
+
+
+    public int Count => count;
+
+    public ReadOnlySpan<FonTapeEntry> Entries => entries.AsSpan(0, count);
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public int Add(int keyOffset, int keyLength, char typeCode, bool isArray, int valueOffset, int valueLength) {
+        if (count == entries.Length) {
+            Grow();
+        }
+        ref var entry = ref entries[count];
+        entry.KeyOffset = keyOffset;
+        entry.KeyLength = keyLength;
+        entry.ValueOffset = valueOffset;
+        entry.ValueLength = valueLength;
+        entry.TypeCode = typeCode;
+        entry.IsArray = isArray;
+        entry.End = count + 1;
+        return count++;
+    }
+
+
+    /// <summary>
+    /// Marks every entry added since <paramref name="index"/> as its children.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public void Close(int index) => entries[index].End = count;
+
+
+    public void Dispose() {
+        if (entries.Length > 0) {
+            ArrayPool<FonTapeEntry>.Shared.Return(entries);
+        }
+        entries = [];
+        count = 0;
+    }
+
+
+    private void Grow() {
+        var grown = ArrayPool<FonTapeEntry>.Shared.Rent(entries.Length * 2);
+        Entries.CopyTo(grown);
+        ArrayPool<FonTapeEntry>.Shared.Return(entries);
+        entries = grown;
+    }
+}
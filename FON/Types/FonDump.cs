@@ -4,51 +4,394 @@ using System.Runtime.CompilerServices;
 namespace FON.Types;
 
 
+/// <summary>
+/// Records of a FON file keyed by line number.
+/// </summary>
+/// <remarks>
+/// Records live in a dense slot array indexed by line number, which keeps them in line
+/// order and costs one reference per record. Serializers walk it without sorting.
+/// The dump switches to a <see cref="ConcurrentDictionary{TKey, TValue}"/> once ids become
+/// too sparse for the slot array or when <see cref="FonObjects"/> is accessed.
+/// All members are safe to call concurrently.
+/// </remarks>
 public class FonDump : IEnumerable<KeyValuePair<ulong, FonCollection>>, IDisposable {
-    public ConcurrentDictionary<ulong, FonCollection> FonObjects { get; private set; }
+    /// <summary>
+    /// Largest run of empty slots an add may open before the dump switches to dictionary storage.
+    /// </summary>
+    private const int MaxDenseGap = 1 << 20;
+
+    private readonly object sync = new();
+
+    // Dense storage: slot index == id, null == no record
+    private FonCollection?[] slots;
+    private int slotCount;
+    private int count;
+
+    // Dictionary storage, set once the dump leaves dense mode
+    private volatile ConcurrentDictionary<ulong, FonCollection>? fonObjects;
+
 
     public FonDump() {
-        FonObjects = new(Environment.ProcessorCount, 1024);
+        slots = [];
     }
 
     public FonDump(int capacity) {
-        FonObjects = new(Environment.ProcessorCount, capacity);
+        slots = capacity > 0 ? new FonCollection?[capacity] : [];
+    }
+
+    /// <summary>
+    /// Takes ownership of records parsed in line order (null entries are empty lines).
+    /// </summary>
+    internal FonDump(FonCollection?[] records) {
+        slots = records;
+        slotCount = records.Length;
+        foreach (var record in records) {
+            if (record != null) {
+                count++;
+            }
+        }
     }
 
+
+    /// <summary>
+    /// Dictionary view of the records. Accessing it moves the dump to dictionary storage
+    /// for good, so prefer the dump's own members on hot paths.
+    /// </summary>
+    public ConcurrentDictionary<ulong, FonCollection> FonObjects => fonObjects ?? SwitchToDictionary();
+
     public FonCollection this[ulong index] {
-        get => FonObjects[index];
-        set => FonObjects[index] = value;
+        get => TryGetValue(index, out var value) ? value : throw new KeyNotFoundException($"The given id '{index}' was not present in the FON dump");
+        set => Set(index, value, overwrite: true);
     }
 
-    public int Count => FonObjects.Count;
+    public int Count => fonObjects is { } dictionary ? dictionary.Count : Volatile.Read(ref count);
 
     public void Dispose() {
-        Parallel.ForEach(FonObjects.Values, disposable => disposable.Dispose());
-        FonObjects.Clear();
+        lock (sync) {
+            if (fonObjects is { } dictionary) {
+                Parallel.ForEach(dictionary.Values, disposable => disposable.Dispose());
+                dictionary.Clear();
+            } else {
+                var records = slots;
+                Parallel.For(0, slotCount, i => records[i]?.Dispose());
+                slots = [];
+                slotCount = 0;
+                count = 0;
+            }
+        }
     }
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public IEnumerator<KeyValuePair<ulong, FonCollection>> GetEnumerator() => FonObjects.GetEnumerator();
+    /// <summary>
+    /// Removes every record without disposing it and keeps the slot array for the next batch of the same size.
+    /// </summary>
+    public void Reset() {
+        lock (sync) {
+            if (fonObjects is { } dictionary) {
+                dictionary.Clear();
+            } else {
+                Array.Clear(slots, 0, slotCount);
+                slotCount = 0;
+                count = 0;
+            }
+        }
+    }
+
+    public IEnumerator<KeyValuePair<ulong, FonCollection>> GetEnumerator() {
+        if (fonObjects is { } dictionary) {
+            return dictionary.GetEnumerator();
+        }
+        var records = slots;
+        return EnumerateDense(records, Math.Min(records.Length, Volatile.Read(ref slotCount)));
+    }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     System.Collections.IEnumerator System.Collections.IEnumerable.GetEnumerator() => GetEnumerator();
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
     public void Add(ulong id, FonCollection value) {
-        if (!FonObjects.TryAdd(id, value)) {
+        if (!TryAdd(id, value)) {
             throw new InvalidOperationException($"FonCollection with id {id} already exists in the FON dump");
         }
     }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public bool TryAdd(ulong id, FonCollection value) => FonObjects.TryAdd(id, value);
+    public bool TryAdd(ulong id, FonCollection value) => Set(id, value, overwrite: false);
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public bool Remove(ulong id) => FonObjects.Remove(id, out _);
+    public bool Remove(ulong id) {
+        if (fonObjects is { } dictionary) {
+            return dictionary.Remove(id, out _);
+        }
+
+        lock (sync) {
+            if (fonObjects is { } switched) {
+                return switched.Remove(id, out _);
+            }
+            if (id >= (ulong)slotCount || slots[id] == null) {
+                return false;
+            }
+            slots[id] = null;
+            count--;
+            return true;
+        }
+    }
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public FonCollection Get(ulong id) => FonObjects[id];
+    public FonCollection Get(ulong id) => this[id];
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public FonCollection? TryGet(ulong id) => FonObjects.TryGetValue(id, out FonCollection? value) ? value : null;
+    public FonCollection? TryGet(ulong id) => TryGetValue(id, out var value) ? value : null;
+
+
+
+
+    /// <summary>
+    /// Records in id order with null for missing ids. Dense dumps hand out their slot
+    /// array without copying; dictionary dumps fall back to a sorted snapshot.
+    /// </summary>
+    internal ArraySegment<FonCollection?> GetOrderedRecords() {
+        if (fonObjects is { } dictionary) {
+            return dictionary.OrderBy(x => x.Key).Select(x => (FonCollection?)x.Value).ToArray();
+        }
+
+        lock (sync) {
+            if (fonObjects is { } switched) {
+                return switched.OrderBy(x => x.Key).Select(x => (FonCollection?)x.Value).ToArray();
+            }
+            return new ArraySegment<FonCollection?>(slots, 0, slotCount);
+        }
+    }
+
+
+
+    /// <summary>
+    /// Bulk insert of consecutive records starting at <paramref name="startId"/> (null entries are skipped).
+    /// Used by the chunked deserializer so every chunk takes the lock once.
+    /// </summary>
+    internal void AddRange(ulong startId, ReadOnlySpan<FonCollection?> records) {
+        lock (sync) {
+            if (fonObjects == null && IsDenseRange(startId, records.Length)) {
+                EnsureSlots((int)startId + records.Length);
+                for (int i = 0; i < records.Length; i++) {
+                    if (records[i] != null && slots[(int)startId + i] == null) {
+                        slots[(int)startId + i] = records[i];
+                        count++;
+                    }
+                }
+                slotCount = Math.Max(slotCount, (int)startId + records.Length);
+                return;
+            }
+        }
+
+        for (int i = 0; i < records.Length; i++) {
+            if (records[i] != null) {
+                TryAdd(startId + (ulong)i, records[i]!);
+            }
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Encoded bytes a work item of <see cref="UnpackRawParallel"/> aims for, so small blobs are
+    /// decoded many per task instead of paying scheduling per value.
+    /// </summary>
+    private const int UnpackBatchBytes = 1 << 20;
+
+
+    /// <summary>
+    /// Decodes every still-packed RawData in the dump (nested objects and arrays included) across
+    /// cores, in batches of about 1 MB of Z85 text. Pairs with <see cref="Core.RawUnpackMode.None"/>
+    /// or <see cref="Core.RawUnpackMode.Lazy"/> loading, to decode after the parse instead of on
+    /// the parse threads. Returns the number of values decoded.
+    /// </summary>
+    public int UnpackRawParallel(int? maxDegreeOfParallelism = null) {
+        // A RawData instance may be shared between records, decode it once
+        var seen = new HashSet<RawData>(ReferenceEqualityComparer.Instance);
+        var pending = new List<RawData>();
+        foreach (var (_, record) in this) {
+            CollectPackedRaw(record, seen, pending);
+        }
+        if (pending.Count == 0) {
+            return 0;
+        }
+
+        var batches = new List<(int start, int end)>();
+        int batchStart = 0;
+        long batchBytes = 0;
+        for (int i = 0; i < pending.Count; i++) {
+            batchBytes += pending[i].GetEncodedLength();
+            if (batchBytes >= UnpackBatchBytes) {
+                batches.Add((batchStart, i + 1));
+                batchStart = i + 1;
+                batchBytes = 0;
+            }
+        }
+        if (batchStart < pending.Count) {
+            batches.Add((batchStart, pending.Count));
+        }
+
+        var options = new ParallelOptions { MaxDegreeOfParallelism = maxDegreeOfParallelism ?? Environment.ProcessorCount };
+        Parallel.ForEach(batches, options, batch => {
+            for (int i = batch.start; i < batch.end; i++) {
+                pending[i].Unpack();
+            }
+        });
+        return pending.Count;
+    }
+
+
+
+    private static void CollectPackedRaw(FonCollection collection, HashSet<RawData> seen, List<RawData> pending) {
+        collection.GetEntries(out _, out var values);
+        foreach (ref readonly var value in values) {
+            switch (value.TypeCode) {
+                case 'r' when value.IsArray:
+                    foreach (var raw in (System.Collections.IEnumerable)value.Reference!) {
+                        AddPackedRaw(raw as RawData, seen, pending);
+                    }
+                    break;
+                case 'r':
+                    AddPackedRaw((RawData)value.Reference!, seen, pending);
+                    break;
+                case 'o' when value.IsArray:
+                    foreach (var nested in (System.Collections.IEnumerable)value.Reference!) {
+                        if (nested is FonCollection nestedCollection) {
+                            CollectPackedRaw(nestedCollection, seen, pending);
+                        }
+                    }
+                    break;
+                case 'o':
+                    CollectPackedRaw((FonCollection)value.Reference!, seen, pending);
+                    break;
+            }
+        }
+    }
+
+
+    private static void AddPackedRaw(RawData? raw, HashSet<RawData> seen, List<RawData> pending) {
+        if (raw != null && raw.IsPacked && seen.Add(raw)) {
+            pending.Add(raw);
+        }
+    }
+
+
+
+
+    private bool TryGetValue(ulong id, out FonCollection value) {
+        var dictionary = fonObjects;
+        if (dictionary == null) {
+            var records = slots;
+            if (id < (ulong)Math.Min(records.Length, Volatile.Read(ref slotCount)) && records[id] is { } record) {
+                value = record;
+                return true;
+            }
+
+            // The dump may have switched to dictionary storage meanwhile
+            dictionary = fonObjects;
+            if (dictionary == null) {
+                value = null!;
+                return false;
+            }
+        }
+
+        return dictionary.TryGetValue(id, out value!);
+    }
+
+
+
+    private bool Set(ulong id, FonCollection value, bool overwrite) {
+        ArgumentNullException.ThrowIfNull(value);
+
+        if (fonObjects is { } dictionary) {
+            return SetInDictionary(dictionary, id, value, overwrite);
+        }
+
+        lock (sync) {
+            if (fonObjects == null && IsDenseRange(id, 1)) {
+                var index = (int)id;
+                if (index >= slotCount) {
+                    EnsureSlots(index + 1);
+                    slotCount = index + 1;
+                }
+
+                if (slots[index] == null) {
+                    count++;
+                } else if (!overwrite) {
+                    return false;
+                }
+
+                slots[index] = value;
+                return true;
+            }
+        }
+
+        return SetInDictionary(fonObjects ?? SwitchToDictionary(), id, value, overwrite);
+    }
+
+
+
+    private static bool SetInDictionary(ConcurrentDictionary<ulong, FonCollection> dictionary, ulong id, FonCollection value, bool overwrite) {
+        if (overwrite) {
+            dictionary[id] = value;
+            return true;
+        }
+        return dictionary.TryAdd(id, value);
+    }
+
+
+
+    /// <summary>
+    /// True if the slot array can grow to cover the ids without opening a huge gap. Caller holds the lock.
+    /// </summary>
+    private bool IsDenseRange(ulong startId, int length) {
+        if (startId >= (ulong)Array.MaxLength) {
+            return false;
+        }
+        var end = startId + (ulong)length;
+        return end <= (ulong)Array.MaxLength && end <= (ulong)slotCount + MaxDenseGap;
+    }
+
+
+
+    private void EnsureSlots(int required) {
+        if (required <= slots.Length) {
+            return;
+        }
+        var newSize = (int)Math.Min(Array.MaxLength, Math.Max(required, Math.Max(1024L, slots.Length * 2L)));
+        Array.Resize(ref slots, newSize);
+    }
+
+
+
+    private ConcurrentDictionary<ulong, FonCollection> SwitchToDictionary() {
+        lock (sync) {
+            if (fonObjects is { } existing) {
+                return existing;
+            }
+
+            var dictionary = new ConcurrentDictionary<ulong, FonCollection>(Environment.ProcessorCount, Math.Max(count, 1024));
+            for (int i = 0; i < slotCount; i++) {
+                if (slots[i] is { } record) {
+                    dictionary.TryAdd((ulong)i, record);
+                }
+            }
+
+            fonObjects = dictionary;
+            slots = [];
+            slotCount = 0;
+            count = 0;
+            return dictionary;
+        }
+    }
+
+
+
+    private static IEnumerator<KeyValuePair<ulong, FonCollection>> EnumerateDense(FonCollection?[] records, int length) {
+        for (int i = 0; i < length; i++) {
+            if (records[i] is { } record) {
+                yield return new KeyValuePair<ulong, FonCollection>((ulong)i, record);
+            }
+        }
+    }
 }
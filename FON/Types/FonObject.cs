@@ -1,3 +1,4 @@
+using System.Buffers;
 using System.Runtime.CompilerServices;
 
 namespace FON.Types;
@@ -7,8 +8,8 @@ public readonly ref struct FonObject {
     public readonly string Key;
     public readonly object Value;
 
-    // For super fast verification
-    private static readonly SortedSet<char> KeyNameWhiteList = [.. "qwertyuioplkjhgfdsazxcvbnmQWERTYUIOPLKJHGFDSAZXCVBNM1234567890-_"];
+    // Vectorized lookup: a whole key is checked with one IndexOfAnyExcept
+    private static readonly SearchValues<char> KeyNameWhiteList = SearchValues.Create("qwertyuioplkjhgfdsazxcvbnmQWERTYUIOPLKJHGFDSAZXCVBNM1234567890-_");
 
 
 
@@ -36,12 +37,5 @@ public readonly ref struct FonObject {
 
 
     [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    public static bool CheckKeyName(string key) {
-        foreach (var symbol in key) {
-            if (!KeyNameWhiteList.Contains(symbol)) {
-                return false;
-            }
-        }
-        return true;
-    }
+    public static bool CheckKeyName(string key) => key.AsSpan().IndexOfAnyExcept(KeyNameWhiteList) < 0;
 }
@@ -0,0 +1,312 @@
+using FON.Core;
+using System.Runtime.CompilerServices;
+using System.Text;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Read-only view of one record (or nested object) of a <see cref="FonDocument"/>. Lookups scan the
+/// record's tape entries and decode the value only when asked for it. A view is a few fields pointing
+/// into the document, valid until the document is disposed.
+/// </summary>
+public readonly struct FonRecordView {
+    private readonly FonDocument document;
+    private readonly int start;
+    private readonly int end;
+    private readonly int bodyOffset;
+    private readonly int bodyLength;
+
+
+    internal FonRecordView(FonDocument document, int start, int end, int bodyOffset, int bodyLength) {
+        this.document = document;
+        this.start = start;
+        this.end = end;
+        this.bodyOffset = bodyOffset;
+        this.bodyLength = bodyLength;
+    }
+
+
+    /// <summary>
+    /// Number of keys (nested keys not included).
+    /// </summary>
+    public int Count {
+        get {
+            var tape = document.Tape;
+            int fields = 0;
+            for (int i = start; i < end; i = tape[i].End) {
+                fields++;
+            }
+            return fields;
+        }
+    }
+
+    /// <summary>
+    /// The record text as written, without the surrounding braces of a nested object.
+    /// </summary>
+    public ReadOnlySpan<byte> Raw => document.Text.Slice(bodyOffset, bodyLength);
+
+    public bool ContainsKey(string key) => IndexOf(key) >= 0;
+
+    public FieldEnumerator GetEnumerator() => new(document, start, end);
+
+
+
+
+    public bool TryGetField(string key, out FonFieldView field) {
+        var index = IndexOf(key);
+        field = index < 0 ? default : new FonFieldView(document, index);
+        return index >= 0;
+    }
+
+
+    /// <summary>
+    /// Looks the key up by its UTF-8 bytes, e.g. a <c>"price"u8</c> literal, skipping the key comparison against a string.
+    /// </summary>
+    public bool TryGetField(ReadOnlySpan<byte> utf8Key, out FonFieldView field) {
+        var tape = document.Tape;
+        var text = document.Text;
+        for (int i = start; i < end; i = tape[i].End) {
+            if (text.Slice(tape[i].KeyOffset, tape[i].KeyLength).SequenceEqual(utf8Key)) {
+                field = new FonFieldView(document, i);
+                return true;
+            }
+        }
+        field = default;
+        return false;
+    }
+
+
+    public FonFieldView GetField(string key) {
+        return TryGetField(key, out var field) ? field : throw new KeyNotFoundException($"The given key '{key}' was not present in the record");
+    }
+
+
+
+
+    /// <summary>
+    /// Decodes a value like <see cref="FonCollection.Get{T}(string)"/>; primitives are parsed straight from the text.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public T Get<T>(string key) => GetField(key).Get<T>();
+
+    /// <summary>
+    /// The value text as written: digits, a quoted string, or a whole array or object in brackets.
+    /// </summary>
+    public ReadOnlySpan<byte> GetRaw(string key) => GetField(key).Raw;
+
+    public FonRecordView GetObject(string key) => GetField(key).AsObject();
+
+    public FonArrayView GetObjects(string key) => GetField(key).AsObjects();
+
+
+    /// <summary>
+    /// Materializes the record as a mutable <see cref="FonCollection"/>.
+    /// </summary>
+    public FonCollection ToCollection() => Fon.DeserializeLineOptimized(Raw);
+
+
+
+
+    private int IndexOf(string key) {
+        ArgumentNullException.ThrowIfNull(key);
+        var tape = document.Tape;
+        var text = document.Text;
+        for (int i = start; i < end; i = tape[i].End) {
+            if (KeyEquals(text.Slice(tape[i].KeyOffset, tape[i].KeyLength), key)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static bool KeyEquals(ReadOnlySpan<byte> utf8, string key) {
+        if (Ascii.Equals(utf8, key)) {
+            return true;
+        }
+        // Ascii.Equals rejects any non-ASCII input, those keys take the decoding path
+        return !Ascii.IsValid(utf8) && Encoding.UTF8.GetString(utf8) == key;
+    }
+
+
+
+
+    public struct FieldEnumerator {
+        private readonly FonDocument document;
+        private readonly int end;
+        private int next;
+        private int current;
+
+
+        internal FieldEnumerator(FonDocument document, int start, int end) {
+            this.document = document;
+            this.end = end;
+            next = start;
+            current = -1;
+        }
+
+
+        public readonly FonFieldView Current => new(document, current);
+
+        public bool MoveNext() {
+            if (next >= end) {
+                return false;
+            }
+            current = next;
+            next = document.Tape[current].End;
+            return true;
+        }
+    }
+}
+
+
+
+
+/// <summary>
+/// One key of a <see cref="FonRecordView"/> and its still encoded value.
+/// </summary>
+public readonly struct FonFieldView {
+    private readonly FonDocument document;
+    private readonly int index;
+
+
+    internal FonFieldView(FonDocument document, int index) {
+        this.document = document;
+        this.index = index;
+    }
+
+
+    private ref readonly FonTapeEntry Entry => ref document.Tape[index];
+
+    public ReadOnlySpan<byte> KeyUtf8 => document.Text.Slice(Entry.KeyOffset, Entry.KeyLength);
+
+    /// <summary>
+    /// The key as a string, interned like the keys of parsed collections.
+    /// </summary>
+    public string Key => FonKeyCache.Get(KeyUtf8);
+
+    /// <summary>
+    /// FON type code of the value (of its elements for an array).
+    /// </summary>
+    public char TypeCode => Entry.TypeCode;
+
+    public bool IsArray => Entry.IsArray;
+
+    /// <summary>
+    /// The value text as written: digits, a quoted string, or a whole array or object in brackets.
+    /// </summary>
+    public ReadOnlySpan<byte> Raw => document.Text.Slice(Entry.ValueOffset, Entry.ValueLength);
+
+
+    /// <summary>
+    /// Decodes the value like <see cref="FonCollection.Get{T}(string)"/>: primitives without boxing,
+    /// strings, RawData, lists and objects as newly created instances.
+    /// Throws <see cref="InvalidCastException"/> if the value is of another type.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public T Get<T>() {
+        ref readonly var entry = ref Entry;
+        return Fon.DecodeTapeValue(document.Text.Slice(entry.ValueOffset, entry.ValueLength), entry.TypeCode, entry.IsArray).Get<T>();
+    }
+
+
+    public FonRecordView AsObject() {
+        ref readonly var entry = ref Entry;
+        if (entry.TypeCode != 'o' || entry.IsArray) {
+            throw new InvalidCastException($"Value of key '{Key}' is not an object");
+        }
+        // Body without the braces
+        return new FonRecordView(document, index + 1, entry.End, entry.ValueOffset + 1, entry.ValueLength - 2);
+    }
+
+
+    public FonArrayView AsObjects() {
+        ref readonly var entry = ref Entry;
+        if (entry.TypeCode != 'o' || !entry.IsArray) {
+            throw new InvalidCastException($"Value of key '{Key}' is not an array of objects");
+        }
+        return new FonArrayView(document, index + 1, entry.End);
+    }
+}
+
+
+
+
+/// <summary>
+/// The objects of an o:[...] value. Elements are found by walking the tape, so prefer enumerating
+/// over indexing when reading all of them.
+/// </summary>
+public readonly struct FonArrayView {
+    private readonly FonDocument document;
+    private readonly int start;
+    private readonly int end;
+
+
+    internal FonArrayView(FonDocument document, int start, int end) {
+        this.document = document;
+        this.start = start;
+        this.end = end;
+    }
+
+
+    public int Count {
+        get {
+            var tape = document.Tape;
+            int elements = 0;
+            for (int i = start; i < end; i = tape[i].End) {
+                elements++;
+            }
+            return elements;
+        }
+    }
+
+    public FonRecordView this[int index] {
+        get {
+            var tape = document.Tape;
+            for (int i = start; i < end; i = tape[i].End) {
+                if (index-- == 0) {
+                    return Element(i);
+                }
+            }
+            throw new ArgumentOutOfRangeException(nameof(index));
+        }
+    }
+
+    public Enumerator GetEnumerator() => new(this);
+
+
+    private FonRecordView Element(int i) {
+        ref readonly var element = ref document.Tape[i];
+        return new FonRecordView(document, i + 1, element.End, element.ValueOffset + 1, element.ValueLength - 2);
+    }
+
+
+
+
+    public struct Enumerator {
+        private readonly FonArrayView array;
+        private int next;
+        private int current;
+
+
+        internal Enumerator(FonArrayView array) {
+            this.array = array;
+            next = array.start;
+            current = -1;
+        }
+
+
+        public readonly FonRecordView Current => array.Element(current);
+
+        public bool MoveNext() {
+            if (next >= array.end) {
+                return false;
+            }
+            current = next;
+            next = array.document.Tape[current].End;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,115 @@
+using System.Runtime.CompilerServices;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Key sequence shared by every parsed collection with the same keys in the same order, together
+/// with its lookup index. A repeated schema then costs one key array (and one index) instead of one
+/// per record. Shapes are immutable; a collection copies the keys when it is changed (see
+/// <see cref="FonCollection"/>).
+/// </summary>
+internal sealed class FonShape {
+    // Nesting levels that keep their own recent shape; deeper objects share the last slot
+    private const int TrackedDepths = 8;
+
+    [ThreadStatic]
+    private static FonShape?[]? recent;
+
+    public readonly string[] Keys;
+    public readonly Dictionary<string, int>? Index;
+
+
+    public FonShape(string[] keys, Dictionary<string, int>? index) {
+        Keys = keys;
+        Index = index;
+    }
+
+
+    /// <summary>
+    /// Shape of the last collection this thread parsed at <paramref name="depth"/>: the best guess
+    /// for the next one, since neighbouring records usually follow the same schema.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static FonShape? Recent(int depth) => recent?[Math.Min(depth, TrackedDepths - 1)];
+
+
+    public static void Remember(int depth, FonShape shape) {
+        (recent ??= new FonShape?[TrackedDepths])[Math.Min(depth, TrackedDepths - 1)] = shape;
+    }
+}
+
+
+
+
+/// <summary>
+/// Collects the entries of one parsed collection. While keys follow the recent shape of the same depth
+/// only values are stored, and the result shares that shape; on the first different key it falls back
+/// to a plain collection, which then becomes the recent shape for the records after it.
+/// </summary>
+internal struct FonCollectionBuilder {
+    private readonly int depth;
+    private readonly bool shareShapes;
+    private FonShape? shape;
+    private FonValue[]? values;
+    private int count;
+    private FonCollection? collection;
+
+
+    /// <summary>
+    /// Fills <paramref name="target"/> when given. While a <see cref="FonCollectionPool"/> is parsing, the
+    /// collection is rented from it instead; both keep their own keys, so neither shares a shape.
+    /// </summary>
+    public FonCollectionBuilder(int depth, bool shareShapes, FonCollection? target = null) {
+        this.depth = depth;
+        collection = target ?? FonCollectionPool.Parsing?.Rent();
+        this.shareShapes = shareShapes && collection == null;
+        shape = this.shareShapes ? FonShape.Recent(depth) : null;
+        values = null;
+        count = 0;
+        if (collection == null && !this.shareShapes) {
+            collection = new FonCollection();
+        }
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public void Add(string key, in FonValue value) {
+        if (collection == null) {
+            if (shape != null && count < shape.Keys.Length && string.Equals(shape.Keys[count], key)) {
+                (values ??= new FonValue[shape.Keys.Length])[count++] = value;
+                return;
+            }
+            Diverge();
+        }
+        collection!.AddValue(key, value);
+    }
+
+
+    public FonCollection Build() {
+        if (collection == null) {
+            if (shape != null && count == shape.Keys.Length && count > 0) {
+                return FonCollection.FromShape(shape, values!);
+            }
+            // Ended early: a prefix of the shape is a shape of its own
+            Diverge();
+        }
+
+        if (shareShapes && shape == null && collection!.Count > 1) {
+            FonShape.Remember(depth, collection.ShareKeys());
+        }
+        return collection!;
+    }
+
+
+    private void Diverge() {
+        var result = new FonCollection(Math.Max(count * 2, 4));
+        for (int i = 0; i < count; i++) {
+            result.AddValue(shape!.Keys[i], values![i]);
+        }
+        collection = result;
+        // Only a collection built without a matching shape sets the next one
+        shape = null;
+        values = null;
+    }
+}
@@ -0,0 +1,210 @@
+using FON.Core;
+using System.Collections;
+using System.Runtime.CompilerServices;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Tagged value slot stored by <see cref="FonCollection"/>.
+/// Primitives (e, t, i, u, l, g, f, d, b) live inline in an 8-byte payload, so reading
+/// and writing them through the generic accessors never boxes. Everything else
+/// (strings, RawData, nested collections, lists) is kept as a reference.
+/// </summary>
+internal readonly struct FonValue {
+    private readonly ulong bits;
+    private readonly object? reference;
+
+    /// <summary>
+    /// Type code from <see cref="Fon.SupportTypes"/> (element type code for lists),
+    /// or '\0' for values FON cannot serialize.
+    /// </summary>
+    public readonly char TypeCode;
+
+    /// <summary>
+    /// True if the value is a list of <see cref="TypeCode"/> elements.
+    /// </summary>
+    public readonly bool IsArray;
+
+
+    private FonValue(char typeCode, ulong bits) {
+        TypeCode = typeCode;
+        this.bits = bits;
+        reference = null;
+        IsArray = false;
+    }
+
+    private FonValue(char typeCode, object? reference, bool isArray) {
+        TypeCode = typeCode;
+        this.reference = reference;
+        IsArray = isArray;
+        bits = 0;
+    }
+
+
+    public object? Reference => reference;
+
+    public byte Byte => (byte)bits;
+    public short Int16 => (short)bits;
+    public int Int32 => (int)bits;
+    public uint UInt32 => (uint)bits;
+    public long Int64 => (long)bits;
+    public ulong UInt64 => bits;
+    public float Single => BitConverter.Int32BitsToSingle((int)bits);
+    public double Double => BitConverter.Int64BitsToDouble((long)bits);
+    public bool Boolean => bits != 0;
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static FonValue Create<T>(T value) {
+        // typeof(T) checks are folded by the JIT and (X)(object)value does not box for value types
+        if (typeof(T) == typeof(byte)) return new('e', (byte)(object)value!);
+        if (typeof(T) == typeof(short)) return new('t', (ulong)(short)(object)value!);
+        if (typeof(T) == typeof(int)) return new('i', (ulong)(int)(object)value!);
+        if (typeof(T) == typeof(uint)) return new('u', (uint)(object)value!);
+        if (typeof(T) == typeof(long)) return new('l', (ulong)(long)(object)value!);
+        if (typeof(T) == typeof(ulong)) return new('g', (ulong)(object)value!);
+        if (typeof(T) == typeof(float)) return new('f', (uint)BitConverter.SingleToInt32Bits((float)(object)value!));
+        if (typeof(T) == typeof(double)) return new('d', (ulong)BitConverter.DoubleToInt64Bits((double)(object)value!));
+        if (typeof(T) == typeof(bool)) return new('b', (bool)(object)value! ? 1UL : 0UL);
+        return FromObject(value);
+    }
+
+
+
+    public static FonValue FromObject(object? value) {
+        return value switch {
+            byte e => Create(e),
+            short t => Create(t),
+            int i => Create(i),
+            uint u => Create(u),
+            long l => Create(l),
+            ulong g => Create(g),
+            float f => Create(f),
+            double d => Create(d),
+            bool b => Create(b),
+            string s => new('s', s, false),
+            RawData r => new('r', r, false),
+            FonCollection o => new('o', o, false),
+            IList list => new(GetListTypeCode(list), list, true),
+            _ => new('\0', value, false)
+        };
+    }
+
+
+
+    /// <summary>
+    /// Wraps a string, RawData or FonCollection whose type code is already known (used by the parsers).
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static FonValue FromReference(char typeCode, object value) => new(typeCode, value, false);
+
+
+
+    /// <summary>
+    /// Wraps a list whose element type code is already known (used by the parsers).
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public static FonValue FromList(IList list, char elementTypeCode) => new(elementTypeCode, list, true);
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public bool TryGet<T>(out T value) {
+        if (typeof(T) == typeof(byte)) return Inline('e', (byte)bits, out value);
+        if (typeof(T) == typeof(short)) return Inline('t', (short)bits, out value);
+        if (typeof(T) == typeof(int)) return Inline('i', (int)bits, out value);
+        if (typeof(T) == typeof(uint)) return Inline('u', (uint)bits, out value);
+        if (typeof(T) == typeof(long)) return Inline('l', (long)bits, out value);
+        if (typeof(T) == typeof(ulong)) return Inline('g', bits, out value);
+        if (typeof(T) == typeof(float)) return Inline('f', Single, out value);
+        if (typeof(T) == typeof(double)) return Inline('d', Double, out value);
+        if (typeof(T) == typeof(bool)) return Inline('b', bits != 0, out value);
+
+        if (ToObject() is T result) {
+            value = result;
+            return true;
+        }
+        value = default!;
+        return false;
+    }
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    public T Get<T>() {
+        if (TryGet(out T value)) {
+            return value;
+        }
+        throw new InvalidCastException($"Unable to cast value of type '{ToObject()?.GetType().FullName ?? "null"}' to type '{typeof(T).FullName}'");
+    }
+
+
+
+    /// <summary>
+    /// Widens an inline numeric value (e, t, i, u, l, g, f, d) to double; false for anything else and for NaN.
+    /// </summary>
+    public bool TryGetNumber(out double value) {
+        value = IsArray ? double.NaN : TypeCode switch {
+            'e' => Byte,
+            't' => Int16,
+            'i' => Int32,
+            'u' => UInt32,
+            'l' => Int64,
+            'g' => UInt64,
+            'f' => Single,
+            'd' => Double,
+            _ => double.NaN
+        };
+        return !double.IsNaN(value);
+    }
+
+
+
+    /// <summary>
+    /// Returns the value as an object. Boxes inline primitives.
+    /// </summary>
+    public object ToObject() {
+        if (reference != null || IsArray) {
+            return reference!;
+        }
+
+        return TypeCode switch {
+            'e' => Byte,
+            't' => Int16,
+            'i' => Int32,
+            'u' => UInt32,
+            'l' => Int64,
+            'g' => UInt64,
+            'f' => Single,
+            'd' => Double,
+            'b' => Boolean,
+            _ => null!
+        };
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private bool Inline<TStored, T>(char expected, TStored stored, out T value) {
+        if (TypeCode == expected && !IsArray) {
+            value = (T)(object)stored!;
+            return true;
+        }
+        value = default!;
+        return false;
+    }
+
+
+
+    private static char GetListTypeCode(IList list) {
+        var arguments = list.GetType().GenericTypeArguments;
+        if (arguments.Length == 1 && Fon.SupportTypes.TryGetValue(arguments[0], out var code)) {
+            return code;
+        }
+        return '\0';
+    }
+}
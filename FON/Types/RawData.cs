@@ -1,42 +1,64 @@
 using System.Buffers;
-using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 using System.Text;
 
 namespace FON.Types;
 
 
+/// <summary>
+/// Binary value, held decoded (<see cref="data"/> / <see cref="Memory"/>) or as Z85 text (<see cref="encoded"/>).
+///
+/// Both forms are memory-backed: decoded bytes can live in a caller's array, a slice of a larger
+/// buffer or pooled memory (<see cref="IMemoryOwner{T}"/>, returned on <see cref="Dispose"/>), and
+/// Z85 text can stay ASCII bytes sliced from the buffer it was read from. The string and an exact
+/// byte[] are only built when <see cref="encoded"/> / <see cref="data"/> are asked for;
+/// <see cref="TryDecodeTo"/> and <see cref="TryEncodeTo(Span{byte}, out int)"/> skip them entirely.
+///
+/// Values read with <see cref="Core.RawUnpackMode.Lazy"/> stay packed until <see cref="data"/> or
+/// <see cref="Memory"/> is first read, which decodes them (safe to race from several threads).
+/// <see cref="Pack"/> returns them to that state, releasing the decoded bytes.
+/// </summary>
 public class RawData : IDisposable {
-    private static ReadOnlySpan<char> Z85Encode => "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+    private ReadOnlyMemory<byte> decoded;
+    private IMemoryOwner<byte>? owner;
+    private byte[]? dataArray;
 
-    private static ReadOnlySpan<byte> Z85Decode => [
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 0-15
-        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 16-31
-        255, 68,  255, 84,  83,  82,  72,  255, 75,  76,  70,  65,  255, 63,  62,  69,  // 32-47: ! # $ % & ( ) * + - . /
-        0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  64,  255, 73,  66,  74,  71,   // 48-63: 0-9 : < = > ?
-        81,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  // 64-79: @ A-O
-        51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  77,  255, 78,  67,  255, // 80-95: P-Z [ ] ^
-        255, 10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  // 96-111: a-o
-        25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  79,  255, 80,  255, 255  // 112-127: p-z { }
-    ];
+    // Z85 text: ASCII bytes and/or a string, whichever it was created from (the other is derived on demand)
+    private ReadOnlyMemory<byte> encodedUtf8;
+    private string? encodedString;
 
-    public string encoded { get; private set; } = string.Empty;
-    public byte[] data { get; private set; } = [];
+    // Set for lazily unpacked values: first access decodes under this lock, then publishes lazyDecoded
+    private object? lazyGate;
+    private volatile bool lazyDecoded;
 
 
-    public RawData(byte[] data) => this.data = data;
+    public RawData(byte[] data) => SetDecoded(data, null);
 
-    public RawData(ReadOnlySpan<byte> data) => this.data = data.ToArray();
+    public RawData(ReadOnlySpan<byte> data) => SetDecoded(data.ToArray(), null);
 
-    public RawData(Span<byte> data) => this.data = data.ToArray();
+    public RawData(Span<byte> data) => SetDecoded(data.ToArray(), null);
 
-    public RawData(ReadOnlySpan<char> encoded) => this.encoded = encoded.ToString();
+    /// <summary>
+    /// Wraps <paramref name="data"/> without copying; the memory must not change while this instance uses it.
+    /// </summary>
+    public RawData(ReadOnlyMemory<byte> data) => SetDecoded(data, null);
 
-    public RawData(Span<char> encoded) => this.encoded = encoded.ToString();
+    /// <summary>
+    /// Takes ownership of the first <paramref name="length"/> bytes of <paramref name="owner"/>,
+    /// which is disposed with this instance (or when it switches to the encoded form).
+    /// </summary>
+    public RawData(IMemoryOwner<byte> owner, int length) {
+        ArgumentNullException.ThrowIfNull(owner);
+        SetDecoded(owner.Memory[..length], owner);
+    }
+
+    public RawData(ReadOnlySpan<char> encoded) => SetEncoded(default, encoded.ToString());
+
+    public RawData(Span<char> encoded) => SetEncoded(default, encoded.ToString());
 
 
     public void Dispose() {
-        data = [];
-        encoded = string.Empty;
+        SetDecoded(ReadOnlyMemory<byte>.Empty, null);
     }
 
 
@@ -44,154 +66,276 @@ public class RawData : IDisposable {
 
     public static RawData Create(string data) => new(Encoding.UTF8.GetBytes(data));
 
+    /// <summary>
+    /// Wraps Z85 text held as ASCII/UTF-8 bytes without copying; it is decoded when first unpacked.
+    /// The memory must not change while this instance uses it.
+    /// </summary>
+    public static RawData FromEncoded(ReadOnlyMemory<byte> encoded) {
+        var raw = new RawData(ReadOnlyMemory<byte>.Empty);
+        raw.SetEncoded(encoded, null);
+        return raw;
+    }
 
+    /// <summary>
+    /// Copies Z85 text out of a parser buffer that is about to be reused. Kept as ASCII bytes,
+    /// half the size of the string.
+    /// </summary>
+    internal static RawData CopyEncoded(ReadOnlySpan<byte> encoded) => FromEncoded(encoded.ToArray());
+
+    /// <summary>
+    /// Makes <see cref="data"/> / <see cref="Memory"/> decode on first access (<see cref="Core.RawUnpackMode.Lazy"/>).
+    /// </summary>
+    internal RawData DecodeOnAccess() {
+        lazyGate = new object();
+        return this;
+    }
 
-    public RawData Unpack() {
-        if (encoded == string.Empty) {
-            return this;
-        }
+    /// <summary>
+    /// Decodes Z85 text from a parser buffer straight into an exact-size array.
+    /// </summary>
+    internal static RawData Decode<TChar>(ReadOnlySpan<TChar> encoded) where TChar : unmanaged {
+        var blocks = Z85.SplitPadding(encoded, out int removedBytes);
+        var buffer = GC.AllocateUninitializedArray<byte>(Z85.GetDecodedLength(encoded));
+        Z85.DecodeBlocks(blocks, buffer, removedBytes);
+        return new RawData(buffer);
+    }
 
-        // Z85: 5 chars -> 4 bytes, with possible padding
-        var paddingInfo = GetPaddingInfo(encoded);
-        int decodedLength = (encoded.Length / 5 * 4) - paddingInfo.removedBytes;
 
-        byte[] buffer = ArrayPool<byte>.Shared.Rent(decodedLength + 4);
-        try {
-            int written = Z85DecodeBytes(encoded.AsSpan(), buffer, paddingInfo);
-            data = buffer[..written];
-            encoded = string.Empty;
-        } finally {
-            ArrayPool<byte>.Shared.Return(buffer);
+
+
+    /// <summary>
+    /// Decoded bytes; empty while only the encoded form is held (see <see cref="IsPacked"/>),
+    /// unless the value unpacks lazily. Returns the wrapped array as is when the value was created
+    /// from one, otherwise builds (and keeps) an exact copy — use <see cref="Memory"/> to avoid it.
+    /// </summary>
+    public byte[] data {
+        get {
+            EnsureLazyDecoded();
+            if (dataArray == null) {
+                dataArray = MemoryMarshal.TryGetArray(decoded, out var segment) && segment.Offset == 0 && segment.Count == segment.Array!.Length
+                    ? segment.Array
+                    : decoded.ToArray();
+            }
+            return dataArray;
         }
+    }
 
-        return this;
+    /// <summary>
+    /// Decoded bytes without a copy; empty while only the encoded form is held, unless the value unpacks lazily.
+    /// </summary>
+    public ReadOnlyMemory<byte> Memory {
+        get {
+            EnsureLazyDecoded();
+            return decoded;
+        }
     }
 
+    /// <summary>
+    /// Z85 text; empty until <see cref="Pack"/>. Built from the ASCII bytes on first access when
+    /// the value was read from a UTF-8 buffer.
+    /// </summary>
+    public string encoded => encodedString ??= Encoding.ASCII.GetString(encodedUtf8.Span);
 
+    /// <summary>
+    /// True while only the encoded form is held.
+    /// </summary>
+    public bool IsPacked => HasEncoded && decoded.IsEmpty;
 
-    public RawData Pack() {
-        if (encoded != string.Empty) {
-            return this;
+    private bool HasEncoded => !encodedUtf8.IsEmpty || !string.IsNullOrEmpty(encodedString);
+
+
+
+
+    /// <summary>
+    /// Exact number of decoded bytes, computed from the text length when still packed.
+    /// </summary>
+    public int GetDecodedLength() {
+        if (!IsPacked) {
+            return decoded.Length;
         }
+        return encodedString != null ? Z85.GetDecodedLength(encodedString.AsSpan()) : Z85.GetDecodedLength(encodedUtf8.Span);
+    }
 
-        // Z85 requires input length divisible by 4, we pad if needed
-        int padding = (4 - (data.Length % 4)) % 4;
-        int paddedLength = data.Length + padding;
-        int outputLength = paddedLength / 4 * 5;
 
-        char[] chars = ArrayPool<char>.Shared.Rent(outputLength + 1); // +1 for padding marker
+    /// <summary>
+    /// Writes the decoded bytes to <paramref name="destination"/>, decoding straight from the Z85 text
+    /// when packed. The instance itself is left as it is. Returns false when
+    /// <paramref name="destination"/> is shorter than <see cref="GetDecodedLength"/>.
+    /// </summary>
+    /// <exception cref="FormatException">The encoded text holds an invalid character.</exception>
+    public bool TryDecodeTo(Span<byte> destination, out int written) {
+        int length = GetDecodedLength();
+        if (destination.Length < length) {
+            written = 0;
+            return false;
+        }
 
-        try {
-            int written = Z85EncodeBytes(data, chars, padding);
-            encoded = new string(chars, 0, written);
-            data = [];
-        } finally {
-            ArrayPool<char>.Shared.Return(chars);
+        if (!IsPacked) {
+            decoded.Span.CopyTo(destination);
+            written = length;
+        } else if (!encodedUtf8.IsEmpty) {
+            written = DecodeText(encodedUtf8.Span, destination);
+        } else {
+            written = DecodeText(encodedString.AsSpan(), destination);
         }
+        return true;
+    }
 
-        return this;
+
+    /// <summary>
+    /// Number of Z85 chars (padding marker included) this value takes when serialized.
+    /// </summary>
+    public int GetEncodedLength() {
+        if (HasEncoded) {
+            return encodedString?.Length ?? encodedUtf8.Length;
+        }
+        return Z85.GetEncodedLength(decoded.Length);
     }
 
 
+    /// <summary>
+    /// Writes the Z85 text as ASCII to <paramref name="destination"/>, encoding straight from the
+    /// decoded bytes when not packed. Returns false when it is shorter than <see cref="GetEncodedLength"/>.
+    /// </summary>
+    public bool TryEncodeTo(Span<byte> destination, out int written) => TryEncodeText(destination, out written);
+
+    /// <inheritdoc cref="TryEncodeTo(Span{byte}, out int)"/>
+    public bool TryEncodeTo(Span<char> destination, out int written) => TryEncodeText(destination, out written);
+
+
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    private static int Z85EncodeBytes(ReadOnlySpan<byte> input, Span<char> output, int padding) {
-        var alphabet = Z85Encode;
-        int inputLen = input.Length;
-        int paddedLen = inputLen + padding;
-        int writePos = 0;
 
-        // Process full 4-byte blocks
-        int fullBlocks = inputLen / 4;
-        for (int i = 0; i < fullBlocks; i++) {
-            int offset = i * 4;
-            uint value = ((uint)input[offset] << 24)        |
-                         ((uint)input[offset + 1] << 16)    |
-                         ((uint)input[offset + 2] << 8)     |
-                         input[offset + 3];
+    /// <summary>
+    /// Switches to the decoded form: decodes the Z85 text into a new exact-size array.
+    /// </summary>
+    public RawData Unpack() {
+        if (lazyGate != null) {
+            EnsureLazyDecoded();
+            return this;
+        }
+        if (!IsPacked) {
+            return this;
+        }
+
+        var buffer = GC.AllocateUninitializedArray<byte>(GetDecodedLength());
+        TryDecodeTo(buffer, out _);
+        SetDecoded(buffer, null);
+        return this;
+    }
+
 
-            output[writePos + 4] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 3] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 2] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 1] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos] = alphabet[(int)value];
-            writePos += 5;
+    /// <summary>
+    /// Switches to the decoded form, decoding into memory rented from <paramref name="pool"/>.
+    /// The memory goes back to the pool on <see cref="Dispose"/>.
+    /// </summary>
+    public RawData Unpack(MemoryPool<byte> pool) {
+        ArgumentNullException.ThrowIfNull(pool);
+        if (!IsPacked) {
+            return this;
         }
 
-        // Handle remaining bytes with padding
-        int remaining = inputLen % 4;
-        if (remaining > 0) {
-            uint value = 0;
-            int offset = fullBlocks * 4;
+        int length = GetDecodedLength();
+        var rented = pool.Rent(length);
+        try {
+            TryDecodeTo(rented.Memory.Span, out _);
+        } catch {
+            rented.Dispose();
+            throw;
+        }
+        SetDecoded(rented.Memory[..length], rented);
+        return this;
+    }
 
-            for (int i = 0; i < remaining; i++) {
-                value = (value << 8) | input[offset + i];
-            }
-            // Pad with zeros
-            for (int i = remaining; i < 4; i++) {
-                value <<= 8;
-            }
 
-            output[writePos + 4] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 3] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 2] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos + 1] = alphabet[(int)(value % 85)]; value /= 85;
-            output[writePos] = alphabet[(int)value];
-            writePos += 5;
 
-            // Append padding marker (number of padding bytes: 1, 2, or 3)
-            output[writePos] = (char)('0' + padding);
-            writePos++;
+    /// <summary>
+    /// Switches to the encoded form: the Z85 text becomes <see cref="encoded"/> and the decoded
+    /// bytes are released. The serializers don't need this, they encode into their output directly.
+    /// </summary>
+    /// <remarks>
+    /// This also holds for a lazily unpacked value that was already decoded: the decode is thrown
+    /// away and the next read of <see cref="data"/> or <see cref="Memory"/> decodes again. Leave such
+    /// values unpacked when they will be read again.
+    /// </remarks>
+    public RawData Pack() {
+        if (HasEncoded) {
+            return this;
         }
 
-        return writePos;
+        var text = string.Create(Z85.GetEncodedLength(decoded.Length), decoded, static (chars, bytes) => {
+            Z85.Encode(bytes.Span, chars, (4 - bytes.Length % 4) % 4);
+        });
+        SetEncoded(default, text);
+        return this;
     }
 
 
 
-    private static (int removedBytes, bool hasPadding) GetPaddingInfo(string encoded) {
-        if (encoded.Length == 0) {
-            return (0, false);
+
+    private void EnsureLazyDecoded() {
+        if (lazyGate == null || lazyDecoded) {
+            return;
         }
 
-        // Check if last char is a padding marker (1, 2, or 3)
-        char last = encoded[^1];
-        if (last >= '1' && last <= '3') {
-            return (last - '0', true);
+        lock (lazyGate) {
+            if (IsPacked) {
+                var buffer = GC.AllocateUninitializedArray<byte>(GetDecodedLength());
+                TryDecodeTo(buffer, out _);
+                SetDecoded(buffer, null);
+            }
+            lazyDecoded = true;
         }
-        return (0, false);
     }
 
 
+    private bool TryEncodeText<TChar>(Span<TChar> destination, out int written) where TChar : unmanaged {
+        int length = GetEncodedLength();
+        if (destination.Length < length) {
+            written = 0;
+            return false;
+        }
 
-    [MethodImpl(MethodImplOptions.AggressiveInlining)]
-    private static int Z85DecodeBytes(ReadOnlySpan<char> input, Span<byte> output, (int removedBytes, bool hasPadding) paddingInfo) {
-        var decode = Z85Decode;
-        int inputLen = paddingInfo.hasPadding ? input.Length - 1 : input.Length;
-        int writePos = 0;
+        if (!HasEncoded) {
+            written = Z85.Encode(decoded.Span, destination, (4 - decoded.Length % 4) % 4);
+        } else if (typeof(TChar) == typeof(byte)) {
+            var bytes = MemoryMarshal.Cast<TChar, byte>(destination);
+            written = encodedString != null ? Encoding.ASCII.GetBytes(encodedString, bytes) : Copy(encodedUtf8.Span, bytes);
+        } else {
+            var chars = MemoryMarshal.Cast<TChar, char>(destination);
+            written = encodedString != null ? Copy(encodedString.AsSpan(), chars) : Encoding.ASCII.GetChars(encodedUtf8.Span, chars);
+        }
+        return true;
+    }
 
-        for (int i = 0; i < inputLen; i += 5) {
-            uint value = 0;
-            for (int j = 0; j < 5; j++) {
-                char c = input[i + j];
-                if (c > 127) {
-                    throw new FormatException($"Invalid Z85 character at position {i + j}");
-                }
-                byte decoded = decode[c];
-                if (decoded == 255) {
-                    throw new FormatException($"Invalid Z85 character '{c}' at position {i + j}");
-                }
-                value = value * 85 + decoded;
-            }
 
-            output[writePos] = (byte)(value >> 24);
-            output[writePos + 1] = (byte)(value >> 16);
-            output[writePos + 2] = (byte)(value >> 8);
-            output[writePos + 3] = (byte)value;
-            writePos += 4;
+    private static int Copy<T>(ReadOnlySpan<T> source, Span<T> destination) {
+        source.CopyTo(destination);
+        return source.Length;
+    }
+
+
+    private static int DecodeText<TChar>(ReadOnlySpan<TChar> text, Span<byte> destination) where TChar : unmanaged {
+        var blocks = Z85.SplitPadding(text, out int removedBytes);
+        return Z85.DecodeBlocks(blocks, destination, removedBytes);
+    }
+
+
+    private void SetDecoded(ReadOnlyMemory<byte> memory, IMemoryOwner<byte>? memoryOwner) {
+        if (owner != null && owner != memoryOwner) {
+            owner.Dispose();
         }
+        decoded = memory;
+        owner = memoryOwner;
+        dataArray = null;
+        encodedUtf8 = default;
+        encodedString = null;
+    }
+
 
-        // Remove padding bytes from the end
-        return writePos - paddingInfo.removedBytes;
+    private void SetEncoded(ReadOnlyMemory<byte> utf8, string? text) {
+        SetDecoded(ReadOnlyMemory<byte>.Empty, null);
+        encodedUtf8 = utf8;
+        encodedString = text;
+        lazyDecoded = false;
     }
 }
@@ -0,0 +1,512 @@
+using FON.Diagnostics;
+using System.Buffers.Binary;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.Arm;
+using System.Runtime.Intrinsics.X86;
+
+namespace FON.Types;
+
+
+/// <summary>
+/// Z85 kernels behind <see cref="RawData.Pack"/> and <see cref="RawData.Unpack()"/>.
+///
+/// With SSSE3 or AdvSimd, 16 blocks (64 bytes / 80 chars) are handled per iteration: division by 85
+/// is a widening multiply-shift, and the alphabet mapping and validation are lookups over 16-byte
+/// table rows. The scalar code handles the tail and reports invalid characters with their position.
+/// FON.Native/src/z85.rs implements the same kernels (SSSE3 only).
+///
+/// Text is either UTF-16 (<c>char</c>) or ASCII bytes (<c>byte</c>, e.g. a slice of a UTF-8 file),
+/// so RawData can be decoded from and encoded into the parser's and writer's buffers directly.
+/// </summary>
+internal static class Z85 {
+    /// <summary>
+    /// ceil(2^38 / 85): (v * Div85Magic) >> 38 == v / 85 for every uint.
+    /// </summary>
+    private const ulong Div85Magic = 0xC0C0C0C1;
+
+    private const int VectorBlocks = 16;
+
+    private static ReadOnlySpan<byte> Alphabet => "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#"u8;
+
+    private static ReadOnlySpan<byte> Decode => [
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 0-15
+        255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, // 16-31
+        255, 68,  255, 84,  83,  82,  72,  255, 75,  76,  70,  65,  255, 63,  62,  69,  // 32-47: ! # $ % & ( ) * + - . /
+        0,   1,   2,   3,   4,   5,   6,   7,   8,   9,  64,  255, 73,  66,  74,  71,   // 48-63: 0-9 : < = > ?
+        81,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  // 64-79: @ A-O
+        51,  52,  53,  54,  55,  56,  57,  58,  59,  60,  61,  77,  255, 78,  67,  255, // 80-95: P-Z [ ] ^
+        255, 10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  // 96-111: a-o
+        25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  79,  255, 80,  255, 255  // 112-127: p-z { }
+    ];
+
+    /// <summary>
+    /// Byte shuffles that move digit j of each block between "block b at 5b + j" (the text layout)
+    /// and "lane b" (one block per uint). Row j of Pack gives output bytes 0-15, row j of PackTail
+    /// bytes 16-19; row j of Unpack reads bytes 0-15 and row j of UnpackTail bytes 4-19.
+    /// </summary>
+    private static readonly Vector128<byte>[] pack = new Vector128<byte>[5];
+    private static readonly Vector128<byte>[] packTail = new Vector128<byte>[5];
+    private static readonly Vector128<byte>[] unpack = new Vector128<byte>[5];
+    private static readonly Vector128<byte>[] unpackTail = new Vector128<byte>[5];
+
+
+    static Z85() {
+        Span<byte> packRow = stackalloc byte[16];
+        Span<byte> packTailRow = stackalloc byte[16];
+        Span<byte> unpackRow = stackalloc byte[16];
+        Span<byte> unpackTailRow = stackalloc byte[16];
+
+        for (int j = 0; j < 5; j++) {
+            // 0x80 yields zero in both pshufb and tbl
+            packRow.Fill(0x80);
+            packTailRow.Fill(0x80);
+            unpackRow.Fill(0x80);
+            unpackTailRow.Fill(0x80);
+
+            for (int b = 0; b < 4; b++) {
+                var textPosition = 5 * b + j;
+                if (textPosition < 16) {
+                    packRow[textPosition] = (byte)(4 * b);
+                    unpackRow[4 * b] = (byte)textPosition;
+                } else {
+                    packTailRow[textPosition - 16] = (byte)(4 * b);
+                    unpackTailRow[4 * b] = (byte)(textPosition - 4);
+                }
+            }
+
+            pack[j] = Vector128.Create((ReadOnlySpan<byte>)packRow);
+            packTail[j] = Vector128.Create((ReadOnlySpan<byte>)packTailRow);
+            unpack[j] = Vector128.Create((ReadOnlySpan<byte>)unpackRow);
+            unpackTail[j] = Vector128.Create((ReadOnlySpan<byte>)unpackTailRow);
+        }
+    }
+
+
+    private static bool IsVectorized => Ssse3.IsSupported || AdvSimd.Arm64.IsSupported;
+
+
+
+
+    /// <summary>
+    /// Chars needed for <paramref name="length"/> bytes, padding marker included.
+    /// </summary>
+    public static int GetEncodedLength(int length) => (length + 3) / 4 * 5 + (length % 4 == 0 ? 0 : 1);
+
+
+    /// <summary>
+    /// Bytes held by <paramref name="input"/>, a full encoded value (marker included).
+    /// </summary>
+    public static int GetDecodedLength<TChar>(ReadOnlySpan<TChar> input) where TChar : unmanaged {
+        var blocks = SplitPadding(input, out int removedBytes);
+        return Math.Max(0, blocks.Length / 5 * 4 - removedBytes);
+    }
+
+
+    /// <summary>
+    /// Splits a trailing padding marker ('1'-'3') off <paramref name="input"/>, returning the blocks.
+    /// </summary>
+    public static ReadOnlySpan<TChar> SplitPadding<TChar>(ReadOnlySpan<TChar> input, out int removedBytes) where TChar : unmanaged {
+        if (input.Length > 0) {
+            var last = ToInt(input[^1]);
+            if (last >= '1' && last <= '3') {
+                removedBytes = last - '0';
+                return input[..^1];
+            }
+        }
+        removedBytes = 0;
+        return input;
+    }
+
+
+
+
+    /// <summary>
+    /// Encodes <paramref name="input"/>; a partial last block is zero-padded and followed by a
+    /// marker char holding <paramref name="padding"/>. Returns the number of chars written.
+    /// </summary>
+    public static int Encode<TChar>(ReadOnlySpan<byte> input, Span<TChar> output, int padding) where TChar : unmanaged {
+        if (FonMetrics.Z85Ticks is not { } ticks) {
+            return EncodeAll(input, output, padding);
+        }
+        var started = Stopwatch.GetTimestamp();
+        var written = EncodeAll(input, output, padding);
+        Interlocked.Add(ref ticks.Value, Stopwatch.GetTimestamp() - started);
+        return written;
+    }
+
+
+    private static int EncodeAll<TChar>(ReadOnlySpan<byte> input, Span<TChar> output, int padding) where TChar : unmanaged {
+        int fullBlocks = input.Length / 4;
+        int done = IsVectorized ? EncodeVector(input, output, fullBlocks / VectorBlocks) : 0;
+
+        int writePos = done * 5;
+        for (int i = done; i < fullBlocks; i++) {
+            EncodeBlock(BinaryPrimitives.ReadUInt32BigEndian(input.Slice(i * 4)), output.Slice(writePos, 5));
+            writePos += 5;
+        }
+
+        // Handle remaining bytes with padding
+        int remaining = input.Length % 4;
+        if (remaining > 0) {
+            Span<byte> last = stackalloc byte[4];
+            last.Clear();
+            input.Slice(fullBlocks * 4).CopyTo(last);
+
+            EncodeBlock(BinaryPrimitives.ReadUInt32BigEndian(last), output.Slice(writePos, 5));
+            writePos += 5;
+
+            // Append padding marker (number of padding bytes: 1, 2, or 3)
+            output[writePos] = FromAscii<TChar>((byte)('0' + padding));
+            writePos++;
+        }
+
+        return writePos;
+    }
+
+
+
+
+    /// <summary>
+    /// Decodes whole 5-char blocks of <paramref name="input"/> and drops <paramref name="removedBytes"/>
+    /// from the end. <paramref name="output"/> only needs room for the bytes kept. Returns the number
+    /// of bytes written.
+    /// </summary>
+    public static int DecodeBlocks<TChar>(ReadOnlySpan<TChar> input, Span<byte> output, int removedBytes) where TChar : unmanaged {
+        if (FonMetrics.Z85Ticks is not { } ticks) {
+            return DecodeAll(input, output, removedBytes);
+        }
+        var started = Stopwatch.GetTimestamp();
+        var written = DecodeAll(input, output, removedBytes);
+        Interlocked.Add(ref ticks.Value, Stopwatch.GetTimestamp() - started);
+        return written;
+    }
+
+
+    private static int DecodeAll<TChar>(ReadOnlySpan<TChar> input, Span<byte> output, int removedBytes) where TChar : unmanaged {
+        int blocks = input.Length / 5;
+        // A padded last block goes through the scalar loop, it is not written whole
+        int vectorBlocks = removedBytes > 0 ? blocks - 1 : blocks;
+        int done = IsVectorized && vectorBlocks > 0 ? DecodeVector(input, output, vectorBlocks / VectorBlocks) : 0;
+
+        var decode = Decode;
+        Span<byte> last = stackalloc byte[4];
+        int writePos = done * 4;
+        for (int i = done * 5; i + 5 <= input.Length; i += 5) {
+            var chars = input.Slice(i, 5);
+            uint value = 0;
+            for (int j = 0; j < 5; j++) {
+                int c = ToInt(chars[j]);
+                if (c > 127) {
+                    throw new FormatException($"Invalid Z85 character at position {i + j}");
+                }
+                byte decoded = decode[c];
+                if (decoded == 255) {
+                    throw new FormatException($"Invalid Z85 character '{(char)c}' at position {i + j}");
+                }
+                value = value * 85 + decoded;
+            }
+
+            if (i + 10 > input.Length && removedBytes > 0) {
+                // Keep only the unpadded part of the last block
+                BinaryPrimitives.WriteUInt32BigEndian(last, value);
+                int kept = Math.Max(0, 4 - removedBytes);
+                last[..kept].CopyTo(output.Slice(writePos));
+                return writePos + kept;
+            }
+
+            BinaryPrimitives.WriteUInt32BigEndian(output.Slice(writePos, 4), value);
+            writePos += 4;
+        }
+
+        return Math.Max(0, writePos - removedBytes);
+    }
+
+
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static void EncodeBlock<TChar>(uint value, Span<TChar> output) where TChar : unmanaged {
+        var alphabet = Alphabet;
+        output[4] = FromAscii<TChar>(alphabet[(int)(value % 85)]); value /= 85;
+        output[3] = FromAscii<TChar>(alphabet[(int)(value % 85)]); value /= 85;
+        output[2] = FromAscii<TChar>(alphabet[(int)(value % 85)]); value /= 85;
+        output[1] = FromAscii<TChar>(alphabet[(int)(value % 85)]); value /= 85;
+        output[0] = FromAscii<TChar>(alphabet[(int)value]);
+    }
+
+
+    // TChar is byte or char; the typeof checks fold away per instantiation
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static int ToInt<TChar>(TChar c) where TChar : unmanaged {
+        return typeof(TChar) == typeof(byte) ? Unsafe.As<TChar, byte>(ref c) : Unsafe.As<TChar, char>(ref c);
+    }
+
+
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static TChar FromAscii<TChar>(byte b) where TChar : unmanaged {
+        if (typeof(TChar) == typeof(byte)) {
+            return Unsafe.As<byte, TChar>(ref b);
+        }
+        char c = (char)b;
+        return Unsafe.As<char, TChar>(ref c);
+    }
+
+
+
+
+    /// <summary>
+    /// Encodes <paramref name="iterations"/> * 16 blocks. Returns the number of blocks encoded.
+    /// </summary>
+    private static int EncodeVector<TChar>(ReadOnlySpan<byte> input, Span<TChar> output, int iterations) where TChar : unmanaged {
+        if (iterations == 0) {
+            return 0;
+        }
+        // The kernel goes through refs, check the bounds once up front
+        if (input.Length < iterations * VectorBlocks * 4 || output.Length < iterations * VectorBlocks * 5) {
+            throw new ArgumentException("Buffer too small for the encoded blocks");
+        }
+
+        ref byte source = ref MemoryMarshal.GetReference(input);
+        ref TChar destination = ref MemoryMarshal.GetReference(output);
+
+        var byteSwap = Vector128.Create((byte)3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        var (p0, p1, p2, p3, p4) = (pack[0], pack[1], pack[2], pack[3], pack[4]);
+        var (t1, t2, t3, t4) = (packTail[1], packTail[2], packTail[3], packTail[4]);
+
+        // Alphabet padded to 128 entries, rows of 16
+        Span<byte> alphabet = stackalloc byte[128];
+        alphabet.Clear();
+        Alphabet.CopyTo(alphabet);
+        var table = new ByteTable(alphabet);
+
+        // Digits of 16 blocks in text order, plus room for the last group's full-width tail store
+        Span<byte> digits = stackalloc byte[VectorBlocks * 5 + 12];
+        ref byte digitsRef = ref MemoryMarshal.GetReference(digits);
+
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            var inputOffset = (nuint)(iteration * VectorBlocks * 4);
+
+            // 4 groups of 4 blocks: one block per uint lane
+            for (int group = 0; group < 4; group++) {
+                var value = Shuffle(Vector128.LoadUnsafe(ref source, inputOffset + (nuint)(group * 16)), byteSwap).AsUInt32();
+
+                var q1 = Div85(value);
+                var q2 = Div85(q1);
+                var q3 = Div85(q2);
+                var q4 = Div85(q3);
+                var d4 = (value - Times85(q1)).AsByte();
+                var d3 = (q1 - Times85(q2)).AsByte();
+                var d2 = (q2 - Times85(q3)).AsByte();
+                var d1 = (q3 - Times85(q4)).AsByte();
+                var d0 = q4.AsByte();
+
+                var head = Shuffle(d0, p0) | Shuffle(d1, p1) | Shuffle(d2, p2) | Shuffle(d3, p3) | Shuffle(d4, p4);
+                var tail = Shuffle(d1, t1) | Shuffle(d2, t2) | Shuffle(d3, t3) | Shuffle(d4, t4);
+
+                // The tail store is 16 bytes wide, the next group's head overwrites the spare part
+                head.StoreUnsafe(ref digitsRef, (nuint)(group * 20));
+                tail.StoreUnsafe(ref digitsRef, (nuint)(group * 20 + 16));
+            }
+
+            var outputOffset = (nuint)(iteration * VectorBlocks * 5);
+            for (int k = 0; k < 5; k++) {
+                var chars = table.Lookup(Vector128.LoadUnsafe(ref digitsRef, (nuint)(k * 16)), rows: 6);
+
+                if (typeof(TChar) == typeof(byte)) {
+                    chars.StoreUnsafe(ref Unsafe.As<TChar, byte>(ref destination), outputOffset + (nuint)(k * 16));
+                } else {
+                    var (lower, upper) = Vector128.Widen(chars);
+                    lower.StoreUnsafe(ref Unsafe.As<TChar, ushort>(ref destination), outputOffset + (nuint)(k * 16));
+                    upper.StoreUnsafe(ref Unsafe.As<TChar, ushort>(ref destination), outputOffset + (nuint)(k * 16 + 8));
+                }
+            }
+        }
+
+        return iterations * VectorBlocks;
+    }
+
+
+
+
+    /// <summary>
+    /// Decodes up to <paramref name="iterations"/> * 16 blocks. Stops before the first 80-char run
+    /// holding an invalid character, so the scalar loop can report it. Returns the number of blocks decoded.
+    /// </summary>
+    private static int DecodeVector<TChar>(ReadOnlySpan<TChar> input, Span<byte> output, int iterations) where TChar : unmanaged {
+        if (iterations == 0) {
+            return 0;
+        }
+        // The kernel goes through refs, check the bounds once up front
+        if (input.Length < iterations * VectorBlocks * 5 || output.Length < iterations * VectorBlocks * 4) {
+            throw new ArgumentException("Buffer too small for the decoded blocks");
+        }
+
+        ref TChar source = ref MemoryMarshal.GetReference(input);
+        ref byte destination = ref MemoryMarshal.GetReference(output);
+
+        var byteSwap = Vector128.Create((byte)3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        var nonAscii = Vector128.Create((ushort)0xFF80);
+        var (u0, u1, u2, u3, u4) = (unpack[0], unpack[1], unpack[2], unpack[3], unpack[4]);
+        var (t0, t1, t2, t3, t4) = (unpackTail[0], unpackTail[1], unpackTail[2], unpackTail[3], unpackTail[4]);
+
+        // Control chars are caught by the index wrapping below 0, the table starts at ' '
+        Span<byte> printable = stackalloc byte[128];
+        printable.Clear();
+        Decode[32..].CopyTo(printable);
+        var table = new ByteTable(printable);
+        var space = Vector128.Create((byte)32);
+
+        Span<byte> digits = stackalloc byte[VectorBlocks * 5];
+        ref byte digitsRef = ref MemoryMarshal.GetReference(digits);
+
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            var inputOffset = (nuint)(iteration * VectorBlocks * 5);
+            var wide = Vector128<ushort>.Zero;
+            var invalid = Vector128<byte>.Zero;
+
+            for (int k = 0; k < 5; k++) {
+                Vector128<byte> chars;
+                if (typeof(TChar) == typeof(byte)) {
+                    // Non-ASCII bytes have bit 7 set and are caught with the rest
+                    chars = Vector128.LoadUnsafe(ref Unsafe.As<TChar, byte>(ref source), inputOffset + (nuint)(k * 16));
+                    invalid |= chars;
+                } else {
+                    var first = Vector128.LoadUnsafe(ref Unsafe.As<TChar, ushort>(ref source), inputOffset + (nuint)(k * 16));
+                    var second = Vector128.LoadUnsafe(ref Unsafe.As<TChar, ushort>(ref source), inputOffset + (nuint)(k * 16 + 8));
+                    wide |= first | second;
+                    chars = Vector128.Narrow(first, second);
+                }
+
+                var index = chars - space;
+                var digit = table.Lookup(index, rows: 6);
+                invalid |= digit | index;
+                digit.StoreUnsafe(ref digitsRef, (nuint)(k * 16));
+            }
+
+            // Valid digits are below 85, the table marks invalid chars with 255 and wrapped indices have bit 7 set
+            if ((wide & nonAscii) != Vector128<ushort>.Zero || Vector128.ExtractMostSignificantBits(invalid) != 0) {
+                return iteration * VectorBlocks;
+            }
+
+            var outputOffset = (nuint)(iteration * VectorBlocks * 4);
+            for (int group = 0; group < 4; group++) {
+                var head = Vector128.LoadUnsafe(ref digitsRef, (nuint)(group * 20));
+                var tail = Vector128.LoadUnsafe(ref digitsRef, (nuint)(group * 20 + 4));
+
+                var value = (Shuffle(head, u0) | Shuffle(tail, t0)).AsUInt32();
+                value = Times85(value) + (Shuffle(head, u1) | Shuffle(tail, t1)).AsUInt32();
+                value = Times85(value) + (Shuffle(head, u2) | Shuffle(tail, t2)).AsUInt32();
+                value = Times85(value) + (Shuffle(head, u3) | Shuffle(tail, t3)).AsUInt32();
+                value = Times85(value) + (Shuffle(head, u4) | Shuffle(tail, t4)).AsUInt32();
+
+                Shuffle(value.AsByte(), byteSwap).StoreUnsafe(ref destination, outputOffset + (nuint)(group * 16));
+            }
+        }
+
+        return iterations * VectorBlocks;
+    }
+
+
+
+
+    /// <summary>
+    /// pshufb / tbl: byte i of the result is source[indices[i]], or 0 for an index of 0x80.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<byte> Shuffle(Vector128<byte> source, Vector128<byte> indices) {
+        if (Ssse3.IsSupported) {
+            return Ssse3.Shuffle(source, indices);
+        }
+        if (AdvSimd.Arm64.IsSupported) {
+            return AdvSimd.Arm64.VectorTableLookup(source, indices);
+        }
+        throw new PlatformNotSupportedException();
+    }
+
+
+
+
+    /// <summary>
+    /// 128-entry byte table held in 8 rows of 16. <see cref="Lookup"/> maps every byte below 16 * rows
+    /// through the table and everything else to 0.
+    /// </summary>
+    private readonly struct ByteTable {
+        private readonly Vector128<byte> r0, r1, r2, r3, r4, r5, r6, r7;
+
+
+        public ByteTable(ReadOnlySpan<byte> table) {
+            r0 = Vector128.Create(table.Slice(0, 16));
+            r1 = Vector128.Create(table.Slice(16, 16));
+            r2 = Vector128.Create(table.Slice(32, 16));
+            r3 = Vector128.Create(table.Slice(48, 16));
+            r4 = Vector128.Create(table.Slice(64, 16));
+            r5 = Vector128.Create(table.Slice(80, 16));
+            r6 = Vector128.Create(table.Slice(96, 16));
+            r7 = Vector128.Create(table.Slice(112, 16));
+        }
+
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public Vector128<byte> Lookup(Vector128<byte> index, int rows) {
+            if (AdvSimd.Arm64.IsSupported) {
+                // tbl takes up to 64-byte tables and yields 0 for any index past the end
+                return AdvSimd.Arm64.VectorTableLookup((r0, r1, r2, r3), index) |
+                       AdvSimd.Arm64.VectorTableLookup((r4, r5, r6, r7), index - Vector128.Create((byte)64));
+            }
+
+            // pshufb looks at the low nibble unless bit 7 is set. Saturating +0x70 keeps 0-15 as 0x70-0x7F
+            // and pushes everything else (including rows below, wrapped around) to 0x80 and up
+            var bias = Vector128.Create((byte)0x70);
+            var row = Vector128.Create((byte)16);
+            var result = Ssse3.Shuffle(r0, Sse2.AddSaturate(index, bias));
+            result |= Ssse3.Shuffle(r1, Sse2.AddSaturate(index -= row, bias));
+            result |= Ssse3.Shuffle(r2, Sse2.AddSaturate(index -= row, bias));
+            result |= Ssse3.Shuffle(r3, Sse2.AddSaturate(index -= row, bias));
+            result |= Ssse3.Shuffle(r4, Sse2.AddSaturate(index -= row, bias));
+            result |= Ssse3.Shuffle(r5, Sse2.AddSaturate(index -= row, bias));
+            if (rows > 6) {
+                result |= Ssse3.Shuffle(r6, Sse2.AddSaturate(index -= row, bias));
+                result |= Ssse3.Shuffle(r7, Sse2.AddSaturate(index -= row, bias));
+            }
+            return result;
+        }
+    }
+
+
+
+
+    /// <summary>
+    /// Per-lane value / 85 as a widening multiply by <see cref="Div85Magic"/> and a shift.
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<uint> Div85(Vector128<uint> value) {
+        if (Sse2.IsSupported) {
+            var magic = Vector128.Create((uint)Div85Magic);
+            var even = Sse2.Multiply(value, magic);
+            var odd = Sse2.Multiply(Sse2.ShiftRightLogical(value.AsUInt64(), 32).AsUInt32(), magic);
+            return (Sse2.ShiftRightLogical(even, 38) | Sse2.ShiftLeftLogical(Sse2.ShiftRightLogical(odd, 38), 32)).AsUInt32();
+        }
+        if (AdvSimd.IsSupported) {
+            var lower = AdvSimd.MultiplyWideningLower(value.GetLower(), Vector64.Create((uint)Div85Magic));
+            var upper = AdvSimd.MultiplyWideningUpper(value, Vector128.Create((uint)Div85Magic));
+            return AdvSimd.ExtractNarrowingUpper(
+                AdvSimd.ExtractNarrowingLower(AdvSimd.ShiftRightLogical(lower, 38)),
+                AdvSimd.ShiftRightLogical(upper, 38));
+        }
+        throw new PlatformNotSupportedException();
+    }
+
+
+
+
+    /// <summary>
+    /// 85 = 64 + 16 + 4 + 1, shifts and adds only (no 32-bit vector multiply before SSE4.1).
+    /// </summary>
+    [MethodImpl(MethodImplOptions.AggressiveInlining)]
+    private static Vector128<uint> Times85(Vector128<uint> value) {
+        return (value << 6) + (value << 4) + (value << 2) + value;
+    }
+}